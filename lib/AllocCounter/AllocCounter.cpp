@@ -0,0 +1,107 @@
+#include "AllocCounter.h"
+
+#include <stdlib.h>
+
+#include <atomic>
+#include <new>
+
+#ifdef ALLOC_COUNTER
+
+static std::atomic<uint32_t> allocs{0};
+static std::atomic<uint32_t> frees{0};
+
+extern "C" {
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+void __real_free(void* ptr);
+
+void* __wrap_malloc(size_t size) {
+  allocs.fetch_add(1, std::memory_order_relaxed);
+  return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+  allocs.fetch_add(1, std::memory_order_relaxed);
+  return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+  allocs.fetch_add(1, std::memory_order_relaxed);
+  return __real_realloc(ptr, size);
+}
+
+void __wrap_free(void* ptr) {
+  if (ptr) frees.fetch_add(1, std::memory_order_relaxed);
+  __real_free(ptr);
+}
+}
+
+// A shared libstdc++ calls malloc through its own PLT, out of reach of --wrap
+void* operator new(size_t size) {
+  void* ptr = malloc(size ? size : 1);
+  if (!ptr) {
+#ifdef __cpp_exceptions
+    throw std::bad_alloc();
+#else
+    abort();
+#endif
+  }
+  return ptr;
+}
+
+void* operator new[](size_t size) {
+  return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  return malloc(size ? size : 1);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+  return malloc(size ? size : 1);
+}
+
+void operator delete(void* ptr) noexcept {
+  free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+  free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+  free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+  free(ptr);
+}
+
+bool allocCounterEnabled() {
+  return true;
+}
+
+AllocCounts allocCounts() {
+  return {allocs.load(std::memory_order_relaxed), frees.load(std::memory_order_relaxed)};
+}
+
+uint32_t allocCount() {
+  return allocs.load(std::memory_order_relaxed);
+}
+
+#else
+
+bool allocCounterEnabled() {
+  return false;
+}
+
+AllocCounts allocCounts() {
+  return {0, 0};
+}
+
+uint32_t allocCount() {
+  return 0;
+}
+
+#endif
@@ -0,0 +1,21 @@
+// Heap allocation counter
+// With -DALLOC_COUNTER and the linker flags
+//   -Wl,--wrap=malloc -Wl,--wrap=calloc -Wl,--wrap=realloc -Wl,--wrap=free
+// every malloc/calloc/realloc/free in the image bumps a process-wide counter (operator
+// new/delete are routed through malloc/free so host builds count C++ allocations too).
+// Without the define the functions return zeros and nothing is wrapped.
+//
+//   server.setAllocProbe(allocCount);   // per-request allocations in HttpServerStats
+
+#pragma once
+
+#include <stdint.h>
+
+struct AllocCounts {
+  uint32_t allocs;  // malloc + calloc + realloc
+  uint32_t frees;
+};
+
+bool allocCounterEnabled();
+AllocCounts allocCounts();
+uint32_t allocCount();
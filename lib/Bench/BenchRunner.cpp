@@ -0,0 +1,145 @@
+// Benchmark scenarios for the sketches
+
+#include "BenchRunner.h"
+
+#include <Arduino.h>
+#include <stdarg.h>
+
+#include "HeapSampler.h"
+
+#define BENCH_LINE_SIZE 6144
+const uint32_t BENCH_SETTLE_MS = 200;       // after start(), before measuring
+const uint32_t BENCH_IDLE_STEP_MS = 10;     // pace of step()/heap sampling without load
+const uint32_t BENCH_HEAP_INTERVAL_MS = 100;
+const uint32_t BENCH_HTTP_TIMEOUT_MS = 2000;
+
+// Report lines are built in place: no heap use while the next scenario is being measured
+static char line[BENCH_LINE_SIZE];
+static size_t lineLength;
+
+static void append(const char* format, ...) __attribute__((format(printf, 1, 2)));
+
+static void append(const char* format, ...) {
+  if (lineLength >= sizeof(line)) return;
+  va_list args;
+  va_start(args, format);
+  int n = vsnprintf(line + lineLength, sizeof(line) - lineLength, format, args);
+  va_end(args);
+  lineLength = n < 0 ? sizeof(line) : lineLength + n;
+}
+
+static void appendHistogram(const char* key, const LatencyHistogram& h) {
+  append(",\"%s\":{\"count\":%u,\"min\":%u,\"p50\":%u,\"p90\":%u,\"p99\":%u,\"max\":%u,\"mean\":%u,\"buckets\":[",
+         key, (unsigned)h.count(), (unsigned)h.min(), (unsigned)h.percentile(50), (unsigned)h.percentile(90),
+         (unsigned)h.percentile(99), (unsigned)h.max(), (unsigned)h.mean());
+  bool first = true;
+  for (uint8_t i = 0; i < LATENCY_BUCKETS; i++) {
+    if (h.bucketCount(i) == 0) continue;
+    append("%s[%u,%u]", first ? "" : ",", (unsigned)LatencyHistogram::bucketUpperBound(i), (unsigned)h.bucketCount(i));
+    first = false;
+  }
+  append("]}");
+}
+
+static void emitLine(const BenchTarget& target) {
+  if (lineLength >= sizeof(line)) {
+    snprintf(line, sizeof(line), "BENCH {\"bench\":\"%s\",\"error\":\"report too long\"}", target.name);
+  }
+  target.emit(line);
+}
+
+static void runScenario(const BenchTarget& target, const BenchScenario& scenario, HttpBenchClient& api) {
+  static LatencyHistogram latency;
+  static HeapSampler heap(BENCH_HEAP_INTERVAL_MS);
+
+  if (scenario.start) scenario.start(api);
+  delay(BENCH_SETTLE_MS);
+
+  latency.reset();
+  uint32_t requests = 0;
+  uint32_t errors = 0;
+  uint32_t allocsBefore = target.allocs ? target.allocs() : 0;
+  uint32_t startMs = millis();
+  uint32_t startUs = micros();
+  heap.reset(startMs);
+  target.loop->start();
+  if (scenario.burst) scenario.burst->start();
+
+  for (;;) {
+    uint32_t elapsed = millis() - startMs;
+    if (elapsed >= scenario.durationMs) break;
+
+    if (scenario.load) {
+      bool post = target.postPath && target.postEvery && requests % target.postEvery == 0;
+      uint32_t sentUs = micros();
+      int status = post ? api.request("POST", target.postPath, target.postBody)
+                        : api.request("GET", target.getPath, nullptr);
+      uint32_t tookUs = micros() - sentUs;
+      requests++;
+      if (status == 200) {
+        latency.record(tookUs);
+      } else {
+        errors++;
+        if (status == 0) delay(BENCH_IDLE_STEP_MS);  // server gone: do not spin on connect()
+      }
+    } else {
+      delay(BENCH_IDLE_STEP_MS);
+    }
+
+    if (scenario.step) scenario.step(api, elapsed);
+    heap.sample(millis(), ESP.getFreeHeap(), ESP.getMaxAllocHeap());
+  }
+
+  uint32_t seconds100 = (micros() - startUs) / 10000;
+  target.loop->stop();
+  if (scenario.burst) scenario.burst->stop();
+  uint32_t allocs = target.allocs ? target.allocs() - allocsBefore : 0;
+  delay(target.loop->periodUs() / 1000 * 2 + 1);  // the control task has seen the stop
+
+  lineLength = 0;
+  append("BENCH {\"bench\":\"%s\",\"scenario\":\"%s\",\"seconds\":%u.%02u", target.name, scenario.name,
+         (unsigned)(seconds100 / 100), (unsigned)(seconds100 % 100));
+  append(",\"loop\":{\"period_us\":%u,\"deadline_misses\":%u", (unsigned)target.loop->periodUs(),
+         (unsigned)target.loop->deadlineMisses());
+  appendHistogram("busy_us", target.loop->busy());
+  appendHistogram("jitter_us", target.loop->jitter());
+  append("}");
+  if (scenario.load) {
+    uint32_t rps10 = seconds100 ? (uint32_t)((uint64_t)(requests - errors) * 1000 / seconds100) : 0;
+    append(",\"http\":{\"requests\":%u,\"errors\":%u,\"rps\":%u.%u", (unsigned)requests, (unsigned)errors,
+           (unsigned)(rps10 / 10), (unsigned)(rps10 % 10));
+    appendHistogram("latency_us", latency);
+    append("}");
+  }
+  if (scenario.burst) {
+    const BurstProbe& burst = *scenario.burst;
+    uint32_t ok = burst.requests() - burst.errors();
+    uint32_t rps10 = burst.sendingUs() ? (uint32_t)((uint64_t)ok * 10000000 / burst.sendingUs()) : 0;
+    append(",\"burst\":{\"requests\":%u,\"errors\":%u,\"rps\":%u.%u,\"superseded\":%u,\"applied\":%u",
+           (unsigned)burst.requests(), (unsigned)burst.errors(), (unsigned)(rps10 / 10), (unsigned)(rps10 % 10),
+           (unsigned)burst.superseded(), (unsigned)burst.lag().count());
+    appendHistogram("lag_us", burst.lag());
+    append("}");
+  }
+  append(",\"heap\":{\"free_min\":%u,\"largest_block_min\":%u,\"samples\":[", (unsigned)heap.minFree(),
+         (unsigned)heap.minLargestBlock());
+  for (uint8_t i = 0; i < heap.count(); i++) {
+    const HeapSample& s = heap.at(i);
+    append("%s[%u,%u,%u]", i ? "," : "", (unsigned)s.timeMs, (unsigned)s.freeBytes, (unsigned)s.largestBlock);
+  }
+  append("]}");
+  if (target.allocs) append(",\"allocs\":%u", (unsigned)allocs);
+  append("}");
+  emitLine(target);
+}
+
+void runBenchmarks(const BenchTarget& target, const BenchScenario* scenarios, size_t count) {
+  HttpBenchClient api;
+  api.connect(target.httpPort, BENCH_HTTP_TIMEOUT_MS);
+
+  for (size_t i = 0; i < count; i++) runScenario(target, scenarios[i], api);
+
+  lineLength = 0;
+  append("BENCH {\"bench\":\"%s\",\"done\":true,\"scenarios\":%u}", target.name, (unsigned)count);
+  emitLine(target);
+}
@@ -0,0 +1,41 @@
+// Benchmark scenarios for the sketches (build flag -DBENCH)
+// A scenario puts the running firmware into a state through its own HTTP API (loopback client)
+// or input overrides, then measures for a fixed time: control-loop busy time and period
+// jitter (LoopProbe), request latency and throughput when `load` is set, burst rate and
+// command lag when `burst` is set (BurstProbe), heap minimum and largest free block over
+// time, and heap allocations.
+// Each scenario produces one line "BENCH {json}", the run ends with {"done":true};
+// tools/bench_report.py collects them and compares against a baseline.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "BurstProbe.h"
+#include "HttpBenchClient.h"
+#include "LoopProbe.h"
+
+struct BenchScenario {
+  const char* name;
+  uint32_t durationMs;
+  void (*start)(HttpBenchClient& api);                     // may block; not measured
+  void (*step)(HttpBenchClient& api, uint32_t elapsedMs);  // optional, between measurements
+  bool load;                                               // hammer the API for the whole run
+  BurstProbe* burst;                                       // optional, fired by step()
+};
+
+struct BenchTarget {
+  const char* name;     // sketch name in the report
+  uint16_t httpPort;    // where the sketch's HttpServer listens
+  const char* getPath;  // load: GET requests...
+  const char* postPath; // ...and every postEvery-th one a POST (nullptr = GET only)
+  const char* postBody;
+  uint8_t postEvery;
+  LoopProbe* loop;
+  uint32_t (*allocs)();  // running allocation count, nullptr when not available
+  void (*emit)(const char* line);
+};
+
+// Runs every scenario once, in order; blocks the calling task for the sum of their durations
+void runBenchmarks(const BenchTarget& target, const BenchScenario* scenarios, size_t count);
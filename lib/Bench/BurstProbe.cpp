@@ -0,0 +1,33 @@
+// Input burst capture for benchmarks
+
+#include "BurstProbe.h"
+
+#include <Arduino.h>
+#include <stdio.h>
+
+void BurstProbe::fire(HttpBenchClient& api) {
+  char body[64];
+  uint32_t startUs = micros();
+  for (uint16_t i = 0; i < count_; i++) {
+    float u = count_ > 1 ? (float)i / (count_ - 1) : 1.0f;
+    if (reverse_) u = 1.0f - u;
+    snprintf(body, sizeof(body), format_, from_ + (to_ - from_) * u);
+    int status = api.request("POST", path_, body);
+    requests_++;
+    if (status != 200) {
+      errors_++;
+      if (status == 0) break;  // server gone: the next step reconnects
+    }
+  }
+  sendingUs_ += micros() - startUs;
+  reverse_ = !reverse_;
+}
+
+void BurstProbe::start() {
+  lag_.reset();
+  requests_ = 0;
+  errors_ = 0;
+  sendingUs_ = 0;
+  supersededStart_ = superseded_();
+  recording_.store(true, std::memory_order_release);
+}
@@ -0,0 +1,58 @@
+// Input burst capture for benchmarks
+// A burst scenario's step calls fire(): `count` back-to-back POSTs sweeping one value from
+// one end of a range to the other, the way a dragged UI slider or a script sends targets.
+// The control task calls applied() for every target it actually writes to the servo, with
+// the time since the request was received. The runner reports the request rate of the bursts,
+// how many targets were superseded before the control task got to them, and the
+// receipt -> servo write lag of the ones that were applied.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+
+#include "HttpBenchClient.h"
+#include "LatencyHistogram.h"
+
+class BurstProbe {
+public:
+  // `format` takes the value as its only %f (e.g. "{\"angle\":%.1f}"); `superseded` reads the
+  // sketch's running count of targets replaced before they were applied
+  BurstProbe(const char* path, const char* format, float from, float to, uint16_t count, uint32_t (*superseded)())
+      : path_(path), format_(format), from_(from), to_(to), count_(count), superseded_(superseded) {}
+
+  // Control task, for every applied target
+  void applied(uint32_t lagUs) {
+    if (recording_.load(std::memory_order_acquire)) lag_.record(lagUs);
+  }
+
+  // Scenario step: one sweep, alternating direction
+  void fire(HttpBenchClient& api);
+
+  // Runner side
+  void start();
+  void stop() { recording_.store(false, std::memory_order_release); }
+
+  uint32_t requests() const { return requests_; }
+  uint32_t errors() const { return errors_; }
+  uint32_t sendingUs() const { return sendingUs_; }  // time spent inside fire()
+  uint32_t superseded() const { return superseded_() - supersededStart_; }
+  const LatencyHistogram& lag() const { return lag_; }
+
+private:
+  const char* path_;
+  const char* format_;
+  float from_;
+  float to_;
+  uint16_t count_;
+  uint32_t (*superseded_)();
+
+  std::atomic<bool> recording_{false};
+  LatencyHistogram lag_;
+  bool reverse_ = false;
+  uint32_t requests_ = 0;
+  uint32_t errors_ = 0;
+  uint32_t sendingUs_ = 0;
+  uint32_t supersededStart_ = 0;
+};
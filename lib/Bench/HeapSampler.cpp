@@ -0,0 +1,28 @@
+// Heap usage over time
+
+#include "HeapSampler.h"
+
+void HeapSampler::reset(uint32_t nowMs) {
+  intervalMs_ = initialIntervalMs_;
+  startMs_ = nowMs;
+  nextMs_ = 0;
+  minFree_ = UINT32_MAX;
+  minLargest_ = UINT32_MAX;
+  count_ = 0;
+}
+
+void HeapSampler::sample(uint32_t nowMs, uint32_t freeBytes, uint32_t largestBlock) {
+  if (freeBytes < minFree_) minFree_ = freeBytes;
+  if (largestBlock < minLargest_) minLargest_ = largestBlock;
+
+  uint32_t elapsed = nowMs - startMs_;
+  if (count_ > 0 && elapsed < nextMs_) return;
+
+  if (count_ == HEAP_SAMPLES) {
+    for (uint8_t i = 0; i < HEAP_SAMPLES / 2; i++) samples_[i] = samples_[i * 2];
+    count_ = HEAP_SAMPLES / 2;
+    intervalMs_ *= 2;
+  }
+  samples_[count_++] = {elapsed, freeBytes, largestBlock};
+  nextMs_ = elapsed - elapsed % intervalMs_ + intervalMs_;
+}
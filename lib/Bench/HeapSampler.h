@@ -0,0 +1,39 @@
+// Heap usage over time
+// Keeps the minimum free heap / largest free block seen on every call and a bounded series of
+// samples for plotting. When the series is full every other sample is dropped and the interval
+// doubles, so a run of any length ends up with 16..32 evenly spaced points.
+
+#pragma once
+
+#include <stdint.h>
+
+#define HEAP_SAMPLES 32
+
+struct HeapSample {
+  uint32_t timeMs;  // since reset()
+  uint32_t freeBytes;
+  uint32_t largestBlock;
+};
+
+class HeapSampler {
+public:
+  explicit HeapSampler(uint32_t intervalMs) : initialIntervalMs_(intervalMs) {}
+
+  void reset(uint32_t nowMs);
+  void sample(uint32_t nowMs, uint32_t freeBytes, uint32_t largestBlock);
+
+  uint32_t minFree() const { return minFree_; }
+  uint32_t minLargestBlock() const { return minLargest_; }
+  uint8_t count() const { return count_; }
+  const HeapSample& at(uint8_t index) const { return samples_[index]; }
+
+private:
+  uint32_t initialIntervalMs_;
+  uint32_t intervalMs_ = 0;
+  uint32_t startMs_ = 0;
+  uint32_t nextMs_ = 0;
+  uint32_t minFree_ = UINT32_MAX;
+  uint32_t minLargest_ = UINT32_MAX;
+  uint8_t count_ = 0;
+  HeapSample samples_[HEAP_SAMPLES];
+};
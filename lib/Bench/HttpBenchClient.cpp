@@ -0,0 +1,122 @@
+// Minimal blocking HTTP/1.1 client for loopback benchmarks
+
+#include "HttpBenchClient.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+bool HttpBenchClient::connect(uint16_t port, uint32_t timeoutMs) {
+  close();
+  fd_ = socket(AF_INET, SOCK_STREAM, 0);
+  if (fd_ < 0) return false;
+
+  struct timeval timeout;
+  timeout.tv_sec = timeoutMs / 1000;
+  timeout.tv_usec = (timeoutMs % 1000) * 1000;
+  setsockopt(fd_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  setsockopt(fd_, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+  int yes = 1;
+  setsockopt(fd_, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons(port);
+  if (::connect(fd_, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+    close();
+    return false;
+  }
+  port_ = port;
+  timeoutMs_ = timeoutMs;
+  return true;
+}
+
+void HttpBenchClient::close() {
+  if (fd_ >= 0) {
+    ::close(fd_);
+    fd_ = -1;
+  }
+}
+
+bool HttpBenchClient::sendAll(const char* data, size_t length) {
+  while (length > 0) {
+    ssize_t n = send(fd_, data, length, MSG_NOSIGNAL);
+    if (n <= 0) return false;
+    data += n;
+    length -= (size_t)n;
+  }
+  return true;
+}
+
+int HttpBenchClient::request(const char* method, const char* path, const char* body) {
+  if (fd_ < 0 && (port_ == 0 || !connect(port_, timeoutMs_))) return 0;
+
+  size_t bodyLength = body ? strlen(body) : 0;
+  int headerLength = snprintf(buffer_, sizeof(buffer_),
+                              "%s %s HTTP/1.1\r\nHost: 127.0.0.1\r\nContent-Type: application/json\r\n"
+                              "Content-Length: %u\r\n\r\n",
+                              method, path, (unsigned)bodyLength);
+  if (headerLength <= 0 || (size_t)headerLength >= sizeof(buffer_) || !sendAll(buffer_, headerLength) ||
+      (bodyLength > 0 && !sendAll(body, bodyLength))) {
+    close();
+    return 0;
+  }
+
+  // Read until the end of the headers
+  size_t length = 0;
+  char* headerEnd = nullptr;
+  while (!headerEnd) {
+    if (length == sizeof(buffer_) - 1) {
+      close();
+      return 0;
+    }
+    ssize_t n = recv(fd_, buffer_ + length, sizeof(buffer_) - 1 - length, 0);
+    if (n <= 0) {
+      close();
+      return 0;
+    }
+    length += (size_t)n;
+    buffer_[length] = '\0';
+    headerEnd = strstr(buffer_, "\r\n\r\n");
+  }
+
+  int status = 0;
+  if (sscanf(buffer_, "HTTP/1.%*d %d", &status) != 1) {
+    close();
+    return 0;
+  }
+  size_t contentLength = 0;
+  bool keepAlive = true;
+  for (char* line = strstr(buffer_, "\r\n"); line && line < headerEnd; line = strstr(line + 2, "\r\n")) {
+    if (strncasecmp(line + 2, "Content-Length:", 15) == 0) contentLength = strtoul(line + 17, nullptr, 10);
+    if (strncasecmp(line + 2, "Connection: close", 17) == 0) keepAlive = false;
+  }
+
+  // Discard the body
+  size_t received = length - (size_t)(headerEnd + 4 - buffer_);
+  while (received < contentLength) {
+    size_t want = contentLength - received;
+    ssize_t n = recv(fd_, buffer_, want < sizeof(buffer_) ? want : sizeof(buffer_), 0);
+    if (n <= 0) {
+      close();
+      return 0;
+    }
+    received += (size_t)n;
+  }
+
+  if (!keepAlive) close();
+  return status;
+}
@@ -0,0 +1,33 @@
+// Minimal blocking HTTP/1.1 client for loopback benchmarks
+// One keep-alive connection to 127.0.0.1; request() sends a request and reads the complete
+// response (body discarded). Same BSD socket API as HttpServer, so it runs on lwIP and Linux.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef HTTP_BENCH_BUFFER_SIZE
+#define HTTP_BENCH_BUFFER_SIZE 1024
+#endif
+
+class HttpBenchClient {
+public:
+  ~HttpBenchClient() { close(); }
+
+  bool connect(uint16_t port, uint32_t timeoutMs);
+  void close();
+  bool connected() const { return fd_ >= 0; }
+
+  // Status code of the response, 0 on a network error (the connection is closed then).
+  // `body` may be nullptr; it is sent as application/json.
+  int request(const char* method, const char* path, const char* body);
+
+private:
+  bool sendAll(const char* data, size_t length);
+
+  int fd_ = -1;
+  uint16_t port_ = 0;
+  uint32_t timeoutMs_ = 0;
+  char buffer_[HTTP_BENCH_BUFFER_SIZE];
+};
@@ -0,0 +1,55 @@
+// Fixed-bucket latency histogram
+
+#include "LatencyHistogram.h"
+
+#include <string.h>
+
+static const uint32_t SUB_BUCKETS = 1u << LATENCY_SUB_BITS;
+
+void LatencyHistogram::reset() {
+  memset(buckets_, 0, sizeof(buckets_));
+  count_ = 0;
+  min_ = UINT32_MAX;
+  max_ = 0;
+  sum_ = 0;
+}
+
+uint8_t LatencyHistogram::bucketIndex(uint32_t value) {
+  if (value < SUB_BUCKETS) return (uint8_t)value;
+  uint32_t msb = 31 - __builtin_clz(value);
+  uint32_t shift = msb - LATENCY_SUB_BITS;
+  uint32_t index = (shift + 1) * SUB_BUCKETS + ((value >> shift) & (SUB_BUCKETS - 1));
+  return (uint8_t)(index < LATENCY_BUCKETS ? index : LATENCY_BUCKETS - 1);
+}
+
+uint32_t LatencyHistogram::bucketUpperBound(uint8_t index) {
+  if (index < SUB_BUCKETS) return index;
+  uint32_t shift = index / SUB_BUCKETS - 1;
+  uint32_t lower = (SUB_BUCKETS + index % SUB_BUCKETS) << shift;
+  return lower + (1u << shift) - 1;
+}
+
+void LatencyHistogram::record(uint32_t value) {
+  buckets_[bucketIndex(value)]++;
+  count_++;
+  sum_ += value;
+  if (value < min_) min_ = value;
+  if (value > max_) max_ = value;
+}
+
+uint32_t LatencyHistogram::percentile(float p) const {
+  if (count_ == 0) return 0;
+  uint32_t rank = (uint32_t)(p / 100.0f * count_ + 0.999f);  // nearest-rank
+  if (rank < 1) rank = 1;
+  if (rank > count_) rank = count_;
+
+  uint32_t seen = 0;
+  for (uint8_t i = 0; i < LATENCY_BUCKETS; i++) {
+    seen += buckets_[i];
+    if (seen >= rank) {
+      uint32_t bound = bucketUpperBound(i);
+      return bound < max_ ? bound : max_;
+    }
+  }
+  return max_;
+}
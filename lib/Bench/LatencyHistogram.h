@@ -0,0 +1,37 @@
+// Fixed-bucket latency histogram
+// Log-linear buckets: values below 8 are exact, above that every power of two is split into
+// 8 buckets, so any value is known to within 12.5 %. Covers 0 .. 16.7 s in microseconds with
+// 176 counters and no allocation; recording is a handful of integer operations.
+
+#pragma once
+
+#include <stdint.h>
+
+#define LATENCY_SUB_BITS 3
+#define LATENCY_BUCKETS 176  // (24 - LATENCY_SUB_BITS + 1) octaves * 8
+
+class LatencyHistogram {
+public:
+  void reset();
+  void record(uint32_t value);
+
+  uint32_t count() const { return count_; }
+  uint32_t min() const { return count_ ? min_ : 0; }
+  uint32_t max() const { return max_; }
+  uint32_t mean() const { return count_ ? (uint32_t)(sum_ / count_) : 0; }
+
+  // Upper bound of the bucket holding the p-th percentile (never above max())
+  uint32_t percentile(float p) const;
+
+  uint32_t bucketCount(uint8_t index) const { return buckets_[index]; }
+  static uint32_t bucketUpperBound(uint8_t index);
+
+private:
+  static uint8_t bucketIndex(uint32_t value);
+
+  uint32_t buckets_[LATENCY_BUCKETS] = {};
+  uint32_t count_ = 0;
+  uint32_t min_ = UINT32_MAX;
+  uint32_t max_ = 0;
+  uint64_t sum_ = 0;
+};
@@ -0,0 +1,61 @@
+// Per-call cost of the logging macros
+
+#include "LogCostBench.h"
+
+#include <Arduino.h>
+#include <stdio.h>
+
+#include "Log.h"
+
+const uint32_t LOG_BENCH_ROUNDS = 8;
+const uint32_t LOG_BENCH_BATCH = LOG_BUFFER_SIZE / 2;  // fits while the log task catches up
+const uint32_t LOG_BENCH_DRAIN_MS = 200;
+const uint32_t LOG_BENCH_SERIAL_CALLS = 16;
+
+static uint32_t nsPerCall(uint32_t us, uint32_t calls) {
+  return calls ? (uint32_t)((uint64_t)us * 1000 / calls) : 0;
+}
+
+void benchLogCost(const char* benchName, void (*emit)(const char* line)) {
+  // Queued: batches the ring can take, drained in between
+  uint32_t queuedUs = 0;
+  uint32_t queuedCalls = 0;
+  for (uint32_t round = 0; round < LOG_BENCH_ROUNDS; round++) {
+    delay(LOG_BENCH_DRAIN_MS);
+    uint32_t startUs = micros();
+    for (uint32_t i = 0; i < LOG_BENCH_BATCH; i++) {
+      LOG_INFO("bench: sweep %.1f° → %d° (speed: %dms)", 90.5f, (int)i, 15);
+    }
+    queuedUs += micros() - startUs;
+    queuedCalls += LOG_BENCH_BATCH;
+  }
+
+  // Dropped: fill the ring without yielding, then time calls that find it full
+  for (uint32_t i = 0; i < LOG_BUFFER_SIZE; i++) LOG_INFO("bench: fill %u", (unsigned)i);
+  uint32_t dropsBefore = logBuffer.dropped();
+  uint32_t dropStartUs = micros();
+  for (uint32_t i = 0; i < LOG_BENCH_ROUNDS * LOG_BENCH_BATCH; i++) {
+    LOG_INFO("bench: sweep %.1f° → %d° (speed: %dms)", 90.5f, (int)i, 15);
+  }
+  uint32_t dropUs = micros() - dropStartUs;
+  uint32_t drops = logBuffer.dropped() - dropsBefore;
+  delay(LOG_BENCH_DRAIN_MS);
+
+  // Direct: what the call used to cost (blocks once the UART FIFO is full)
+  uint32_t serialStartUs = micros();
+  for (uint32_t i = 0; i < LOG_BENCH_SERIAL_CALLS; i++) {
+    Serial.printf("bench: sweep %.1f° → %d° (speed: %dms)\n", 90.5f, (int)i, 15);
+  }
+  uint32_t serialUs = micros() - serialStartUs;
+  delay(LOG_BENCH_DRAIN_MS);
+
+  char line[256];
+  snprintf(line, sizeof(line),
+           "BENCH {\"bench\":\"%s\",\"scenario\":\"log_call\",\"log\":{\"calls\":%u,\"ns\":%u,\"drop_calls\":%u,"
+           "\"dropped\":%u,\"drop_ns\":%u,\"serial_calls\":%u,\"serial_ns\":%u}}",
+           benchName, (unsigned)queuedCalls, (unsigned)nsPerCall(queuedUs, queuedCalls),
+           (unsigned)(LOG_BENCH_ROUNDS * LOG_BENCH_BATCH), (unsigned)drops,
+           (unsigned)nsPerCall(dropUs, LOG_BENCH_ROUNDS * LOG_BENCH_BATCH), (unsigned)LOG_BENCH_SERIAL_CALLS,
+           (unsigned)nsPerCall(serialUs, LOG_BENCH_SERIAL_CALLS));
+  emit(line);
+}
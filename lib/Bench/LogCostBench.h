@@ -0,0 +1,9 @@
+// Per-call cost of the logging macros (lib/Log)
+// Times a typical LOG_INFO (three arguments) while the ring has room, the same call while the
+// ring is full (the drop path) and, for comparison, the same message through Serial.printf.
+// Emits one "BENCH {json}" line with scenario "log_call". Blocks for about a second; run it
+// before the scenarios, from a task above the log task's priority.
+
+#pragma once
+
+void benchLogCost(const char* benchName, void (*emit)(const char* line));
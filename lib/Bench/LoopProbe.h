@@ -0,0 +1,46 @@
+// Control-loop timing capture for benchmarks
+// The control task calls record() after every tick; it costs one relaxed load while no
+// benchmark is recording. The runner brackets a scenario with start()/stop() and reads the
+// histograms once the task has seen the stop (one control period later).
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+
+#include "LatencyHistogram.h"
+
+class LoopProbe {
+public:
+  explicit LoopProbe(uint32_t periodUs) : periodUs_(periodUs) {}
+
+  // Control task, after TickStats::end()
+  void record(uint32_t busyUs, uint32_t jitterUs) {
+    if (!recording_.load(std::memory_order_acquire)) return;
+    busy_.record(busyUs);
+    jitter_.record(jitterUs);
+    if (busyUs > periodUs_ || jitterUs >= periodUs_) misses_++;
+  }
+
+  // Runner side
+  void start() {
+    busy_.reset();
+    jitter_.reset();
+    misses_ = 0;
+    recording_.store(true, std::memory_order_release);
+  }
+  void stop() { recording_.store(false, std::memory_order_release); }
+
+  const LatencyHistogram& busy() const { return busy_; }
+  const LatencyHistogram& jitter() const { return jitter_; }
+  uint32_t deadlineMisses() const { return misses_; }
+  uint32_t periodUs() const { return periodUs_; }
+
+private:
+  uint32_t periodUs_;
+  std::atomic<bool> recording_{false};
+  LatencyHistogram busy_;
+  LatencyHistogram jitter_;
+  uint32_t misses_ = 0;
+};
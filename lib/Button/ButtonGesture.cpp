@@ -0,0 +1,78 @@
+// Push button debouncing and gesture detection
+
+#include "ButtonGesture.h"
+
+void ButtonGesture::edge(const ButtonEdge& e) {
+  settle(e.timeMs);
+  if (e.pressed == raw_) return;
+  raw_ = e.pressed;
+  rawSinceMs_ = e.timeMs;
+}
+
+ButtonEvent ButtonGesture::poll(uint32_t nowMs) {
+  settle(nowMs);
+  timeouts(nowMs);
+  if (eventCount_ == 0) return BUTTON_NONE;
+
+  ButtonEvent event = events_[0];
+  for (uint8_t i = 1; i < eventCount_; i++) events_[i - 1] = events_[i];
+  eventCount_--;
+  return event;
+}
+
+// Commit the raw level once it has been stable long enough. The transition is dated at the
+// raw edge, so gesture timing does not depend on how often we are polled.
+void ButtonGesture::settle(uint32_t nowMs) {
+  if (raw_ == stable_ || (int32_t)(nowMs - rawSinceMs_) < (int32_t)debounceMs_) return;
+  timeouts(rawSinceMs_);
+  stable_ = raw_;
+  transition(stable_, rawSinceMs_);
+}
+
+void ButtonGesture::timeouts(uint32_t nowMs) {
+  int32_t elapsed = (int32_t)(nowMs - stateSinceMs_);
+  if (elapsed < 0) return;  // a poll time older than the last transition
+
+  if (state_ == DOWN && elapsed >= longPressMs_) {
+    emit(BUTTON_LONG_PRESS);
+    state_ = HELD;
+  } else if (state_ == WAIT_SECOND && elapsed >= doubleClickMs_) {
+    emit(BUTTON_CLICK);
+    state_ = IDLE;
+  } else if (state_ == DOWN_SECOND && elapsed >= longPressMs_) {
+    // First click stands on its own, the second press became a long press
+    emit(BUTTON_CLICK);
+    emit(BUTTON_LONG_PRESS);
+    state_ = HELD;
+  }
+}
+
+void ButtonGesture::transition(bool pressed, uint32_t atMs) {
+  if (pressed) presses_++;
+
+  switch (state_) {
+    case IDLE:
+      if (pressed) state_ = DOWN;
+      break;
+    case DOWN:
+      if (!pressed) state_ = WAIT_SECOND;
+      break;
+    case WAIT_SECOND:
+      if (pressed) state_ = DOWN_SECOND;
+      break;
+    case DOWN_SECOND:
+      if (!pressed) {
+        emit(BUTTON_DOUBLE_CLICK);
+        state_ = IDLE;
+      }
+      break;
+    case HELD:
+      if (!pressed) state_ = IDLE;
+      break;
+  }
+  stateSinceMs_ = atMs;
+}
+
+void ButtonGesture::emit(ButtonEvent event) {
+  if (eventCount_ < sizeof(events_) / sizeof(events_[0])) events_[eventCount_++] = event;
+}
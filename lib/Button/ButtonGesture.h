@@ -0,0 +1,68 @@
+// Push button debouncing and gesture detection
+// Hardware-independent: the caller feeds timestamped edges (typically queued by a GPIO
+// interrupt) and polls with the current time; nothing here reads pins or blocks.
+//
+//   edges -> debouncer (a level counts once it held for debounceMs) -> gesture state machine
+//
+// A press released before longPressMs is a click. A second click starting within
+// doubleClickMs of the first release makes a double click; otherwise the single click is
+// reported when that window expires. Holding for longPressMs reports a long press at once,
+// without waiting for the release.
+
+#pragma once
+
+#include <stdint.h>
+
+enum ButtonEvent : uint8_t {
+  BUTTON_NONE,
+  BUTTON_CLICK,
+  BUTTON_DOUBLE_CLICK,
+  BUTTON_LONG_PRESS
+};
+
+struct ButtonEdge {
+  uint32_t timeMs;
+  bool pressed;  // level after the edge
+};
+
+class ButtonGesture {
+public:
+  ButtonGesture(uint16_t debounceMs, uint16_t doubleClickMs, uint16_t longPressMs)
+      : debounceMs_(debounceMs), doubleClickMs_(doubleClickMs), longPressMs_(longPressMs) {}
+
+  // Raw edge, in time order. Repeated levels are ignored.
+  void edge(const ButtonEdge& e);
+
+  // Next gesture as of `nowMs`, BUTTON_NONE when there is none. Call until it returns NONE.
+  ButtonEvent poll(uint32_t nowMs);
+
+  // Debounced level
+  bool pressed() const { return stable_; }
+
+  // Stable transitions that made it through the debouncer
+  uint32_t presses() const { return presses_; }
+
+private:
+  enum State : uint8_t { IDLE, DOWN, WAIT_SECOND, DOWN_SECOND, HELD };
+
+  void settle(uint32_t nowMs);
+  void timeouts(uint32_t nowMs);
+  void transition(bool pressed, uint32_t atMs);
+  void emit(ButtonEvent event);
+
+  uint16_t debounceMs_;
+  uint16_t doubleClickMs_;
+  uint16_t longPressMs_;
+
+  bool raw_ = false;
+  uint32_t rawSinceMs_ = 0;
+  bool stable_ = false;
+
+  State state_ = IDLE;
+  uint32_t stateSinceMs_ = 0;
+  uint32_t presses_ = 0;
+
+  // Events found between two polls (at most two per settled transition)
+  ButtonEvent events_[4] = {};
+  uint8_t eventCount_ = 0;
+};
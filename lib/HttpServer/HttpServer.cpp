@@ -0,0 +1,814 @@
+// Event-driven HTTP/1.1 + WebSocket server
+
+#include "HttpServer.h"
+#include "Sha1.h"
+#include "Trace.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+static uint32_t nowMs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)(ts.tv_sec * 1000u + ts.tv_nsec / 1000000);
+}
+
+static uint32_t nowUs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)(ts.tv_sec * 1000000u + ts.tv_nsec / 1000);
+}
+
+static bool setNonBlocking(int fd) {
+  int flags = fcntl(fd, F_GETFL, 0);
+  return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+static HttpMethod parseMethod(const char* s, size_t n) {
+  if (n == 3 && memcmp(s, "GET", 3) == 0) return HttpMethod::Get;
+  if (n == 4 && memcmp(s, "POST", 4) == 0) return HttpMethod::Post;
+  if (n == 3 && memcmp(s, "PUT", 3) == 0) return HttpMethod::Put;
+  if (n == 6 && memcmp(s, "DELETE", 6) == 0) return HttpMethod::Delete;
+  if (n == 4 && memcmp(s, "HEAD", 4) == 0) return HttpMethod::Head;
+  if (n == 7 && memcmp(s, "OPTIONS", 7) == 0) return HttpMethod::Options;
+  return HttpMethod::Unknown;
+}
+
+static int hexValue(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+const char* httpStatusText(int code) {
+  switch (code) {
+    case 101: return "Switching Protocols";
+    case 200: return "OK";
+    case 204: return "No Content";
+    case 304: return "Not Modified";
+    case 400: return "Bad Request";
+    case 404: return "Not Found";
+    case 405: return "Method Not Allowed";
+    case 408: return "Request Timeout";
+    case 413: return "Payload Too Large";
+    case 431: return "Request Header Fields Too Large";
+    case 500: return "Internal Server Error";
+    case 503: return "Service Unavailable";
+    default: return "Unknown";
+  }
+}
+
+// ===== REQUEST =====
+
+const char* HttpRequest::header(const char* name) const {
+  for (uint8_t i = 0; i < headerCount_; i++) {
+    if (strcasecmp(headerNames_[i], name) == 0) return headerValues_[i];
+  }
+  return nullptr;
+}
+
+bool HttpRequest::queryParam(const char* name, char* out, size_t outSize) const {
+  const size_t nameLength = strlen(name);
+  const char* p = query_;
+
+  while (*p) {
+    const char* end = strchr(p, '&');
+    if (!end) end = p + strlen(p);
+
+    if ((size_t)(end - p) > nameLength && memcmp(p, name, nameLength) == 0 && p[nameLength] == '=') {
+      size_t n = 0;
+      for (const char* v = p + nameLength + 1; v < end; v++) {
+        char c = *v;
+        if (c == '+') {
+          c = ' ';
+        } else if (c == '%' && end - v > 2 && hexValue(v[1]) >= 0 && hexValue(v[2]) >= 0) {
+          c = (char)(hexValue(v[1]) * 16 + hexValue(v[2]));
+          v += 2;
+        }
+        if (n + 1 >= outSize) return false;
+        out[n++] = c;
+      }
+      out[n] = '\0';
+      return true;
+    }
+    p = *end ? end + 1 : end;
+  }
+  return false;
+}
+
+// ===== RESPONSE =====
+
+void HttpResponse::addHeader(const char* name, const char* value) {
+  int n = snprintf(headers_ + headersLength_, sizeof(headers_) - headersLength_, "%s: %s\r\n", name, value);
+  if (n > 0 && headersLength_ + n < sizeof(headers_)) headersLength_ += n;
+}
+
+void HttpResponse::send(int code, const char* contentType, const char* body) {
+  send(code, contentType, body, body ? strlen(body) : 0);
+}
+
+// Status line and headers into the connection buffer
+bool HttpResponse::beginResponse(int code, const char* contentType, size_t length, bool chunked) {
+  if (sent_ || !conn_) return false;
+  sent_ = true;
+
+  HttpConnection& conn = *conn_;
+  char framing[32];
+  if (!chunked) {
+    snprintf(framing, sizeof(framing), "Content-Length: %u\r\n", (unsigned)length);
+  } else {
+    strcpy(framing, http10_ ? "" : "Transfer-Encoding: chunked\r\n");
+  }
+  int n = snprintf(conn.tx, sizeof(conn.tx),
+                   "HTTP/1.1 %d %s\r\n"
+                   "Content-Type: %s\r\n"
+                   "%s"
+                   "Connection: %s\r\n"
+                   "%.*s\r\n",
+                   code, httpStatusText(code), contentType ? contentType : "text/plain", framing,
+                   keepAlive_ ? "keep-alive" : "close", (int)headersLength_, headers_);
+  if (n < 0 || (size_t)n >= sizeof(conn.tx)) n = 0;
+  conn.txLength = n;
+  conn.txSent = 0;
+  conn.closeAfterSend = !keepAlive_;
+  return true;
+}
+
+// Room for a body of `length` after the headers; a heap block when the buffer is too small
+uint8_t* HttpResponse::reserveBody(size_t length) {
+  HttpConnection& conn = *conn_;
+  if (conn.txLength + length <= sizeof(conn.tx)) {
+    uint8_t* out = (uint8_t*)conn.tx + conn.txLength;
+    conn.txLength += length;
+    return out;
+  }
+
+  conn.ownedBody = (uint8_t*)malloc(length);
+  if (!conn.ownedBody) {
+    conn.closeAfterSend = true;
+    return nullptr;
+  }
+  conn.body = conn.ownedBody;
+  conn.bodyLength = length;
+  conn.bodySent = 0;
+  return conn.ownedBody;
+}
+
+void HttpResponse::send(int code, const char* contentType, const char* body, size_t length) {
+  if (!beginResponse(code, contentType, length)) return;
+  if (headOnly_ || length == 0) return;
+
+  uint8_t* out = reserveBody(length);
+  if (out) memcpy(out, body, length);
+}
+
+void HttpResponse::sendWith(int code, const char* contentType, size_t length, BodyWriter write, void* context) {
+  if (!beginResponse(code, contentType, length)) return;
+  if (headOnly_ || length == 0) return;
+
+  char* out = (char*)reserveBody(length);
+  if (!out) return;
+  size_t written = write(out, length, context);
+  if (written < length) memset(out + written, ' ', length - written);
+}
+
+void HttpResponse::sendStatic(int code, const char* contentType, const uint8_t* data, size_t length) {
+  if (!beginResponse(code, contentType, length)) return;
+  if (headOnly_ || length == 0) return;
+
+  HttpConnection& conn = *conn_;
+  conn.body = data;
+  conn.bodyLength = length;
+  conn.bodySent = 0;
+}
+
+void HttpResponse::sendChunked(int code, const char* contentType, ChunkWriter write, void* context) {
+  if (http10_) keepAlive_ = false;  // no chunked encoding: the close ends the body
+  if (!beginResponse(code, contentType, 0, true)) return;
+  if (headOnly_) return;
+
+  HttpConnection& conn = *conn_;
+  conn.stream = write;
+  conn.streamContext = context;
+  conn.streamChunked = !http10_;
+}
+
+void HttpResponse::sendGzipAsset(const HttpRequest& req, const char* contentType, const uint8_t* gz, size_t length,
+                                 const char* etag) {
+  addHeader("ETag", etag);
+  addHeader("Cache-Control", "no-cache");
+
+  const char* ifNoneMatch = req.header("If-None-Match");
+  if (ifNoneMatch && strcmp(ifNoneMatch, etag) == 0) {
+    send(304, contentType, nullptr, 0);
+    return;
+  }
+
+  addHeader("Content-Encoding", "gzip");
+  addHeader("Vary", "Accept-Encoding");
+  sendStatic(200, contentType, gz, length);
+}
+
+// ===== SERVER =====
+
+bool HttpServer::begin() {
+  listenFd_ = socket(AF_INET, SOCK_STREAM, 0);
+  if (listenFd_ < 0) return false;
+
+  int yes = 1;
+  setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port = htons(port_ + HTTP_PORT_OFFSET);
+
+  if (bind(listenFd_, (struct sockaddr*)&addr, sizeof(addr)) != 0 ||
+      listen(listenFd_, HTTP_MAX_CONNECTIONS) != 0 ||
+      !setNonBlocking(listenFd_)) {
+    close(listenFd_);
+    listenFd_ = -1;
+    return false;
+  }
+  return true;
+}
+
+void HttpServer::end() {
+  for (HttpConnection& conn : connections_) {
+    if (conn.fd >= 0) closeConnection(conn);
+  }
+  if (listenFd_ >= 0) {
+    close(listenFd_);
+    listenFd_ = -1;
+  }
+}
+
+void HttpServer::poll(uint32_t timeoutMs) {
+  if (listenFd_ < 0) return;
+
+  fd_set readSet, writeSet;
+  FD_ZERO(&readSet);
+  FD_ZERO(&writeSet);
+  FD_SET(listenFd_, &readSet);
+  int maxFd = listenFd_;
+  if (wakeFd_ >= 0) {
+    FD_SET(wakeFd_, &readSet);
+    if (wakeFd_ > maxFd) maxFd = wakeFd_;
+  }
+
+  for (HttpConnection& conn : connections_) {
+    if (conn.fd < 0) continue;
+    // Do not read further requests while a response is still going out
+    if (conn.pending()) {
+      FD_SET(conn.fd, &writeSet);
+    } else {
+      FD_SET(conn.fd, &readSet);
+    }
+    if (conn.fd > maxFd) maxFd = conn.fd;
+  }
+
+  struct timeval tv;
+  tv.tv_sec = timeoutMs / 1000;
+  tv.tv_usec = (timeoutMs % 1000) * 1000;
+  int ready = select(maxFd + 1, &readSet, &writeSet, nullptr, &tv);
+  uint32_t now = nowMs();
+
+  if (ready > 0) {
+    if (FD_ISSET(listenFd_, &readSet)) acceptClients(now);
+
+    for (HttpConnection& conn : connections_) {
+      if (conn.fd < 0) continue;
+      if (FD_ISSET(conn.fd, &writeSet)) {
+        flush(conn, now);
+      } else if (FD_ISSET(conn.fd, &readSet)) {
+        readClient(conn, now);
+      }
+    }
+  }
+
+  for (HttpConnection& conn : connections_) {
+    if (conn.fd < 0) continue;
+    uint32_t idle = now - conn.lastActivityMs;
+
+    if (conn.websocket) {
+      if (idle > WS_IDLE_TIMEOUT_MS) {
+        stats_.timeouts++;
+        closeConnection(conn);
+      } else if (idle > WS_PING_INTERVAL_MS && !conn.pingSent && queueFrame(conn, 0x9, nullptr, 0)) {
+        conn.pingSent = true;
+        flush(conn, now);
+      }
+    } else if (idle > HTTP_IDLE_TIMEOUT_MS) {
+      stats_.timeouts++;
+      closeConnection(conn);
+    }
+  }
+}
+
+void HttpServer::acceptClients(uint32_t now) {
+  for (;;) {
+    int fd = accept(listenFd_, nullptr, nullptr);
+    if (fd < 0) return;
+
+    HttpConnection* slot = nullptr;
+    for (HttpConnection& conn : connections_) {
+      if (conn.fd < 0) {
+        slot = &conn;
+        break;
+      }
+    }
+
+    if (!slot || !setNonBlocking(fd)) {
+      static const char busy[] =
+          "HTTP/1.1 503 Service Unavailable\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+      ::send(fd, busy, sizeof(busy) - 1, MSG_NOSIGNAL);
+      close(fd);
+      stats_.rejected++;
+      continue;
+    }
+
+    int yes = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+
+    slot->fd = fd;
+    slot->lastActivityMs = now;
+    slot->rxLength = 0;
+    slot->txLength = slot->txSent = 0;
+    slot->body = nullptr;
+    slot->bodyLength = slot->bodySent = 0;
+    slot->stream = nullptr;
+    slot->closeAfterSend = false;
+    slot->websocket = false;
+    slot->pingSent = false;
+    slot->processing = false;
+    stats_.accepted++;
+    stats_.active++;
+  }
+}
+
+void HttpServer::readClient(HttpConnection& conn, uint32_t now) {
+  size_t space = HTTP_RX_BUFFER_SIZE - conn.rxLength;
+  if (space == 0) {
+    sendError(conn, 431, "Request too large");
+    flush(conn, now);
+    return;
+  }
+
+  ssize_t n = recv(conn.fd, conn.rx + conn.rxLength, space, 0);
+  if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+    closeConnection(conn);
+    return;
+  }
+  if (n < 0) return;
+
+  conn.rxLength += n;
+  conn.lastActivityMs = now;
+  conn.pingSent = false;
+  processRequests(conn);
+  if (conn.fd >= 0 && conn.pending()) flush(conn, now);
+}
+
+// Handle every complete request in the receive buffer (pipelining), stop at the first
+// response that cannot be written out immediately.
+void HttpServer::processRequests(HttpConnection& conn) {
+  if (conn.processing) return;  // a handler flushed its own reply, the outer loop continues
+  conn.processing = true;
+
+  if (conn.websocket) {
+    processFrames(conn);
+  } else {
+    processHttp(conn);
+  }
+  conn.processing = false;
+}
+
+void HttpServer::processHttp(HttpConnection& conn) {
+  while (conn.fd >= 0 && !conn.pending() && !conn.closeAfterSend && conn.rxLength > 0) {
+    conn.rx[conn.rxLength] = '\0';
+    char* end = strstr(conn.rx, "\r\n\r\n");
+    if (!end) {
+      if (conn.rxLength >= HTTP_RX_BUFFER_SIZE) sendError(conn, 431, "Request too large");
+      return;
+    }
+
+    size_t consumed = 0;
+    if (!handleRequest(conn, end - conn.rx + 4, &consumed)) return;  // body incomplete
+
+    memmove(conn.rx, conn.rx + consumed, conn.rxLength - consumed);
+    conn.rxLength -= consumed;
+  }
+}
+
+bool HttpServer::handleRequest(HttpConnection& conn, size_t headerEnd, size_t* consumed) {
+  HttpRequest req;
+  HttpResponse res;
+  res.conn_ = &conn;
+
+  // Content-Length first: wait for the body without touching the buffer
+  size_t contentLength = 0;
+  {
+    const char* cl = nullptr;
+    for (const char* p = strstr(conn.rx, "\r\n"); p && p < conn.rx + headerEnd; p = strstr(p + 2, "\r\n")) {
+      if (strncasecmp(p + 2, "Content-Length:", 15) == 0) {
+        cl = p + 17;
+        break;
+      }
+    }
+    if (cl) {
+      // strtoul accepts "-1" (as ULONG_MAX) and saturates on overflow: only plain digits count
+      while (*cl == ' ' || *cl == '\t') cl++;
+      char* digitsEnd;
+      errno = 0;
+      unsigned long value = strtoul(cl, &digitsEnd, 10);
+      if (*cl < '0' || *cl > '9' || digitsEnd == cl) {
+        sendError(conn, 400, "Bad Content-Length");
+        return false;
+      }
+      contentLength = errno == ERANGE ? SIZE_MAX : value;
+    }
+  }
+
+  // headerEnd is within the buffer, so this cannot wrap whatever the client sent
+  if (contentLength > HTTP_RX_BUFFER_SIZE - headerEnd) {
+    sendError(conn, 413, "Payload too large");
+    return false;
+  }
+  if (conn.rxLength < headerEnd + contentLength) return false;
+
+  // Request line: METHOD SP target SP version
+  char* line = conn.rx;
+  char* lineEnd = strstr(line, "\r\n");
+  *lineEnd = '\0';
+  char* sp1 = strchr(line, ' ');
+  char* sp2 = sp1 ? strchr(sp1 + 1, ' ') : nullptr;
+  if (!sp1 || !sp2) {
+    sendError(conn, 400, "Bad request");
+    return false;
+  }
+  *sp1 = '\0';
+  *sp2 = '\0';
+  req.method_ = parseMethod(line, sp1 - line);
+  req.path_ = sp1 + 1;
+  char* q = strchr(sp1 + 1, '?');
+  if (q) {
+    *q = '\0';
+    req.query_ = q + 1;
+  }
+  const bool http10 = strcmp(sp2 + 1, "HTTP/1.0") == 0;
+
+  // Headers: split in place into name / value strings
+  char* p = lineEnd + 2;
+  char* headersEnd = conn.rx + headerEnd - 2;
+  while (p < headersEnd) {
+    char* eol = strstr(p, "\r\n");
+    *eol = '\0';
+    char* colon = strchr(p, ':');
+    if (colon && req.headerCount_ < HTTP_MAX_HEADERS) {
+      *colon = '\0';
+      char* value = colon + 1;
+      while (*value == ' ' || *value == '\t') value++;
+      req.headerNames_[req.headerCount_] = p;
+      req.headerValues_[req.headerCount_] = value;
+      req.headerCount_++;
+    }
+    p = eol + 2;
+  }
+
+  // Body is null-terminated in place; the byte after it is restored below
+  char* body = conn.rx + headerEnd;
+  char saved = body[contentLength];
+  body[contentLength] = '\0';
+  req.body_ = body;
+  req.bodyLength_ = contentLength;
+
+  const char* connection = req.header("Connection");
+  if (http10) {
+    res.keepAlive_ = connection && strcasecmp(connection, "keep-alive") == 0;
+  } else {
+    res.keepAlive_ = !(connection && strcasecmp(connection, "close") == 0);
+  }
+  res.headOnly_ = req.method_ == HttpMethod::Head;
+  res.http10_ = http10;
+
+  if (wsPath_ && strcmp(req.path_, wsPath_) == 0 && upgradeWebSocket(conn, req)) {
+    stats_.requests++;
+    *consumed = headerEnd + contentLength;
+    return true;
+  }
+
+  uint32_t startUs = routeProbe_ ? nowUs() : 0;
+  uint8_t route;
+  if (allocProbe_) {
+    uint32_t allocsBefore = allocProbe_();
+    route = dispatch(req, res);
+    uint32_t allocs = allocProbe_() - allocsBefore;
+    stats_.handlerAllocs += allocs;
+    if (allocs > 0) stats_.allocRequests++;
+  } else {
+    route = dispatch(req, res);
+  }
+  if (!res.sent_) res.send(500, "text/plain", "No response");
+  if (routeProbe_) routeProbe_(route, nowUs() - startUs);
+
+  body[contentLength] = saved;
+  stats_.requests++;
+  *consumed = headerEnd + contentLength;
+  return true;
+}
+
+uint8_t HttpServer::dispatch(HttpRequest& req, HttpResponse& res) {
+  uint8_t index = routeLookup_ ? routeLookup_(routeTable_, req.path_) : HTTP_NO_ROUTE;
+  if (index < routeCount_) {
+    const HttpRoute& route = routes_[index];
+    if (route.method == HttpMethod::Any || route.method == req.method_ ||
+        (route.method == HttpMethod::Get && req.method_ == HttpMethod::Head)) {
+      TRACE_SCOPE(route.path);  // one trace track entry per route
+      route.handler(req, res);
+      return index;
+    }
+    res.send(405, "application/json", "{\"error\":\"Method not allowed\"}");
+  } else if (notFound_) {
+    notFound_(req, res);
+  } else {
+    res.send(404, "text/plain", "Not found");
+  }
+  return HTTP_NO_ROUTE;
+}
+
+void HttpServer::sendError(HttpConnection& conn, int code, const char* message) {
+  HttpResponse res;
+  res.conn_ = &conn;
+  res.keepAlive_ = false;
+  res.send(code, "text/plain", message);
+  conn.rxLength = 0;
+  stats_.errors++;
+}
+
+void HttpServer::flush(HttpConnection& conn, uint32_t now) {
+  for (;;) {
+    while (conn.txSent < conn.txLength) {
+      ssize_t n = ::send(conn.fd, conn.tx + conn.txSent, conn.txLength - conn.txSent, MSG_NOSIGNAL);
+      if (n <= 0) {
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return;
+        closeConnection(conn);
+        return;
+      }
+      conn.txSent += n;
+      conn.lastActivityMs = now;
+    }
+
+    while (conn.bodySent < conn.bodyLength) {
+      ssize_t n = ::send(conn.fd, conn.body + conn.bodySent, conn.bodyLength - conn.bodySent, MSG_NOSIGNAL);
+      if (n <= 0) {
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return;
+        closeConnection(conn);
+        return;
+      }
+      conn.bodySent += n;
+      conn.lastActivityMs = now;
+    }
+
+    if (!conn.stream) break;
+    nextChunk(conn);
+  }
+
+  // Response complete
+  free(conn.ownedBody);
+  conn.ownedBody = nullptr;
+  conn.body = nullptr;
+  conn.bodyLength = conn.bodySent = 0;
+  conn.txLength = conn.txSent = 0;
+
+  if (conn.closeAfterSend) {
+    closeConnection(conn);
+    return;
+  }
+
+  // Pipelined requests that arrived while we were writing
+  processRequests(conn);
+  if (conn.fd >= 0 && conn.pending()) flush(conn, now);
+}
+
+// Next piece of a streamed body into tx: "<hex size>\r\n<data>\r\n", "0\r\n\r\n" at the end
+void HttpServer::nextChunk(HttpConnection& conn) {
+  static const char last[] = "0\r\n\r\n";
+  const size_t head = conn.streamChunked ? 6 : 0;                    // 4 hex digits + CRLF
+  const size_t tail = conn.streamChunked ? 2 + sizeof(last) - 1 : 0;  // CRLF + room for the end
+  static_assert(HTTP_TX_BUFFER_SIZE <= 0xFFFF, "chunk size must fit 4 hex digits");
+
+  size_t n = conn.stream(conn.tx + head, sizeof(conn.tx) - head - tail, conn.streamContext);
+  size_t length = 0;
+  if (n > 0) {
+    if (conn.streamChunked) {
+      static const char hex[] = "0123456789abcdef";
+      for (int i = 0; i < 4; i++) conn.tx[i] = hex[(n >> (12 - 4 * i)) & 0xF];
+      conn.tx[4] = '\r';
+      conn.tx[5] = '\n';
+      conn.tx[head + n] = '\r';
+      conn.tx[head + n + 1] = '\n';
+      length = head + n + 2;
+    } else {
+      length = n;
+    }
+  } else {
+    conn.stream = nullptr;
+    if (conn.streamChunked) {
+      memcpy(conn.tx, last, sizeof(last) - 1);
+      length = sizeof(last) - 1;
+    }
+  }
+  conn.txLength = length;
+  conn.txSent = 0;
+}
+
+void HttpServer::closeConnection(HttpConnection& conn) {
+  if (conn.stream) {
+    conn.stream(nullptr, 0, conn.streamContext);  // the producer learns the body was abandoned
+    conn.stream = nullptr;
+  }
+  if (conn.websocket) {
+    conn.websocket = false;
+    if (wsHandler_) wsHandler_(clientIndex(conn), WebSocketEvent::Disconnect, nullptr, 0);
+  }
+  close(conn.fd);
+  conn.fd = -1;
+  conn.rxLength = 0;
+  conn.txLength = conn.txSent = 0;
+  free(conn.ownedBody);
+  conn.ownedBody = nullptr;
+  conn.body = nullptr;
+  conn.bodyLength = conn.bodySent = 0;
+  conn.closeAfterSend = false;
+  if (stats_.active > 0) stats_.active--;
+}
+
+// ===== WEBSOCKET =====
+
+bool HttpServer::upgradeWebSocket(HttpConnection& conn, HttpRequest& req) {
+  const char* upgrade = req.header("Upgrade");
+  const char* key = req.header("Sec-WebSocket-Key");
+  if (req.method_ != HttpMethod::Get || !upgrade || strcasecmp(upgrade, "websocket") != 0 || !key) {
+    return false;
+  }
+
+  // Sec-WebSocket-Accept = base64(sha1(key + GUID))
+  static const char guid[] = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+  char material[64 + sizeof(guid)];
+  size_t keyLength = strlen(key);
+  if (keyLength > 64) return false;
+  memcpy(material, key, keyLength);
+  memcpy(material + keyLength, guid, sizeof(guid) - 1);
+
+  uint8_t digest[20];
+  char accept[32];
+  sha1((const uint8_t*)material, keyLength + sizeof(guid) - 1, digest);
+  base64Encode(digest, sizeof(digest), accept);
+
+  int n = snprintf(conn.tx, sizeof(conn.tx),
+                   "HTTP/1.1 101 Switching Protocols\r\n"
+                   "Upgrade: websocket\r\n"
+                   "Connection: Upgrade\r\n"
+                   "Sec-WebSocket-Accept: %s\r\n\r\n",
+                   accept);
+  conn.txLength = n;
+  conn.txSent = 0;
+  conn.websocket = true;
+  conn.pingSent = false;
+
+  if (wsHandler_) wsHandler_(clientIndex(conn), WebSocketEvent::Connect, nullptr, 0);
+  return true;
+}
+
+// Parse complete client frames from the receive buffer (RFC 6455 section 5.2).
+// Client frames are always masked; fragmented messages are not supported.
+void HttpServer::processFrames(HttpConnection& conn) {
+  while (conn.fd >= 0 && conn.rxLength >= 2) {
+    uint8_t* p = (uint8_t*)conn.rx;
+    const bool fin = p[0] & 0x80;
+    const uint8_t opcode = p[0] & 0x0F;
+    const bool masked = p[1] & 0x80;
+    uint64_t length = p[1] & 0x7F;
+    size_t header = 2;
+
+    if (length == 126) {
+      if (conn.rxLength < 4) return;
+      length = (uint64_t)p[2] << 8 | p[3];
+      header = 4;
+    } else if (length == 127) {
+      if (conn.rxLength < 10) return;
+      length = 0;
+      for (int i = 0; i < 8; i++) length = length << 8 | p[2 + i];
+      header = 10;
+    }
+
+    // Length alone first: a 64-bit length near 2^64 would wrap any sum with the header
+    if (!masked || !fin || length > HTTP_RX_BUFFER_SIZE - header - 4) {
+      stats_.errors++;
+      closeConnection(conn);
+      return;
+    }
+    header += 4;
+    if (conn.rxLength < header + length) return;
+
+    const uint8_t* mask = p + header - 4;
+    char* payload = conn.rx + header;
+    for (size_t i = 0; i < length; i++) payload[i] ^= mask[i & 3];
+
+    const size_t frameLength = header + length;
+    char saved = payload[length];
+    payload[length] = '\0';
+
+    switch (opcode) {
+      case 0x1:  // text
+      case 0x2:  // binary
+        stats_.wsMessages++;
+        if (wsHandler_) {
+          TRACE_SCOPE("ws_message");
+          wsHandler_(clientIndex(conn), WebSocketEvent::Message, payload, length);
+        }
+        break;
+
+      case 0x8:  // close: echo it and hang up
+        if (!queueFrame(conn, 0x8, payload, length < 2 ? length : 2)) {
+          closeConnection(conn);
+          return;
+        }
+        conn.closeAfterSend = true;
+        break;
+
+      case 0x9:  // ping
+        queueFrame(conn, 0xA, payload, length);
+        break;
+
+      default:  // pong and anything else
+        break;
+    }
+
+    if (conn.fd < 0) return;
+    payload[length] = saved;
+    memmove(conn.rx, conn.rx + frameLength, conn.rxLength - frameLength);
+    conn.rxLength -= frameLength;
+    if (conn.closeAfterSend) {
+      conn.rxLength = 0;
+      return;
+    }
+  }
+}
+
+bool HttpServer::queueFrame(HttpConnection& conn, uint8_t opcode, const char* payload, size_t length) {
+  if (conn.fd < 0 || !conn.websocket || conn.pending() || conn.closeAfterSend) return false;
+
+  size_t header = length < 126 ? 2 : 4;
+  if (length > 0xFFFF || header + length > sizeof(conn.tx)) return false;
+
+  uint8_t* p = (uint8_t*)conn.tx;
+  p[0] = 0x80 | opcode;  // FIN, server frames are not masked
+  if (header == 2) {
+    p[1] = (uint8_t)length;
+  } else {
+    p[1] = 126;
+    p[2] = (uint8_t)(length >> 8);
+    p[3] = (uint8_t)length;
+  }
+  if (length) memcpy(conn.tx + header, payload, length);
+  conn.txLength = header + length;
+  conn.txSent = 0;
+  return true;
+}
+
+bool HttpServer::wsSend(uint8_t client, const char* text, size_t length) {
+  if (client >= HTTP_MAX_CONNECTIONS) return false;
+  HttpConnection& conn = connections_[client];
+  if (!queueFrame(conn, 0x1, text, length)) return false;
+  flush(conn, nowMs());
+  return true;
+}
+
+bool HttpServer::wsConnected(uint8_t client) const {
+  return client < HTTP_MAX_CONNECTIONS && connections_[client].fd >= 0 && connections_[client].websocket;
+}
+
+uint8_t HttpServer::wsClientCount() const {
+  uint8_t count = 0;
+  for (const HttpConnection& conn : connections_) {
+    if (conn.fd >= 0 && conn.websocket) count++;
+  }
+  return count;
+}
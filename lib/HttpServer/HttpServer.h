@@ -0,0 +1,293 @@
+// Event-driven HTTP/1.1 + WebSocket server
+// Non-blocking BSD sockets + select(): several keep-alive connections are served from one
+// poll() call that never blocks longer than its timeout. Builds against lwIP on the ESP32
+// and against the host socket API on Linux.
+// All buffers are fixed-size and owned by the server; handlers get a parsed request that
+// points into the receive buffer.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef HTTP_MAX_CONNECTIONS
+#define HTTP_MAX_CONNECTIONS 5
+#endif
+
+// Largest route table (RouteTable checks it at compile time, lib/Metrics sizes its histograms)
+#ifndef HTTP_MAX_ROUTES
+#define HTTP_MAX_ROUTES 24
+#endif
+
+#ifndef HTTP_MAX_HEADERS
+#define HTTP_MAX_HEADERS 16
+#endif
+
+#ifndef HTTP_RX_BUFFER_SIZE
+#define HTTP_RX_BUFFER_SIZE 1536
+#endif
+
+#ifndef HTTP_TX_BUFFER_SIZE
+#define HTTP_TX_BUFFER_SIZE 1536
+#endif
+
+// Added to the listening port: lets the host simulation serve "port 80" without root
+#ifndef HTTP_PORT_OFFSET
+#define HTTP_PORT_OFFSET 0
+#endif
+
+#ifndef HTTP_IDLE_TIMEOUT_MS
+#define HTTP_IDLE_TIMEOUT_MS 5000
+#endif
+
+// WebSocket connections are pinged when idle and dropped when the peer stays silent
+#ifndef WS_PING_INTERVAL_MS
+#define WS_PING_INTERVAL_MS 15000
+#endif
+
+#ifndef WS_IDLE_TIMEOUT_MS
+#define WS_IDLE_TIMEOUT_MS 45000
+#endif
+
+enum class HttpMethod : uint8_t {
+  Any,
+  Get,
+  Post,
+  Put,
+  Delete,
+  Head,
+  Options,
+  Unknown
+};
+
+class HttpServer;
+struct HttpConnection;
+
+class HttpRequest {
+public:
+  HttpMethod method() const { return method_; }
+  const char* path() const { return path_; }
+  const char* query() const { return query_; }
+  const char* body() const { return body_; }
+  size_t bodyLength() const { return bodyLength_; }
+
+  // Case-insensitive header lookup, nullptr if absent
+  const char* header(const char* name) const;
+
+  // Decoded query-string parameter, false if absent or too long for `out`
+  bool queryParam(const char* name, char* out, size_t outSize) const;
+
+private:
+  friend class HttpServer;
+
+  HttpMethod method_ = HttpMethod::Unknown;
+  const char* path_ = "";
+  const char* query_ = "";
+  const char* body_ = "";
+  size_t bodyLength_ = 0;
+  uint8_t headerCount_ = 0;
+  const char* headerNames_[HTTP_MAX_HEADERS];
+  const char* headerValues_[HTTP_MAX_HEADERS];
+};
+
+class HttpResponse {
+public:
+  // Extra header for the next send(); name and value are copied
+  void addHeader(const char* name, const char* value);
+
+  // The body is copied into the connection buffer (or a heap copy when it does not fit)
+  void send(int code, const char* contentType, const char* body, size_t length);
+  void send(int code, const char* contentType, const char* body);
+
+  // The body is produced by `write` directly in its final place (connection buffer, or a heap
+  // block when it does not fit). `length` must be known up front; a short write is padded
+  // with spaces so the Content-Length stays valid.
+  typedef size_t (*BodyWriter)(char* out, size_t length, void* context);
+  void sendWith(int code, const char* contentType, size_t length, BodyWriter write, void* context);
+
+  // Zero-copy: the body is written straight from `data`, which must stay valid
+  // (flash-resident constants)
+  void sendStatic(int code, const char* contentType, const uint8_t* data, size_t length);
+
+  // Streamed body of unknown length (chunked encoding): `write` fills at most `capacity`
+  // bytes and returns how many, 0 when the body is complete. It is called again from later
+  // poll() passes whenever the socket has drained, so `context` must outlive the handler.
+  // If the connection closes first, `write` is called once with out == nullptr.
+  typedef size_t (*ChunkWriter)(char* out, size_t capacity, void* context);
+  void sendChunked(int code, const char* contentType, ChunkWriter write, void* context);
+
+  // Precompressed asset with ETag revalidation: 304 when the client copy is current
+  void sendGzipAsset(const HttpRequest& req, const char* contentType, const uint8_t* gz, size_t length,
+                     const char* etag);
+
+  bool sent() const { return sent_; }
+
+private:
+  friend class HttpServer;
+
+  bool beginResponse(int code, const char* contentType, size_t length, bool chunked = false);
+  uint8_t* reserveBody(size_t length);
+
+  HttpConnection* conn_ = nullptr;
+  bool keepAlive_ = true;
+  bool headOnly_ = false;
+  bool http10_ = false;
+  bool sent_ = false;
+  size_t headersLength_ = 0;
+  char headers_[192];
+};
+
+typedef void (*HttpHandler)(HttpRequest& req, HttpResponse& res);
+
+struct HttpRoute {
+  const char* path;    // exact match
+  HttpMethod method;   // Any accepts every method, Get also HEAD
+  HttpHandler handler;
+};
+
+enum class WebSocketEvent : uint8_t {
+  Connect,
+  Disconnect,
+  Message  // text or binary frame, data is null-terminated
+};
+
+// `client` identifies the connection until its Disconnect event
+typedef void (*WebSocketHandler)(uint8_t client, WebSocketEvent event, const char* data, size_t length);
+
+// Returns a running count of heap allocations (see lib/AllocCounter)
+typedef uint32_t (*HttpAllocProbe)();
+
+// Route index passed to the route probe for requests no route accepted (404 / 405)
+const uint8_t HTTP_NO_ROUTE = 0xFF;
+
+// Called after every handler with its route index (table order) and the time from
+// dispatch until the response was queued
+typedef void (*HttpRouteProbe)(uint8_t route, uint32_t elapsedUs);
+
+// Index of the route serving `path` in a route table, HTTP_NO_ROUTE if none (lib/RouteTable)
+typedef uint8_t (*HttpRouteLookup)(const void* table, const char* path);
+
+struct HttpServerStats {
+  uint32_t accepted;
+  uint32_t rejected;     // connection refused because all slots were busy
+  uint32_t requests;
+  uint32_t timeouts;     // idle keep-alive connections closed
+  uint32_t errors;       // malformed / oversized requests
+  uint32_t wsMessages;   // WebSocket frames received
+  uint32_t handlerAllocs; // heap allocations made while handlers ran (needs an alloc probe)
+  uint32_t allocRequests; // requests whose handler allocated at least once
+  uint8_t active;
+};
+
+struct HttpConnection {
+  int fd = -1;
+  uint32_t lastActivityMs = 0;
+  bool closeAfterSend = false;
+  bool websocket = false;
+  bool pingSent = false;
+  bool processing = false;
+
+  size_t rxLength = 0;
+  char rx[HTTP_RX_BUFFER_SIZE + 1];  // +1 keeps the body null-terminated
+
+  size_t txLength = 0;
+  size_t txSent = 0;
+  char tx[HTTP_TX_BUFFER_SIZE];
+
+  // Body that did not fit into tx
+  const uint8_t* body = nullptr;
+  size_t bodyLength = 0;
+  size_t bodySent = 0;
+  uint8_t* ownedBody = nullptr;
+
+  // Streamed body: refills tx chunk by chunk
+  HttpResponse::ChunkWriter stream = nullptr;
+  void* streamContext = nullptr;
+  bool streamChunked = false;  // false for HTTP/1.0: raw bytes, end of body = close
+
+  bool pending() const { return txSent < txLength || bodySent < bodyLength || stream; }
+};
+
+class HttpServer {
+public:
+  explicit HttpServer(uint16_t port) : port_(port) {}
+  ~HttpServer() { end(); }
+
+  // Fixed route table, usually a compile-time RouteTable (useRoutes() in lib/RouteTable).
+  // `lookup` maps a request path to its index in `routes`; `routes` and `table` must outlive
+  // the server.
+  void setRoutes(const HttpRoute* routes, uint8_t count, HttpRouteLookup lookup, const void* table) {
+    routes_ = routes;
+    routeCount_ = count;
+    routeLookup_ = lookup;
+    routeTable_ = table;
+  }
+  void onNotFound(HttpHandler handler) { notFound_ = handler; }
+
+  // Count heap allocations around every handler call into handlerAllocs / allocRequests
+  void setAllocProbe(HttpAllocProbe probe) { allocProbe_ = probe; }
+
+  // Time every handler call (per-route latency metrics, lib/Metrics)
+  void setRouteProbe(HttpRouteProbe probe) { routeProbe_ = probe; }
+  uint8_t routeCount() const { return routeCount_; }
+  const char* routePath(uint8_t route) const { return route < routeCount_ ? routes_[route].path : nullptr; }
+
+  // Single WebSocket endpoint: GET `path` with "Upgrade: websocket"
+  void onWebSocket(const char* path, WebSocketHandler handler) {
+    wsPath_ = path;
+    wsHandler_ = handler;
+  }
+
+  // Queue one text frame. Returns false while a previous frame to this client is still
+  // being written (the caller decides whether to retry or drop) or if it does not fit.
+  bool wsSend(uint8_t client, const char* text, size_t length);
+  bool wsConnected(uint8_t client) const;
+  uint8_t wsClientCount() const;
+
+  bool begin();
+  void end();
+
+  // One event-loop pass: accept, read, dispatch, write, expire idle connections.
+  // Waits at most timeoutMs for socket activity.
+  void poll(uint32_t timeoutMs);
+
+  // Also return from poll() as soon as `fd` is readable (another socket served by the same
+  // task, e.g. UdpControl); the caller reads it. -1 removes it.
+  void wakeOn(int fd) { wakeFd_ = fd; }
+
+  const HttpServerStats& stats() const { return stats_; }
+  uint16_t port() const { return port_; }
+
+private:
+  void acceptClients(uint32_t now);
+  void readClient(HttpConnection& conn, uint32_t now);
+  void processRequests(HttpConnection& conn);
+  void processHttp(HttpConnection& conn);
+  bool handleRequest(HttpConnection& conn, size_t headerEnd, size_t* consumed);
+  bool upgradeWebSocket(HttpConnection& conn, HttpRequest& req);
+  void processFrames(HttpConnection& conn);
+  bool queueFrame(HttpConnection& conn, uint8_t opcode, const char* payload, size_t length);
+  uint8_t clientIndex(const HttpConnection& conn) const { return (uint8_t)(&conn - connections_); }
+  uint8_t dispatch(HttpRequest& req, HttpResponse& res);
+  void sendError(HttpConnection& conn, int code, const char* message);
+  void flush(HttpConnection& conn, uint32_t now);
+  void nextChunk(HttpConnection& conn);
+  void closeConnection(HttpConnection& conn);
+
+  uint16_t port_;
+  int listenFd_ = -1;
+  int wakeFd_ = -1;
+  const HttpRoute* routes_ = nullptr;
+  uint8_t routeCount_ = 0;
+  HttpRouteLookup routeLookup_ = nullptr;
+  const void* routeTable_ = nullptr;
+  HttpHandler notFound_ = nullptr;
+  HttpAllocProbe allocProbe_ = nullptr;
+  HttpRouteProbe routeProbe_ = nullptr;
+  const char* wsPath_ = nullptr;
+  WebSocketHandler wsHandler_ = nullptr;
+  HttpConnection connections_[HTTP_MAX_CONNECTIONS];
+  HttpServerStats stats_ = {};
+};
+
+const char* httpStatusText(int code);
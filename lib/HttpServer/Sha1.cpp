@@ -0,0 +1,88 @@
+// Minimal SHA-1 / Base64
+
+#include "Sha1.h"
+
+#include <string.h>
+
+static inline uint32_t rotl(uint32_t x, int n) { return (x << n) | (x >> (32 - n)); }
+
+static void sha1Block(uint32_t h[5], const uint8_t block[64]) {
+  uint32_t w[80];
+  for (int i = 0; i < 16; i++) {
+    w[i] = (uint32_t)block[i * 4] << 24 | (uint32_t)block[i * 4 + 1] << 16 |
+           (uint32_t)block[i * 4 + 2] << 8 | block[i * 4 + 3];
+  }
+  for (int i = 16; i < 80; i++) w[i] = rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+
+  uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+  for (int i = 0; i < 80; i++) {
+    uint32_t f, k;
+    if (i < 20) {
+      f = (b & c) | (~b & d);
+      k = 0x5A827999;
+    } else if (i < 40) {
+      f = b ^ c ^ d;
+      k = 0x6ED9EBA1;
+    } else if (i < 60) {
+      f = (b & c) | (b & d) | (c & d);
+      k = 0x8F1BBCDC;
+    } else {
+      f = b ^ c ^ d;
+      k = 0xCA62C1D6;
+    }
+    uint32_t t = rotl(a, 5) + f + e + k + w[i];
+    e = d;
+    d = c;
+    c = rotl(b, 30);
+    b = a;
+    a = t;
+  }
+  h[0] += a;
+  h[1] += b;
+  h[2] += c;
+  h[3] += d;
+  h[4] += e;
+}
+
+void sha1(const uint8_t* data, size_t length, uint8_t digest[20]) {
+  uint32_t h[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+
+  size_t offset = 0;
+  for (; offset + 64 <= length; offset += 64) sha1Block(h, data + offset);
+
+  // Padding: 0x80, zeros, 64-bit big-endian bit length
+  uint8_t tail[128];
+  size_t rest = length - offset;
+  memcpy(tail, data + offset, rest);
+  tail[rest] = 0x80;
+  size_t tailLength = rest + 1 + 8 <= 64 ? 64 : 128;
+  memset(tail + rest + 1, 0, tailLength - rest - 1);
+  uint64_t bits = (uint64_t)length * 8;
+  for (int i = 0; i < 8; i++) tail[tailLength - 1 - i] = (uint8_t)(bits >> (8 * i));
+
+  sha1Block(h, tail);
+  if (tailLength == 128) sha1Block(h, tail + 64);
+
+  for (int i = 0; i < 5; i++) {
+    digest[i * 4] = h[i] >> 24;
+    digest[i * 4 + 1] = h[i] >> 16;
+    digest[i * 4 + 2] = h[i] >> 8;
+    digest[i * 4 + 3] = h[i];
+  }
+}
+
+size_t base64Encode(const uint8_t* data, size_t length, char* out) {
+  static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  size_t n = 0;
+  for (size_t i = 0; i < length; i += 3) {
+    uint32_t v = (uint32_t)data[i] << 16;
+    if (i + 1 < length) v |= (uint32_t)data[i + 1] << 8;
+    if (i + 2 < length) v |= data[i + 2];
+    out[n++] = alphabet[(v >> 18) & 63];
+    out[n++] = alphabet[(v >> 12) & 63];
+    out[n++] = i + 1 < length ? alphabet[(v >> 6) & 63] : '=';
+    out[n++] = i + 2 < length ? alphabet[v & 63] : '=';
+  }
+  out[n] = '\0';
+  return n;
+}
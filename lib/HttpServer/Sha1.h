@@ -0,0 +1,12 @@
+// Minimal SHA-1 for the WebSocket handshake (RFC 6455 Sec-WebSocket-Accept)
+// Not for security use.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+void sha1(const uint8_t* data, size_t length, uint8_t digest[20]);
+
+// Base64 with padding; `out` needs 4 * ((length + 2) / 3) + 1 bytes
+size_t base64Encode(const uint8_t* data, size_t length, char* out);
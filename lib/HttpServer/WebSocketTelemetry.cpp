@@ -0,0 +1,37 @@
+// WebSocket telemetry push
+
+#include "WebSocketTelemetry.h"
+
+#include <string.h>
+
+void WebSocketTelemetry::update(const char* message, size_t length) {
+  if (length > sizeof(message_)) return;
+  if (length == length_ && memcmp(message, message_, length) == 0) return;
+
+  memcpy(message_, message, length);
+  length_ = length;
+  version_++;
+}
+
+void WebSocketTelemetry::pump(uint32_t nowMs) {
+  if (length_ == 0) return;
+
+  for (uint8_t client = 0; client < HTTP_MAX_CONNECTIONS; client++) {
+    if (!server_.wsConnected(client) || clientVersion_[client] == version_) continue;
+    if (clientVersion_[client] != 0 && nowMs - clientSentMs_[client] < minIntervalMs_) continue;
+
+    if (server_.wsSend(client, message_, length_)) {
+      clientVersion_[client] = version_;
+      clientSentMs_[client] = nowMs;
+      sent_++;
+    }
+  }
+}
+
+void WebSocketTelemetry::clientConnected(uint8_t client) {
+  if (client < HTTP_MAX_CONNECTIONS) clientVersion_[client] = 0;
+}
+
+void WebSocketTelemetry::clientDisconnected(uint8_t client) {
+  if (client < HTTP_MAX_CONNECTIONS) clientVersion_[client] = 0;
+}
@@ -0,0 +1,43 @@
+// WebSocket telemetry push
+// Holds the latest telemetry message and sends it to every connected WebSocket client
+// when it changes, at most once per `minIntervalMs` per client. A client that is still
+// busy receiving simply gets the newest message later - intermediate states are skipped.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "HttpServer.h"
+
+#ifndef WS_TELEMETRY_MAX_LENGTH
+#define WS_TELEMETRY_MAX_LENGTH 256
+#endif
+
+class WebSocketTelemetry {
+public:
+  WebSocketTelemetry(HttpServer& server, uint32_t minIntervalMs)
+      : server_(server), minIntervalMs_(minIntervalMs) {}
+
+  // Replace the current message; a byte-identical message is not re-sent
+  void update(const char* message, size_t length);
+
+  // Send to clients that are due; call after every server.poll()
+  void pump(uint32_t nowMs);
+
+  // Forward Connect / Disconnect events so new clients get the current state at once
+  void clientConnected(uint8_t client);
+  void clientDisconnected(uint8_t client);
+
+  uint32_t sent() const { return sent_; }
+
+private:
+  HttpServer& server_;
+  uint32_t minIntervalMs_;
+  uint32_t version_ = 1;
+  uint32_t sent_ = 0;
+  size_t length_ = 0;
+  char message_[WS_TELEMETRY_MAX_LENGTH];
+  uint32_t clientVersion_[HTTP_MAX_CONNECTIONS] = {};
+  uint32_t clientSentMs_[HTTP_MAX_CONNECTIONS] = {};
+};
@@ -0,0 +1,85 @@
+// Analog joystick axis filtering and calibration
+
+#include "AxisFilter.h"
+
+static uint16_t median3(uint16_t a, uint16_t b, uint16_t c) {
+  if (a > b) {
+    uint16_t t = a;
+    a = b;
+    b = t;
+  }
+  if (b > c) b = c;
+  return a > b ? a : b;
+}
+
+void AxisFilter::reset(uint16_t value) {
+  state_ = (int32_t)value << 8;
+  history_[0] = history_[1] = history_[2] = value;
+  primed_ = true;
+}
+
+uint16_t AxisFilter::update(const uint16_t* samples, uint8_t count) {
+  if (count == 0) return value();
+
+  uint32_t sum = 0;
+  uint16_t low = 0xFFFF;
+  uint16_t high = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    sum += samples[i];
+    if (samples[i] < low) low = samples[i];
+    if (samples[i] > high) high = samples[i];
+  }
+  uint16_t block;
+  if (count > 2) {
+    block = (uint16_t)((sum - low - high + (count - 2) / 2) / (count - 2));
+  } else {
+    block = (uint16_t)((sum + count / 2) / count);
+  }
+
+  if (!primed_) reset(block);
+
+  history_[0] = history_[1];
+  history_[1] = history_[2];
+  history_[2] = block;
+  int32_t x = (int32_t)median3(history_[0], history_[1], history_[2]) << 8;
+
+  // Rounded arithmetic shift so the state settles exactly on a constant input
+  int32_t delta = x - state_;
+  state_ += delta >= 0 ? (delta + (1 << shift_) - 1) >> shift_ : -((-delta + (1 << shift_) - 1) >> shift_);
+  return value();
+}
+
+void CenterCalibrator::add(uint16_t filtered) {
+  if (done()) return;
+  count_++;
+  sum_ += filtered;
+  if (filtered < low_) low_ = filtered;
+  if (filtered > high_) high_ = filtered;
+}
+
+AxisCalibration CenterCalibrator::result(bool* ok) const {
+  AxisCalibration cal = {(JOYSTICK_ADC_MAX + 1) / 2, minDeadzone_, 0, JOYSTICK_ADC_MAX};
+  uint16_t noise = count_ > 0 ? high_ - low_ : 0xFFFF;
+  bool valid = count_ > 0 && noise <= maxNoise_;
+  if (ok) *ok = valid;
+  if (!valid) return cal;
+
+  cal.center = (uint16_t)((sum_ + count_ / 2) / count_);
+  // Twice the peak-to-peak noise keeps a released stick at exactly 0
+  uint16_t deadzone = noise * 2;
+  cal.deadzone = deadzone > minDeadzone_ ? deadzone : minDeadzone_;
+  return cal;
+}
+
+int16_t normalizeAxis(uint16_t filtered, const AxisCalibration& cal) {
+  int32_t offset = (int32_t)filtered - cal.center;
+  int32_t magnitude = offset < 0 ? -offset : offset;
+  if (magnitude <= cal.deadzone) return 0;
+
+  int32_t span = (offset > 0 ? (int32_t)cal.max - cal.center : (int32_t)cal.center - cal.min) - cal.deadzone;
+  if (span <= 0) return 0;
+
+  int32_t scaled = (magnitude - cal.deadzone) * JOYSTICK_FULL_SCALE / span;
+  if (scaled > JOYSTICK_FULL_SCALE) scaled = JOYSTICK_FULL_SCALE;
+  return (int16_t)(offset < 0 ? -scaled : scaled);
+}
@@ -0,0 +1,71 @@
+// Analog joystick axis filtering and calibration
+// Hardware-independent integer code: the caller reads the ADC, these classes only see samples.
+//
+// Per output step an axis gets a block of oversampled raw readings:
+//   trimmed mean (min and max dropped) -> median of the last 3 outputs -> first-order IIR
+// The trimmed mean and median remove the isolated spikes the ESP32 ADC is known for, the
+// IIR (alpha = 1/2^shift, Q8 state) smooths what is left.
+
+#pragma once
+
+#include <stdint.h>
+
+#ifndef JOYSTICK_ADC_MAX
+#define JOYSTICK_ADC_MAX 4095
+#endif
+
+// Normalized deflection range: -JOYSTICK_FULL_SCALE..JOYSTICK_FULL_SCALE
+#define JOYSTICK_FULL_SCALE 1000
+
+class AxisFilter {
+public:
+  explicit AxisFilter(uint8_t iirShift = 2) : shift_(iirShift) {}
+
+  // Restart from a known value (no transient from zero)
+  void reset(uint16_t value);
+
+  // Feed one block of raw readings, returns the filtered value in ADC units
+  uint16_t update(const uint16_t* samples, uint8_t count);
+
+  uint16_t value() const { return (uint16_t)((state_ + 128) >> 8); }
+
+private:
+  uint8_t shift_;
+  bool primed_ = false;
+  int32_t state_ = 0;  // Q8
+  uint16_t history_[3] = {};
+};
+
+struct AxisCalibration {
+  uint16_t center;
+  uint16_t deadzone;  // ADC units either side of center that read as 0
+  uint16_t min;
+  uint16_t max;
+};
+
+// Neutral position measured at boot while the stick is left alone.
+// The deadzone follows the observed noise; a stick that moved during calibration falls
+// back to the nominal center.
+class CenterCalibrator {
+public:
+  CenterCalibrator(uint16_t samples, uint16_t minDeadzone, uint16_t maxNoise)
+      : needed_(samples), minDeadzone_(minDeadzone), maxNoise_(maxNoise) {}
+
+  void add(uint16_t filtered);
+  bool done() const { return count_ >= needed_; }
+
+  // Valid once done(); `ok` is false when the noise band exceeded maxNoise
+  AxisCalibration result(bool* ok = nullptr) const;
+
+private:
+  uint16_t needed_;
+  uint16_t minDeadzone_;
+  uint16_t maxNoise_;
+  uint16_t count_ = 0;
+  uint32_t sum_ = 0;
+  uint16_t low_ = 0xFFFF;
+  uint16_t high_ = 0;
+};
+
+// Filtered ADC value -> -1000..1000, 0 inside the deadzone, each side scaled to its own span
+int16_t normalizeAxis(uint16_t filtered, const AxisCalibration& cal);
@@ -0,0 +1,73 @@
+#include "JsonArena.h"
+
+#include <string.h>
+
+// Each block is preceded by its size; blocks are 8-byte aligned
+static const size_t HEADER_SIZE = 8;
+
+static size_t alignUp(size_t n) {
+  return (n + 7) & ~(size_t)7;
+}
+
+static size_t& blockSize(uint8_t* buffer, size_t header) {
+  return *reinterpret_cast<size_t*>(buffer + header);
+}
+
+void* JsonArena::allocate(size_t size) {
+  size_t total = HEADER_SIZE + alignUp(size);
+  if (total > capacity_ - top_) {
+    failures_++;
+    return nullptr;
+  }
+
+  size_t header = top_;
+  blockSize(buffer_, header) = size;
+  last_ = header;
+  top_ += total;
+  if (top_ > peak_) peak_ = top_;
+  return buffer_ + header + HEADER_SIZE;
+}
+
+void JsonArena::deallocate(void* ptr) {
+  if (!ptr) return;
+  size_t header = (uint8_t*)ptr - buffer_ - HEADER_SIZE;
+  if (header != last_) return;  // reclaimed by reset()
+
+  top_ = header;
+  last_ = NONE;
+}
+
+void* JsonArena::reallocate(void* ptr, size_t newSize) {
+  if (!ptr) return allocate(newSize);
+
+  size_t header = (uint8_t*)ptr - buffer_ - HEADER_SIZE;
+  size_t oldSize = blockSize(buffer_, header);
+
+  // Most recent block: grow or shrink in place
+  if (header == last_) {
+    size_t total = HEADER_SIZE + alignUp(newSize);
+    if (total > capacity_ - header) {
+      failures_++;
+      return nullptr;
+    }
+    blockSize(buffer_, header) = newSize;
+    top_ = header + total;
+    if (top_ > peak_) peak_ = top_;
+    return ptr;
+  }
+
+  if (newSize <= oldSize) {
+    blockSize(buffer_, header) = newSize;
+    return ptr;
+  }
+
+  void* moved = allocate(newSize);
+  if (!moved) return nullptr;
+  memcpy(moved, ptr, oldSize);
+  return moved;
+}
+
+void JsonArena::reset() {
+  top_ = 0;
+  last_ = NONE;
+}
@@ -0,0 +1,49 @@
+// Fixed-capacity ArduinoJson allocator
+// Bump allocator over a caller-owned buffer: no heap, O(1) allocate, in-place growth and
+// rollback for the most recent block (the pattern ArduinoJson uses for strings being built
+// and for shrinkToFit). Freed blocks in the middle are only reclaimed by reset() or when the
+// arena goes out of scope. Allocation past the capacity fails, which ArduinoJson reports as
+// DeserializationError::NoMemory / overflowed().
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <ArduinoJson.h>
+
+class JsonArena : public ArduinoJson::Allocator {
+public:
+  JsonArena(uint8_t* buffer, size_t capacity) : buffer_(buffer), capacity_(capacity) {}
+
+  void* allocate(size_t size) override;
+  void deallocate(void* ptr) override;
+  void* reallocate(void* ptr, size_t newSize) override;
+
+  // Forget every block; only valid when no document still points into the arena
+  void reset();
+
+  size_t used() const { return top_; }
+  size_t peak() const { return peak_; }
+  size_t capacity() const { return capacity_; }
+  uint32_t failures() const { return failures_; }
+
+private:
+  static const size_t NONE = (size_t)-1;
+
+  uint8_t* buffer_;
+  size_t capacity_;
+  size_t top_ = 0;
+  size_t last_ = NONE;  // header offset of the most recent live block
+  size_t peak_ = 0;
+  uint32_t failures_ = 0;
+};
+
+template <size_t N>
+class StaticJsonArena : public JsonArena {
+public:
+  StaticJsonArena() : JsonArena(storage_, N) {}
+
+private:
+  alignas(8) uint8_t storage_[N];
+};
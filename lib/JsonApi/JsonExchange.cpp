@@ -0,0 +1,38 @@
+#include "JsonExchange.h"
+
+#include "Trace.h"
+
+bool JsonExchange::parse(const HttpRequest& req, HttpResponse& res) {
+  TRACE_SCOPE("json_parse");
+  DeserializationError error = deserializeJson(request, req.body(), req.bodyLength());
+  if (error == DeserializationError::Ok) return true;
+
+  if (error == DeserializationError::NoMemory) {
+    res.send(413, "application/json", "{\"error\":\"Request too large\"}");
+  } else {
+    res.send(400, "application/json", "{\"error\":\"Invalid JSON\"}");
+  }
+  return false;
+}
+
+bool JsonExchange::parse(const char* data, size_t length) {
+  TRACE_SCOPE("json_parse");
+  return deserializeJson(request, data, length) == DeserializationError::Ok;
+}
+
+void JsonExchange::send(HttpResponse& res, int code) {
+  if (response.overflowed()) {
+    res.send(500, "application/json", "{\"error\":\"Response too large\"}");
+    return;
+  }
+  sendJson(res, code, response);
+}
+
+static size_t writeJson(char* out, size_t capacity, void* context) {
+  return serializeJson(*static_cast<const JsonDocument*>(context), out, capacity);
+}
+
+void sendJson(HttpResponse& res, int code, const JsonDocument& doc) {
+  TRACE_SCOPE("json_serialize");
+  res.sendWith(code, "application/json", measureJson(doc), writeJson, const_cast<JsonDocument*>(&doc));
+}
@@ -0,0 +1,50 @@
+// Allocation-free JSON request/response for HttpServer handlers
+// One JsonExchange lives on the handler's stack: the request body is parsed into `request`,
+// the reply is built in `response`, and both documents draw from the same fixed arena.
+// send() measures the reply and serializes it straight into the connection's send buffer,
+// so a handler never touches the heap:
+//
+//   JsonExchange json;
+//   if (!json.parse(req, res)) return;   // 400 / 413 already sent
+//   int angle = json.request["angle"] | -1;
+//   json.response["angle"] = angle;
+//   json.send(res, 200);
+
+#pragma once
+
+#include <ArduinoJson.h>
+
+#include "HttpServer.h"
+#include "JsonArena.h"
+
+// Enough for one parsed command plus the status reply; 64-bit hosts need about twice as much
+#ifndef JSON_ARENA_SIZE
+#define JSON_ARENA_SIZE 3072
+#endif
+
+class JsonExchange {
+public:
+  JsonExchange() : request(&arena_), response(&arena_) {}
+
+  // Parse the request body. On failure replies 400 (bad JSON) or 413 (does not fit the arena)
+  // and returns false.
+  bool parse(const HttpRequest& req, HttpResponse& res);
+
+  // Parse a WebSocket message (or any buffer), false on error
+  bool parse(const char* data, size_t length);
+
+  // Serialize `response` into the connection buffer
+  void send(HttpResponse& res, int code);
+
+  const JsonArena& arena() const { return arena_; }
+
+private:
+  StaticJsonArena<JSON_ARENA_SIZE> arena_;
+
+public:
+  JsonDocument request;
+  JsonDocument response;
+};
+
+// Serialize any document without an intermediate String
+void sendJson(HttpResponse& res, int code, const JsonDocument& doc);
@@ -0,0 +1,66 @@
+// Asynchronous logging
+// LOG_ERROR / LOG_WARN / LOG_INFO / LOG_DEBUG(format, args...) take printf formats but do not
+// format anything: the call stores the format pointer, a timestamp and the arguments in binary
+// (integers, floats and pointers as they are, strings copied) into a lock-free ring
+// (LogBuffer.h) and returns. A low-priority task formats and prints the records later
+// (logBuffer.drain()), so an API handler or the control loop never waits for the UART. When
+// the ring is full the message is dropped and counted.
+//
+// Levels above LOG_LEVEL (build flag, default LOG_LEVEL_INFO) compile to nothing: no code and
+// the arguments are not evaluated. Formats are checked against the arguments like printf's
+// and must be string literals (only the pointer is stored).
+//
+//   LOG_INFO("Mode: AUTO_SCAN (%s, %.1f s)", scanShapeName(shape), seconds);
+//   LOG_DEBUG("API: status request");   // gone unless -DLOG_LEVEL=LOG_LEVEL_DEBUG
+
+#pragma once
+
+#define LOG_LEVEL_NONE 0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_INFO 3
+#define LOG_LEVEL_DEBUG 4
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+#include "LogBuffer.h"
+
+// Never called: lets the compiler check the arguments against the format
+inline void logCheckFormat(const char* format, ...) __attribute__((format(printf, 1, 2)));
+inline void logCheckFormat(const char*, ...) {}
+
+#define LOG_WRITE_(level, format, ...)              \
+  do {                                              \
+    if (0) logCheckFormat(format, ##__VA_ARGS__);   \
+    logBuffer.write(level, format, ##__VA_ARGS__);  \
+  } while (0)
+#define LOG_SKIP_(format, ...)                      \
+  do {                                              \
+    if (0) logCheckFormat(format, ##__VA_ARGS__);   \
+  } while (0)
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(format, ...) LOG_WRITE_(LOG_LEVEL_ERROR, format, ##__VA_ARGS__)
+#else
+#define LOG_ERROR(format, ...) LOG_SKIP_(format, ##__VA_ARGS__)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_WARN(format, ...) LOG_WRITE_(LOG_LEVEL_WARN, format, ##__VA_ARGS__)
+#else
+#define LOG_WARN(format, ...) LOG_SKIP_(format, ##__VA_ARGS__)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(format, ...) LOG_WRITE_(LOG_LEVEL_INFO, format, ##__VA_ARGS__)
+#else
+#define LOG_INFO(format, ...) LOG_SKIP_(format, ##__VA_ARGS__)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(format, ...) LOG_WRITE_(LOG_LEVEL_DEBUG, format, ##__VA_ARGS__)
+#else
+#define LOG_DEBUG(format, ...) LOG_SKIP_(format, ##__VA_ARGS__)
+#endif
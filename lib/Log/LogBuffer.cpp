@@ -0,0 +1,230 @@
+// Lock-free log record ring
+
+#include "LogBuffer.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+LogBuffer logBuffer;
+
+void LogRecord::put(const char* value) {
+  if (!value) value = "(null)";
+  if (cut || size + 2 > LOG_PAYLOAD_SIZE) {
+    cut = true;
+    return;
+  }
+  size_t length = strlen(value);
+  size_t room = LOG_PAYLOAD_SIZE - size - 2;
+  if (length > room) length = room;  // cut to what is left
+  if (length > 255) length = 255;
+  payload[size] = LOG_ARG_STR;
+  payload[size + 1] = (uint8_t)length;
+  memcpy(payload + size + 2, value, length);
+  size += 2 + length;
+}
+
+LogBuffer::LogBuffer() {
+  for (uint32_t i = 0; i < LOG_BUFFER_SIZE; i++) slots_[i].seq.store(i, std::memory_order_relaxed);
+}
+
+bool LogBuffer::push(const LogRecord& record) {
+  uint32_t index = head_.load(std::memory_order_relaxed);
+  Slot* slot;
+  for (;;) {
+    slot = &slots_[index & (LOG_BUFFER_SIZE - 1)];
+    int32_t lag = (int32_t)(slot->seq.load(std::memory_order_acquire) - index);
+    if (lag == 0) {
+      if (head_.compare_exchange_weak(index, index + 1, std::memory_order_relaxed)) break;
+    } else if (lag < 0) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);  // the reader has not freed this slot yet
+      return false;
+    } else {
+      index = head_.load(std::memory_order_relaxed);  // another writer took it
+    }
+  }
+  // Only the record's used part is copied
+  slot->record.format = record.format;
+  slot->record.timeMs = record.timeMs;
+  slot->record.level = record.level;
+  slot->record.size = record.size;
+  slot->record.cut = record.cut;
+  memcpy(slot->record.payload, record.payload, record.size);
+  slot->seq.store(index + 1, std::memory_order_release);
+  return true;
+}
+
+bool LogBuffer::pop(LogRecord& record) {
+  Slot& slot = slots_[tail_ & (LOG_BUFFER_SIZE - 1)];
+  if (slot.seq.load(std::memory_order_acquire) != tail_ + 1) return false;
+  record = slot.record;
+  slot.seq.store(tail_ + LOG_BUFFER_SIZE, std::memory_order_release);
+  tail_++;
+  return true;
+}
+
+uint32_t LogBuffer::drain(void (*emit)(const char* line)) {
+  char line[LOG_LINE_SIZE];
+  LogRecord record;
+  uint32_t count = 0;
+  while (pop(record)) {
+    format(record, line, sizeof(line));
+    emit(line);
+    count++;
+  }
+  uint32_t drops = dropped();
+  if (drops != reportedDrops_) {
+    snprintf(line, sizeof(line), "log: %u messages dropped", (unsigned)(drops - reportedDrops_));
+    emit(line);
+    reportedDrops_ = drops;
+  }
+  return count;
+}
+
+namespace {
+
+const char LEVEL_LETTERS[] = "-EWID";
+
+// snprintf into the rest of `out`; keeps `length` at most size - 1
+void append(char* out, size_t size, size_t& length, const char* spec, ...) __attribute__((format(printf, 4, 5)));
+
+void append(char* out, size_t size, size_t& length, const char* spec, ...) {
+  if (length + 1 >= size) return;
+  va_list args;
+  va_start(args, spec);
+  int n = vsnprintf(out + length, size - length, spec, args);
+  va_end(args);
+  if (n > 0) length += (size_t)n < size - length ? (size_t)n : size - length - 1;
+}
+
+// One conversion of the original format ("%-6.1f"), its length modifier replaced by what the
+// stored argument needs
+void appendArg(char* out, size_t size, size_t& length, const char* spec, size_t specLength, char conversion,
+               const uint8_t*& arg, const uint8_t* end) {
+  char fmt[24];
+  if (specLength > sizeof(fmt) - 4 || arg >= end) {
+    append(out, size, length, "?");
+    arg = end;
+    return;
+  }
+  memcpy(fmt, spec, specLength);
+  char* tail = fmt + specLength;
+
+  uint8_t tag = *arg++;
+  uint32_t u32;
+  uint64_t u64;
+  float f32;
+  double f64;
+  const void* ptr;
+
+// Format checking happened at the call site; here the specs are built at run time
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wformat-nonliteral"
+  switch (tag) {
+    case LOG_ARG_I32:
+    case LOG_ARG_U32:
+    case LOG_ARG_I64:
+    case LOG_ARG_U64: {
+      // As 64 bits: sign-extended when signed, so %d and %u/%x print what printf would
+      if (tag == LOG_ARG_I32 || tag == LOG_ARG_U32) {
+        memcpy(&u32, arg, 4);
+        arg += 4;
+        u64 = tag == LOG_ARG_I32 ? (uint64_t)(int64_t)(int32_t)u32 : u32;
+      } else {
+        memcpy(&u64, arg, 8);
+        arg += 8;
+      }
+      bool isUnsigned = strchr("uxXo", conversion) != nullptr;
+      if (isUnsigned && tag == LOG_ARG_I32) u64 = u32;  // %u of a negative int: 32-bit wrap
+      if (conversion == 'c') {
+        memcpy(tail, "c", 2);
+        append(out, size, length, fmt, (int)u64);
+      } else if (isUnsigned) {
+        tail[0] = 'l';
+        tail[1] = 'l';
+        tail[2] = conversion;
+        tail[3] = '\0';
+        append(out, size, length, fmt, (unsigned long long)u64);
+      } else {
+        memcpy(tail, "lld", 4);
+        append(out, size, length, fmt, (long long)u64);
+      }
+      break;
+    }
+    case LOG_ARG_F32:
+    case LOG_ARG_F64:
+      if (tag == LOG_ARG_F32) {
+        memcpy(&f32, arg, 4);
+        f64 = f32;
+        arg += 4;
+      } else {
+        memcpy(&f64, arg, 8);
+        arg += 8;
+      }
+      tail[0] = conversion;
+      tail[1] = '\0';
+      append(out, size, length, fmt, f64);
+      break;
+    case LOG_ARG_PTR:
+      memcpy(&ptr, arg, sizeof(ptr));
+      arg += sizeof(ptr);
+      append(out, size, length, "%p", ptr);
+      break;
+    case LOG_ARG_STR: {
+      // Not terminated: the stored length (or a smaller precision from the spec) bounds it
+      uint8_t stored = *arg++;
+      int n = stored;
+      const char* dot = (const char*)memchr(spec, '.', specLength);
+      if (dot && atoi(dot + 1) < n) n = atoi(dot + 1);
+      memcpy(fmt + (dot ? dot - spec : specLength), ".*s", 4);
+      append(out, size, length, fmt, n, (const char*)arg);
+      arg += stored;
+      break;
+    }
+    default:
+      append(out, size, length, "?");
+      arg = end;
+      break;
+  }
+#pragma GCC diagnostic pop
+}
+
+}  // namespace
+
+size_t LogBuffer::format(const LogRecord& record, char* out, size_t size) {
+  size_t length = 0;
+  out[0] = '\0';
+  char level = record.level < sizeof(LEVEL_LETTERS) - 1 ? LEVEL_LETTERS[record.level] : '?';
+  append(out, size, length, "%4u.%03u %c ", (unsigned)(record.timeMs / 1000), (unsigned)(record.timeMs % 1000), level);
+
+  const uint8_t* arg = record.payload;
+  const uint8_t* end = record.payload + record.size;
+  for (const char* f = record.format; *f && length + 1 < size;) {
+    if (*f != '%') {
+      const char* text = f;
+      while (*f && *f != '%') f++;
+      append(out, size, length, "%.*s", (int)(f - text), text);
+      continue;
+    }
+    if (f[1] == '%') {
+      append(out, size, length, "%%");
+      f += 2;
+      continue;
+    }
+    // %[flags][width][.precision][length]conversion
+    const char* spec = f++;
+    while (*f && strchr("-+ #0", *f)) f++;
+    while (*f >= '0' && *f <= '9') f++;
+    if (*f == '.') {
+      f++;
+      while (*f >= '0' && *f <= '9') f++;
+    }
+    size_t specLength = f - spec;
+    while (*f && strchr("hlLqjzt", *f)) f++;
+    if (!*f) break;
+    char conversion = *f++;
+    if (conversion == 'i') conversion = 'd';
+    appendArg(out, size, length, spec, specLength, conversion, arg, end);
+  }
+  return length;
+}
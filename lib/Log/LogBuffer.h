@@ -0,0 +1,135 @@
+// Lock-free log record ring (see Log.h for the macros)
+// Any task on either core writes concurrently: a slot is claimed with a compare-and-swap on the
+// head and published with a per-slot sequence number, so writers never block on each other or
+// on the reader. A full ring refuses the record (counted in dropped()) rather than overwrite
+// one that is still waiting to be printed. One reader (the log task) drains the ring and does
+// all the formatting.
+
+#pragma once
+
+#include <Arduino.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <atomic>
+#include <type_traits>
+
+#ifndef LOG_BUFFER_SIZE
+#define LOG_BUFFER_SIZE 64  // records (power of two), 68 bytes each on the ESP32
+#endif
+
+#ifndef LOG_PAYLOAD_SIZE
+#define LOG_PAYLOAD_SIZE 53  // encoded argument bytes per record
+#endif
+
+#ifndef LOG_LINE_SIZE
+#define LOG_LINE_SIZE 160  // formatted line, longer ones are cut
+#endif
+
+// Argument tags in the payload, each followed by its value
+enum LogArg : uint8_t {
+  LOG_ARG_I32,
+  LOG_ARG_U32,
+  LOG_ARG_I64,
+  LOG_ARG_U64,
+  LOG_ARG_F32,
+  LOG_ARG_F64,
+  LOG_ARG_PTR,
+  LOG_ARG_STR  // length byte, then the characters without terminator
+};
+
+struct LogRecord {
+  const char* format;
+  uint32_t timeMs;
+  uint8_t level;
+  uint8_t size;  // payload bytes used
+  bool cut;      // an argument did not fit: it and all after it print as "?"
+  uint8_t payload[LOG_PAYLOAD_SIZE];
+
+  // Argument encoding: integers up to 32 bits take 5 bytes, a float 5, a string 2 + its
+  // length. What does not fit is left out and printed as "?".
+  template <typename T>
+  typename std::enable_if<std::is_integral<T>::value>::type put(T value) {
+    if (sizeof(T) > 4) {
+      if (std::is_signed<T>::value) {
+        putValue(LOG_ARG_I64, (int64_t)value);
+      } else {
+        putValue(LOG_ARG_U64, (uint64_t)value);
+      }
+    } else if (std::is_signed<T>::value) {
+      putValue(LOG_ARG_I32, (int32_t)value);
+    } else {
+      putValue(LOG_ARG_U32, (uint32_t)value);
+    }
+  }
+  template <typename T>
+  typename std::enable_if<std::is_enum<T>::value>::type put(T value) {
+    put((typename std::underlying_type<T>::type)value);
+  }
+  void put(float value) { putValue(LOG_ARG_F32, value); }
+  void put(double value) { putValue(LOG_ARG_F64, value); }
+  void put(const void* value) { putValue(LOG_ARG_PTR, value); }
+  void put(const char* value);
+  void put(char* value) { put((const char*)value); }
+
+private:
+  template <typename T>
+  void putValue(LogArg tag, T value) {
+    if (cut || size + 1 + sizeof(T) > LOG_PAYLOAD_SIZE) {
+      cut = true;  // later arguments must not slip into the space left
+      return;
+    }
+    payload[size] = tag;
+    memcpy(payload + size + 1, &value, sizeof(T));
+    size += 1 + sizeof(T);
+  }
+};
+
+class LogBuffer {
+  static_assert((LOG_BUFFER_SIZE & (LOG_BUFFER_SIZE - 1)) == 0, "LOG_BUFFER_SIZE must be a power of two");
+
+public:
+  LogBuffer();
+
+  // Writer side, any task
+  template <typename... Args>
+  void write(uint8_t level, const char* format, Args... args) {
+    LogRecord record;
+    record.format = format;
+    record.timeMs = millis();
+    record.level = level;
+    record.size = 0;
+    record.cut = false;
+    (record.put(args), ...);
+    push(record);
+  }
+
+  bool push(const LogRecord& record);
+
+  // Reader side, one task: formats and emits every waiting record (plus a line when messages
+  // were dropped since the last call); returns how many records were emitted
+  uint32_t drain(void (*emit)(const char* line));
+
+  // Line for one record: "  12.345 I message"
+  static size_t format(const LogRecord& record, char* out, size_t size);
+
+  uint32_t written() const { return head_.load(std::memory_order_relaxed); }
+  uint32_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+  struct Slot {
+    std::atomic<uint32_t> seq;  // index while free, index + 1 once written
+    LogRecord record;
+  };
+
+  bool pop(LogRecord& record);
+
+  std::atomic<uint32_t> head_{0};
+  std::atomic<uint32_t> dropped_{0};
+  uint32_t tail_ = 0;           // reader only
+  uint32_t reportedDrops_ = 0;  // reader only
+  Slot slots_[LOG_BUFFER_SIZE];
+};
+
+extern LogBuffer logBuffer;
@@ -0,0 +1,41 @@
+// Metrics for Prometheus scraping
+
+#include "Metrics.h"
+
+MetricsRegistry metrics;
+
+const uint32_t METRIC_LATENCY_BUCKETS_US[] = {100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000};
+const uint8_t METRIC_LATENCY_BUCKET_COUNT = sizeof(METRIC_LATENCY_BUCKETS_US) / sizeof(METRIC_LATENCY_BUCKETS_US[0]);
+
+void MetricHistogram::observe(uint32_t us) {
+  uint8_t i = 0;
+  while (i < count_ && us > bounds_[i]) i++;
+  buckets_[i].fetch_add(1, std::memory_order_relaxed);
+  sumUs_.fetch_add(us, std::memory_order_relaxed);
+}
+
+bool MetricsRegistry::add(const MetricEntry& entry) {
+  if (count_ >= METRICS_MAX_ENTRIES) return false;
+  entries_[count_++] = entry;
+  return true;
+}
+
+bool MetricsRegistry::counter(const char* name, const char* help, const MetricCounter& counter, const char* labelName,
+                              const char* labelValue) {
+  return add({name, help, MetricType::Counter, labelName, labelValue, &counter, nullptr, nullptr});
+}
+
+bool MetricsRegistry::counter(const char* name, const char* help, MetricReader reader, const char* labelName,
+                              const char* labelValue) {
+  return add({name, help, MetricType::Counter, labelName, labelValue, nullptr, reader, nullptr});
+}
+
+bool MetricsRegistry::gauge(const char* name, const char* help, MetricReader reader, const char* labelName,
+                            const char* labelValue) {
+  return add({name, help, MetricType::Gauge, labelName, labelValue, nullptr, reader, nullptr});
+}
+
+bool MetricsRegistry::histogram(const char* name, const char* help, const MetricHistogram& histogram,
+                                const char* labelName, const char* labelValue) {
+  return add({name, help, MetricType::Histogram, labelName, labelValue, nullptr, nullptr, &histogram});
+}
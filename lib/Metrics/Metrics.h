@@ -0,0 +1,104 @@
+// Metrics for Prometheus scraping
+// Counters and fixed-bucket histograms are plain atomics: any task or core updates them with
+// a relaxed fetch_add and no lock. A registry lists them by name (plus gauges read through a
+// callback) for MetricsExport, which renders the text format straight into the response.
+//
+//   MetricCounter servoCommands;
+//   metrics.counter("servo_commands_total", "Commands accepted into the queue", servoCommands);
+//   servoCommands.inc();
+//
+// Register everything in setup() before the tasks start; the registry itself is not locked.
+// Entries of one metric family (same name, different label) must be registered back to back.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+#ifndef METRICS_MAX_ENTRIES
+#define METRICS_MAX_ENTRIES 64
+#endif
+
+#ifndef METRICS_MAX_BUCKETS
+#define METRICS_MAX_BUCKETS 12
+#endif
+
+class MetricCounter {
+public:
+  void inc(uint32_t n = 1) { value_.fetch_add(n, std::memory_order_relaxed); }
+  uint32_t value() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+  std::atomic<uint32_t> value_{0};
+};
+
+// Default request-latency buckets: 100 us .. 250 ms
+extern const uint32_t METRIC_LATENCY_BUCKETS_US[];
+extern const uint8_t METRIC_LATENCY_BUCKET_COUNT;
+
+// Durations in microseconds, exported in seconds (Prometheus base unit)
+class MetricHistogram {
+public:
+  MetricHistogram() : MetricHistogram(METRIC_LATENCY_BUCKETS_US, METRIC_LATENCY_BUCKET_COUNT) {}
+
+  // `bounds`: ascending upper bounds in us, static storage; at most METRICS_MAX_BUCKETS are used
+  MetricHistogram(const uint32_t* bounds, uint8_t count)
+      : bounds_(bounds), count_(count < METRICS_MAX_BUCKETS ? count : METRICS_MAX_BUCKETS) {}
+
+  void observe(uint32_t us);
+
+  uint8_t boundCount() const { return count_; }
+  uint32_t bound(uint8_t i) const { return bounds_[i]; }
+  // Observations in bucket i alone (not cumulative); i == boundCount() is above the last bound
+  uint32_t bucket(uint8_t i) const { return buckets_[i].load(std::memory_order_relaxed); }
+  uint64_t sumUs() const { return sumUs_.load(std::memory_order_relaxed); }
+
+private:
+  const uint32_t* bounds_;
+  uint8_t count_;
+  std::atomic<uint32_t> buckets_[METRICS_MAX_BUCKETS + 1] = {};
+  std::atomic<uint64_t> sumUs_{0};
+};
+
+enum class MetricType : uint8_t { Counter, Gauge, Histogram };
+
+// Value sampled at scrape time (free heap, queue depth, ...)
+typedef double (*MetricReader)();
+
+struct MetricEntry {
+  const char* name;
+  const char* help;
+  MetricType type;
+  const char* labelName;   // nullptr: no label
+  const char* labelValue;
+  const MetricCounter* counter;
+  MetricReader reader;
+  const MetricHistogram* histogram;
+};
+
+class MetricsRegistry {
+public:
+  // Names, help texts and labels are stored as pointers: use literals or other static strings.
+  // Each returns false when the registry is full.
+  bool counter(const char* name, const char* help, const MetricCounter& counter, const char* labelName = nullptr,
+               const char* labelValue = nullptr);
+  bool counter(const char* name, const char* help, MetricReader reader, const char* labelName = nullptr,
+               const char* labelValue = nullptr);
+  bool gauge(const char* name, const char* help, MetricReader reader, const char* labelName = nullptr,
+             const char* labelValue = nullptr);
+  bool histogram(const char* name, const char* help, const MetricHistogram& histogram, const char* labelName = nullptr,
+                 const char* labelValue = nullptr);
+
+  uint8_t size() const { return count_; }
+  const MetricEntry& entry(uint8_t i) const { return entries_[i]; }
+
+private:
+  bool add(const MetricEntry& entry);
+
+  uint8_t count_ = 0;
+  MetricEntry entries_[METRICS_MAX_ENTRIES];
+};
+
+extern MetricsRegistry metrics;
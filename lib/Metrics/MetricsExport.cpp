@@ -0,0 +1,183 @@
+// Prometheus text exposition of the metrics registry
+
+#include "MetricsExport.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "HttpServer.h"
+#include "Metrics.h"
+
+void MetricsExport::begin(const MetricsRegistry& registry) {
+  registry_ = &registry;
+  entry_ = 0;
+  line_ = 0;
+  cumulative_ = 0;
+}
+
+// Microseconds -> "s.uuuuuu"
+static int formatSeconds(char* out, size_t size, uint64_t us) {
+  return snprintf(out, size, "%lu.%06u", (unsigned long)(us / 1000000), (unsigned)(us % 1000000));
+}
+
+static const char* typeName(MetricType type) {
+  switch (type) {
+    case MetricType::Counter: return "counter";
+    case MetricType::Gauge: return "gauge";
+    default: return "histogram";
+  }
+}
+
+size_t MetricsExport::formatLine(char* out, size_t capacity) {
+  const MetricEntry& e = registry_->entry(entry_);
+  bool familyHead = entry_ == 0 || strcmp(registry_->entry(entry_ - 1).name, e.name) != 0;
+  if (line_ < 2 && !familyHead) line_ = 2;
+  nextCumulative_ = cumulative_;
+
+  int n;
+  if (line_ == 0) {
+    n = snprintf(out, capacity, "# HELP %s %s\n", e.name, e.help);
+  } else if (line_ == 1) {
+    n = snprintf(out, capacity, "# TYPE %s %s\n", e.name, typeName(e.type));
+  } else {
+    // {label="value"} / {label="value",le="..."} / {le="..."}
+    char labels[72];
+    if (e.labelName) {
+      snprintf(labels, sizeof(labels), "%s=\"%s\"", e.labelName, e.labelValue);
+    } else {
+      labels[0] = '\0';
+    }
+    const char* comma = labels[0] ? "," : "";
+    uint8_t sample = line_ - 2;
+
+    if (e.type != MetricType::Histogram) {
+      if (sample > 0) return 0;
+      char value[24];
+      if (e.counter) {
+        snprintf(value, sizeof(value), "%u", (unsigned)e.counter->value());
+      } else {
+        snprintf(value, sizeof(value), "%.10g", e.reader());
+      }
+      n = labels[0] ? snprintf(out, capacity, "%s{%s} %s\n", e.name, labels, value)
+                    : snprintf(out, capacity, "%s %s\n", e.name, value);
+    } else {
+      const MetricHistogram& h = *e.histogram;
+      uint8_t bounds = h.boundCount();
+      if (sample <= bounds) {
+        char le[24];
+        if (sample < bounds) {
+          formatSeconds(le, sizeof(le), h.bound(sample));
+        } else {
+          strcpy(le, "+Inf");
+        }
+        // Committed by write() only if the line fits; otherwise it is rendered again
+        nextCumulative_ = cumulative_ + h.bucket(sample);
+        n = snprintf(out, capacity, "%s_bucket{%s%sle=\"%s\"} %u\n", e.name, labels, comma, le,
+                     (unsigned)nextCumulative_);
+      } else if (sample == bounds + 1) {
+        char sum[24];
+        formatSeconds(sum, sizeof(sum), h.sumUs());
+        n = labels[0] ? snprintf(out, capacity, "%s_sum{%s} %s\n", e.name, labels, sum)
+                      : snprintf(out, capacity, "%s_sum %s\n", e.name, sum);
+      } else if (sample == bounds + 2) {
+        // The +Inf bucket total, so _count always matches it within one scrape
+        n = labels[0] ? snprintf(out, capacity, "%s_count{%s} %u\n", e.name, labels, (unsigned)cumulative_)
+                      : snprintf(out, capacity, "%s_count %u\n", e.name, (unsigned)cumulative_);
+      } else {
+        return 0;
+      }
+    }
+  }
+  return n > 0 ? (size_t)n : 0;
+}
+
+size_t MetricsExport::write(char* out, size_t capacity) {
+  if (!registry_) return 0;
+  size_t length = 0;
+  char line[192];
+
+  while (entry_ < registry_->size()) {
+    size_t n = formatLine(line, sizeof(line));
+    if (n == 0) {
+      entry_++;
+      line_ = 0;
+      cumulative_ = 0;
+      continue;
+    }
+    if (n >= sizeof(line)) {
+      // Cut to a whole line (overlong help text)
+      n = sizeof(line) - 1;
+      line[n - 1] = '\n';
+    }
+    // Stop at a line boundary; the connection buffer always holds at least one line
+    if (length + n > capacity) return length;
+    memcpy(out + length, line, n);
+    length += n;
+    cumulative_ = nextCumulative_;
+    line_++;
+  }
+  return length;
+}
+
+static MetricsExport scrapes[METRICS_MAX_SCRAPES];
+
+static size_t writeMetrics(char* out, size_t capacity, void* context) {
+  MetricsExport& scrape = *static_cast<MetricsExport*>(context);
+  size_t n = out ? scrape.write(out, capacity) : 0;
+  if (n == 0) scrape.end();  // complete, or the client went away
+  return n;
+}
+
+void handleMetricsRequest(HttpRequest& req, HttpResponse& res) {
+  if (req.method() != HttpMethod::Get) {
+    res.send(405, "application/json", "{\"error\":\"Method not allowed\"}");
+    return;
+  }
+  for (MetricsExport& scrape : scrapes) {
+    if (scrape.active()) continue;
+    scrape.begin(metrics);
+    res.sendChunked(200, "text/plain; version=0.0.4", writeMetrics, &scrape);
+    return;
+  }
+  res.send(503, "text/plain", "Too many scrapes\n");
+}
+
+// ===== Per-route latency =====
+// One histogram per distinct path (a path registered for several methods shares it) plus
+// one for requests no route took. Only the network task touches them.
+static HttpServer* httpServer = nullptr;
+static MetricHistogram routeLatency[HTTP_MAX_ROUTES + 1];
+static uint8_t routeSlot[HTTP_MAX_ROUTES];
+static uint8_t unmatchedSlot = 0;
+
+static void observeRoute(uint8_t route, uint32_t elapsedUs) {
+  routeLatency[route < HTTP_MAX_ROUTES ? routeSlot[route] : unmatchedSlot].observe(elapsedUs);
+}
+
+void attachHttpMetrics(HttpServer& server, MetricsRegistry& registry) {
+  static const char* LATENCY = "http_request_duration_seconds";
+  static const char* LATENCY_HELP = "Time from dispatch until the response is queued, per route";
+  httpServer = &server;
+
+  uint8_t slots = 0;
+  for (uint8_t i = 0; i < server.routeCount(); i++) {
+    const char* path = server.routePath(i);
+    uint8_t slot = slots;
+    for (uint8_t j = 0; j < i; j++) {
+      if (strcmp(server.routePath(j), path) == 0) slot = routeSlot[j];
+    }
+    routeSlot[i] = slot;
+    if (slot == slots) registry.histogram(LATENCY, LATENCY_HELP, routeLatency[slots++], "route", path);
+  }
+  unmatchedSlot = slots;
+  registry.histogram(LATENCY, LATENCY_HELP, routeLatency[unmatchedSlot], "route", "unmatched");
+  server.setRouteProbe(observeRoute);
+
+  registry.counter("http_requests_total", "HTTP requests served, WebSocket upgrades included",
+                   [] { return (double)httpServer->stats().requests; });
+  registry.counter("http_errors_total", "Malformed or oversized requests", [] { return (double)httpServer->stats().errors; });
+  registry.counter("http_rejected_total", "Connections refused because every slot was busy",
+                   [] { return (double)httpServer->stats().rejected; });
+  registry.gauge("http_connections", "Open connections", [] { return (double)httpServer->stats().active; });
+  registry.gauge("websocket_clients", "Connected WebSocket clients", [] { return (double)httpServer->wsClientCount(); });
+}
@@ -0,0 +1,47 @@
+// Prometheus text exposition of the metrics registry
+// Rendered line by line into whatever buffer the caller has (HttpServer's chunked
+// responses): a scrape needs one line of stack, however many metrics are registered.
+//
+//   GET /metrics  ->  scrape_configs: - targets: ['<ESP32_IP>:80']
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+class HttpRequest;
+class HttpResponse;
+class HttpServer;
+class MetricsRegistry;
+
+#ifndef METRICS_MAX_SCRAPES
+#define METRICS_MAX_SCRAPES 2
+#endif
+
+class MetricsExport {
+public:
+  void begin(const MetricsRegistry& registry);
+
+  // Next whole lines, at most `capacity` bytes; 0 once complete
+  size_t write(char* out, size_t capacity);
+
+  void end() { registry_ = nullptr; }
+  bool active() const { return registry_ != nullptr; }
+
+private:
+  // 0 once the entry has no more lines
+  size_t formatLine(char* out, size_t capacity);
+
+  const MetricsRegistry* registry_ = nullptr;
+  uint8_t entry_ = 0;
+  uint8_t line_ = 0;         // 0 HELP, 1 TYPE, then samples
+  uint32_t cumulative_ = 0;  // histogram buckets so far in this scrape
+  uint32_t nextCumulative_ = 0;
+};
+
+// GET handler for the global registry (503 while METRICS_MAX_SCRAPES scrapes are running)
+void handleMetricsRequest(HttpRequest& req, HttpResponse& res);
+
+// Handler time of every route of `server` as http_request_duration_seconds{route="..."},
+// plus the server's request / error counters. Call after the route table is set.
+void attachHttpMetrics(HttpServer& server, MetricsRegistry& registry);
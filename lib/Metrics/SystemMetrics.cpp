@@ -0,0 +1,37 @@
+// Board-level metrics shared by the sketches: heap, uptime and the WiFi link
+
+#include "SystemMetrics.h"
+
+#include <Arduino.h>
+#include <WiFi.h>
+
+#include "Metrics.h"
+
+static MetricCounter wifiDisconnects;
+static MetricCounter wifiReconnects;
+static bool wifiUp = false;
+static bool wifiEverUp = false;
+
+void pollWifiMetrics() {
+  bool up = WiFi.status() == WL_CONNECTED;
+  if (up == wifiUp) return;
+  wifiUp = up;
+  if (!up) {
+    wifiDisconnects.inc();
+  } else if (wifiEverUp) {
+    wifiReconnects.inc();
+  }
+  wifiEverUp = wifiEverUp || up;
+}
+
+void addSystemMetrics(MetricsRegistry& registry) {
+  registry.gauge("heap_free_bytes", "Free heap", [] { return (double)ESP.getFreeHeap(); });
+  registry.gauge("heap_free_min_bytes", "Lowest free heap since boot", [] { return (double)ESP.getMinFreeHeap(); });
+  registry.gauge("heap_largest_free_block_bytes", "Largest block malloc() can return now (fragmentation)",
+                 [] { return (double)ESP.getMaxAllocHeap(); });
+  registry.gauge("uptime_seconds", "Time since boot", [] { return millis() / 1000.0; });
+  registry.gauge("wifi_rssi_dbm", "Signal strength of the access point", [] { return (double)WiFi.RSSI(); });
+  registry.gauge("wifi_connected", "1 while associated with the access point", [] { return wifiUp ? 1.0 : 0.0; });
+  registry.counter("wifi_disconnects_total", "Link losses", wifiDisconnects);
+  registry.counter("wifi_reconnects_total", "Link restored after a loss", wifiReconnects);
+}
@@ -0,0 +1,12 @@
+// Board-level metrics shared by the sketches: heap, uptime and the WiFi link
+
+#pragma once
+
+class MetricsRegistry;
+
+// heap_free_bytes, heap_free_min_bytes, heap_largest_free_block_bytes, uptime_seconds,
+// wifi_rssi_dbm, wifi_connected, wifi_disconnects_total, wifi_reconnects_total
+void addSystemMetrics(MetricsRegistry& registry);
+
+// Network task, every pass: counts link drops and reconnects (one WiFi.status() read)
+void pollWifiMetrics();
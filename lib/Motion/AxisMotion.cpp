@@ -0,0 +1,52 @@
+// Axis motion engine
+
+#include "AxisMotion.h"
+
+void AxisMotion::reset(float position) {
+  moving_ = false;
+  position_ = position;
+  velocity_ = 0;
+}
+
+void AxisMotion::follow(float position, float velocity) {
+  moving_ = false;
+  position_ = position;
+  velocity_ = velocity;
+}
+
+void AxisMotion::moveTo(float target, const MotionLimits& limits, uint32_t nowMs) {
+  update(nowMs);
+  profile_.plan(position_, target, velocity_, limits);
+  startMs_ = nowMs;
+  moving_ = profile_.duration() > 0;
+  if (!moving_) reset(target);
+}
+
+void AxisMotion::stop(const MotionLimits& limits, uint32_t nowMs) {
+  update(nowMs);
+  if (!moving_ && velocity_ == 0) return;
+
+  // Target the point where a full-deceleration stop lands
+  const float a = limits.maxAcceleration;
+  const float stopDistance = a > 0 ? velocity_ * (velocity_ < 0 ? -velocity_ : velocity_) / (2 * a) : 0;
+  moveTo(position_ + stopDistance, limits, nowMs);
+}
+
+float AxisMotion::update(uint32_t nowMs) {
+  if (!moving_) return position_;
+
+  const float t = elapsed(nowMs);
+  if (t >= profile_.duration()) {
+    reset(profile_.target());
+  } else {
+    position_ = profile_.positionAt(t);
+    velocity_ = profile_.velocityAt(t);
+  }
+  return position_;
+}
+
+uint32_t AxisMotion::remainingMs(uint32_t nowMs) const {
+  if (!moving_) return 0;
+  const float left = profile_.duration() - elapsed(nowMs);
+  return left > 0 ? (uint32_t)(left * 1000.0f + 0.5f) : 0;
+}
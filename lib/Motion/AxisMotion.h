@@ -0,0 +1,44 @@
+// Axis motion engine
+// Holds the active profile and advances it from a millisecond clock (millis())
+
+#pragma once
+
+#include <stdint.h>
+
+#include "TrapezoidProfile.h"
+
+class AxisMotion {
+public:
+  // Hold still at `position`, cancelling any move
+  void reset(float position);
+
+  // Track a position driven by something else (a Trajectory). The axis is not moving on its
+  // own, but a following moveTo()/stop() starts from this velocity.
+  void follow(float position, float velocity);
+
+  // Start a move from wherever the axis is at `nowMs`, keeping its current velocity
+  void moveTo(float target, const MotionLimits& limits, uint32_t nowMs);
+
+  // Decelerate to rest with the given limits
+  void stop(const MotionLimits& limits, uint32_t nowMs);
+
+  // Advance to `nowMs`, returns the new position
+  float update(uint32_t nowMs);
+
+  bool isMoving() const { return moving_; }
+  float position() const { return position_; }
+  float velocity() const { return velocity_; }
+  float target() const { return moving_ ? profile_.target() : position_; }
+
+  // Remaining time of the active move, 0 when idle
+  uint32_t remainingMs(uint32_t nowMs) const;
+
+private:
+  float elapsed(uint32_t nowMs) const { return (uint32_t)(nowMs - startMs_) / 1000.0f; }
+
+  TrapezoidProfile profile_;
+  uint32_t startMs_ = 0;
+  bool moving_ = false;
+  float position_ = 0;
+  float velocity_ = 0;
+};
@@ -0,0 +1,51 @@
+// Coordinated multi-axis moves
+
+#include "CoordinatedMove.h"
+
+static MotionLimits scaled(const MotionLimits& limits, float s) {
+  return {limits.maxVelocity / s, limits.maxAcceleration / (s * s)};
+}
+
+static float plannedDuration(float from, float to, float startVelocity, const MotionLimits& limits) {
+  TrapezoidProfile profile;
+  profile.plan(from, to, startVelocity, limits);
+  return profile.duration();
+}
+
+float synchronizeLimits(const float* from, const float* to, const float* startVelocity,
+                        MotionLimits* limits, size_t count) {
+  float duration = 0;
+  for (size_t i = 0; i < count; i++) {
+    float t = plannedDuration(from[i], to[i], startVelocity[i], limits[i]);
+    if (t > duration) duration = t;
+  }
+  if (duration <= 0) return 0;
+
+  for (size_t i = 0; i < count; i++) {
+    float t = plannedDuration(from[i], to[i], startVelocity[i], limits[i]);
+    if (t <= 0 || t >= duration) continue;
+
+    // From rest the profile time-scales exactly
+    float s = duration / t;
+    if (startVelocity[i] != 0) {
+      // A start velocity does not scale with the limits: bisect on the scale factor instead
+      float low = 1;
+      float high = s;
+      while (plannedDuration(from[i], to[i], startVelocity[i], scaled(limits[i], high)) < duration && high < 1e3f) {
+        low = high;
+        high *= 2;
+      }
+      for (int iteration = 0; iteration < 24; iteration++) {
+        s = (low + high) / 2;
+        if (plannedDuration(from[i], to[i], startVelocity[i], scaled(limits[i], s)) < duration) {
+          low = s;
+        } else {
+          high = s;
+        }
+      }
+      s = low;
+    }
+    limits[i] = scaled(limits[i], s);
+  }
+  return duration;
+}
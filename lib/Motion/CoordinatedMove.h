@@ -0,0 +1,15 @@
+// Coordinated multi-axis moves
+// Axes with shorter moves are slowed down so that every axis starts and finishes together.
+
+#pragma once
+
+#include <stddef.h>
+
+#include "TrapezoidProfile.h"
+
+// Replace each axis' limits with time-scaled ones (velocity / s, acceleration / s^2) so its
+// trapezoid takes as long as the slowest axis. Exact for moves starting at rest; with a
+// non-zero start velocity the scale is found by bisection and durations match to ~1 ms.
+// Returns the common duration in seconds.
+float synchronizeLimits(const float* from, const float* to, const float* startVelocity,
+                        MotionLimits* limits, size_t count);
@@ -0,0 +1,315 @@
+// Recorded motion timeline
+
+#include "MotionTrack.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+static const uint8_t TAG_RUN = 0x80;
+static const uint8_t TAG_SMALL = 0x40;
+static const uint8_t TAG_VARINT = 0x00;
+static const uint8_t MAX_RUN = 128;
+
+static uint16_t get16(const uint8_t* p) {
+  return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static void put16(uint8_t* p, uint16_t value) {
+  p[0] = (uint8_t)value;
+  p[1] = (uint8_t)(value >> 8);
+}
+
+static uint32_t zigzag(int32_t value) {
+  return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static int32_t unzigzag(uint32_t value) {
+  return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+static size_t varintSize(uint32_t value) {
+  size_t size = 1;
+  while (value >= 0x80) {
+    value >>= 7;
+    size++;
+  }
+  return size;
+}
+
+static bool readVarint(const uint8_t* block, size_t used, size_t& pos, int32_t& value) {
+  uint32_t raw = 0;
+  for (uint8_t shift = 0; shift < 35; shift += 7) {
+    if (pos >= used) return false;
+    uint8_t byte = block[pos++];
+    raw |= (uint32_t)(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) {
+      value = unzigzag(raw);
+      return true;
+    }
+  }
+  return false;
+}
+
+MotionTrack::MotionTrack(uint8_t* storage, size_t size, uint8_t channels)
+    : storage_(storage),
+      blocks_((uint16_t)(size / MOTION_TRACK_BLOCK_SIZE < 0xFFFF ? size / MOTION_TRACK_BLOCK_SIZE : 0xFFFF)),
+      channels_(channels < 1 ? 1 : channels > MOTION_TRACK_MAX_CHANNELS ? MOTION_TRACK_MAX_CHANNELS : channels) {}
+
+uint8_t* MotionTrack::block(uint16_t ringIndex) const {
+  return storage_ + (size_t)((first_ + ringIndex) % blocks_) * MOTION_TRACK_BLOCK_SIZE;
+}
+
+void MotionTrack::clear() {
+  first_ = 0;
+  count_ = 0;
+  open_ = false;
+  hasDelta_ = false;
+  run_ = 0;
+  ticks_ = 0;
+  dropped_ = 0;
+  bytes_ = 0;
+  rewind();
+}
+
+void MotionTrack::add(const int16_t* angles) {
+  if (blocks_ == 0) return;
+  if (open_ && blockTicks_ == UINT16_MAX) {
+    flushRun();
+    closeBlock();
+  }
+  if (!open_) {
+    openBlock(angles);
+    return;
+  }
+
+  int32_t step[MOTION_TRACK_MAX_CHANNELS];
+  int32_t delta[MOTION_TRACK_MAX_CHANNELS];
+  bool repeated = hasDelta_;
+  for (uint8_t c = 0; c < channels_; c++) {
+    step[c] = (int32_t)angles[c] - last_[c];
+    delta[c] = step[c] - step_[c];
+    repeated = repeated && delta[c] == delta_[c];
+  }
+
+  if (repeated) {
+    memcpy(last_, angles, channels_ * sizeof(int16_t));
+    memcpy(step_, step, channels_ * sizeof(int32_t));
+    ticks_++;
+    blockTicks_++;
+    if (++run_ == MAX_RUN) {
+      flushRun();
+      if (used_ >= MOTION_TRACK_BLOCK_SIZE) closeBlock();  // no room left for another run
+    }
+    return;
+  }
+
+  flushRun();
+  size_t size = tokenSize(delta);
+  if (used_ + size + 1 > MOTION_TRACK_BLOCK_SIZE) {  // +1: a run may follow the token
+    closeBlock();
+    openBlock(angles);
+    return;
+  }
+  putToken(delta);
+  memcpy(last_, angles, channels_ * sizeof(int16_t));
+  memcpy(step_, step, channels_ * sizeof(int32_t));
+  memcpy(delta_, delta, channels_ * sizeof(int32_t));
+  hasDelta_ = true;
+  ticks_++;
+  blockTicks_++;
+}
+
+void MotionTrack::finish() {
+  if (open_) {
+    flushRun();
+    closeBlock();
+  }
+  if (first_ != 0) {
+    std::rotate(storage_, storage_ + (size_t)first_ * MOTION_TRACK_BLOCK_SIZE,
+                storage_ + (size_t)blocks_ * MOTION_TRACK_BLOCK_SIZE);
+    first_ = 0;
+  }
+  rewind();
+}
+
+// New block starting at `angles`; the oldest one makes room when the ring is full
+void MotionTrack::openBlock(const int16_t* angles) {
+  if (count_ == blocks_) {
+    const uint8_t* oldest = block(0);
+    uint16_t ticks = get16(oldest + 2);
+    dropped_ += ticks;
+    ticks_ -= ticks;
+    bytes_ -= get16(oldest);
+    first_ = (first_ + 1) % blocks_;
+    count_--;
+  }
+  count_++;
+
+  uint8_t* b = block(count_ - 1);
+  for (uint8_t c = 0; c < channels_; c++) put16(b + HEADER + c * sizeof(int16_t), (uint16_t)angles[c]);
+  memcpy(last_, angles, channels_ * sizeof(int16_t));
+  memset(step_, 0, sizeof(step_));
+  used_ = (uint16_t)startSize();
+  blockTicks_ = 1;
+  hasDelta_ = false;
+  run_ = 0;
+  open_ = true;
+  ticks_++;
+  bytes_ += used_;
+}
+
+void MotionTrack::closeBlock() {
+  if (!open_) return;
+  uint8_t* b = block(count_ - 1);
+  put16(b, used_);
+  put16(b + 2, blockTicks_);
+  open_ = false;
+}
+
+void MotionTrack::flushRun() {
+  if (run_ == 0) return;
+  block(count_ - 1)[used_++] = TAG_RUN | (uint8_t)(run_ - 1);
+  bytes_++;
+  run_ = 0;
+}
+
+size_t MotionTrack::tokenSize(const int32_t* delta) const {
+  int32_t limit = 1 << (6 / channels_ - 1);
+  bool small = true;
+  size_t size = 1;
+  for (uint8_t c = 0; c < channels_; c++) {
+    small = small && delta[c] >= -limit && delta[c] < limit;
+    size += varintSize(zigzag(delta[c]));
+  }
+  return small ? 1 : size;
+}
+
+void MotionTrack::putToken(const int32_t* delta) {
+  uint8_t* b = block(count_ - 1);
+  size_t start = used_;
+  if (tokenSize(delta) == 1) {
+    uint8_t bits = 6 / channels_;
+    uint8_t packed = 0;
+    for (uint8_t c = 0; c < channels_; c++) {
+      packed = (uint8_t)((packed << bits) | ((uint32_t)delta[c] & ((1u << bits) - 1)));
+    }
+    b[used_++] = TAG_SMALL | packed;
+  } else {
+    b[used_++] = TAG_VARINT;
+    for (uint8_t c = 0; c < channels_; c++) {
+      uint32_t value = zigzag(delta[c]);
+      while (value >= 0x80) {
+        b[used_++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+      }
+      b[used_++] = (uint8_t)value;
+    }
+  }
+  bytes_ += used_ - start;
+}
+
+void MotionTrack::rewind() {
+  readBlock_ = 0;
+  readPos_ = 0;
+  repeat_ = 0;
+  played_ = 0;
+}
+
+bool MotionTrack::next(int16_t* angles) {
+  if (repeat_ > 0) {
+    repeat_--;
+  } else {
+    for (;;) {
+      if (readBlock_ >= count_) return false;
+      const uint8_t* b = block(readBlock_);
+      size_t used = get16(b);
+
+      if (readPos_ == 0) {
+        for (uint8_t c = 0; c < channels_; c++) {
+          position_[c] = (int16_t)get16(b + HEADER + c * sizeof(int16_t));
+          readStep_[c] = 0;
+          readDelta_[c] = 0;
+        }
+        readPos_ = startSize();
+        memcpy(angles, position_, channels_ * sizeof(int16_t));
+        played_++;
+        return true;
+      }
+      if (readPos_ >= used) {
+        readBlock_++;
+        readPos_ = 0;
+        continue;
+      }
+
+      uint8_t tag = b[readPos_++];
+      if (tag & TAG_RUN) {
+        repeat_ = tag & (MAX_RUN - 1);
+      } else if (tag & TAG_SMALL) {
+        uint8_t bits = 6 / channels_;
+        for (uint8_t c = 0; c < channels_; c++) {
+          int32_t field = (tag >> ((channels_ - 1 - c) * bits)) & ((1 << bits) - 1);
+          readDelta_[c] = field >= (1 << (bits - 1)) ? field - (1 << bits) : field;
+        }
+      } else {
+        for (uint8_t c = 0; c < channels_; c++) {
+          if (!readVarint(b, used, readPos_, readDelta_[c])) {
+            readBlock_ = count_;  // damaged block: end of the track
+            return false;
+          }
+        }
+      }
+      break;
+    }
+  }
+
+  for (uint8_t c = 0; c < channels_; c++) {
+    readStep_[c] += readDelta_[c];
+    position_[c] = (int16_t)(position_[c] + readStep_[c]);
+  }
+  memcpy(angles, position_, channels_ * sizeof(int16_t));
+  played_++;
+  return true;
+}
+
+MotionTrackStats MotionTrack::stats() const {
+  return {ticks_, played_, dropped_, bytes_};
+}
+
+// Loaded blocks are walked once: every token must parse and add up to the block's tick count
+bool MotionTrack::restore(size_t size) {
+  clear();
+  if (size % MOTION_TRACK_BLOCK_SIZE != 0 || size / MOTION_TRACK_BLOCK_SIZE > blocks_) return false;
+
+  uint16_t count = (uint16_t)(size / MOTION_TRACK_BLOCK_SIZE);
+  uint32_t ticks = 0;
+  uint32_t bytes = 0;
+  for (uint16_t i = 0; i < count; i++) {
+    const uint8_t* b = storage_ + (size_t)i * MOTION_TRACK_BLOCK_SIZE;
+    size_t used = get16(b);
+    if (used < startSize() || used > MOTION_TRACK_BLOCK_SIZE) return false;
+
+    uint32_t blockTicks = 1;
+    size_t pos = startSize();
+    while (pos < used) {
+      uint8_t tag = b[pos++];
+      if (tag & TAG_RUN) {
+        blockTicks += (tag & (MAX_RUN - 1)) + 1u;
+      } else {
+        int32_t value;
+        for (uint8_t c = 0; !(tag & TAG_SMALL) && c < channels_; c++) {
+          if (!readVarint(b, used, pos, value)) return false;
+        }
+        blockTicks++;
+      }
+    }
+    if (blockTicks != get16(b + 2)) return false;
+    ticks += blockTicks;
+    bytes += used;
+  }
+
+  count_ = count;
+  ticks_ = ticks;
+  bytes_ = bytes;
+  return true;
+}
@@ -0,0 +1,112 @@
+// Recorded motion timeline
+// One sample per control tick: the commanded angle of every channel (1/100 degree). A sample
+// is stored as the change of the step from the previous tick (second difference), which is 0
+// while holding still or panning at constant speed and small while accelerating; repeated
+// changes become a run count. A hold costs one byte per 1.28 s at 10 ms ticks; continuous
+// two-axis stick movement about 3 KB per minute.
+//
+// The buffer is a ring of fixed-size blocks. Each block starts with absolute angles, so when
+// recording runs out of space the oldest block is dropped and playback starts at the next one.
+//
+// Block layout (little-endian): used bytes (u16), ticks (u16), start angles (i16 per channel),
+// then one token per tick (the step starts at 0 in every block):
+//   1rrrrrrr  the previous step change again, r + 1 times
+//   01xxxxxx  small step change, 6 / channels bits per channel (two's complement, channel 0 first)
+//   00000000  step change as one zigzag LEB128 varint per channel
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef MOTION_TRACK_BLOCK_SIZE
+#define MOTION_TRACK_BLOCK_SIZE 256
+#endif
+
+#define MOTION_TRACK_MAX_CHANNELS 3
+
+struct MotionTrackStats {
+  uint32_t ticks;    // samples held
+  uint32_t played;   // samples returned by next() since rewind()
+  uint32_t dropped;  // samples lost with the oldest blocks
+  uint32_t bytes;    // encoded size
+};
+
+class MotionTrack {
+public:
+  // `size` is rounded down to whole blocks; channels 1..MOTION_TRACK_MAX_CHANNELS
+  MotionTrack(uint8_t* storage, size_t size, uint8_t channels);
+
+  // Recording: clear(), add() once per tick, finish()
+  void clear();
+  void add(const int16_t* angles);
+  void finish();  // pending run written, blocks in order from the start of the storage
+
+  // Playback (after finish()): every recorded sample in order, false after the last one
+  void rewind();
+  bool next(int16_t* angles);
+
+  MotionTrackStats stats() const;
+  bool empty() const { return ticks_ == 0; }
+  uint8_t channels() const { return channels_; }
+  size_t capacity() const { return blocks_ * MOTION_TRACK_BLOCK_SIZE; }
+
+  // Persistence: after finish() the track is data()[0..dataSize()). To load one, copy that
+  // many bytes to storage() and call restore(); false (and an empty track) if they do not hold
+  // valid blocks.
+  const uint8_t* data() const { return storage_; }
+  size_t dataSize() const { return (size_t)count_ * MOTION_TRACK_BLOCK_SIZE; }
+  uint8_t* storage() { return storage_; }
+  bool restore(size_t size);
+
+private:
+  static const size_t HEADER = 4;
+
+  uint8_t* block(uint16_t ringIndex) const;
+  size_t startSize() const { return HEADER + channels_ * sizeof(int16_t); }
+  void openBlock(const int16_t* angles);
+  void closeBlock();
+  void flushRun();
+  size_t tokenSize(const int32_t* delta) const;
+  void putToken(const int32_t* delta);
+
+  uint8_t* storage_;
+  uint16_t blocks_;
+  uint8_t channels_;
+
+  // Ring of blocks, oldest first
+  uint16_t first_ = 0;
+  uint16_t count_ = 0;
+
+  // Recording: current block (the last one), last sample and step, the change being repeated
+  bool open_ = false;
+  uint16_t used_ = 0;
+  uint16_t blockTicks_ = 0;
+  int16_t last_[MOTION_TRACK_MAX_CHANNELS] = {};
+  int32_t step_[MOTION_TRACK_MAX_CHANNELS] = {};
+  int32_t delta_[MOTION_TRACK_MAX_CHANNELS] = {};
+  bool hasDelta_ = false;
+  uint8_t run_ = 0;
+
+  // Playback
+  uint16_t readBlock_ = 0;
+  size_t readPos_ = 0;
+  uint8_t repeat_ = 0;
+  int16_t position_[MOTION_TRACK_MAX_CHANNELS] = {};
+  int32_t readStep_[MOTION_TRACK_MAX_CHANNELS] = {};
+  int32_t readDelta_[MOTION_TRACK_MAX_CHANNELS] = {};
+
+  uint32_t ticks_ = 0;
+  uint32_t played_ = 0;
+  uint32_t dropped_ = 0;
+  uint32_t bytes_ = 0;
+};
+
+template <size_t N>
+class StaticMotionTrack : public MotionTrack {
+public:
+  explicit StaticMotionTrack(uint8_t channels) : MotionTrack(storage_, N, channels) {}
+
+private:
+  uint8_t storage_[N];
+};
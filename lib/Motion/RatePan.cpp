@@ -0,0 +1,44 @@
+// Rate-controlled pan axis
+
+#include "RatePan.h"
+
+#include <math.h>
+
+float stickToRate(float deflection, const PanResponse& response) {
+  float x = fmaxf(-1.0f, fminf(1.0f, deflection));
+  float expo = fmaxf(0.0f, fminf(1.0f, response.expo));
+  return response.maxRate * ((1 - expo) * x + expo * x * x * x);
+}
+
+void RatePan::reset(float position) {
+  position_ = fmaxf(min_, fminf(max_, position));
+  velocity_ = 0;
+}
+
+float RatePan::update(float targetRate, float maxAccel, float dt) {
+  if (dt <= 0) return position_;
+
+  // Never faster than what still stops at the limit ahead: v^2 = 2 a d
+  if (maxAccel > 0) {
+    float room = targetRate > 0 ? max_ - position_ : position_ - min_;
+    float stopRate = sqrtf(2 * maxAccel * fmaxf(0.0f, room));
+    if (fabsf(targetRate) > stopRate) targetRate = copysignf(stopRate, targetRate);
+
+    float maxStep = maxAccel * dt;
+    float step = targetRate - velocity_;
+    if (step > maxStep) step = maxStep;
+    if (step < -maxStep) step = -maxStep;
+    float next = velocity_ + step;
+    position_ += (velocity_ + next) / 2 * dt;  // trapezoidal integration
+    velocity_ = next;
+  } else {
+    velocity_ = targetRate;
+    position_ += velocity_ * dt;
+  }
+
+  if (position_ <= min_ || position_ >= max_) {
+    position_ = fmaxf(min_, fminf(max_, position_));
+    velocity_ = 0;
+  }
+  return position_;
+}
@@ -0,0 +1,35 @@
+// Rate-controlled pan axis
+// Turns a velocity command (joystick deflection or a streamed rate) into a position by
+// integrating over real elapsed time. Velocity changes are acceleration-limited and the axis
+// brakes early enough to come to rest exactly at its travel limits.
+
+#pragma once
+
+struct PanResponse {
+  float maxRate;   // deg/s at full deflection
+  float expo;      // 0 = linear, 1 = cubic: fine control around center
+  float maxAccel;  // deg/s^2
+};
+
+// Deflection -1..1 -> deg/s: maxRate * ((1 - expo) * x + expo * x^3)
+float stickToRate(float deflection, const PanResponse& response);
+
+class RatePan {
+public:
+  RatePan(float minAngle, float maxAngle) : min_(minAngle), max_(maxAngle) {}
+
+  // Hold at `position` with zero velocity
+  void reset(float position);
+
+  // Advance by dt seconds towards `targetRate`, returns the new position
+  float update(float targetRate, float maxAccel, float dt);
+
+  float position() const { return position_; }
+  float velocity() const { return velocity_; }
+
+private:
+  float min_;
+  float max_;
+  float position_ = 0;
+  float velocity_ = 0;
+};
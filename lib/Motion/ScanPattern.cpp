@@ -0,0 +1,264 @@
+// Scan patterns precomputed into motion tables
+
+#include "ScanPattern.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char* SHAPE_NAMES[] = {"sine", "raster", "tour"};
+static const uint8_t SHAPE_COUNT = sizeof(SHAPE_NAMES) / sizeof(SHAPE_NAMES[0]);
+
+const char* scanShapeName(uint8_t shape) {
+  return shape < SHAPE_COUNT ? SHAPE_NAMES[shape] : "unknown";
+}
+
+bool scanShapeFromName(const char* name, uint8_t* shape) {
+  for (uint8_t i = 0; i < SHAPE_COUNT; i++) {
+    if (strcmp(name, SHAPE_NAMES[i]) == 0) {
+      *shape = i;
+      return true;
+    }
+  }
+  return false;
+}
+
+namespace {
+
+// Raster: line end, dwell and row step per row, plus the start, the way back and its dwell
+const uint8_t MAX_KEYS = 3 * SCAN_MAX_ROWS + 2;
+
+// One period as keyframes (degrees, ms from the start of the period)
+struct Path {
+  uint8_t axes;
+  uint8_t count = 0;
+  float timeMs[MAX_KEYS] = {};
+  float angles[MAX_KEYS][SCAN_MAX_AXES] = {};
+  bool smooth[MAX_KEYS] = {};  // segment ending at this key: cosine ease in/out, otherwise linear
+
+  explicit Path(uint8_t axes) : axes(axes) {}
+
+  void add(float ms, const float* to, bool ease) {
+    if (count == MAX_KEYS) return;
+    timeMs[count] = count ? timeMs[count - 1] + ms : 0;
+    memcpy(angles[count], to, axes * sizeof(float));
+    smooth[count] = ease;
+    count++;
+  }
+
+  // The axis with the longest way moves at `speed` (peak speed of an eased segment)
+  void moveTo(const float* to, float speed, bool ease) {
+    float distance = 0;
+    for (uint8_t a = 0; a < axes; a++) distance = fmaxf(distance, fabsf(to[a] - angles[count - 1][a]));
+    float ms = distance / speed * 1000.0f * (ease ? (float)M_PI / 2 : 1.0f);
+    if (ms > 0) add(ms, to, ease);
+  }
+
+  void hold(float ms) {
+    if (ms > 0) add(ms, angles[count - 1], false);
+  }
+
+  float at(uint8_t key, uint8_t axis, float t) const {
+    float u = (t - timeMs[key - 1]) / (timeMs[key] - timeMs[key - 1]);
+    if (smooth[key]) u = (1 - cosf((float)M_PI * u)) / 2;
+    return angles[key - 1][axis] + (angles[key][axis] - angles[key - 1][axis]) * u;
+  }
+};
+
+bool rangesValid(const ScanPattern& pattern, uint8_t axes) {
+  for (uint8_t a = 0; a < axes; a++) {
+    if (pattern.min[a] > pattern.max[a]) return false;
+  }
+  return true;
+}
+
+bool speedValid(float speed) {
+  return isfinite(speed) && speed >= 1.0f;
+}
+
+void buildRaster(const ScanPattern& pattern, Path& path) {
+  float start[SCAN_MAX_AXES];
+  for (uint8_t a = 0; a < path.axes; a++) start[a] = pattern.min[a] / (float)ANGLE_SCALE;
+  path.add(0, start, false);
+
+  float span = (pattern.max[1] - pattern.min[1]) / (float)ANGLE_SCALE;
+  float point[SCAN_MAX_AXES];
+  for (uint8_t row = 0; row < pattern.rows; row++) {
+    point[0] = (row % 2 ? pattern.min[0] : pattern.max[0]) / (float)ANGLE_SCALE;
+    if (path.axes > 1) point[1] = start[1] + (pattern.rows > 1 ? span * row / (pattern.rows - 1) : 0);
+    path.moveTo(point, pattern.speed, false);
+    path.hold(pattern.dwellMs);
+    if (row + 1 < pattern.rows && path.axes > 1) {
+      point[1] = start[1] + span * (row + 1) / (pattern.rows - 1);
+      path.moveTo(point, pattern.speed, true);
+    }
+  }
+  // One row: the sweep back is a line too; otherwise a glide back to the first row
+  path.moveTo(start, pattern.speed, pattern.rows > 1 && path.axes > 1);
+  path.hold(pattern.dwellMs);
+}
+
+void buildTour(const ScanPattern& pattern, Path& path) {
+  float point[SCAN_MAX_AXES];
+  for (uint8_t i = 0; i <= pattern.stopCount; i++) {
+    const ScanStop& stop = pattern.stops[i % pattern.stopCount];
+    for (uint8_t a = 0; a < path.axes; a++) point[a] = stop.angles[a] / (float)ANGLE_SCALE;
+    if (i == 0) {
+      path.add(0, point, false);
+    } else {
+      path.moveTo(point, pattern.speed, true);
+    }
+    if (i < pattern.stopCount) path.hold(stop.dwellMs);
+  }
+}
+
+// Keyframes (raster, tour) and period; 0 if the pattern is invalid
+uint32_t plan(const ScanPattern& pattern, Path& path) {
+  if (path.axes < 1 || path.axes > SCAN_MAX_AXES) return 0;
+
+  uint32_t periodMs;
+  switch (pattern.shape) {
+    case SCAN_SINE:
+      if (!rangesValid(pattern, path.axes)) return 0;
+      periodMs = pattern.periodMs;
+      break;
+    case SCAN_RASTER:
+      if (!rangesValid(pattern, path.axes) || !speedValid(pattern.speed)) return 0;
+      if (pattern.rows < 1 || pattern.rows > SCAN_MAX_ROWS) return 0;
+      buildRaster(pattern, path);
+      periodMs = (uint32_t)lroundf(path.timeMs[path.count - 1]);
+      break;
+    case SCAN_TOUR:
+      if (!speedValid(pattern.speed) || pattern.stopCount < 1 || pattern.stopCount > SCAN_MAX_STOPS) return 0;
+      buildTour(pattern, path);
+      periodMs = (uint32_t)lroundf(path.timeMs[path.count - 1]);
+      break;
+    default:
+      return 0;
+  }
+  return periodMs < 100 ? 0 : periodMs;
+}
+
+}  // namespace
+
+uint32_t scanPeriodMs(const ScanPattern& pattern, uint8_t axes) {
+  Path path(axes);
+  return plan(pattern, path);
+}
+
+bool ScanTable::build(const ScanPattern& pattern, uint8_t axes) {
+  Path path(axes);
+  uint32_t periodMs = plan(pattern, path);
+  if (periodMs == 0) return false;
+
+  // Sample the period; keys are visited in order, so this is one pass over both
+  uint8_t key = 1;
+  for (uint32_t i = 0; i < SCAN_TABLE_SIZE; i++) {
+    float t = (float)i * periodMs / SCAN_TABLE_SIZE;
+    for (uint8_t a = 0; a < axes; a++) {
+      float angle;
+      if (pattern.shape == SCAN_SINE) {
+        float mid = (pattern.min[a] + pattern.max[a]) / 2.0f;
+        float amplitude = (pattern.max[a] - pattern.min[a]) / 2.0f;
+        angle = (mid - amplitude * cosf(2 * (float)M_PI * i / SCAN_TABLE_SIZE)) / ANGLE_SCALE;
+      } else {
+        while (key + 1 < path.count && path.timeMs[key] <= t) key++;
+        angle = path.at(key, a, t);
+      }
+      table_[i][a] = (int16_t)lroundf(angle * ANGLE_SCALE);
+    }
+  }
+
+  axes_ = axes;
+  periodMs_ = periodMs;
+  phasePerMs_ = (PHASE_END + periodMs - 1) / periodMs;  // rounded up: a whole period is never short
+  phase_ = 0;
+  indexSteps();
+  return true;
+}
+
+// Step i runs from sample i to i + 1 (the last one back to sample 0). Level 0 holds the
+// steepest step of each block, level k the steeper of two level k - 1 runs side by side.
+void ScanTable::indexSteps() {
+  for (uint32_t b = 0; b < STEP_BLOCKS; b++) {
+    for (uint8_t a = 0; a < axes_; a++) {
+      uint16_t steepest = 0;
+      for (uint32_t i = b * SCAN_STEP_BLOCK; i < (b + 1) * SCAN_STEP_BLOCK; i++) {
+        uint32_t next = (i + 1) & (SCAN_TABLE_SIZE - 1);
+        uint16_t step = (uint16_t)abs(table_[next][a] - table_[i][a]);
+        if (step > steepest) steepest = step;
+      }
+      steepest_[0][b][a] = steepest;
+    }
+  }
+  for (uint8_t k = 1; k < STEP_LEVELS; k++) {
+    for (uint32_t b = 0; b < STEP_BLOCKS; b++) {
+      uint32_t half = (b + (1u << (k - 1))) & (STEP_BLOCKS - 1);
+      for (uint8_t a = 0; a < axes_; a++) {
+        uint16_t left = steepest_[k - 1][b][a];
+        uint16_t right = steepest_[k - 1][half][a];
+        steepest_[k][b][a] = left > right ? left : right;
+      }
+    }
+  }
+}
+
+uint32_t ScanTable::advance(uint32_t elapsedMs, uint16_t ratePercent) {
+  rate_ = ratePercent;
+  uint64_t phase = phase_ + (uint64_t)elapsedMs * phasePerMs_ * ratePercent / 100;
+  phase_ = phase % PHASE_END;
+  return (uint32_t)(phase / PHASE_END);
+}
+
+void ScanTable::sample(int16_t* angles) const {
+  uint32_t index = (uint32_t)(phase_ >> PHASE_BITS);
+  uint32_t next = (index + 1) & (SCAN_TABLE_SIZE - 1);
+  int32_t fraction = (int32_t)(phase_ >> (PHASE_BITS - 16)) & 0xFFFF;
+  for (uint8_t a = 0; a < axes_; a++) {
+    int32_t from = table_[index][a];
+    angles[a] = (int16_t)(from + (((table_[next][a] - from) * fraction) >> 16));
+  }
+}
+
+void ScanTable::start(int16_t* angles) const {
+  memcpy(angles, table_[0], axes_ * sizeof(int16_t));
+}
+
+float ScanTable::velocity(uint8_t axis) const {
+  if (!periodMs_ || axis >= axes_) return 0;
+  uint32_t index = (uint32_t)(phase_ >> PHASE_BITS);
+  uint32_t next = (index + 1) & (SCAN_TABLE_SIZE - 1);
+  float sampleS = periodMs_ / 1000.0f / SCAN_TABLE_SIZE;
+  return (table_[next][axis] - table_[index][axis]) / (float)ANGLE_SCALE / sampleS * rate_ / 100.0f;
+}
+
+uint16_t ScanTable::limitRate(uint32_t elapsedMs, uint16_t ratePercent, const float* maxSpeed) const {
+  if (!periodMs_ || !ratePercent) return ratePercent;
+
+  // The step the phase is in and every one the advance would pass, as whole blocks
+  uint64_t span = ((uint64_t)elapsedMs * phasePerMs_ * ratePercent / 100) >> PHASE_BITS;
+  uint32_t samples = span < SCAN_TABLE_SIZE ? (uint32_t)span + 1 : SCAN_TABLE_SIZE;
+  uint32_t index = (uint32_t)(phase_ >> PHASE_BITS);
+  uint32_t first = index / SCAN_STEP_BLOCK;
+  uint32_t blocks = (index + samples - 1) / SCAN_STEP_BLOCK - first + 1;
+  if (blocks > STEP_BLOCKS) blocks = STEP_BLOCKS;
+
+  // Two runs of 2^level blocks, one from each end, cover them exactly
+  uint8_t level = 0;
+  while ((2u << level) <= blocks) level++;
+  uint32_t last = (first + blocks - (1u << level)) & (STEP_BLOCKS - 1);
+  int32_t steepest[SCAN_MAX_AXES] = {};
+  for (uint8_t a = 0; a < axes_; a++) {
+    uint16_t left = steepest_[level][first][a];
+    uint16_t right = steepest_[level][last][a];
+    steepest[a] = left > right ? left : right;
+  }
+
+  float sampleS = periodMs_ / 1000.0f / SCAN_TABLE_SIZE;
+  uint16_t rate = ratePercent;
+  for (uint8_t a = 0; a < axes_; a++) {
+    float speed = steepest[a] / (float)ANGLE_SCALE / sampleS;  // deg/s at 100 %
+    if (speed * rate / 100.0f > maxSpeed[a]) rate = (uint16_t)(maxSpeed[a] * 100.0f / speed);
+  }
+  return rate > 0 ? rate : 1;
+}
@@ -0,0 +1,124 @@
+// Scan patterns precomputed into motion tables
+// A pattern describes one period of a repeating scan for one or two axes:
+//
+//   Sine    every axis oscillates between its min and max (min == max holds it), starting at min
+//   Raster  axis 0 sweeps min -> max at constant speed, pauses (dwell), axis 1 steps to the
+//           next row, sweeps back, ...; after the last row it returns to the first
+//   Tour    glide from stop to stop at up to `speed` and wait `dwellMs` at each, then back to
+//           the first stop
+//
+// ScanTable::build() evaluates the period once (float math) into SCAN_TABLE_SIZE equally
+// spaced fixed-point samples. A control tick then only advances a phase accumulator and
+// interpolates between two neighbouring samples; the scan rate scales the phase step, so
+// speeding up or slowing down never rebuilds the table. build() also indexes the steepest
+// step of every block of SCAN_STEP_BLOCK samples and of every run of 2^k blocks, so the
+// rate limit finds the steepest step of any stretch of the period with two lookups.
+
+#pragma once
+
+#include <stdint.h>
+
+#include "ServoCalibration.h"  // ANGLE_SCALE
+
+#ifndef SCAN_TABLE_SIZE
+#define SCAN_TABLE_SIZE 512  // power of two
+#endif
+
+#ifndef SCAN_STEP_BLOCK
+#define SCAN_STEP_BLOCK 16  // samples per block of the steepest-step index, power of two
+#endif
+
+#define SCAN_MAX_AXES 2
+#define SCAN_MAX_ROWS 10
+#define SCAN_MAX_STOPS 8
+
+enum ScanShape : uint8_t {
+  SCAN_SINE,
+  SCAN_RASTER,
+  SCAN_TOUR
+};
+
+struct ScanStop {
+  int16_t angles[SCAN_MAX_AXES];  // 1/100 degree
+  uint16_t dwellMs;
+};
+
+// Trivially copyable without padding: published through StateSnapshot, persisted bytewise
+struct ScanPattern {
+  uint8_t shape;       // ScanShape
+  uint8_t rows;        // Raster: lines, spread over axis 1's range
+  uint8_t stopCount;   // Tour
+  uint8_t reserved;
+  uint16_t periodMs;   // Sine: one full back-and-forth
+  uint16_t dwellMs;    // Raster: pause at each line end
+  float speed;         // Raster, Tour: deg/s
+  int16_t min[SCAN_MAX_AXES];  // Sine, Raster: 1/100 degree
+  int16_t max[SCAN_MAX_AXES];
+  ScanStop stops[SCAN_MAX_STOPS];
+};
+
+const char* scanShapeName(uint8_t shape);
+bool scanShapeFromName(const char* name, uint8_t* shape);
+
+// Length of one period for the first `axes` axes, 0 if the pattern cannot be built. Cheap
+// enough to validate a pattern before handing it to the task that owns the table.
+uint32_t scanPeriodMs(const ScanPattern& pattern, uint8_t axes);
+
+// Levels of the steepest-step index over `blocks` blocks: runs of 1, 2, 4 ... blocks
+constexpr uint8_t scanStepLevels(uint32_t blocks) {
+  return blocks > 1 ? 1 + scanStepLevels(blocks / 2) : 1;
+}
+
+class ScanTable {
+public:
+  // Precompute `pattern` for the first `axes` axes. False (table unchanged) if the pattern is
+  // out of range or its period is shorter than 100 ms.
+  bool build(const ScanPattern& pattern, uint8_t axes);
+
+  // Back to the start of the period
+  void restart() { phase_ = 0; }
+
+  // Advance by `elapsedMs` at `ratePercent` of the pattern's own timing; returns how many
+  // periods were completed on the way (usually 0)
+  uint32_t advance(uint32_t elapsedMs, uint16_t ratePercent);
+
+  // Angles (1/100 degree) at the current phase
+  void sample(int16_t* angles) const;
+
+  // Where the period starts (and ends)
+  void start(int16_t* angles) const;
+
+  // Rate of change of one axis at the current phase, deg/s at the last advance() rate
+  float velocity(uint8_t axis) const;
+
+  // `ratePercent`, or less where the next advance(elapsedMs) would ask an axis to move faster
+  // than its maxSpeed (deg/s, e.g. the servo's slew rate): the steepest table step in the
+  // blocks the step passes through decides, so the limit may set in up to a block early.
+  // Constant time however far the step goes. At least 1 %, so the scan never stalls.
+  uint16_t limitRate(uint32_t elapsedMs, uint16_t ratePercent, const float* maxSpeed) const;
+
+  uint32_t periodMs() const { return periodMs_; }
+  float progress() const { return phase_ / (float)PHASE_END; }  // 0..1 within the period
+  bool built() const { return periodMs_ > 0; }
+
+private:
+  // Phase: table index with a 24-bit fraction, so rounding does not drift over long scans
+  static const uint8_t PHASE_BITS = 24;
+  static const uint64_t PHASE_END = (uint64_t)SCAN_TABLE_SIZE << PHASE_BITS;
+
+  static const uint32_t STEP_BLOCKS = SCAN_TABLE_SIZE / SCAN_STEP_BLOCK;
+  static const uint8_t STEP_LEVELS = scanStepLevels(STEP_BLOCKS);
+  static_assert(STEP_BLOCKS >= 1 && (STEP_BLOCKS & (STEP_BLOCKS - 1)) == 0,
+                "SCAN_STEP_BLOCK must be a power of two no larger than SCAN_TABLE_SIZE");
+
+  void indexSteps();
+
+  int16_t table_[SCAN_TABLE_SIZE][SCAN_MAX_AXES] = {};
+  // Largest |step| (1/100 degree) from block b over 2^k blocks, wrapping around the period
+  uint16_t steepest_[STEP_LEVELS][STEP_BLOCKS][SCAN_MAX_AXES] = {};
+  uint8_t axes_ = 0;
+  uint32_t periodMs_ = 0;
+  uint64_t phasePerMs_ = 0;  // at 100 %
+  uint64_t phase_ = 0;
+  uint16_t rate_ = 100;
+};
@@ -0,0 +1,101 @@
+// Waypoint trajectory
+
+#include "Trajectory.h"
+
+#include <math.h>
+
+uint32_t Trajectory::segmentMs(const Waypoint& waypoint, float from) {
+  if (waypoint.durationMs > 0) return waypoint.durationMs;
+  if (waypoint.velocity <= 0) return 1;
+  uint32_t ms = (uint32_t)lroundf(fabsf(waypoint.angle - from) / waypoint.velocity * 1000.0f);
+  return ms > 0 ? ms : 1;
+}
+
+// Waypoint velocity from the slopes on both sides (deg/s).
+// Same-sign slopes average; limiting to 3x the smaller slope keeps both adjacent
+// Hermite segments monotone (Fritsch-Carlson), a reversal stops at the waypoint.
+static float blendVelocity(float slopeIn, float slopeOut) {
+  if (slopeIn * slopeOut <= 0) return 0;
+  float v = (slopeIn + slopeOut) / 2;
+  float limit = 3 * fminf(fabsf(slopeIn), fabsf(slopeOut));
+  return fabsf(v) > limit ? copysignf(limit, v) : v;
+}
+
+void Trajectory::start(float position, float velocity, uint32_t nowMs) {
+  position_ = position;
+  velocity_ = velocity;
+  startMs_ = nowMs;
+  durationMs_ = 0;
+  pending_ = 0;
+  reached_ = 0;
+  segment_ = false;
+  active_ = true;
+}
+
+void Trajectory::cancel() {
+  active_ = false;
+  segment_ = false;
+  pending_ = 0;
+  velocity_ = 0;
+}
+
+void Trajectory::push(const Waypoint& waypoint) {
+  if (pending_ >= LOOKAHEAD) return;
+  lookahead_[pending_++] = waypoint;
+}
+
+void Trajectory::beginSegment() {
+  const Waypoint wp = lookahead_[0];
+  for (uint8_t i = 1; i < pending_; i++) lookahead_[i - 1] = lookahead_[i];
+  pending_--;
+
+  from_ = position_;
+  to_ = wp.angle;
+  v0_ = velocity_;
+  durationMs_ = segmentMs(wp, from_);
+
+  // End velocity needs the waypoint after this one; without it we arrive at rest
+  v1_ = 0;
+  if (pending_ > 0) {
+    const Waypoint& next = lookahead_[0];
+    float slopeIn = (to_ - from_) * 1000.0f / durationMs_;
+    float slopeOut = (next.angle - to_) * 1000.0f / segmentMs(next, to_);
+    v1_ = blendVelocity(slopeIn, slopeOut);
+  }
+  segment_ = true;
+}
+
+float Trajectory::update(uint32_t nowMs) {
+  while (active_) {
+    if (!segment_) {
+      if (pending_ == 0) {
+        // Out of waypoints: the last segment ended at rest
+        active_ = false;
+        velocity_ = 0;
+        break;
+      }
+      beginSegment();
+    }
+
+    uint32_t elapsed = nowMs - startMs_;
+    if ((int32_t)elapsed < 0) elapsed = 0;  // segment starts in the future (never in practice)
+    if (elapsed < durationMs_) {
+      const float T = durationMs_ / 1000.0f;
+      const float s = (float)elapsed / durationMs_;
+      const float s2 = s * s;
+      const float s3 = s2 * s;
+      const float dp = to_ - from_;
+      position_ = from_ + (3 * s2 - 2 * s3) * dp + (s3 - 2 * s2 + s) * T * v0_ + (s3 - s2) * T * v1_;
+      velocity_ = (6 * s - 6 * s2) * dp / T + (3 * s2 - 4 * s + 1) * v0_ + (3 * s2 - 2 * s) * v1_;
+      break;
+    }
+
+    // Segment done: the next one starts where this one ended, not at `nowMs`
+    position_ = to_;
+    velocity_ = v1_;
+    startMs_ += durationMs_;
+    segment_ = false;
+    reached_++;
+  }
+  return position_;
+}
@@ -0,0 +1,66 @@
+// Waypoint trajectory
+// Plays a stream of waypoints as cubic Hermite segments. Velocity at each interior waypoint
+// is blended from the neighbouring segment slopes (zero where the direction reverses, and
+// limited so a segment never overshoots its endpoints), so the axis flows through waypoints
+// instead of stopping at each one. The last known waypoint is reached at rest.
+//
+// Segment start times are accumulated in whole milliseconds from the trajectory start, not
+// from the tick that noticed the previous segment ended, so long paths do not drift.
+
+#pragma once
+
+#include <stdint.h>
+
+struct Waypoint {
+  float angle;          // deg
+  uint32_t durationMs;  // time from the previous waypoint; 0 = derive from velocity
+  float velocity;       // deg/s average speed, used when durationMs is 0
+};
+
+class Trajectory {
+public:
+  // Waypoints held ahead of the running segment (target + the one after, for blending)
+  static const uint8_t LOOKAHEAD = 2;
+
+  // Begin from the axis' current state; waypoints follow through push()
+  void start(float position, float velocity, uint32_t nowMs);
+
+  // Abandon the path, holding the current position
+  void cancel();
+
+  bool lookaheadFull() const { return pending_ >= LOOKAHEAD; }
+  void push(const Waypoint& waypoint);
+
+  // Advance to `nowMs`, returns the new position. Goes inactive at the last waypoint.
+  float update(uint32_t nowMs);
+
+  bool active() const { return active_; }
+  float position() const { return position_; }
+  float velocity() const { return velocity_; }
+  float target() const { return segment_ ? to_ : position_; }
+  uint32_t reached() const { return reached_; }  // waypoints reached since start()
+  uint8_t pending() const { return pending_; }
+
+  // Duration a waypoint gets when entered from `from`
+  static uint32_t segmentMs(const Waypoint& waypoint, float from);
+
+private:
+  void beginSegment();
+
+  Waypoint lookahead_[LOOKAHEAD];
+  uint8_t pending_ = 0;
+  bool active_ = false;
+  bool segment_ = false;
+  uint32_t reached_ = 0;
+
+  // Running segment: Hermite from (from_, v0_) to (to_, v1_) over durationMs_
+  uint32_t startMs_ = 0;
+  uint32_t durationMs_ = 0;
+  float from_ = 0;
+  float to_ = 0;
+  float v0_ = 0;
+  float v1_ = 0;
+
+  float position_ = 0;
+  float velocity_ = 0;
+};
@@ -0,0 +1,83 @@
+// Trapezoidal velocity profile
+
+#include "TrapezoidProfile.h"
+
+#include <math.h>
+
+void TrapezoidProfile::plan(float from, float to, float startVelocity, const MotionLimits& limits) {
+  from_ = from;
+  to_ = to;
+  t1_ = t2_ = t3_ = 0;
+  d1_ = d2_ = 0;
+  u0_ = acc1_ = vp_ = 0;
+  dir_ = 1;
+
+  const float a = limits.maxAcceleration;
+  const float vmax = limits.maxVelocity;
+  if (a <= 0 || vmax <= 0) return;  // No limits - jump straight to the target
+
+  // Direction is taken relative to where we would stop, not where we start:
+  // if we are too fast to stop before the target, we overshoot and come back
+  const float distance = to - from;
+  const float stopDistance = startVelocity * fabsf(startVelocity) / (2 * a);
+  if (distance == 0 && startVelocity == 0) return;
+
+  dir_ = (distance - stopDistance) >= 0 ? 1.0f : -1.0f;
+  const float d = distance * dir_;
+  u0_ = startVelocity * dir_;
+  decel_ = a;
+
+  // Triangular profile: peak velocity that covers exactly the distance
+  const float peakSq = a * d + u0_ * u0_ / 2;
+  const float peak = peakSq > 0 ? sqrtf(peakSq) : 0;
+
+  if (peak <= vmax) {
+    vp_ = peak;
+    acc1_ = a;
+    t1_ = (vp_ - u0_) / a;
+    t3_ = vp_ / a;
+  } else {
+    vp_ = vmax;
+    acc1_ = u0_ <= vmax ? a : -a;
+    t1_ = (vmax - u0_) / acc1_;
+    t3_ = vmax / a;
+    const float accelDistance = (vmax * vmax - u0_ * u0_) / (2 * acc1_);
+    const float decelDistance = vmax * vmax / (2 * a);
+    const float cruise = d - accelDistance - decelDistance;
+    t2_ = cruise > 0 ? cruise / vmax : 0;
+  }
+
+  if (t1_ < 0) t1_ = 0;
+  d1_ = u0_ * t1_ + acc1_ * t1_ * t1_ / 2;
+  d2_ = vp_ * t2_;
+}
+
+float TrapezoidProfile::positionAt(float t) const {
+  if (t >= duration()) return to_;
+  if (t <= 0) return from_;
+
+  float s;
+  if (t < t1_) {
+    s = u0_ * t + acc1_ * t * t / 2;
+  } else if (t < t1_ + t2_) {
+    s = d1_ + vp_ * (t - t1_);
+  } else {
+    const float td = t - t1_ - t2_;
+    s = d1_ + d2_ + vp_ * td - decel_ * td * td / 2;
+  }
+  return from_ + dir_ * s;
+}
+
+float TrapezoidProfile::velocityAt(float t) const {
+  if (t < 0 || t >= duration()) return 0;
+
+  float v;
+  if (t < t1_) {
+    v = u0_ + acc1_ * t;
+  } else if (t < t1_ + t2_) {
+    v = vp_;
+  } else {
+    v = vp_ - decel_ * (t - t1_ - t2_);
+  }
+  return dir_ * v;
+}
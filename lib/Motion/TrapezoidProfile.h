@@ -0,0 +1,35 @@
+// Trapezoidal velocity profile
+// Hardware-independent trajectory math: position is a pure function of elapsed time
+
+#pragma once
+
+// Motion limits for one axis (degrees, seconds)
+struct MotionLimits {
+  float maxVelocity;      // deg/s
+  float maxAcceleration;  // deg/s^2
+};
+
+// Accelerate -> cruise -> decelerate from `from` to `to`.
+// The start velocity may be non-zero (retargeting mid-move), the move always ends at rest.
+class TrapezoidProfile {
+public:
+  void plan(float from, float to, float startVelocity, const MotionLimits& limits);
+
+  float positionAt(float t) const;
+  float velocityAt(float t) const;
+
+  float duration() const { return t1_ + t2_ + t3_; }
+  float from() const { return from_; }
+  float target() const { return to_; }
+
+private:
+  float from_ = 0;
+  float to_ = 0;
+  float dir_ = 1;     // +1 / -1, all phase values below are along dir_
+  float u0_ = 0;      // start velocity
+  float acc1_ = 0;    // phase 1 acceleration (negative when entering above maxVelocity)
+  float vp_ = 0;      // cruise (peak) velocity
+  float decel_ = 0;   // phase 3 deceleration magnitude
+  float t1_ = 0, t2_ = 0, t3_ = 0;
+  float d1_ = 0, d2_ = 0;
+};
@@ -0,0 +1,99 @@
+// Named position presets
+
+#include "PresetTable.h"
+
+#include <string.h>
+
+// FNV-1a
+uint32_t PresetTable::hash(const char* name) {
+  uint32_t h = 2166136261u;
+  while (*name) {
+    h ^= (uint8_t)*name++;
+    h *= 16777619u;
+  }
+  return h;
+}
+
+bool PresetTable::validName(const char* name) {
+  size_t length = 0;
+  for (; name[length]; length++) {
+    if (length == PRESET_NAME_SIZE - 1) return false;
+    if (name[length] < 0x20 || name[length] > 0x7E) return false;
+  }
+  return length > 0;
+}
+
+int PresetTable::find(const char* name) const {
+  for (uint32_t i = hash(name);; i++) {
+    uint8_t entry = index_[i & (INDEX_SIZE - 1)];
+    if (entry == 0) return -1;
+    if (strcmp(slots_[entry - 1].name, name) == 0) return entry - 1;
+  }
+}
+
+const Preset* PresetTable::get(int slot) const {
+  if (slot < 0 || slot >= PRESET_SLOTS || slots_[slot].name[0] == '\0') return nullptr;
+  return &slots_[slot];
+}
+
+bool PresetTable::set(int slot, const char* name, const int16_t* angles, uint8_t axes) {
+  if (slot < 0 || slot >= PRESET_SLOTS || axes > PRESET_MAX_AXES || !validName(name)) return false;
+  int existing = find(name);
+  if (existing >= 0 && existing != slot) return false;
+
+  Preset& preset = slots_[slot];
+  memset(&preset, 0, sizeof(preset));
+  strcpy(preset.name, name);
+  memcpy(preset.angles, angles, axes * sizeof(int16_t));
+  rebuildIndex();
+  return true;
+}
+
+bool PresetTable::remove(int slot) {
+  if (!get(slot)) return false;
+  memset(&slots_[slot], 0, sizeof(Preset));
+  rebuildIndex();
+  return true;
+}
+
+int PresetTable::freeSlot() const {
+  for (int slot = 0; slot < PRESET_SLOTS; slot++) {
+    if (slots_[slot].name[0] == '\0') return slot;
+  }
+  return -1;
+}
+
+int PresetTable::next(int slot) const {
+  for (int i = 1; i <= PRESET_SLOTS; i++) {
+    int candidate = ((slot < 0 ? -1 : slot) + i) % PRESET_SLOTS;
+    if (slots_[candidate].name[0] != '\0') return candidate;
+  }
+  return -1;
+}
+
+void PresetTable::restore() {
+  for (int slot = 0; slot < PRESET_SLOTS; slot++) {
+    Preset& preset = slots_[slot];
+    preset.name[PRESET_NAME_SIZE - 1] = '\0';
+    if (!validName(preset.name)) memset(&preset, 0, sizeof(preset));
+  }
+  rebuildIndex();
+}
+
+// Linear probing; a repeated name (only possible in a damaged blob) loses its slot
+void PresetTable::rebuildIndex() {
+  memset(index_, 0, sizeof(index_));
+  count_ = 0;
+  for (int slot = 0; slot < PRESET_SLOTS; slot++) {
+    Preset& preset = slots_[slot];
+    if (preset.name[0] == '\0') continue;
+    if (find(preset.name) >= 0) {
+      memset(&preset, 0, sizeof(preset));
+      continue;
+    }
+    uint32_t i = hash(preset.name);
+    while (index_[i & (INDEX_SIZE - 1)] != 0) i++;
+    index_[i & (INDEX_SIZE - 1)] = (uint8_t)(slot + 1);
+    count_++;
+  }
+}
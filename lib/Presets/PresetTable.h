@@ -0,0 +1,70 @@
+// Named position presets
+// A fixed table of PRESET_SLOTS poses (one angle per axis, 1/100 degree), addressed by slot
+// or by name. Names go through a small open-addressed hash index, so a recall by name costs
+// one hash and, with the index four times the table size, almost always one compare - no
+// scan over the slots. Changing the table (set/remove) rebuilds the index; that is the rare
+// path, driven by an operator.
+//
+// The table is trivially copyable: one task owns it and publishes copies (StateSnapshot),
+// and slots() is the blob stored in NVS.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef PRESET_SLOTS
+#define PRESET_SLOTS 8
+#endif
+
+#define PRESET_MAX_AXES 2
+#define PRESET_NAME_SIZE 16  // including the terminator
+
+// No padding: stored bytewise
+struct Preset {
+  char name[PRESET_NAME_SIZE];       // empty = free slot
+  int16_t angles[PRESET_MAX_AXES];  // 1/100 degree
+};
+
+class PresetTable {
+public:
+  static const uint8_t INDEX_SIZE = 4 * PRESET_SLOTS;  // power of two
+  static_assert((INDEX_SIZE & (INDEX_SIZE - 1)) == 0, "PRESET_SLOTS must be a power of two");
+
+  // Slot holding `name`, -1 if none
+  int find(const char* name) const;
+
+  // Preset in `slot`, nullptr if the slot is free or out of range
+  const Preset* get(int slot) const;
+
+  // Store a pose in `slot`. False if the slot is out of range, the name is not 1..15
+  // printable characters, or another slot already uses it.
+  bool set(int slot, const char* name, const int16_t* angles, uint8_t axes);
+
+  bool remove(int slot);
+
+  // First free slot, -1 when full
+  int freeSlot() const;
+
+  // Next used slot after `slot` (wrapping, -1 starts at the first), -1 when empty
+  int next(int slot) const;
+
+  uint8_t count() const { return count_; }
+
+  // Persistence: copy a stored blob of slotsSize() bytes into slots(), then restore().
+  // Entries with invalid or repeated names are dropped.
+  Preset* slots() { return slots_; }
+  const Preset* slots() const { return slots_; }
+  static size_t slotsSize() { return sizeof(Preset) * PRESET_SLOTS; }
+  void restore();
+
+  static bool validName(const char* name);
+
+private:
+  static uint32_t hash(const char* name);
+  void rebuildIndex();
+
+  Preset slots_[PRESET_SLOTS] = {};
+  uint8_t index_[INDEX_SIZE] = {};  // slot + 1, 0 = empty
+  uint8_t count_ = 0;
+};
@@ -0,0 +1,151 @@
+// Compile-time HTTP route table
+// Every firmware declares its routes as one constexpr array. RouteTable checks it while
+// compiling (paths start with '/', no path twice, at most HTTP_MAX_ROUTES) and builds a
+// perfect hash over the paths, so HttpServer finds a route with one hash of the request path
+// and one strcmp, however many routes there are. The table lives in flash.
+//
+//   constexpr HttpRoute ROUTES[] = {
+//     {"/api/status", HttpMethod::Get, handleApiStatus},
+//     {"/api/servo", HttpMethod::Post, jsonRoute<handleApiServo>},
+//   };
+//   ROUTE_TABLE(routeTable, ROUTES);
+//   ...
+//   useRoutes(server, routeTable);
+//
+// One handler per path. Requests with another method get 405 from the server (Any accepts
+// every method, Get also HEAD); a handler for both GET and POST registers Any and looks at
+// req.method().
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "HttpServer.h"
+#include "JsonExchange.h"
+
+// Hash seeds tried at compile time before the table is rejected
+#ifndef ROUTE_SEED_LIMIT
+#define ROUTE_SEED_LIMIT 1024
+#endif
+
+// FNV-1a; the seed changes the offset basis, the final xor-shift spreads it into the low bits
+constexpr uint32_t routeHash(const char* path, uint32_t seed) {
+  uint32_t hash = 2166136261u ^ (seed * 0x9E3779B9u);
+  for (; *path; path++) hash = (hash ^ (uint8_t)*path) * 16777619u;
+  return hash ^ (hash >> 16);
+}
+
+// Slot array size: a power of two, at least 4 slots per route so a seed is found quickly
+constexpr size_t routeSlotCount(size_t routes) {
+  size_t slots = 8;
+  while (slots < routes * 4) slots *= 2;
+  return slots;
+}
+
+constexpr bool routePathsEqual(const char* a, const char* b) {
+  while (*a && *a == *b) {
+    a++;
+    b++;
+  }
+  return *a == *b;
+}
+
+template <size_t N>
+class RouteTable {
+  static_assert(N > 0 && N <= HTTP_MAX_ROUTES, "A route table holds 1..HTTP_MAX_ROUTES routes");
+
+public:
+  static constexpr size_t SLOTS = routeSlotCount(N);
+
+  constexpr explicit RouteTable(const HttpRoute (&routes)[N]) : routes_(routes) {
+    if (!pathsValid() || !pathsUnique()) return;
+    for (seed_ = 0; seed_ < ROUTE_SEED_LIMIT; seed_++) {
+      if (place()) return;
+    }
+  }
+
+  // Index of the route serving `path`, HTTP_NO_ROUTE if there is none
+  uint8_t find(const char* path) const {
+    uint8_t index = slots_[slot(path)];
+    return index != HTTP_NO_ROUTE && strcmp(routes_[index].path, path) == 0 ? index : HTTP_NO_ROUTE;
+  }
+
+  // HttpRouteLookup for HttpServer::setRoutes()
+  static uint8_t lookup(const void* table, const char* path) {
+    return static_cast<const RouteTable*>(table)->find(path);
+  }
+
+  const HttpRoute* routes() const { return routes_; }
+  static constexpr uint8_t size() { return (uint8_t)N; }
+
+  // Compile-time checks (ROUTE_TABLE)
+  constexpr bool pathsValid() const {
+    for (size_t i = 0; i < N; i++) {
+      if (!routes_[i].path || routes_[i].path[0] != '/' || !routes_[i].handler) return false;
+    }
+    return true;
+  }
+
+  constexpr bool pathsUnique() const {
+    for (size_t i = 0; i < N; i++) {
+      for (size_t j = i + 1; j < N; j++) {
+        if (routePathsEqual(routes_[i].path, routes_[j].path)) return false;
+      }
+    }
+    return true;
+  }
+
+  constexpr bool hashed() const { return seed_ < ROUTE_SEED_LIMIT; }
+
+private:
+  constexpr size_t slot(const char* path) const { return routeHash(path, seed_) & (SLOTS - 1); }
+
+  // Every route in its own slot with the current seed
+  constexpr bool place() {
+    for (size_t i = 0; i < SLOTS; i++) slots_[i] = HTTP_NO_ROUTE;
+    for (size_t i = 0; i < N; i++) {
+      size_t s = slot(routes_[i].path);
+      if (slots_[s] != HTTP_NO_ROUTE) return false;
+      slots_[s] = (uint8_t)i;
+    }
+    return true;
+  }
+
+  const HttpRoute* routes_;
+  uint32_t seed_ = ROUTE_SEED_LIMIT;
+  uint8_t slots_[SLOTS] = {};
+};
+
+// Declares `name` for a constexpr HttpRoute array and rejects a bad table at compile time
+#define ROUTE_TABLE(name, routes)                                                      \
+  constexpr RouteTable<sizeof(routes) / sizeof((routes)[0])> name(routes);             \
+  static_assert(name.pathsValid(), "Route paths must start with '/' and have a handler"); \
+  static_assert(name.pathsUnique(), "Route path declared twice");                      \
+  static_assert(name.hashed(), "No perfect hash for these paths, raise ROUTE_SEED_LIMIT")
+
+// Serve `table` from `server` (before begin())
+template <size_t N>
+void useRoutes(HttpServer& server, const RouteTable<N>& table) {
+  server.setRoutes(table.routes(), table.size(), RouteTable<N>::lookup, &table);
+}
+
+// ===== Handler templates =====
+// Route handler that gets the parsed request: the body of anything but GET/HEAD is parsed
+// first, so invalid JSON (400) or a body that does not fit the arena (413) never reaches it.
+// An empty body counts as {}, so a bodiless POST gets every optional field's default.
+// The reply is built in json.response as usual.
+typedef void (*JsonRouteHandler)(JsonExchange& json, HttpRequest& req, HttpResponse& res);
+
+template <JsonRouteHandler Handler>
+void jsonRoute(HttpRequest& req, HttpResponse& res) {
+  JsonExchange json;
+  bool hasBody = req.method() != HttpMethod::Get && req.method() != HttpMethod::Head;
+  if (hasBody && req.bodyLength() == 0) {
+    json.request.to<JsonObject>();
+  } else if (hasBody && !json.parse(req, res)) {
+    return;
+  }
+  Handler(json, req, res);
+}
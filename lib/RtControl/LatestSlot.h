@@ -0,0 +1,52 @@
+// Latest-wins single-slot mailbox
+// One thread posts values, exactly one other thread takes the newest. A value posted before
+// the previous one was taken replaces it (counted as superseded), so a burst of targets costs
+// the consumer one take, never a backlog. Portable C++: three buffers and one atomic index
+// (triple buffering), neither side ever waits. T must be trivially copyable.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <type_traits>
+
+template <typename T>
+class LatestSlot {
+  static_assert(std::is_trivially_copyable<T>::value, "LatestSlot needs a trivially copyable type");
+
+public:
+  // Producer side
+  void post(const T& value) {
+    buffers_[back_] = value;
+    const uint8_t previous = middle_.exchange(back_ | FRESH, std::memory_order_acq_rel);
+    back_ = previous & INDEX;
+    posted_.fetch_add(1, std::memory_order_relaxed);
+    if (previous & FRESH) superseded_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Consumer side: the newest value since the last take; false when nothing new was posted
+  bool take(T& value) {
+    if (!(middle_.load(std::memory_order_relaxed) & FRESH)) return false;
+    const uint8_t previous = middle_.exchange(front_, std::memory_order_acq_rel);
+    front_ = previous & INDEX;
+    value = buffers_[front_];
+    return true;
+  }
+
+  // Any thread. Taken = posted - superseded, minus one while a value is waiting.
+  uint32_t posted() const { return posted_.load(std::memory_order_relaxed); }
+  uint32_t superseded() const { return superseded_.load(std::memory_order_relaxed); }
+  bool pending() const { return middle_.load(std::memory_order_relaxed) & FRESH; }
+
+private:
+  static const uint8_t INDEX = 0x03;
+  static const uint8_t FRESH = 0x04;  // middle holds a value not taken yet
+
+  T buffers_[3] = {};
+  uint8_t back_ = 0;                  // producer only: next buffer to fill
+  uint8_t front_ = 2;                 // consumer only: last buffer taken
+  std::atomic<uint8_t> middle_{1};    // handed over by exchange
+  std::atomic<uint32_t> posted_{0};
+  std::atomic<uint32_t> superseded_{0};
+};
@@ -0,0 +1,53 @@
+// Single-producer / single-consumer lock-free ring buffer
+// Portable C++: only std::atomic, no RTOS primitives.
+// One thread (or ISR) pushes, exactly one other thread pops.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+template <typename T, size_t N>
+class SpscQueue {
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+public:
+  // Producer side. Returns false (and counts a drop) when the queue is full.
+  bool push(const T& item) {
+    const uint32_t head = head_.load(std::memory_order_relaxed);
+    const uint32_t tail = tail_.load(std::memory_order_acquire);
+    if (head - tail >= N) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    buffer_[head & (N - 1)] = item;
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer side. Returns false when the queue is empty.
+  bool pop(T& item) {
+    const uint32_t tail = tail_.load(std::memory_order_relaxed);
+    const uint32_t head = head_.load(std::memory_order_acquire);
+    if (head == tail) return false;
+    item = buffer_[tail & (N - 1)];
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Approximate when called from a third thread, exact from either side
+  size_t size() const {
+    return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+  }
+
+  static constexpr size_t capacity() { return N; }
+  uint32_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+  T buffer_[N];
+  std::atomic<uint32_t> head_{0};  // written by producer only
+  std::atomic<uint32_t> tail_{0};  // written by consumer only
+  std::atomic<uint32_t> dropped_{0};
+};
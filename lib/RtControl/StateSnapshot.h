@@ -0,0 +1,45 @@
+// Seqlock-protected state snapshot
+// One writer publishes a copy of its state, any number of readers take consistent copies
+// without blocking the writer. T must be trivially copyable.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <type_traits>
+
+template <typename T>
+class StateSnapshot {
+  static_assert(std::is_trivially_copyable<T>::value, "StateSnapshot needs a trivially copyable type");
+
+public:
+  // Writer side (single thread)
+  void publish(const T& value) {
+    const uint32_t seq = seq_.load(std::memory_order_relaxed);
+    seq_.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    value_ = value;
+    seq_.store(seq + 2, std::memory_order_release);
+  }
+
+  // Reader side: retries while a publish is in flight
+  T read() const {
+    T copy;
+    uint32_t before, after;
+    do {
+      before = seq_.load(std::memory_order_acquire);
+      copy = value_;
+      std::atomic_thread_fence(std::memory_order_acquire);
+      after = seq_.load(std::memory_order_relaxed);
+    } while ((before & 1) || before != after);
+    return copy;
+  }
+
+  // Number of completed publishes
+  uint32_t version() const { return seq_.load(std::memory_order_acquire) >> 1; }
+
+private:
+  T value_{};
+  std::atomic<uint32_t> seq_{0};
+};
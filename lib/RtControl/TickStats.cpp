@@ -0,0 +1,24 @@
+// Control loop timing statistics
+
+#include "TickStats.h"
+
+void TickStats::begin(uint32_t nowUs) {
+  if (started_) {
+    const uint32_t period = nowUs - lastStartUs_;
+    const uint32_t jitter = period > periodUs_ ? period - periodUs_ : periodUs_ - period;
+    timing_.lastPeriodUs = period;
+    timing_.lastJitterUs = jitter;
+    if (jitter > timing_.maxJitterUs) timing_.maxJitterUs = jitter;
+    if (period >= 2 * periodUs_) timing_.deadlineMisses++;
+  }
+  started_ = true;
+  lastStartUs_ = nowUs;
+  timing_.ticks++;
+}
+
+void TickStats::end(uint32_t nowUs) {
+  const uint32_t busy = nowUs - lastStartUs_;
+  timing_.lastBusyUs = busy;
+  if (busy > timing_.maxBusyUs) timing_.maxBusyUs = busy;
+  if (busy > periodUs_) timing_.deadlineMisses++;
+}
@@ -0,0 +1,33 @@
+// Control loop timing statistics
+// Tracks period jitter and deadline misses of a fixed-rate tick (microsecond clock)
+
+#pragma once
+
+#include <stdint.h>
+
+struct TickTiming {
+  uint32_t ticks;
+  uint32_t deadlineMisses;  // tick started a full period late or its body overran the period
+  uint32_t lastPeriodUs;    // start-to-start time of the last tick (0 before the second tick)
+  uint32_t lastJitterUs;    // |actual period - nominal period| of the last tick
+  uint32_t maxJitterUs;
+  uint32_t lastBusyUs;      // time spent inside the last tick body
+  uint32_t maxBusyUs;
+};
+
+class TickStats {
+public:
+  explicit TickStats(uint32_t periodUs) : periodUs_(periodUs) {}
+
+  void begin(uint32_t nowUs);
+  void end(uint32_t nowUs);
+
+  const TickTiming& timing() const { return timing_; }
+  uint32_t periodUs() const { return periodUs_; }
+
+private:
+  uint32_t periodUs_;
+  uint32_t lastStartUs_ = 0;
+  bool started_ = false;
+  TickTiming timing_ = {};
+};
@@ -0,0 +1,23 @@
+// Servo driven in fixed-point angles through a calibration table
+
+#include "CalibratedServo.h"
+
+void CalibratedServo::attach(uint8_t pin) {
+  servo_.setPeriodHertz(50);
+  servo_.attach(pin, SERVO_PULSE_MIN_US, SERVO_PULSE_MAX_US);
+}
+
+void CalibratedServo::setCalibration(const ServoCalibration& cal) {
+  map_.build(cal);
+  pulseUs_ = 0;
+  write(angle_);
+}
+
+bool CalibratedServo::write(int32_t angle) {
+  angle_ = angle;
+  uint16_t pulse = map_.pulseUs(angle);
+  if (pulse == pulseUs_) return false;
+  servo_.writeMicroseconds(pulse);
+  pulseUs_ = pulse;
+  return true;
+}
@@ -0,0 +1,32 @@
+// Servo driven in fixed-point angles through a calibration table
+// Writes pulse widths (writeMicroseconds) instead of integer degrees: about 0.1 degree per
+// microsecond step on a typical 500-2500 us servo.
+
+#pragma once
+
+#include <ESP32Servo.h>
+
+#include "ServoCalibration.h"
+
+class CalibratedServo {
+public:
+  explicit CalibratedServo(const ServoCalibration& cal) { map_.build(cal); }
+
+  // 50 Hz on the next free LEDC channel, accepting the whole calibratable pulse range
+  void attach(uint8_t pin);
+
+  // New table (precomputed here, not per write); the current angle is output again
+  void setCalibration(const ServoCalibration& cal);
+
+  // Angle in 1/100 degree. Returns false when the pulse width did not change.
+  bool write(int32_t angle);
+
+  int32_t angle() const { return angle_; }
+  uint16_t pulseUs() const { return pulseUs_; }
+
+private:
+  Servo servo_;
+  PulseMap map_;
+  int32_t angle_ = 90 * ANGLE_SCALE;
+  uint16_t pulseUs_ = 0;
+};
@@ -0,0 +1,63 @@
+// Servo calibration tables in NVS
+
+#include "CalibrationStore.h"
+
+#include <Preferences.h>
+
+static const char* NAMESPACE = "servo_cal";
+static const char* MODEL_NAMESPACE = "servo_model";
+
+template <typename T>
+static bool loadBlob(const char* space, const char* key, T& value, bool (*valid)(const T&)) {
+  Preferences prefs;
+  if (!prefs.begin(space, true)) return false;
+
+  T stored;
+  bool ok = prefs.getBytesLength(key) == sizeof(stored) &&
+            prefs.getBytes(key, &stored, sizeof(stored)) == sizeof(stored) && valid(stored);
+  prefs.end();
+
+  if (ok) value = stored;
+  return ok;
+}
+
+template <typename T>
+static bool saveBlob(const char* space, const char* key, const T& value) {
+  Preferences prefs;
+  if (!prefs.begin(space, false)) return false;
+  bool ok = prefs.putBytes(key, &value, sizeof(value)) == sizeof(value);
+  prefs.end();
+  return ok;
+}
+
+static bool eraseBlob(const char* space, const char* key) {
+  Preferences prefs;
+  if (!prefs.begin(space, false)) return false;
+  bool ok = !prefs.isKey(key) || prefs.remove(key);
+  prefs.end();
+  return ok;
+}
+
+bool loadCalibration(const char* key, ServoCalibration& cal) {
+  return loadBlob(NAMESPACE, key, cal, calibrationValid);
+}
+
+bool saveCalibration(const char* key, const ServoCalibration& cal) {
+  return saveBlob(NAMESPACE, key, cal);
+}
+
+bool eraseCalibration(const char* key) {
+  return eraseBlob(NAMESPACE, key);
+}
+
+bool loadDynamics(const char* key, ServoDynamics& dynamics) {
+  return loadBlob(MODEL_NAMESPACE, key, dynamics, dynamicsValid);
+}
+
+bool saveDynamics(const char* key, const ServoDynamics& dynamics) {
+  return saveBlob(MODEL_NAMESPACE, key, dynamics);
+}
+
+bool eraseDynamics(const char* key) {
+  return eraseBlob(MODEL_NAMESPACE, key);
+}
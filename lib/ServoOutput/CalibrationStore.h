@@ -0,0 +1,20 @@
+// Servo calibration tables in NVS (Preferences namespace "servo_cal"), one blob per servo,
+// and their slew rates (namespace "servo_model", same key)
+
+#pragma once
+
+#include "ServoCalibration.h"
+#include "ServoModel.h"
+
+// False when the key is missing or holds an invalid table; `cal` is left untouched then
+bool loadCalibration(const char* key, ServoCalibration& cal);
+
+bool saveCalibration(const char* key, const ServoCalibration& cal);
+
+// Back to the sketch's built-in default on the next boot
+bool eraseCalibration(const char* key);
+
+// Same contract for the servo's dynamics (ServoModel)
+bool loadDynamics(const char* key, ServoDynamics& dynamics);
+bool saveDynamics(const char* key, const ServoDynamics& dynamics);
+bool eraseDynamics(const char* key);
@@ -0,0 +1,41 @@
+// Servo pulse calibration
+
+#include "ServoCalibration.h"
+
+ServoCalibration linearCalibration(uint16_t minUs, uint16_t maxUs) {
+  ServoCalibration cal;
+  for (int i = 0; i < SERVO_CAL_POINTS; i++) {
+    int32_t span = ((int32_t)maxUs - minUs) * i;
+    cal.pulseUs[i] = (uint16_t)(minUs + (span + (span >= 0 ? 3 : -3)) / (SERVO_CAL_POINTS - 1));
+  }
+  return cal;
+}
+
+bool calibrationValid(const ServoCalibration& cal) {
+  int direction = cal.pulseUs[SERVO_CAL_POINTS - 1] > cal.pulseUs[0] ? 1 : -1;
+  for (int i = 0; i < SERVO_CAL_POINTS; i++) {
+    if (cal.pulseUs[i] < SERVO_PULSE_MIN_US || cal.pulseUs[i] > SERVO_PULSE_MAX_US) return false;
+    if (i > 0 && ((int32_t)cal.pulseUs[i] - cal.pulseUs[i - 1]) * direction <= 0) return false;
+  }
+  return true;
+}
+
+void PulseMap::build(const ServoCalibration& cal) {
+  for (int i = 0; i < SEGMENTS; i++) {
+    int32_t rise = (int32_t)cal.pulseUs[i + 1] - cal.pulseUs[i];
+    offset_[i] = (int32_t)cal.pulseUs[i] << 16;
+    slope_[i] = (rise * 65536 + (rise >= 0 ? SERVO_CAL_STEP / 2 : -SERVO_CAL_STEP / 2)) / SERVO_CAL_STEP;
+  }
+  // 180 degrees exactly lands in this extra segment
+  offset_[SEGMENTS] = (int32_t)cal.pulseUs[SEGMENTS] << 16;
+  slope_[SEGMENTS] = 0;
+}
+
+uint16_t PulseMap::pulseUs(int32_t angle) const {
+  if (angle < 0) angle = 0;
+  if (angle > 180 * ANGLE_SCALE) angle = 180 * ANGLE_SCALE;
+
+  int32_t segment = angle / SERVO_CAL_STEP;
+  int32_t within = angle - segment * SERVO_CAL_STEP;
+  return (uint16_t)((offset_[segment] + slope_[segment] * within + 32768) >> 16);
+}
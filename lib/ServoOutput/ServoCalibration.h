@@ -0,0 +1,46 @@
+// Servo pulse calibration
+// Hardware-independent: angle -> pulse width through a per-servo table of breakpoints.
+//
+// Angles are fixed-point, 1/100 degree (ANGLE_SCALE), so slow moves are no longer limited to
+// 181 integer steps. The table holds the pulse width measured at every SERVO_CAL_STEP; the
+// first and last entries are the 0 and 180 degree pulses, the ones in between correct the
+// servo's nonlinearity. PulseMap turns the table into per-segment offset/slope pairs once, so
+// the per-tick lookup is one division by a constant and one multiply.
+
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+
+#define ANGLE_SCALE 100        // fixed-point angles: 1/100 degree
+#define SERVO_CAL_POINTS 7     // breakpoints at 0, 30, ..., 180 degrees
+#define SERVO_CAL_STEP (180 * ANGLE_SCALE / (SERVO_CAL_POINTS - 1))
+#define SERVO_PULSE_MIN_US 400
+#define SERVO_PULSE_MAX_US 2600
+
+inline int32_t angleFromDegrees(float degrees) { return (int32_t)lroundf(degrees * ANGLE_SCALE); }
+inline float angleToDegrees(int32_t angle) { return angle / (float)ANGLE_SCALE; }
+
+struct ServoCalibration {
+  uint16_t pulseUs[SERVO_CAL_POINTS];  // strictly increasing, or decreasing for a reversed servo
+};
+
+// Straight line from minUs at 0 degrees to maxUs at 180
+ServoCalibration linearCalibration(uint16_t minUs, uint16_t maxUs);
+
+// Every pulse within SERVO_PULSE_MIN_US..MAX_US and the table strictly monotonic
+bool calibrationValid(const ServoCalibration& cal);
+
+class PulseMap {
+public:
+  void build(const ServoCalibration& cal);
+
+  // Angle in 1/100 degree (clamped to 0..180 degrees) -> pulse width in microseconds
+  uint16_t pulseUs(int32_t angle) const;
+
+private:
+  static const int SEGMENTS = SERVO_CAL_POINTS - 1;
+
+  int32_t offset_[SEGMENTS + 1] = {};  // Q16 microseconds at the segment start
+  int32_t slope_[SEGMENTS + 1] = {};   // Q16 microseconds per 1/100 degree
+};
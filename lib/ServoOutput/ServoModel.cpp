@@ -0,0 +1,69 @@
+// Estimated servo horn position
+
+#include "ServoModel.h"
+
+bool dynamicsValid(const ServoDynamics& dynamics) {
+  return dynamics.slewRate >= SERVO_SLEW_MIN && dynamics.slewRate <= SERVO_SLEW_MAX &&
+         dynamics.deadMs <= SERVO_DEAD_MAX_MS;
+}
+
+void ServoModel::setDynamics(const ServoDynamics& dynamics) {
+  dynamics_ = dynamics;
+  stepPerMs_ = dynamics.slewRate * ANGLE_SCALE / 1000.0f;
+}
+
+void ServoModel::reset(int32_t angle, uint32_t nowMs) {
+  first_ = 0;
+  count_ = 0;
+  commanded_ = angle;
+  target_ = angle;
+  estimate_ = angle;
+  lastMs_ = nowMs;
+}
+
+int32_t ServoModel::update(int32_t commanded, uint32_t nowMs) {
+  advance(nowMs);
+  if (commanded != commanded_) {
+    if (count_ == SERVO_MODEL_HISTORY) {
+      // More changes than the dead time can hold: the oldest reaches the horn early
+      target_ = history_[first_].angle;
+      first_ = (first_ + 1) % SERVO_MODEL_HISTORY;
+      count_--;
+    }
+    history_[(first_ + count_) % SERVO_MODEL_HISTORY] = {nowMs, commanded};
+    count_++;
+    commanded_ = commanded;
+    advance(nowMs);  // without dead time it is in effect right away
+  }
+  return estimated();
+}
+
+// Turn towards each command in flight from the moment it reaches the horn, then on to `nowMs`
+void ServoModel::advance(uint32_t nowMs) {
+  while (count_) {
+    const Command& next = history_[first_];
+    uint32_t effectiveMs = next.ms + dynamics_.deadMs;
+    if ((int32_t)(nowMs - effectiveMs) < 0) break;
+    slewUntil(effectiveMs);
+    target_ = next.angle;
+    first_ = (first_ + 1) % SERVO_MODEL_HISTORY;
+    count_--;
+  }
+  slewUntil(nowMs);
+}
+
+void ServoModel::slewUntil(uint32_t ms) {
+  int32_t elapsed = (int32_t)(ms - lastMs_);
+  if (elapsed <= 0) return;  // already there (an early command, or a shorter dead time)
+  lastMs_ = ms;
+
+  float step = stepPerMs_ * elapsed;
+  float gap = target_ - estimate_;
+  if (gap > step) {
+    estimate_ += step;
+  } else if (gap < -step) {
+    estimate_ -= step;
+  } else {
+    estimate_ = target_;
+  }
+}
@@ -0,0 +1,75 @@
+// Estimated servo horn position
+// A hobby servo reports nothing back: after a write the horn only starts once the new pulse
+// width has reached it (dead time, up to one 50 Hz frame) and then turns at its own slew rate.
+// ServoModel replays the commanded angles through exactly that - a delay line followed by a
+// rate limit - so the firmware knows where the horn probably is instead of assuming it is
+// already at the last command.
+//
+// The defaults are the SG90 datasheet figures: 0.1 s per 60 degrees at 4.8 V (600 deg/s) and
+// one PWM frame. A measured slew rate (stopwatch or video of a long sweep) replaces them.
+
+#pragma once
+
+#include <stdint.h>
+
+#include "ServoCalibration.h"  // ANGLE_SCALE
+
+#ifndef SERVO_MODEL_HISTORY
+#define SERVO_MODEL_HISTORY 16  // commands in flight: covers the dead time at one per 5 ms tick
+#endif
+
+#define SERVO_SLEW_MIN 10.0f    // deg/s
+#define SERVO_SLEW_MAX 2000.0f
+#define SERVO_DEAD_MAX_MS 80
+
+struct ServoDynamics {
+  float slewRate;   // deg/s under the expected load
+  uint16_t deadMs;  // write -> horn starts turning
+  uint16_t reserved;
+};
+
+const ServoDynamics SG90_DYNAMICS = {600.0f, 20, 0};
+
+// Slew rate within SERVO_SLEW_MIN..MAX, dead time at most SERVO_DEAD_MAX_MS
+bool dynamicsValid(const ServoDynamics& dynamics);
+
+class ServoModel {
+public:
+  explicit ServoModel(const ServoDynamics& dynamics) { setDynamics(dynamics); }
+
+  // Takes effect from the next update(); the estimate carries on from where it is
+  void setDynamics(const ServoDynamics& dynamics);
+
+  // Horn assumed to be resting at `angle` (1/100 degree), nothing in flight
+  void reset(int32_t angle, uint32_t nowMs);
+
+  // Once per control tick with the angle written last; returns the estimate (1/100 degree)
+  int32_t update(int32_t commanded, uint32_t nowMs);
+
+  int32_t commanded() const { return commanded_; }
+  int32_t estimated() const { return (int32_t)(estimate_ + (estimate_ < 0 ? -0.5f : 0.5f)); }
+
+  // The horn has reached the last command and nothing is in flight
+  bool arrived() const { return count_ == 0 && estimate_ == target_; }
+
+  const ServoDynamics& dynamics() const { return dynamics_; }
+
+private:
+  struct Command {
+    uint32_t ms;  // when it was written
+    int32_t angle;
+  };
+
+  void advance(uint32_t nowMs);
+  void slewUntil(uint32_t ms);
+
+  ServoDynamics dynamics_;
+  float stepPerMs_ = 0;  // 1/100 degree
+  Command history_[SERVO_MODEL_HISTORY];
+  uint8_t first_ = 0;
+  uint8_t count_ = 0;
+  int32_t commanded_ = 90 * ANGLE_SCALE;
+  int32_t target_ = 90 * ANGLE_SCALE;  // newest command that has reached the horn
+  float estimate_ = 90 * ANGLE_SCALE;
+  uint32_t lastMs_ = 0;
+};
@@ -0,0 +1,31 @@
+// Sketch state in NVS
+
+#include "StateStore.h"
+
+#include <Preferences.h>
+
+static const char* NAMESPACE = "state";
+
+bool loadStateBlob(const char* key, void* data, size_t size) {
+  Preferences prefs;
+  if (!prefs.begin(NAMESPACE, true)) return false;
+  bool ok = prefs.getBytesLength(key) == size && prefs.getBytes(key, data, size) == size;
+  prefs.end();
+  return ok;
+}
+
+bool saveStateBlob(const char* key, const void* data, size_t size) {
+  Preferences prefs;
+  if (!prefs.begin(NAMESPACE, false)) return false;
+  bool ok = prefs.putBytes(key, data, size) == size;
+  prefs.end();
+  return ok;
+}
+
+bool eraseStateBlob(const char* key) {
+  Preferences prefs;
+  if (!prefs.begin(NAMESPACE, false)) return false;
+  bool ok = prefs.remove(key);
+  prefs.end();
+  return ok;
+}
@@ -0,0 +1,98 @@
+// Sketch state persisted in NVS (Preferences namespace "state") with write coalescing
+// The control side keeps publishing its state as often as it likes; PersistentState compares
+// it with what is in flash and writes only once a change has settled, so a pan in progress
+// or a running scan does not turn into a flash write per step:
+//
+//   - a change is written after it stayed unchanged for settleMs,
+//   - or, if it keeps changing, maxDelayMs after it first differed,
+//   - and never sooner than minIntervalMs after the previous write.
+//
+// A write briefly stalls flash access on both cores, so flush() belongs in the network task,
+// never in the control loop.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <type_traits>
+
+// Blob I/O; load is false when the key is missing or holds a different size
+bool loadStateBlob(const char* key, void* data, size_t size);
+bool saveStateBlob(const char* key, const void* data, size_t size);
+bool eraseStateBlob(const char* key);  // false when the key was not there
+
+struct PersistPolicy {
+  uint32_t settleMs;
+  uint32_t minIntervalMs;
+  uint32_t maxDelayMs;
+};
+
+// T is compared bytewise: give it no padding and build it from a zeroed value
+template <typename T>
+class PersistentState {
+  static_assert(std::is_trivially_copyable<T>::value, "PersistentState needs a trivially copyable type");
+
+public:
+  PersistentState(const char* key, const PersistPolicy& policy) : key_(key), policy_(policy) {}
+
+  // Boot: false (and `value` untouched) when nothing valid is stored
+  bool load(T& value) {
+    T stored;
+    if (!loadStateBlob(key_, &stored, sizeof(T))) return false;
+    value = current_ = saved_ = stored;
+    return true;
+  }
+
+  // Latest state; cheap when nothing changed
+  void update(const T& value, uint32_t now) {
+    if (memcmp(&value, &current_, sizeof(T)) == 0) return;
+    current_ = value;
+    lastChange_ = now;
+    updates_++;
+    if (!dirty_) {
+      dirty_ = true;
+      firstChange_ = now;
+    }
+  }
+
+  // Writes the state when the policy says so; true when flash was written
+  bool flush(uint32_t now) {
+    if (!dirty_) return false;
+    if (now - lastChange_ < policy_.settleMs && now - firstChange_ < policy_.maxDelayMs) return false;
+    if (written_ && now - lastWrite_ < policy_.minIntervalMs) return false;
+
+    dirty_ = false;
+    if (memcmp(&current_, &saved_, sizeof(T)) == 0) return false;  // changed back meanwhile
+    lastWrite_ = now;
+    written_ = true;
+    if (!saveStateBlob(key_, &current_, sizeof(T))) {
+      failures_++;
+      dirty_ = true;  // retried after minIntervalMs
+      return false;
+    }
+    saved_ = current_;
+    writes_++;
+    return true;
+  }
+
+  const T& value() const { return current_; }
+  uint32_t updates() const { return updates_; }  // state changes seen
+  uint32_t writes() const { return writes_; }    // flash writes they were coalesced into
+  uint32_t failures() const { return failures_; }
+
+private:
+  const char* key_;
+  PersistPolicy policy_;
+  T current_{};
+  T saved_{};
+  bool dirty_ = false;
+  bool written_ = false;
+  uint32_t firstChange_ = 0;
+  uint32_t lastChange_ = 0;
+  uint32_t lastWrite_ = 0;
+  uint32_t updates_ = 0;
+  uint32_t writes_ = 0;
+  uint32_t failures_ = 0;
+};
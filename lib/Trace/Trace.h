@@ -0,0 +1,34 @@
+// Hot-path tracing
+// Build with -DTRACE to record scoped trace points into a lock-free ring buffer (TraceBuffer.h)
+// and dump it as Chrome / Perfetto trace-event JSON. Without it the macros expand to nothing:
+// no code, no RAM, and this header pulls in nothing.
+//
+//   void writeAxis(...) {
+//     TRACE_SCOPE("servo_write");   // duration of the enclosing block
+//     ...
+//   }
+//   TRACE_INSTANT("udp_watchdog");  // a point in time
+//
+// Names must be string literals (or otherwise live forever): only the pointer is stored.
+
+#pragma once
+
+#ifdef TRACE
+
+#include "TraceBuffer.h"
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(traceScope_, __LINE__)(name)
+#define TRACE_INSTANT(name) traceBuffer.instant(name)
+
+#else
+
+#define TRACE_SCOPE(name) \
+  do {                    \
+  } while (0)
+#define TRACE_INSTANT(name) \
+  do {                      \
+  } while (0)
+
+#endif
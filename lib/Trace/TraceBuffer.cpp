@@ -0,0 +1,32 @@
+// Lock-free trace event ring buffer
+
+#ifdef TRACE
+
+#include "TraceBuffer.h"
+
+TraceBuffer traceBuffer;
+
+void TraceBuffer::anchor(uint8_t core) {
+  // Both cores' cycle counters run at the CPU clock, micros() is shared: one offset per core
+  // maps cycles onto micros() * MHz (mod 2^32) for good
+  cyclesPerUs_ = getCpuFrequencyMhz();
+  uint32_t cycles = now();
+  offsets_[core] = (uint32_t)micros() * cyclesPerUs_ - cycles;
+  anchored_[core].store(true, std::memory_order_release);
+}
+
+bool TraceBuffer::read(uint32_t index, TraceEvent& event) const {
+  const Slot& slot = slots_[index & (TRACE_BUFFER_SIZE - 1)];
+  if (slot.seq.load(std::memory_order_acquire) != index + 1) return false;
+  event = slot.event;
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return slot.seq.load(std::memory_order_relaxed) == index + 1;
+}
+
+bool TraceBuffer::coreOffset(uint8_t core, uint32_t& offset) const {
+  if (core >= TRACE_CORES || !anchored_[core].load(std::memory_order_acquire)) return false;
+  offset = offsets_[core];
+  return true;
+}
+
+#endif
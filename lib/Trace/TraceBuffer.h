@@ -0,0 +1,92 @@
+// Lock-free trace event ring buffer (only built with -DTRACE, see Trace.h)
+// Any task on either core, and ISRs, record concurrently: a slot is claimed with one atomic
+// add and published with a per-slot sequence number, so writers never wait and the oldest
+// events are overwritten. Timestamps are raw CPU cycle counts of the recording core; each
+// core's offset to the common microsecond clock is learned on its first event, so the dump
+// can put both cores on one time line.
+
+#pragma once
+
+#include <Arduino.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+#ifndef TRACE_BUFFER_SIZE
+#define TRACE_BUFFER_SIZE 512  // events (power of two), 20 bytes each on the ESP32
+#endif
+
+#define TRACE_CORES 2
+
+struct TraceEvent {
+  uint32_t startCycles;
+  uint32_t durationCycles;  // 0 for instants
+  const char* name;
+  uint8_t core;
+  char phase;  // 'X' complete, 'i' instant
+};
+
+class TraceBuffer {
+  static_assert((TRACE_BUFFER_SIZE & (TRACE_BUFFER_SIZE - 1)) == 0, "TRACE_BUFFER_SIZE must be a power of two");
+
+public:
+  static uint32_t now() { return ESP.getCycleCount(); }
+
+  bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+  void setEnabled(bool on) { enabled_.store(on, std::memory_order_release); }
+
+  void complete(const char* name, uint32_t startCycles) { record(name, 'X', startCycles, now() - startCycles); }
+  void instant(const char* name) { record(name, 'i', now(), 0); }
+
+  // Reader side (the dump). Slots are consistent only while recording is disabled; a slot
+  // overwritten during the copy is reported as missing.
+  uint32_t head() const { return head_.load(std::memory_order_acquire); }
+  bool read(uint32_t index, TraceEvent& event) const;
+  bool coreOffset(uint8_t core, uint32_t& offset) const;
+  uint32_t cyclesPerUs() const { return cyclesPerUs_; }
+
+private:
+  struct Slot {
+    std::atomic<uint32_t> seq{0};  // index + 1 once written, 0 while being written
+    TraceEvent event;
+  };
+
+  void record(const char* name, char phase, uint32_t start, uint32_t duration) {
+    if (!enabled_.load(std::memory_order_relaxed)) return;
+    uint8_t core = (uint8_t)xPortGetCoreID();
+    if (core < TRACE_CORES && !anchored_[core].load(std::memory_order_acquire)) anchor(core);
+
+    uint32_t index = head_.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = slots_[index & (TRACE_BUFFER_SIZE - 1)];
+    slot.seq.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.event = {start, duration, name, core, phase};
+    slot.seq.store(index + 1, std::memory_order_release);
+  }
+
+  void anchor(uint8_t core);
+
+  std::atomic<bool> enabled_{true};
+  std::atomic<uint32_t> head_{0};
+  std::atomic<bool> anchored_[TRACE_CORES] = {};
+  uint32_t offsets_[TRACE_CORES] = {};
+  uint32_t cyclesPerUs_ = 0;
+  Slot slots_[TRACE_BUFFER_SIZE];
+};
+
+extern TraceBuffer traceBuffer;
+
+// Records the enclosing block as one complete event
+class TraceScope {
+public:
+  explicit TraceScope(const char* name) : name_(name), start_(TraceBuffer::now()) {}
+  ~TraceScope() { traceBuffer.complete(name_, start_); }
+
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+  const char* name_;
+  uint32_t start_;
+};
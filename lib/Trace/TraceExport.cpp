@@ -0,0 +1,157 @@
+// Chrome / Perfetto trace-event JSON export of the trace buffer
+
+#ifdef TRACE
+
+#include "TraceExport.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "HttpServer.h"
+#include "TraceBuffer.h"
+
+static const char TRACE_HEADER[] =
+    "{\"displayTimeUnit\":\"ms\",\"traceEvents\":["
+    "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"esp32\"}},"
+    "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"core 0\"}},"
+    "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"core 1\"}}";
+
+bool TraceExport::begin() {
+  if (state_ != IDLE) return false;
+  traceBuffer.setEnabled(false);
+
+  end_ = traceBuffer.head();
+  next_ = end_ > TRACE_BUFFER_SIZE ? end_ - TRACE_BUFFER_SIZE : 0;
+  written_ = 0;
+  missing_ = 0;
+  timeline_ = {};
+  state_ = HEADER;
+  return true;
+}
+
+void TraceExport::abort() {
+  if (state_ == IDLE) return;
+  state_ = IDLE;
+  traceBuffer.setEnabled(true);
+}
+
+// Cycles -> "us.fraction" as Chrome expects, relative to the first event
+static int formatMicros(char* out, size_t size, int64_t cycles, uint32_t cyclesPerUs) {
+  if (cycles < 0) cycles = 0;
+  uint64_t ns = (uint64_t)cycles * 1000 / cyclesPerUs;
+  return snprintf(out, size, "%u.%03u", (unsigned)(ns / 1000), (unsigned)(ns % 1000));
+}
+
+// 0 when the slot was overwritten; `timeline` advances to this event
+size_t TraceExport::formatEvent(char* out, size_t capacity, Timeline& timeline) const {
+  TraceEvent event;
+  if (!traceBuffer.read(next_, event)) return 0;
+
+  uint32_t offset = 0;
+  traceBuffer.coreOffset(event.core, offset);
+  uint32_t cycles = event.startCycles + offset;
+  if (timeline.started) {
+    timeline.elapsedCycles += (int32_t)(cycles - timeline.lastCycles);  // ring order is close to time order
+  }
+  timeline.started = true;
+  timeline.lastCycles = cycles;
+
+  uint32_t cyclesPerUs = traceBuffer.cyclesPerUs() ? traceBuffer.cyclesPerUs() : 1;
+  char ts[24];
+  formatMicros(ts, sizeof(ts), timeline.elapsedCycles, cyclesPerUs);
+
+  int n;
+  if (event.phase == 'X') {
+    char dur[24];
+    formatMicros(dur, sizeof(dur), event.durationCycles, cyclesPerUs);
+    n = snprintf(out, capacity, ",{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%s,\"dur\":%s,\"pid\":1,\"tid\":%u}", event.name,
+                 ts, dur, event.core);
+  } else {
+    n = snprintf(out, capacity, ",{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%s,\"pid\":1,\"tid\":%u}", event.name,
+                 ts, event.core);
+  }
+  return n > 0 && (size_t)n < capacity ? (size_t)n : 0;
+}
+
+size_t TraceExport::write(char* out, size_t capacity) {
+  size_t length = 0;
+  char event[160];
+
+  for (;;) {
+    switch (state_) {
+      case IDLE:
+        return length;
+
+      case HEADER:
+        if (capacity - length < sizeof(TRACE_HEADER)) return length;
+        memcpy(out + length, TRACE_HEADER, sizeof(TRACE_HEADER) - 1);
+        length += sizeof(TRACE_HEADER) - 1;
+        state_ = EVENTS;
+        break;
+
+      case EVENTS: {
+        if (next_ == end_) {
+          state_ = FOOTER;
+          break;
+        }
+        // Formatted aside first: an event that does not fit waits for the next piece
+        Timeline timeline = timeline_;
+        size_t n = formatEvent(event, sizeof(event), timeline);
+        if (n == 0) {
+          missing_++;
+          next_++;
+          break;
+        }
+        if (n > capacity - length) return length;
+        memcpy(out + length, event, n);
+        length += n;
+        timeline_ = timeline;
+        written_++;
+        next_++;
+        break;
+      }
+
+      case FOOTER: {
+        char footer[96];
+        int n = snprintf(footer, sizeof(footer), "],\"otherData\":{\"events\":%u,\"missing\":%u,\"cpu_mhz\":%u}}",
+                         (unsigned)written_, (unsigned)missing_, (unsigned)traceBuffer.cyclesPerUs());
+        if (n <= 0 || (size_t)n > capacity - length) return length;
+        memcpy(out + length, footer, n);
+        length += n;
+        state_ = DONE;
+        return length;
+      }
+
+      case DONE:
+        if (length > 0) return length;
+        abort();
+        return 0;
+    }
+  }
+}
+
+static size_t writeTrace(char* out, size_t capacity, void* context) {
+  TraceExport* exporter = static_cast<TraceExport*>(context);
+  if (!out) {
+    exporter->abort();
+    return 0;
+  }
+  return exporter->write(out, capacity);
+}
+
+void handleTraceRequest(HttpRequest& req, HttpResponse& res) {
+  static TraceExport exporter;
+
+  if (req.method() != HttpMethod::Get) {
+    res.send(405, "application/json", "{\"error\":\"Method not allowed\"}");
+    return;
+  }
+  if (!exporter.begin()) {
+    res.send(503, "application/json", "{\"error\":\"Trace dump in progress\"}");
+    return;
+  }
+  res.addHeader("Content-Disposition", "attachment; filename=\"trace.json\"");
+  res.sendChunked(200, "application/json", writeTrace, &exporter);
+}
+
+#endif
@@ -0,0 +1,49 @@
+// Chrome / Perfetto trace-event JSON export of the trace buffer (-DTRACE)
+// The dump is produced piece by piece into whatever buffer the caller has (HttpServer's
+// chunked responses), so it never needs more than one event's worth of memory. Recording is
+// paused from begin() until the last piece so the snapshot is consistent.
+//
+//   GET /api/trace  ->  open the file in chrome://tracing or ui.perfetto.dev
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+class HttpRequest;
+class HttpResponse;
+
+class TraceExport {
+public:
+  // False while another export is still running
+  bool begin();
+
+  // Next piece of JSON, at most `capacity` bytes; 0 once complete (recording resumes)
+  size_t write(char* out, size_t capacity);
+
+  // Stop early (client went away); recording resumes
+  void abort();
+
+  bool active() const { return state_ != IDLE; }
+
+private:
+  enum State : uint8_t { IDLE, HEADER, EVENTS, FOOTER, DONE };
+
+  struct Timeline {
+    bool started;
+    uint32_t lastCycles;    // last event start on the common cycle clock
+    int64_t elapsedCycles;  // since the first event
+  };
+
+  size_t formatEvent(char* out, size_t capacity, Timeline& timeline) const;
+
+  State state_ = IDLE;
+  uint32_t next_ = 0;  // buffer index of the next event
+  uint32_t end_ = 0;
+  uint32_t written_ = 0;
+  uint32_t missing_ = 0;
+  Timeline timeline_ = {};
+};
+
+// GET handler: streams the buffer as trace-event JSON (503 while a dump is in progress)
+void handleTraceRequest(HttpRequest& req, HttpResponse& res);
@@ -0,0 +1,118 @@
+// UDP control endpoint
+
+#include "UdpControl.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+bool UdpControl::begin() {
+  fd_ = socket(AF_INET, SOCK_DGRAM, 0);
+  if (fd_ < 0) return false;
+
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port = htons(port_);
+
+  int flags = fcntl(fd_, F_GETFL, 0);
+  if (bind(fd_, (struct sockaddr*)&addr, sizeof(addr)) != 0 || flags < 0 ||
+      fcntl(fd_, F_SETFL, flags | O_NONBLOCK) != 0) {
+    close(fd_);
+    fd_ = -1;
+    return false;
+  }
+  return true;
+}
+
+void UdpControl::end() {
+  if (fd_ >= 0) {
+    close(fd_);
+    fd_ = -1;
+  }
+}
+
+bool UdpControl::poll(uint32_t nowUs, UdpCommand& command) {
+  if (fd_ < 0) return false;
+
+  bool found = false;
+  uint8_t packet[UDP_COMMAND_SIZE + 1];  // +1 so oversized datagrams are caught
+
+  for (;;) {
+    struct sockaddr_in from;
+    socklen_t fromLength = sizeof(from);
+    ssize_t n = recvfrom(fd_, packet, sizeof(packet), 0, (struct sockaddr*)&from, &fromLength);
+    if (n < 0) break;
+    stats_.received++;
+
+    UdpCommand incoming;
+    if (!decodeUdpCommand(packet, (size_t)n, incoming)) {
+      stats_.malformed++;
+      continue;
+    }
+
+    // A different sender (or a restarted one on a new port) takes over with its own sequence
+    uint32_t addr = from.sin_addr.s_addr;
+    uint16_t port = from.sin_port;
+    bool newSender = !hasSender_ || addr != senderAddr_ || port != senderPort_;
+    if (!newSender && (int32_t)(incoming.seq - lastSeq_) <= 0) {
+      stats_.stale++;
+      continue;
+    }
+
+    hasSender_ = true;
+    senderAddr_ = addr;
+    senderPort_ = port;
+    lastSeq_ = incoming.seq;
+    lastPacketUs_ = nowUs;
+    stats_.accepted++;
+
+    if (incoming.type == UDP_STOP) {
+      streaming_ = false;
+    } else {
+      streaming_ = true;
+      if (incoming.type == UDP_HEARTBEAT) continue;
+    }
+
+    if (found) stats_.superseded++;
+    command = incoming;
+    found = true;
+  }
+
+  if (found) {
+    receivedUs_ = nowUs;
+    ackWanted_ = (command.flags & UDP_FLAG_ACK) != 0;
+    ackSeq_ = command.seq;
+    ackTimestamp_ = command.timestamp;
+  }
+  return found;
+}
+
+bool UdpControl::watchdogExpired(uint32_t nowUs) {
+  if (!streaming_ || nowUs - lastPacketUs_ < watchdogMs_ * 1000u) return false;
+  streaming_ = false;
+  stats_.watchdogTrips++;
+  return true;
+}
+
+void UdpControl::applied(uint32_t seq, int16_t angle, uint32_t latencyUs) {
+  if (fd_ < 0 || !ackWanted_ || seq != ackSeq_) return;
+  ackWanted_ = false;
+
+  UdpAck ack = {UDP_ACK_APPLIED, seq, ackTimestamp_, angle, latencyUs};
+  uint8_t packet[UDP_ACK_SIZE];
+  encodeUdpAck(ack, packet);
+
+  struct sockaddr_in to;
+  memset(&to, 0, sizeof(to));
+  to.sin_family = AF_INET;
+  to.sin_addr.s_addr = senderAddr_;
+  to.sin_port = senderPort_;
+  if (sendto(fd_, packet, sizeof(packet), 0, (struct sockaddr*)&to, sizeof(to)) == (ssize_t)sizeof(packet)) {
+    stats_.acks++;
+  }
+}
@@ -0,0 +1,69 @@
+// UDP control endpoint
+// Non-blocking datagram socket for streaming joystick commands (see UdpProtocol.h).
+// Latest wins: a packet whose sequence number is not newer than the last accepted one is
+// dropped as stale, and when several commands are waiting only the newest is returned.
+// A watchdog reports when an active stream goes quiet so the caller can stop the motion.
+// Builds against lwIP on the ESP32 and the host socket API on Linux, like HttpServer.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "UdpProtocol.h"
+
+struct UdpControlStats {
+  uint32_t received;
+  uint32_t accepted;
+  uint32_t stale;          // sequence number not newer than the last accepted one
+  uint32_t superseded;     // accepted but replaced by a newer packet from the same read
+  uint32_t malformed;
+  uint32_t acks;
+  uint32_t watchdogTrips;
+};
+
+class UdpControl {
+public:
+  UdpControl(uint16_t port, uint32_t watchdogMs) : port_(port), watchdogMs_(watchdogMs) {}
+  ~UdpControl() { end(); }
+
+  bool begin();
+  void end();
+
+  // Drain the socket. Returns true with the newest accepted ANGLE / RATE / STOP command.
+  // Heartbeats only feed the watchdog. A packet from a new address starts a new sequence.
+  bool poll(uint32_t nowUs, UdpCommand& command);
+
+  // True once when no packet arrived for watchdogMs while a stream was active
+  bool watchdogExpired(uint32_t nowUs);
+
+  // The command `seq` reached the servo: send the ack if the sender asked for one
+  void applied(uint32_t seq, int16_t angle, uint32_t latencyUs);
+
+  // Receipt time of the command returned by the last successful poll()
+  uint32_t receivedUs() const { return receivedUs_; }
+
+  const UdpControlStats& stats() const { return stats_; }
+  uint16_t port() const { return port_; }
+  int fd() const { return fd_; }
+
+private:
+  uint16_t port_;
+  uint32_t watchdogMs_;
+  int fd_ = -1;
+
+  bool hasSender_ = false;
+  uint32_t senderAddr_ = 0;
+  uint16_t senderPort_ = 0;
+  uint32_t lastSeq_ = 0;
+  uint32_t lastPacketUs_ = 0;
+  bool streaming_ = false;
+  uint32_t receivedUs_ = 0;
+
+  // Newest command that may still need an ack
+  bool ackWanted_ = false;
+  uint32_t ackSeq_ = 0;
+  uint32_t ackTimestamp_ = 0;
+
+  UdpControlStats stats_ = {};
+};
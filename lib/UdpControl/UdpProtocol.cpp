@@ -0,0 +1,60 @@
+// Binary UDP control protocol
+
+#include "UdpProtocol.h"
+
+#include <string.h>
+
+static uint16_t get16(const uint8_t* p) {
+  return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get32(const uint8_t* p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void put16(uint8_t* p, uint16_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+}
+
+static void put32(uint8_t* p, uint32_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  p[2] = (uint8_t)(v >> 16);
+  p[3] = (uint8_t)(v >> 24);
+}
+
+bool decodeUdpCommand(const uint8_t* data, size_t length, UdpCommand& command) {
+  if (length != UDP_COMMAND_SIZE || data[0] != UDP_CONTROL_MAGIC) return false;
+
+  uint8_t type = data[1];
+  if (type < UDP_ANGLE || type > UDP_HEARTBEAT) return false;
+
+  command.type = (UdpPacketType)type;
+  command.flags = data[2];
+  command.seq = get32(data + 4);
+  command.timestamp = get32(data + 8);
+  command.value = (int16_t)get16(data + 12);
+  return true;
+}
+
+void encodeUdpCommand(const UdpCommand& command, uint8_t out[UDP_COMMAND_SIZE]) {
+  memset(out, 0, UDP_COMMAND_SIZE);
+  out[0] = UDP_CONTROL_MAGIC;
+  out[1] = command.type;
+  out[2] = command.flags;
+  put32(out + 4, command.seq);
+  put32(out + 8, command.timestamp);
+  put16(out + 12, (uint16_t)command.value);
+}
+
+void encodeUdpAck(const UdpAck& ack, uint8_t out[UDP_ACK_SIZE]) {
+  memset(out, 0, UDP_ACK_SIZE);
+  out[0] = UDP_CONTROL_MAGIC;
+  out[1] = UDP_ACK;
+  out[3] = ack.status;
+  put32(out + 4, ack.seq);
+  put32(out + 8, ack.timestamp);
+  put16(out + 12, (uint16_t)ack.angle);
+  put32(out + 16, ack.latencyUs);
+}
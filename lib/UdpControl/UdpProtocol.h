@@ -0,0 +1,67 @@
+// Binary UDP control protocol
+// Fixed-size little-endian datagrams, decoded byte by byte (no struct packing assumptions).
+//
+// Command, 16 bytes (host -> device):
+//   0  u8   magic 0xC7
+//   1  u8   type (UdpPacketType)
+//   2  u8   flags (UDP_FLAG_ACK: answer once the command reached the servo)
+//   3  u8   reserved, 0
+//   4  u32  sequence number, increasing per sender
+//   8  u32  sender timestamp (any clock, echoed back in the ack)
+//   12 i16  value: ANGLE in 1/100 deg, RATE in 1/10 deg/s
+//   14 u16  reserved, 0
+//
+// Ack, 20 bytes (device -> host):
+//   0  u8   magic 0xC7
+//   1  u8   UDP_ACK
+//   2  u8   0
+//   3  u8   status (UdpAckStatus)
+//   4  u32  sequence number being acknowledged
+//   8  u32  sender timestamp, echoed
+//   12 i16  servo angle after the command, 1/100 deg
+//   14 u16  reserved, 0
+//   16 u32  device time from packet receipt to servo write, us
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define UDP_CONTROL_MAGIC 0xC7
+#define UDP_COMMAND_SIZE 16
+#define UDP_ACK_SIZE 20
+
+#define UDP_FLAG_ACK 0x01
+
+enum UdpPacketType : uint8_t {
+  UDP_ANGLE = 1,      // absolute position
+  UDP_RATE = 2,       // pan velocity, held until the next packet or the watchdog
+  UDP_STOP = 3,       // same as POST /api/stop
+  UDP_HEARTBEAT = 4,  // keeps the watchdog fed without changing the command
+  UDP_ACK = 0x80
+};
+
+enum UdpAckStatus : uint8_t {
+  UDP_ACK_APPLIED = 0
+};
+
+struct UdpCommand {
+  UdpPacketType type;
+  uint8_t flags;
+  uint32_t seq;
+  uint32_t timestamp;
+  int16_t value;
+};
+
+struct UdpAck {
+  UdpAckStatus status;
+  uint32_t seq;
+  uint32_t timestamp;
+  int16_t angle;
+  uint32_t latencyUs;
+};
+
+// False for anything that is not a well-formed command
+bool decodeUdpCommand(const uint8_t* data, size_t length, UdpCommand& command);
+void encodeUdpCommand(const UdpCommand& command, uint8_t out[UDP_COMMAND_SIZE]);
+void encodeUdpAck(const UdpAck& ack, uint8_t out[UDP_ACK_SIZE]);
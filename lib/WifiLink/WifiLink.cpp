@@ -0,0 +1,56 @@
+// Background WiFi station link
+
+#include "WifiLink.h"
+
+#include <Arduino.h>
+#include <WiFi.h>
+
+static const uint32_t FIRST_BACKOFF_MS = 1000;
+
+void WifiLink::begin(uint32_t now) {
+  WiFi.mode(WIFI_STA);
+  WiFi.setAutoReconnect(true);  // short drops are repaired by the driver
+  backoffMs_ = FIRST_BACKOFF_MS;
+  connect(now);
+}
+
+void WifiLink::connect(uint32_t now) {
+  WiFi.begin(ssid_, password_);
+  attempts_++;
+  state_ = CONNECTING;
+  since_ = now;
+}
+
+bool WifiLink::poll(uint32_t now) {
+  bool up = WiFi.status() == WL_CONNECTED;
+  if (up) {
+    if (state_ == CONNECTED) return false;
+    state_ = CONNECTED;
+    backoffMs_ = FIRST_BACKOFF_MS;
+    return true;
+  }
+
+  switch (state_) {
+    case CONNECTED:
+      // Link lost: give the driver's own reconnect one timeout before starting over
+      state_ = CONNECTING;
+      since_ = now;
+      break;
+
+    case CONNECTING:
+      if (now - since_ >= connectTimeoutMs_) {
+        WiFi.disconnect();
+        state_ = WAITING;
+        since_ = now;
+      }
+      break;
+
+    case WAITING:
+      if (now - since_ >= backoffMs_) {
+        backoffMs_ = backoffMs_ * 2 < maxBackoffMs_ ? backoffMs_ * 2 : maxBackoffMs_;
+        connect(now);
+      }
+      break;
+  }
+  return false;
+}
@@ -0,0 +1,38 @@
+// Background WiFi station link
+// begin() only starts the association and returns, so a sketch brings up its control loop
+// without waiting for the access point. poll() runs from the network task and follows the
+// link: it reports every (re)connection, and an attempt the AP does not answer within
+// connectTimeoutMs - at boot or after a drop the WiFi driver could not repair - is restarted
+// after a back-off that doubles up to maxBackoffMs. Nothing here blocks.
+
+#pragma once
+
+#include <stdint.h>
+
+class WifiLink {
+public:
+  WifiLink(const char* ssid, const char* password, uint32_t connectTimeoutMs = 15000, uint32_t maxBackoffMs = 60000)
+      : ssid_(ssid), password_(password), connectTimeoutMs_(connectTimeoutMs), maxBackoffMs_(maxBackoffMs) {}
+
+  void begin(uint32_t now);
+
+  // True on the pass the link came up
+  bool poll(uint32_t now);
+
+  bool connected() const { return state_ == CONNECTED; }
+  uint32_t attempts() const { return attempts_; }
+
+private:
+  enum State : uint8_t { CONNECTING, CONNECTED, WAITING };
+
+  void connect(uint32_t now);
+
+  const char* ssid_;
+  const char* password_;
+  uint32_t connectTimeoutMs_;
+  uint32_t maxBackoffMs_;
+  State state_ = WAITING;
+  uint32_t since_ = 0;      // CONNECTING: attempt start, WAITING: back-off start
+  uint32_t backoffMs_ = 0;
+  uint32_t attempts_ = 0;
+};
@@ -0,0 +1,75 @@
+"""Embed the web UI into the firmware as a gzip-compressed flash blob.
+
+PlatformIO pre-script: reads the page named by `custom_web_page` in the current env,
+gzips it and writes $BUILD_DIR/generated/web_index.h with
+
+    WEB_INDEX_GZ[]        - compressed bytes (const, stays in flash)
+    WEB_INDEX_GZ_LENGTH   - its size
+    WEB_INDEX_ETAG        - quoted content hash for If-None-Match / 304
+
+Can also be run by hand: python3 scripts/embed_web.py web/servo_control.html out.h
+"""
+
+import gzip
+import hashlib
+import os
+import sys
+
+
+def render_header(source_path, html):
+    compressed = gzip.compress(html, compresslevel=9, mtime=0)
+    etag = hashlib.sha1(compressed).hexdigest()[:16]
+
+    lines = [
+        "// Generated by scripts/embed_web.py from %s - do not edit" % os.path.basename(source_path),
+        "// %d bytes -> %d bytes gzip" % (len(html), len(compressed)),
+        "",
+        "#pragma once",
+        "",
+        "#include <stddef.h>",
+        "#include <stdint.h>",
+        "",
+        "static const uint8_t WEB_INDEX_GZ[] = {",
+    ]
+    for i in range(0, len(compressed), 16):
+        chunk = compressed[i:i + 16]
+        lines.append("  " + ", ".join("0x%02x" % b for b in chunk) + ",")
+    lines += [
+        "};",
+        "",
+        "static const size_t WEB_INDEX_GZ_LENGTH = sizeof(WEB_INDEX_GZ);",
+        'static const char WEB_INDEX_ETAG[] = "\\"%s\\"";' % etag,
+        "",
+    ]
+    return "\n".join(lines), len(html), len(compressed)
+
+
+def embed(source_path, header_path):
+    with open(source_path, "rb") as f:
+        html = f.read()
+    text, raw_size, gz_size = render_header(source_path, html)
+
+    # Rewrite only on change so the sketch is not rebuilt every time
+    if os.path.exists(header_path):
+        with open(header_path) as f:
+            if f.read() == text:
+                return raw_size, gz_size
+    os.makedirs(os.path.dirname(header_path) or ".", exist_ok=True)
+    with open(header_path, "w") as f:
+        f.write(text)
+    return raw_size, gz_size
+
+
+if __name__ == "__main__" and len(sys.argv) == 3:
+    raw, gz = embed(sys.argv[1], sys.argv[2])
+    print("%s: %d -> %d bytes" % (sys.argv[1], raw, gz))
+else:
+    Import("env")  # noqa: F821 - provided by PlatformIO
+
+    page = env.GetProjectOption("custom_web_page", "")  # noqa: F821
+    if page:
+        out_dir = os.path.join(env.subst("$BUILD_DIR"), "generated")  # noqa: F821
+        source = os.path.join(env.subst("$PROJECT_DIR"), page)  # noqa: F821
+        raw, gz = embed(source, os.path.join(out_dir, "web_index.h"))
+        print("Web UI %s: %d -> %d bytes gzip" % (page, raw, gz))
+        env.Append(CPPPATH=[out_dir])  # noqa: F821
@@ -0,0 +1,146 @@
+// Arduino core for the host simulation (see SimHal.h)
+// Only what the sketches use: time, GPIO/ADC, interrupts, Serial, ESP, and the FreeRTOS task
+// calls of the ESP32 core, mapped onto threads and the simulated clock.
+
+#pragma once
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include "SimHal.h"
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+#define INPUT_PULLDOWN 0x09
+
+#define RISING 0x01
+#define FALLING 0x02
+#define CHANGE 0x03
+
+#define IRAM_ATTR
+
+#define PI 3.1415926535897932384626433832795
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+using std::max;
+using std::min;
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+inline uint32_t getCpuFrequencyMhz() { return 240; }
+
+// ESP32 millis()/micros() are 32-bit and wrap; so do these
+inline unsigned long millis() { return (uint32_t)(sim::nowUs() / 1000); }
+inline unsigned long micros() { return (uint32_t)sim::nowUs(); }
+inline void delay(uint32_t ms) { sim::sleepUs((uint64_t)ms * 1000); }
+inline void delayMicroseconds(uint32_t us) { sim::sleepUs(us); }
+inline void yield() {}
+
+inline void pinMode(uint8_t pin, uint8_t mode) { sim::setPinMode(pin, mode); }
+inline int digitalRead(uint8_t pin) { return sim::readDigital(pin) ? HIGH : LOW; }
+inline void digitalWrite(uint8_t pin, uint8_t level) { sim::writeDigital(pin, level != LOW); }
+inline uint16_t analogRead(uint8_t pin) { return sim::readAnalog(pin); }
+
+inline int digitalPinToInterrupt(uint8_t pin) { return pin; }
+inline void attachInterrupt(int pin, void (*handler)(), int mode) { sim::attachIsr((uint8_t)pin, handler, mode); }
+inline void detachInterrupt(int pin) { sim::detachIsr((uint8_t)pin); }
+
+class Printable;
+
+// Serial: stdout, line-buffered across threads
+class HardwareSerial {
+public:
+  void begin(unsigned long baud) { (void)baud; }
+  int available() { return 0; }
+  int read() { return -1; }
+  void flush() { fflush(stdout); }
+
+  size_t print(const char* s) { return fputs(s, stdout) >= 0 ? strlen(s) : 0; }
+  size_t print(char c) { return putchar(c) != EOF ? 1 : 0; }
+  size_t print(int n) { return printf("%d", n); }
+  size_t print(unsigned int n) { return printf("%u", n); }
+  size_t print(long n) { return printf("%ld", n); }
+  size_t print(unsigned long n) { return printf("%lu", n); }
+  size_t print(double n, int digits = 2) { return printf("%.*f", digits, n); }
+  size_t print(const Printable& p);
+
+  template <typename T>
+  size_t println(const T& value) {
+    size_t n = print(value);
+    return n + println();
+  }
+  size_t println() {
+    putchar('\n');
+    fflush(stdout);
+    return 1;
+  }
+
+  int printf(const char* format, ...) __attribute__((format(printf, 2, 3))) {
+    va_list args;
+    va_start(args, format);
+    int n = vprintf(format, args);
+    va_end(args);
+    return n;
+  }
+};
+
+extern HardwareSerial Serial;
+
+class Printable {
+public:
+  virtual ~Printable() {}
+  virtual size_t printTo(HardwareSerial& out) const = 0;
+};
+
+inline size_t HardwareSerial::print(const Printable& p) { return p.printTo(*this); }
+
+// A device-sized heap: free = heap size minus what the host process has allocated, so
+// leaks and drift show up; the largest block is capped like the fragmented ESP32 heap
+class EspClass {
+public:
+  uint32_t getHeapSize() { return 327680; }
+  uint32_t getFreeHeap();
+  uint32_t getMinFreeHeap();
+  uint32_t getMaxAllocHeap();
+  uint32_t getCycleCount() { return (uint32_t)(sim::nowUs() * 240); }  // 240 MHz on the sim clock
+  const char* getSdkVersion() { return "native-sim"; }
+  void restart() { exit(0); }
+};
+
+extern EspClass ESP;
+
+// ===== FreeRTOS (ESP32 core) =====
+// Tasks are host threads; priorities and cores are not modelled. One tick = 1 ms.
+typedef uint32_t TickType_t;
+typedef void* TaskHandle_t;
+typedef int BaseType_t;
+typedef void (*TaskFunction_t)(void*);
+
+#define pdPASS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define portTICK_PERIOD_MS 1
+#define configTICK_RATE_HZ 1000
+#define portMAX_DELAY 0xFFFFFFFFu
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t task, const char* name, uint32_t stackDepth, void* param,
+                                   unsigned priority, TaskHandle_t* handle, int core);
+inline TickType_t xTaskGetTickCount() { return (TickType_t)millis(); }
+int xPortGetCoreID();  // the core the calling task was created for (setup()/loop(): 1)
+void vTaskDelay(TickType_t ticks);
+void vTaskDelayUntil(TickType_t* previousWake, TickType_t period);
+void vTaskDelete(TaskHandle_t task);
+
+// The sketch
+void setup();
+void loop();
@@ -0,0 +1,44 @@
+// ESP32Servo for the host simulation: every pulse-width change lands in sim::servoTimeline()
+
+#pragma once
+
+#include "Arduino.h"
+
+#define DEFAULT_uS_LOW 544
+#define DEFAULT_uS_HIGH 2400
+
+class Servo {
+public:
+  int attach(int pin) { return attach(pin, DEFAULT_uS_LOW, DEFAULT_uS_HIGH); }
+  int attach(int pin, int minUs, int maxUs) {
+    pin_ = pin;
+    minUs_ = minUs;
+    maxUs_ = maxUs;
+    return pin;
+  }
+  void detach() { pin_ = -1; }
+  bool attached() const { return pin_ >= 0; }
+  void setPeriodHertz(int hertz) { (void)hertz; }
+
+  // Degrees (below minUs, as in ESP32Servo) or microseconds
+  void write(int value) {
+    if (value < minUs_) {
+      value = constrain(value, 0, 180);
+      value = minUs_ + (maxUs_ - minUs_) * value / 180;
+    }
+    writeMicroseconds(value);
+  }
+  void writeMicroseconds(int us) {
+    if (!attached()) return;
+    pulseUs_ = constrain(us, minUs_, maxUs_);
+    sim::recordPulse((uint8_t)pin_, (uint16_t)pulseUs_);
+  }
+  int readMicroseconds() const { return pulseUs_; }
+  int read() const { return (pulseUs_ - minUs_) * 180 / (maxUs_ - minUs_); }
+
+private:
+  int pin_ = -1;
+  int minUs_ = DEFAULT_uS_LOW;
+  int maxUs_ = DEFAULT_uS_HIGH;
+  int pulseUs_ = 0;
+};
@@ -0,0 +1,56 @@
+// LittleFS for the host simulation: flat files in memory, optionally kept in a host directory
+// (sim::setFsDir / --fs). Sized like the 1.5 MB data partition of the default ESP32 table; a
+// write that does not fit comes back short, as on the device.
+
+#pragma once
+
+#include <memory>
+
+#include "Arduino.h"
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+namespace fs {
+
+class File {
+public:
+  explicit operator bool() const { return (bool)file_; }
+
+  size_t write(const uint8_t* buffer, size_t size);
+  size_t write(uint8_t byte) { return write(&byte, 1); }
+  size_t read(uint8_t* buffer, size_t size);
+  size_t size() const;
+  void close();  // also when the last copy goes away; a written file appears here
+
+private:
+  friend class LittleFSFS;
+  struct Open;
+  std::shared_ptr<Open> file_;
+};
+
+class LittleFSFS {
+public:
+  bool begin(bool formatOnFail = false, const char* basePath = "/littlefs", uint8_t maxOpenFiles = 10,
+             const char* partitionLabel = "spiffs");
+  void end() { mounted_ = false; }
+  bool format();
+
+  File open(const char* path, const char* mode = FILE_READ);
+  bool exists(const char* path);
+  bool remove(const char* path);
+  bool rename(const char* from, const char* to);  // replaces `to`
+
+  size_t totalBytes();
+  size_t usedBytes();
+
+private:
+  bool mounted_ = false;
+};
+
+}  // namespace fs
+
+using fs::File;
+
+extern fs::LittleFSFS LittleFS;
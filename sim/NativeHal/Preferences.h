@@ -0,0 +1,40 @@
+// Preferences (NVS) for the host simulation: in memory, optionally backed by a file
+// (sim::setNvsFile / --nvs)
+
+#pragma once
+
+#include "Arduino.h"
+
+class Preferences {
+public:
+  bool begin(const char* name, bool readOnly = false);
+  void end();
+
+  bool isKey(const char* key);
+  bool remove(const char* key);
+  bool clear();
+
+  size_t putBytes(const char* key, const void* value, size_t length);
+  size_t getBytes(const char* key, void* buffer, size_t maxLength);
+  size_t getBytesLength(const char* key);
+
+  size_t putUInt(const char* key, uint32_t value) { return putBytes(key, &value, sizeof(value)); }
+  uint32_t getUInt(const char* key, uint32_t defaultValue = 0) { return get(key, defaultValue); }
+  size_t putInt(const char* key, int32_t value) { return putBytes(key, &value, sizeof(value)); }
+  int32_t getInt(const char* key, int32_t defaultValue = 0) { return get(key, defaultValue); }
+  size_t putUChar(const char* key, uint8_t value) { return putBytes(key, &value, sizeof(value)); }
+  uint8_t getUChar(const char* key, uint8_t defaultValue = 0) { return get(key, defaultValue); }
+  size_t putFloat(const char* key, float value) { return putBytes(key, &value, sizeof(value)); }
+  float getFloat(const char* key, float defaultValue = 0) { return get(key, defaultValue); }
+
+private:
+  template <typename T>
+  T get(const char* key, T defaultValue) {
+    T value;
+    return getBytesLength(key) == sizeof(T) && getBytes(key, &value, sizeof(T)) == sizeof(T) ? value : defaultValue;
+  }
+
+  char namespace_[16] = {};
+  bool open_ = false;
+  bool readOnly_ = false;
+};
@@ -0,0 +1,717 @@
+// Host simulation: clock, pins, servo timeline, NVS, LittleFS, FreeRTOS tasks and main()
+
+#include "SimHal.h"
+
+#include <dirent.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+
+#include "Arduino.h"
+#include "LittleFS.h"
+#include "Preferences.h"
+#include "WiFi.h"
+
+HardwareSerial Serial;
+EspClass ESP;
+WiFiClass WiFi;
+fs::LittleFSFS LittleFS;
+
+// ===== Heap =====
+
+static const uint32_t SIM_HEAP_BASELINE = 65536;  // what the ESP32 core has taken before setup()
+static const uint32_t SIM_MAX_ALLOC = 114676;
+static std::atomic<uint32_t> minFreeHeap(UINT32_MAX);
+
+uint32_t EspClass::getFreeHeap() {
+#ifdef __GLIBC__
+  size_t used = mallinfo2().uordblks + SIM_HEAP_BASELINE;
+#else
+  size_t used = SIM_HEAP_BASELINE;  // no portable way to ask the allocator
+#endif
+  uint32_t freeBytes = used < getHeapSize() ? getHeapSize() - (uint32_t)used : 0;
+  uint32_t low = minFreeHeap.load();
+  while (freeBytes < low && !minFreeHeap.compare_exchange_weak(low, freeBytes)) {
+  }
+  return freeBytes;
+}
+
+uint32_t EspClass::getMinFreeHeap() {
+  getFreeHeap();
+  return minFreeHeap.load();
+}
+
+uint32_t EspClass::getMaxAllocHeap() {
+  uint32_t freeBytes = getFreeHeap();
+  return freeBytes < SIM_MAX_ALLOC ? freeBytes : SIM_MAX_ALLOC;
+}
+
+namespace sim {
+
+// ===== Clock =====
+// Simulated time = base + (host time since anchor) * speed; pause() freezes it at base
+
+static std::mutex clockMutex;
+static std::condition_variable clockChanged;
+static uint64_t baseUs = 0;
+static uint64_t anchorHostUs = 0;
+static double clockSpeed = 1.0;
+static bool clockPaused = false;
+
+static uint64_t hostUs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000u + ts.tv_nsec / 1000;
+}
+
+static uint64_t nowLocked() {
+  if (clockPaused) return baseUs;
+  return baseUs + (uint64_t)((hostUs() - anchorHostUs) * clockSpeed);
+}
+
+static void rebaseLocked() {
+  baseUs = nowLocked();
+  anchorHostUs = hostUs();
+}
+
+uint64_t nowUs() {
+  std::lock_guard<std::mutex> lock(clockMutex);
+  return nowLocked();
+}
+
+void setSpeed(double speed) {
+  std::lock_guard<std::mutex> lock(clockMutex);
+  rebaseLocked();
+  clockSpeed = speed > 0 ? speed : 1.0;
+  clockChanged.notify_all();
+}
+
+void pause() {
+  std::lock_guard<std::mutex> lock(clockMutex);
+  rebaseLocked();
+  clockPaused = true;
+}
+
+void resume() {
+  std::lock_guard<std::mutex> lock(clockMutex);
+  anchorHostUs = hostUs();
+  clockPaused = false;
+  clockChanged.notify_all();
+}
+
+void step(uint64_t us) {
+  std::lock_guard<std::mutex> lock(clockMutex);
+  if (!clockPaused) return;
+  baseUs += us;
+  clockChanged.notify_all();
+}
+
+void sleepUntilUs(uint64_t simUs) {
+  std::unique_lock<std::mutex> lock(clockMutex);
+  for (;;) {
+    uint64_t now = nowLocked();
+    if (now >= simUs) return;
+    if (clockPaused) {
+      clockChanged.wait(lock);
+    } else {
+      auto hostWait = std::chrono::microseconds((uint64_t)((simUs - now) / clockSpeed) + 1);
+      clockChanged.wait_for(lock, hostWait);
+    }
+  }
+}
+
+void sleepUs(uint64_t us) { sleepUntilUs(nowUs() + us); }
+
+// ===== Pins =====
+
+static const int PIN_COUNT = 40;
+static std::mutex pinMutex;
+static uint16_t analogValue[PIN_COUNT];
+static bool digitalLevel[PIN_COUNT];
+static bool outputLevel[PIN_COUNT];
+static void (*isrHandler[PIN_COUNT])();
+static int isrMode[PIN_COUNT];
+static uint16_t adcNoise = 0;
+static std::minstd_rand noiseSource(1);
+
+// Set at static initialization, so host tests that never call run() see the same defaults
+static bool pinsReady = [] {
+  for (int i = 0; i < PIN_COUNT; i++) {
+    analogValue[i] = 2048;
+    digitalLevel[i] = true;
+  }
+  return true;
+}();
+
+static bool validPin(uint8_t pin) { return pin < PIN_COUNT; }
+
+void setAnalog(uint8_t pin, uint16_t value) {
+  if (!validPin(pin)) return;
+  std::lock_guard<std::mutex> lock(pinMutex);
+  analogValue[pin] = value > 4095 ? 4095 : value;
+}
+
+void setDigital(uint8_t pin, bool level) {
+  if (!validPin(pin)) return;
+  void (*handler)() = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(pinMutex);
+    bool previous = digitalLevel[pin];
+    digitalLevel[pin] = level;
+    int mode = isrMode[pin];
+    bool fires = previous != level && (mode == CHANGE || (mode == RISING && level) || (mode == FALLING && !level));
+    if (fires) handler = isrHandler[pin];
+  }
+  if (handler) handler();  // on the caller's thread, like an ISR preempting the sketch
+}
+
+void setAdcNoise(uint16_t amplitude) {
+  std::lock_guard<std::mutex> lock(pinMutex);
+  adcNoise = amplitude;
+}
+
+uint16_t readAnalog(uint8_t pin) {
+  if (!validPin(pin)) return 0;
+  std::lock_guard<std::mutex> lock(pinMutex);
+  int value = analogValue[pin];
+  if (adcNoise > 0) value += (int)(noiseSource() % (2u * adcNoise + 1)) - adcNoise;
+  return (uint16_t)constrain(value, 0, 4095);
+}
+
+bool readDigital(uint8_t pin) {
+  if (!validPin(pin)) return false;
+  std::lock_guard<std::mutex> lock(pinMutex);
+  return digitalLevel[pin];
+}
+
+void writeDigital(uint8_t pin, bool level) {
+  if (!validPin(pin)) return;
+  std::lock_guard<std::mutex> lock(pinMutex);
+  outputLevel[pin] = level;
+}
+
+bool digitalOutput(uint8_t pin) {
+  if (!validPin(pin)) return false;
+  std::lock_guard<std::mutex> lock(pinMutex);
+  return outputLevel[pin];
+}
+
+void setPinMode(uint8_t pin, uint8_t mode) {
+  if (!validPin(pin)) return;
+  std::lock_guard<std::mutex> lock(pinMutex);
+  if (mode == INPUT_PULLDOWN) digitalLevel[pin] = false;
+}
+
+void attachIsr(uint8_t pin, void (*handler)(), int mode) {
+  if (!validPin(pin)) return;
+  std::lock_guard<std::mutex> lock(pinMutex);
+  isrHandler[pin] = handler;
+  isrMode[pin] = mode;
+}
+
+void detachIsr(uint8_t pin) { attachIsr(pin, nullptr, 0); }
+
+// ===== Input script =====
+
+struct ScriptEvent {
+  uint64_t timeUs;
+  bool analog;
+  uint8_t pin;
+  uint16_t value;
+};
+
+static std::vector<ScriptEvent> script;
+
+bool loadScript(const char* path) {
+  FILE* in = fopen(path, "r");
+  if (!in) return false;
+
+  char line[160];
+  int number = 0;
+  while (fgets(line, sizeof(line), in)) {
+    number++;
+    char* comment = strchr(line, '#');
+    if (comment) *comment = '\0';
+
+    double timeMs;
+    char kind[8];
+    unsigned pin, value;
+    int fields = sscanf(line, "%lf %7s %u %u", &timeMs, kind, &pin, &value);
+    if (fields <= 0) continue;
+    bool analog = strcmp(kind, "adc") == 0;
+    if (fields != 4 || (!analog && strcmp(kind, "gpio") != 0) || pin >= PIN_COUNT) {
+      fprintf(stderr, "%s:%d: expected '<time_ms> adc|gpio <pin> <value>'\n", path, number);
+      fclose(in);
+      return false;
+    }
+    script.push_back({(uint64_t)(timeMs * 1000), analog, (uint8_t)pin, (uint16_t)value});
+  }
+  fclose(in);
+  std::stable_sort(script.begin(), script.end(),
+                   [](const ScriptEvent& a, const ScriptEvent& b) { return a.timeUs < b.timeUs; });
+  return true;
+}
+
+void startScript() {
+  if (script.empty()) return;
+  std::thread([] {
+    for (const ScriptEvent& event : script) {
+      sleepUntilUs(event.timeUs);
+      if (event.analog) {
+        setAnalog(event.pin, event.value);
+      } else {
+        setDigital(event.pin, event.value != 0);
+      }
+    }
+  }).detach();
+}
+
+// ===== Servo timeline =====
+
+static const size_t TIMELINE_LIMIT = 4u << 20;
+static std::mutex timelineMutex;
+static std::vector<PwmSample> timeline;
+static uint16_t currentPulse[PIN_COUNT];
+
+void recordPulse(uint8_t pin, uint16_t pulseUs) {
+  if (!validPin(pin)) return;
+  std::lock_guard<std::mutex> lock(timelineMutex);
+  if (currentPulse[pin] == pulseUs) return;
+  currentPulse[pin] = pulseUs;
+  if (timeline.size() < TIMELINE_LIMIT) timeline.push_back({nowUs(), pin, pulseUs});
+}
+
+std::vector<PwmSample> servoTimeline() {
+  std::lock_guard<std::mutex> lock(timelineMutex);
+  return timeline;
+}
+
+uint16_t servoPulse(uint8_t pin) {
+  if (!validPin(pin)) return 0;
+  std::lock_guard<std::mutex> lock(timelineMutex);
+  return currentPulse[pin];
+}
+
+void writeTimelineCsv(FILE* out) {
+  std::lock_guard<std::mutex> lock(timelineMutex);
+  fprintf(out, "time_us,pin,pulse_us\n");
+  for (const PwmSample& sample : timeline) {
+    fprintf(out, "%llu,%u,%u\n", (unsigned long long)sample.timeUs, sample.pin, sample.pulseUs);
+  }
+}
+
+// ===== NVS =====
+// File format: one "namespace key hexbytes" line per entry
+
+typedef std::map<std::string, std::string> NvsNamespace;
+static std::mutex nvsMutex;
+static std::map<std::string, NvsNamespace> nvs;
+static std::string nvsPath;
+
+static void loadNvsFile() {
+  FILE* in = fopen(nvsPath.c_str(), "r");
+  if (!in) return;
+  char ns[32], key[32], hex[4096];
+  while (fscanf(in, "%31s %31s %4095s", ns, key, hex) == 3) {
+    std::string bytes;
+    for (size_t i = 0; hex[i] && hex[i + 1]; i += 2) {
+      unsigned byte;
+      sscanf(hex + i, "%2x", &byte);
+      bytes.push_back((char)byte);
+    }
+    nvs[ns][key] = bytes;
+  }
+  fclose(in);
+}
+
+static void saveNvsFile() {
+  if (nvsPath.empty()) return;
+  FILE* out = fopen(nvsPath.c_str(), "w");
+  if (!out) return;
+  for (const auto& ns : nvs) {
+    for (const auto& entry : ns.second) {
+      fprintf(out, "%s %s ", ns.first.c_str(), entry.first.c_str());
+      for (unsigned char c : entry.second) fprintf(out, "%02x", c);
+      fprintf(out, entry.second.empty() ? "-\n" : "\n");
+    }
+  }
+  fclose(out);
+}
+
+void setNvsFile(const char* path) {
+  std::lock_guard<std::mutex> lock(nvsMutex);
+  nvsPath = path;
+  loadNvsFile();
+}
+
+}  // namespace sim
+
+// ===== Preferences =====
+
+bool Preferences::begin(const char* name, bool readOnly) {
+  if (strlen(name) >= sizeof(namespace_)) return false;  // NVS limit: 15 characters
+  strcpy(namespace_, name);
+  readOnly_ = readOnly;
+  open_ = true;
+  return true;
+}
+
+void Preferences::end() { open_ = false; }
+
+bool Preferences::isKey(const char* key) {
+  std::lock_guard<std::mutex> lock(sim::nvsMutex);
+  return open_ && sim::nvs[namespace_].count(key) > 0;
+}
+
+bool Preferences::remove(const char* key) {
+  if (!open_ || readOnly_) return false;
+  std::lock_guard<std::mutex> lock(sim::nvsMutex);
+  bool removed = sim::nvs[namespace_].erase(key) > 0;
+  sim::saveNvsFile();
+  return removed;
+}
+
+bool Preferences::clear() {
+  if (!open_ || readOnly_) return false;
+  std::lock_guard<std::mutex> lock(sim::nvsMutex);
+  sim::nvs[namespace_].clear();
+  sim::saveNvsFile();
+  return true;
+}
+
+size_t Preferences::putBytes(const char* key, const void* value, size_t length) {
+  if (!open_ || readOnly_ || strlen(key) > 15) return 0;
+  std::lock_guard<std::mutex> lock(sim::nvsMutex);
+  sim::nvs[namespace_][key] = std::string(static_cast<const char*>(value), length);
+  sim::saveNvsFile();
+  return length;
+}
+
+size_t Preferences::getBytes(const char* key, void* buffer, size_t maxLength) {
+  if (!open_) return 0;
+  std::lock_guard<std::mutex> lock(sim::nvsMutex);
+  auto& ns = sim::nvs[namespace_];
+  auto entry = ns.find(key);
+  if (entry == ns.end() || entry->second.size() > maxLength) return 0;
+  memcpy(buffer, entry->second.data(), entry->second.size());
+  return entry->second.size();
+}
+
+size_t Preferences::getBytesLength(const char* key) {
+  if (!open_) return 0;
+  std::lock_guard<std::mutex> lock(sim::nvsMutex);
+  auto& ns = sim::nvs[namespace_];
+  auto entry = ns.find(key);
+  return entry == ns.end() ? 0 : entry->second.size();
+}
+
+// ===== LittleFS =====
+// Whole files in memory; a file opened for writing replaces the stored one on close()
+
+namespace sim {
+
+static const size_t FS_TOTAL_BYTES = 0x160000;  // "spiffs" partition of default.csv
+static std::mutex fsMutex;
+static std::map<std::string, std::string> files;
+static std::string fsDir;
+
+static std::string hostPath(const std::string& path) { return fsDir + "/" + path.substr(path.find_first_not_of('/')); }
+
+static size_t fsUsedLocked() {
+  size_t used = 0;
+  for (const auto& file : files) used += file.second.size();
+  return used;
+}
+
+void setFsDir(const char* path) {
+  std::lock_guard<std::mutex> lock(fsMutex);
+  fsDir = path;
+  DIR* dir = opendir(path);
+  if (!dir) return;
+  while (dirent* entry = readdir(dir)) {
+    if (entry->d_name[0] == '.') continue;
+    std::string name = std::string("/") + entry->d_name;
+    FILE* in = fopen(hostPath(name).c_str(), "rb");
+    if (!in) continue;
+    std::string bytes;
+    char buffer[4096];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), in)) > 0) bytes.append(buffer, n);
+    fclose(in);
+    files[name] = bytes;
+  }
+  closedir(dir);
+}
+
+static void storeFileLocked(const std::string& path, const std::string& bytes) {
+  files[path] = bytes;
+  if (fsDir.empty()) return;
+  FILE* out = fopen(hostPath(path).c_str(), "wb");
+  if (!out) return;
+  fwrite(bytes.data(), 1, bytes.size(), out);
+  fclose(out);
+}
+
+}  // namespace sim
+
+struct fs::File::Open {
+  std::string path;
+  std::string bytes;
+  size_t pos = 0;
+  bool writing = false;
+  size_t room = 0;  // free space when opened for writing
+
+  ~Open() {
+    if (!writing) return;
+    std::lock_guard<std::mutex> lock(sim::fsMutex);
+    sim::storeFileLocked(path, bytes);
+  }
+};
+
+size_t fs::File::write(const uint8_t* buffer, size_t size) {
+  if (!file_ || !file_->writing) return 0;
+  size_t fits = size < file_->room ? size : file_->room;
+  file_->bytes.append(reinterpret_cast<const char*>(buffer), fits);
+  file_->room -= fits;
+  return fits;
+}
+
+size_t fs::File::read(uint8_t* buffer, size_t size) {
+  if (!file_ || file_->writing) return 0;
+  size_t left = file_->bytes.size() - file_->pos;
+  size_t n = size < left ? size : left;
+  memcpy(buffer, file_->bytes.data() + file_->pos, n);
+  file_->pos += n;
+  return n;
+}
+
+size_t fs::File::size() const { return file_ ? file_->bytes.size() : 0; }
+
+void fs::File::close() { file_.reset(); }
+
+bool fs::LittleFSFS::begin(bool, const char*, uint8_t, const char*) {
+  mounted_ = true;
+  return true;
+}
+
+bool fs::LittleFSFS::format() {
+  std::lock_guard<std::mutex> lock(sim::fsMutex);
+  for (const auto& file : sim::files) {
+    if (!sim::fsDir.empty()) ::remove(sim::hostPath(file.first).c_str());
+  }
+  sim::files.clear();
+  return true;
+}
+
+fs::File fs::LittleFSFS::open(const char* path, const char* mode) {
+  File file;
+  if (!mounted_ || path[0] != '/') return file;
+  std::lock_guard<std::mutex> lock(sim::fsMutex);
+  auto stored = sim::files.find(path);
+  bool write = mode[0] == 'w' || mode[0] == 'a';
+  if (!write && stored == sim::files.end()) return file;
+
+  file.file_ = std::make_shared<File::Open>();
+  file.file_->path = path;
+  file.file_->writing = write;
+  if (mode[0] != 'w' && stored != sim::files.end()) file.file_->bytes = stored->second;
+  if (write) {
+    // The old contents stay allocated until the new ones replace them on close()
+    size_t used = sim::fsUsedLocked() + file.file_->bytes.size();
+    file.file_->room = used < sim::FS_TOTAL_BYTES ? sim::FS_TOTAL_BYTES - used : 0;
+  }
+  return file;
+}
+
+bool fs::LittleFSFS::exists(const char* path) {
+  std::lock_guard<std::mutex> lock(sim::fsMutex);
+  return mounted_ && sim::files.count(path) > 0;
+}
+
+bool fs::LittleFSFS::remove(const char* path) {
+  std::lock_guard<std::mutex> lock(sim::fsMutex);
+  if (!mounted_ || sim::files.erase(path) == 0) return false;
+  if (!sim::fsDir.empty()) ::remove(sim::hostPath(path).c_str());
+  return true;
+}
+
+bool fs::LittleFSFS::rename(const char* from, const char* to) {
+  std::lock_guard<std::mutex> lock(sim::fsMutex);
+  auto file = sim::files.find(from);
+  if (!mounted_ || file == sim::files.end() || to[0] != '/') return false;
+  std::string bytes = file->second;
+  sim::files.erase(file);
+  sim::files[to] = bytes;
+  if (!sim::fsDir.empty()) ::rename(sim::hostPath(from).c_str(), sim::hostPath(to).c_str());
+  return true;
+}
+
+size_t fs::LittleFSFS::totalBytes() { return sim::FS_TOTAL_BYTES; }
+
+size_t fs::LittleFSFS::usedBytes() {
+  std::lock_guard<std::mutex> lock(sim::fsMutex);
+  return sim::fsUsedLocked();
+}
+
+// ===== FreeRTOS =====
+
+struct TaskStart {
+  TaskFunction_t task;
+  void* param;
+  int core;
+};
+
+static thread_local int taskCore = 1;  // the Arduino loop task runs on core 1
+
+int xPortGetCoreID() { return taskCore; }
+
+static void* runTask(void* arg) {
+  TaskStart start = *static_cast<TaskStart*>(arg);
+  delete static_cast<TaskStart*>(arg);
+  taskCore = start.core;
+  start.task(start.param);
+  return nullptr;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t task, const char* name, uint32_t stackDepth, void* param,
+                                   unsigned priority, TaskHandle_t* handle, int core) {
+  (void)name;
+  (void)priority;
+  pthread_attr_t attr;
+  pthread_attr_init(&attr);
+  // Host frames are bigger than Xtensa ones; never give a task less than 256 KB
+  size_t stack = stackDepth * 16 > (256u << 10) ? stackDepth * 16 : (256u << 10);
+  pthread_attr_setstacksize(&attr, stack);
+  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+
+  pthread_t thread;
+  int error = pthread_create(&thread, &attr, runTask, new TaskStart{task, param, core == 0 ? 0 : 1});
+  pthread_attr_destroy(&attr);
+  if (handle) *handle = error == 0 ? reinterpret_cast<TaskHandle_t>(thread) : nullptr;
+  return error == 0 ? pdPASS : 0;
+}
+
+void vTaskDelay(TickType_t ticks) { sim::sleepUs((uint64_t)ticks * 1000); }
+
+void vTaskDelayUntil(TickType_t* previousWake, TickType_t period) {
+  // Same as FreeRTOS: the wake time advances by exactly one period, a late task catches up
+  *previousWake += period;
+  uint64_t now = sim::nowUs();
+  uint32_t nowTicks = (uint32_t)(now / 1000);
+  int32_t ahead = (int32_t)(*previousWake - nowTicks);
+  if (ahead > 0) sim::sleepUntilUs(now - now % 1000 + (uint64_t)ahead * 1000);
+}
+
+static pthread_t mainThread;
+static std::atomic<bool> stopRequested(false);
+
+void vTaskDelete(TaskHandle_t task) {
+  if (task != nullptr) return;  // deleting other tasks is not supported
+  if (pthread_equal(pthread_self(), mainThread)) {
+    // loop() ends the Arduino task: the main thread just waits for the end of the run
+    while (!stopRequested) sim::sleepUs(10000);
+    return;
+  }
+  pthread_exit(nullptr);
+}
+
+// ===== main =====
+// Under the PlatformIO test runner the test file has its own main() and no setup()/loop()
+#ifndef PIO_UNIT_TESTING
+
+namespace sim {
+
+static void onSignal(int) { stopRequested = true; }
+
+static void usage(const char* program) {
+  fprintf(stderr,
+          "usage: %s [--speed X] [--seconds N] [--script FILE] [--adc-noise N] [--timeline FILE.csv] "
+          "[--nvs FILE] [--fs DIR]\n",
+          program);
+}
+
+int run(int argc, char** argv) {
+  double seconds = 0;
+  const char* timelinePath = nullptr;
+  anchorHostUs = hostUs();  // simulated time starts at 0 with the process
+
+  for (int i = 1; i < argc; i++) {
+    const char* arg = argv[i];
+    const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+    if (!value) {
+      usage(argv[0]);
+      return 2;
+    }
+    if (strcmp(arg, "--speed") == 0) {
+      setSpeed(atof(value));
+    } else if (strcmp(arg, "--seconds") == 0) {
+      seconds = atof(value);
+    } else if (strcmp(arg, "--script") == 0) {
+      if (!loadScript(value)) {
+        fprintf(stderr, "cannot load script %s\n", value);
+        return 2;
+      }
+    } else if (strcmp(arg, "--adc-noise") == 0) {
+      setAdcNoise((uint16_t)atoi(value));
+    } else if (strcmp(arg, "--timeline") == 0) {
+      timelinePath = value;
+    } else if (strcmp(arg, "--nvs") == 0) {
+      setNvsFile(value);
+    } else if (strcmp(arg, "--fs") == 0) {
+      setFsDir(value);
+    } else {
+      usage(argv[0]);
+      return 2;
+    }
+    i++;
+  }
+
+  mainThread = pthread_self();
+  signal(SIGINT, onSignal);
+  signal(SIGTERM, onSignal);
+  signal(SIGPIPE, SIG_IGN);
+  setvbuf(stdout, nullptr, _IOLBF, 0);
+
+  if (seconds > 0) {
+    std::thread([seconds] {
+      sleepUntilUs((uint64_t)(seconds * 1e6));
+      stopRequested = true;
+    }).detach();
+  }
+
+  startScript();
+  setup();
+  while (!stopRequested) loop();
+
+  if (timelinePath) {
+    FILE* out = fopen(timelinePath, "w");
+    if (out) {
+      writeTimelineCsv(out);
+      fclose(out);
+    }
+    fprintf(stderr, "servo timeline: %zu samples -> %s\n", servoTimeline().size(), timelinePath);
+  }
+  fflush(stdout);
+  _exit(0);  // tasks are still running; skip static destructors under their feet
+}
+
+}  // namespace sim
+
+int main(int argc, char** argv) { return sim::run(argc, argv); }
+
+#endif  // PIO_UNIT_TESTING
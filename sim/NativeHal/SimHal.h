@@ -0,0 +1,76 @@
+// Host simulation control
+// The mock Arduino/FreeRTOS/WiFi/Servo/Preferences/LittleFS headers in this directory let the
+// sketches build and run unmodified on Linux. This is the side the simulation (and host tests)
+// drives: the clock, scripted inputs and the recorded servo output.
+//
+// Time: sim::nowUs() is what millis()/micros() return (wrapped to 32 bits like on the ESP32).
+// It follows the host clock scaled by setSpeed(), or stands still after pause() and only
+// moves on step(), so a test can run the control task tick by tick.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <vector>
+
+namespace sim {
+
+// ===== Clock =====
+uint64_t nowUs();
+void setSpeed(double speed);  // 1 = real time, 10 = ten times faster
+void pause();
+void resume();
+void step(uint64_t us);        // paused only: advance and wake whoever it is due
+void sleepUntilUs(uint64_t simUs);
+void sleepUs(uint64_t us);
+
+// ===== Inputs =====
+// Pins default to mid-scale on the ADC (a centered joystick) and HIGH on the digital side
+// (pull-ups). Digital changes fire attachInterrupt() handlers like an edge on the device.
+void setAnalog(uint8_t pin, uint16_t value);
+void setDigital(uint8_t pin, bool level);
+void setAdcNoise(uint16_t amplitude);  // +-amplitude of uniform noise on every analogRead()
+
+// Script lines: "<time_ms> adc <pin> <value>" or "<time_ms> gpio <pin> <0|1>", '#' comments.
+// Events are applied at their simulated time by a background thread.
+bool loadScript(const char* path);
+void startScript();
+
+// ===== Outputs =====
+struct PwmSample {
+  uint64_t timeUs;
+  uint8_t pin;
+  uint16_t pulseUs;
+};
+
+// Every pulse-width change of every attached servo, in time order
+std::vector<PwmSample> servoTimeline();
+uint16_t servoPulse(uint8_t pin);  // current pulse width, 0 when not attached
+bool digitalOutput(uint8_t pin);   // last digitalWrite()
+void writeTimelineCsv(FILE* out);
+
+// ===== NVS =====
+// Preferences live in memory; with a file they survive a restart of the simulation
+void setNvsFile(const char* path);
+
+// ===== LittleFS =====
+// Files live in memory; with a directory they are loaded from and written through to it
+void setFsDir(const char* path);
+
+// ===== Internals used by the mock headers =====
+void recordPulse(uint8_t pin, uint16_t pulseUs);
+uint16_t readAnalog(uint8_t pin);
+bool readDigital(uint8_t pin);
+void writeDigital(uint8_t pin, bool level);
+void setPinMode(uint8_t pin, uint8_t mode);
+void attachIsr(uint8_t pin, void (*handler)(), int mode);
+void detachIsr(uint8_t pin);
+
+// Runs setup() and then loop() until `seconds` of simulated time have passed (0 = until
+// SIGINT), then writes the servo timeline if a path was given. Not built for unit tests
+// (PIO_UNIT_TESTING), which bring their own main().
+int run(int argc, char** argv);
+
+}  // namespace sim
@@ -0,0 +1,66 @@
+// WiFi for the host simulation: "connects" at once, the sockets are the host's
+
+#pragma once
+
+#include "Arduino.h"
+
+typedef enum {
+  WL_IDLE_STATUS = 0,
+  WL_NO_SSID_AVAIL = 1,
+  WL_CONNECTED = 3,
+  WL_CONNECT_FAILED = 4,
+  WL_CONNECTION_LOST = 5,
+  WL_DISCONNECTED = 6
+} wl_status_t;
+
+#define WIFI_STA 1
+
+class IPAddress : public Printable {
+public:
+  IPAddress(uint8_t a = 0, uint8_t b = 0, uint8_t c = 0, uint8_t d = 0) : bytes_{a, b, c, d} {}
+  size_t printTo(HardwareSerial& out) const override {
+    char text[16];
+    snprintf(text, sizeof(text), "%u.%u.%u.%u", bytes_[0], bytes_[1], bytes_[2], bytes_[3]);
+    return out.print(text);
+  }
+  uint8_t operator[](int i) const { return bytes_[i]; }
+
+private:
+  uint8_t bytes_[4];
+};
+
+class WiFiClass {
+public:
+  wl_status_t begin(const char* ssid, const char* password = nullptr) {
+    (void)ssid;
+    (void)password;
+    status_ = WL_CONNECTED;
+    return status_;
+  }
+  bool disconnect(bool wifiOff = false) {
+    (void)wifiOff;
+    status_ = WL_DISCONNECTED;
+    return true;
+  }
+  bool reconnect() {
+    status_ = WL_CONNECTED;
+    return true;
+  }
+  bool mode(int m) {
+    (void)m;
+    return true;
+  }
+  bool setAutoReconnect(bool on) {
+    (void)on;
+    return true;
+  }
+  wl_status_t status() const { return status_; }
+  bool isConnected() const { return status_ == WL_CONNECTED; }
+  int8_t RSSI() const { return status_ == WL_CONNECTED ? -50 : 0; }
+  IPAddress localIP() const { return IPAddress(127, 0, 0, 1); }
+
+private:
+  wl_status_t status_ = WL_IDLE_STATUS;
+};
+
+extern WiFiClass WiFi;
@@ -0,0 +1,6 @@
+// Fallback for the host simulation; include/wifi_credentials.h takes precedence when present
+
+#pragma once
+
+#define WIFI_SSID "native-sim"
+#define WIFI_PASSWORD ""
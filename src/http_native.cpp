@@ -0,0 +1,251 @@
+// HTTP server host build - Linux
+// Serves the servo_control / webcam_platform route table from lib/HttpServer with the same
+// request parsing and JSON payloads, so throughput and latency can be measured locally:
+//
+//   pio run -e http_native && .pio/build/http_native/program 8080
+//   python3 tools/http_load.py --port 8080 --connections 8 --requests 2000
+//
+// It also runs the webcam_platform UDP control endpoint (lib/UdpControl) with a simulated
+// 10 ms control tick, so command-to-servo latency can be measured with tools/udp_joystick.py:
+//
+//   .pio/build/http_native/program 8080 4210
+//   python3 tools/udp_joystick.py --port 4210 --rate 100 --seconds 10
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <ArduinoJson.h>
+#include "HttpServer.h"
+#include "JsonExchange.h"
+#include "RouteTable.h"
+#include "AllocCounter.h"
+#include "UdpControl.h"
+
+// Stand-in for the device state
+static int currentAngle = 90;
+static int cycleCount = 0;
+static int scanSpeed = 300;
+static int commandCount = 0;
+static bool ledState = false;
+static time_t startTime = 0;
+static volatile bool running = true;
+
+// Stand-in for the control task: UDP commands wait for the next tick, like on the device
+static const uint32_t CONTROL_PERIOD_US = 10000;
+static const uint32_t UDP_WATCHDOG_MS = 250;
+static float remoteAngle = 90;
+static float remoteRate = 0;
+static bool udpPending = false;
+static UdpCommand udpCommand;
+static uint32_t udpReceivedUs = 0;
+
+static uint32_t monotonicUs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)(ts.tv_sec * 1000000u + ts.tv_nsec / 1000);
+}
+
+static void handleApiStatus(HttpRequest&, HttpResponse& res) {
+  JsonExchange json;
+  JsonDocument& doc = json.response;
+  doc["status"] = "ok";
+  doc["led"] = ledState ? "on" : "off";
+  doc["servo_angle"] = currentAngle;
+  doc["servo_target"] = currentAngle;
+  doc["moving"] = false;
+  doc["cycle_running"] = false;
+  doc["cycle_count"] = cycleCount;
+  doc["uptime"] = (long)(time(nullptr) - startTime);
+  doc["freeHeap"] = 0;
+  doc["commands"] = commandCount;
+  doc["rssi"] = 0;
+  json.send(res, 200);
+}
+
+static void handleApiLed(JsonExchange& json, HttpRequest&, HttpResponse& res) {
+  JsonDocument& doc = json.request;
+  const char* state = doc["state"] | "";
+  ledState = strcmp(state, "on") == 0;
+  commandCount++;
+  res.send(200, "application/json", ledState ? "{\"status\":\"ok\",\"led\":\"on\"}" : "{\"status\":\"ok\",\"led\":\"off\"}");
+}
+
+static void handleApiServo(JsonExchange& json, HttpRequest&, HttpResponse& res) {
+  JsonDocument& doc = json.request;
+  int angle = doc["angle"] | -1;
+  if (angle < 0 || angle > 180) {
+    res.send(400, "application/json", "{\"error\":\"Angle must be 0-180\"}");
+    return;
+  }
+  currentAngle = angle;
+  commandCount++;
+
+  JsonDocument& responseDoc = json.response;
+  responseDoc["status"] = "ok";
+  responseDoc["angle"] = angle;
+  json.send(res, 200);
+}
+
+static void handleApiServoSweep(JsonExchange& json, HttpRequest&, HttpResponse& res) {
+  JsonDocument& doc = json.request;
+  int target = doc["target"] | -1;
+  if (target < 0 || target > 180) {
+    res.send(400, "application/json", "{\"error\":\"Target must be 0-180\"}");
+    return;
+  }
+  commandCount++;
+
+  JsonDocument& responseDoc = json.response;
+  responseDoc["status"] = "ok";
+  responseDoc["from"] = currentAngle;
+  responseDoc["to"] = target;
+  responseDoc["speed"] = doc["speed"] | 15;
+  json.send(res, 200);
+  currentAngle = target;
+}
+
+static void handleApiServoCycle(JsonExchange& json, HttpRequest&, HttpResponse& res) {
+  JsonDocument& doc = json.request;
+  commandCount++;
+
+  JsonDocument& responseDoc = json.response;
+  responseDoc["status"] = "ok";
+  responseDoc["cycles"] = doc["count"] | 1;
+  responseDoc["delay"] = doc["delay"] | 300;
+  json.send(res, 200);
+}
+
+static void handleApiServoStop(HttpRequest&, HttpResponse& res) {
+  commandCount++;
+  JsonExchange json;
+  JsonDocument& responseDoc = json.response;
+  responseDoc["status"] = "ok";
+  responseDoc["stopped_at"] = cycleCount;
+  json.send(res, 200);
+}
+
+static void handleApiSetAngle(JsonExchange& json, HttpRequest&, HttpResponse& res) {
+  JsonDocument& doc = json.request;
+  int angle = doc["angle"] | 90;
+  currentAngle = angle < 0 ? 0 : (angle > 180 ? 180 : angle);
+  commandCount++;
+
+  JsonDocument& response = json.response;
+  response["status"] = "ok";
+  response["angle"] = currentAngle;
+  json.send(res, 200);
+}
+
+static void handleApiScan(JsonExchange& json, HttpRequest&, HttpResponse& res) {
+  JsonDocument& doc = json.request;
+  scanSpeed = doc["speed"] | 300;
+  commandCount++;
+
+  JsonDocument& response = json.response;
+  response["status"] = "scanning";
+  response["speed"] = scanSpeed;
+  json.send(res, 200);
+}
+
+static void handleApiStop(HttpRequest&, HttpResponse& res) {
+  currentAngle = 90;
+  res.send(200, "application/json", "{\"status\":\"standby\"}");
+}
+
+constexpr HttpRoute ROUTES[] = {
+  {"/api/status", HttpMethod::Get, handleApiStatus},
+  {"/api/led", HttpMethod::Post, jsonRoute<handleApiLed>},
+  {"/api/servo", HttpMethod::Post, jsonRoute<handleApiServo>},
+  {"/api/servo/sweep", HttpMethod::Post, jsonRoute<handleApiServoSweep>},
+  {"/api/servo/cycle", HttpMethod::Post, jsonRoute<handleApiServoCycle>},
+  {"/api/servo/stop", HttpMethod::Post, handleApiServoStop},
+  {"/api/angle", HttpMethod::Post, jsonRoute<handleApiSetAngle>},
+  {"/api/scan", HttpMethod::Post, jsonRoute<handleApiScan>},
+  {"/api/stop", HttpMethod::Post, handleApiStop},
+};
+ROUTE_TABLE(routeTable, ROUTES);
+
+// One control tick: apply the newest UDP command, move, and ack it with the measured latency
+static void controlTick(UdpControl& udp, uint32_t) {
+  if (udpPending) {
+    if (udpCommand.type == UDP_ANGLE) {
+      remoteAngle = udpCommand.value / 100.0f;
+      remoteRate = 0;
+    } else if (udpCommand.type == UDP_RATE) {
+      remoteRate = udpCommand.value / 10.0f;
+    } else {
+      remoteAngle = 90;
+      remoteRate = 0;
+    }
+  }
+
+  remoteAngle += remoteRate * CONTROL_PERIOD_US / 1e6f;
+  remoteAngle = remoteAngle < 0 ? 0 : (remoteAngle > 180 ? 180 : remoteAngle);
+  currentAngle = (int)(remoteAngle + 0.5f);  // the "PWM write"
+
+  if (udpPending) {
+    udpPending = false;
+    udp.applied(udpCommand.seq, (int16_t)(remoteAngle * 100), monotonicUs() - udpReceivedUs);
+  }
+}
+
+int main(int argc, char** argv) {
+  uint16_t port = argc > 1 ? (uint16_t)atoi(argv[1]) : 8080;
+  uint16_t udpPort = argc > 2 ? (uint16_t)atoi(argv[2]) : 4210;
+  static HttpServer server(port);
+  static UdpControl udp(udpPort, UDP_WATCHDOG_MS);
+
+  signal(SIGINT, [](int) { running = false; });
+  signal(SIGTERM, [](int) { running = false; });
+  startTime = time(nullptr);
+
+  useRoutes(server, routeTable);
+  server.setAllocProbe(allocCount);
+
+  if (!server.begin()) {
+    fprintf(stderr, "Cannot listen on port %u\n", port);
+    return 1;
+  }
+  printf("HTTP server listening on :%u\n", port);
+  if (udp.begin()) {
+    server.wakeOn(udp.fd());
+    printf("UDP control listening on :%u\n", udpPort);
+  }
+
+  uint32_t nextTickUs = monotonicUs();
+  while (running) {
+    int32_t waitUs = (int32_t)(nextTickUs - monotonicUs());
+    server.poll(waitUs > 0 ? (uint32_t)waitUs / 1000 : 0);
+
+    uint32_t nowUs = monotonicUs();
+    UdpCommand command;
+    if (udp.poll(nowUs, command)) {
+      udpCommand = command;  // latest wins until the next tick
+      udpPending = true;
+      udpReceivedUs = nowUs;
+    }
+    if (udp.watchdogExpired(nowUs)) remoteRate = 0;
+
+    if ((int32_t)(nowUs - nextTickUs) >= 0) {
+      controlTick(udp, nowUs);
+      nextTickUs += CONTROL_PERIOD_US;
+      if ((int32_t)(nowUs - nextTickUs) > 0) nextTickUs = nowUs + CONTROL_PERIOD_US;  // fell behind
+    }
+  }
+
+  const HttpServerStats& stats = server.stats();
+  printf("accepted: %u, rejected: %u, requests: %u, timeouts: %u, errors: %u\n",
+         stats.accepted, stats.rejected, stats.requests, stats.timeouts, stats.errors);
+  const UdpControlStats& udpStats = udp.stats();
+  printf("udp received: %u, accepted: %u, stale: %u, superseded: %u, malformed: %u, acks: %u, watchdog: %u\n",
+         udpStats.received, udpStats.accepted, udpStats.stale, udpStats.superseded, udpStats.malformed,
+         udpStats.acks, udpStats.watchdogTrips);
+  if (allocCounterEnabled()) {
+    printf("handler allocations: %u in %u of %u requests\n", stats.handlerAllocs, stats.allocRequests,
+           stats.requests);
+  }
+  return 0;
+}
@@ -5,445 +5,1317 @@
 // Історичний момент: 15 лютого 2026 - революційний день
 
 #include <WiFi.h>
-#include <WebServer.h>
 #include <ArduinoJson.h>
-#include <ESP32Servo.h>
+#include "HttpServer.h"
+#include "JsonExchange.h"
+#include "RouteTable.h"
+#include "AllocCounter.h"
+#include "WebSocketTelemetry.h"
+#include "web_index.h"
+#include "AxisMotion.h"
+#include "Trajectory.h"
+#include "ScanPattern.h"
+#include "PresetTable.h"
+#include "CalibratedServo.h"
+#include "CalibrationStore.h"
+#include "ServoModel.h"
+#include "SpscQueue.h"
+#include "LatestSlot.h"
+#include "StateSnapshot.h"
+#include "TickStats.h"
+#include "Trace.h"
+#include "Log.h"
+#include "Metrics.h"
+#include "MetricsExport.h"
+#include "SystemMetrics.h"
+#include "WifiLink.h"
+#include "StateStore.h"
+#ifdef BENCH
+#include "BenchRunner.h"
+#include "LogCostBench.h"
+#endif
+#ifdef TRACE
+#include "TraceExport.h"
+#endif
 
 // ===== НАЛАШТУВАННЯ WiFi =====
 #include "wifi_credentials.h"
 
 // Веб-сервер на порту 80
-WebServer server(80);
+HttpServer server(80);
+
+// WiFi підключається у фоні (задача мережі), керування servo не чекає на точку доступу
+WifiLink wifiLink(WIFI_SSID, WIFI_PASSWORD);
+
+// WebSocket /ws: push стану при зміні, не частіше ніж раз на 50 мс на клієнта
+const uint32_t WS_MIN_INTERVAL_MS = 50;
+WebSocketTelemetry telemetry(server, WS_MIN_INTERVAL_MS);
 
 // LED пін
 #define LED_PIN 2
 
 // Servo
-Servo myServo;
+// Кут - фіксована кома в 1/100 градуса, на servo йде ширина імпульсу через таблицю
+// калібрування (lib/ServoOutput). SERVO_MIN_US/MAX_US - лінійна таблиця за замовчуванням,
+// поки в NVS немає збереженої (POST /api/servo/calibration).
 #define SERVO_PIN 13
-int currentAngle = 90;  // Поточний кут (початкова позиція - центр)
+#define SERVO_MIN_US 544
+#define SERVO_MAX_US 2400
+const char* SERVO_CAL_KEY = "servo";
+CalibratedServo myServo(linearCalibration(SERVO_MIN_US, SERVO_MAX_US));
+int32_t currentAngle = 90 * ANGLE_SCALE;  // Поточний кут, 1/100° (початкова позиція - центр)
+
+// Таблиця калібрування: пише мережа, задача керування підхоплює по CMD_CALIBRATE
+StateSnapshot<ServoCalibration> servoCalibration;
+
+// Де вал імовірно є зараз (lib/ServoOutput/ServoModel): зворотного зв'язку servo не має, тож
+// задача керування кожен тік проганяє записані кути через мертвий час і швидкість повороту.
+// За замовчуванням - даташит SG90, виміряні значення - POST /api/servo/model (NVS, як калібрування).
+ServoModel servoModel(SG90_DYNAMICS);
+StateSnapshot<ServoDynamics> servoDynamics;
+
+// Рушій руху: позиція рахується від часу і оновлюється задачею керування
+AxisMotion servoMotion;
+const float SERVO_MAX_ACCEL = 600.0f;  // °/с² - розгін/гальмування для sweep
+const MotionLimits STOP_LIMITS = {180.0f, SERVO_MAX_ACCEL};
 
 // Стан системи
 bool ledState = false;
 unsigned long startTime = 0;
-int commandCount = 0;
 
-// Цикл серво
-volatile bool cycleRunning = false;
+// Цикл серво: один період шаблону сканування (lib/Motion/ScanPattern) = один цикл.
+// Шаблон пише мережа перед CMD_CYCLE, задача керування будує з нього таблицю руху,
+// плавно під'їжджає до її початку і далі лише інтерполює таблицю кожен тік.
+// За замовчуванням - синус 0-180 з періодом 2 × delay (два ходи по delay, як раніше).
+const ScanPattern DEFAULT_CYCLE = {SCAN_SINE, 1, 0, 0, 600, 0, 60.0f, {0, 0}, {180 * ANGLE_SCALE, 0}, {}};
+const MotionLimits CYCLE_START_LIMITS = {120.0f, SERVO_MAX_ACCEL};
+StateSnapshot<ScanPattern> cyclePattern;
+ScanTable cycleTable;  // стан циклу належить задачі керування
+bool cycleRunning = false;
+bool cycleStarting = false;  // servo ще їде до початку періоду
 int cycleCount = 0;
 int cycleTarget = 0;
-int cycleDelay = 300;  // Затримка між рухами в мс
+uint16_t cycleRate = 100;    // % від темпу шаблону: менше, де шаблон швидший за servo
+unsigned long lastCycleStep = 0;
+
+// Іменовані позиції (lib/Presets): таблицею володіє мережа (/api/presets, запис у NVS при
+// кожній зміні). Виклик - команда CMD_PRESET з кутом; задача керування плавно веде servo
+// до нього і міряє затримку (запит → рух заплановано) і час переходу (→ прибуття).
+const MotionLimits PRESET_LIMITS = {180.0f, SERVO_MAX_ACCEL};
+PresetTable presets;
+int presetSlot = -1;        // стан виклику належить задачі керування
+bool presetMoving = false;
+unsigned long presetMoveStart = 0;
+uint32_t presetRecalls = 0;
+uint32_t presetLatencyUs = 0;
+uint32_t presetTransitionMs = 0;
+
+// ===== ЗАДАЧІ ТА ЧЕРГА КОМАНД =====
+// Задача керування на ядрі 1 володіє myServo, мережа на ядрі 0.
+// Обробники API лише кладуть команди в lock-free чергу і читають знімок стану.
+#define CONTROL_CORE 1
+#define NETWORK_CORE 0
+const uint32_t CONTROL_PERIOD_MS = 5;  // 200 Гц
+
+enum ServoCommandType : uint8_t {
+  CMD_SWEEP,
+  CMD_CYCLE,
+  CMD_STOP,
+  CMD_CALIBRATE,
+  CMD_PRESET
+};
+
+struct ServoCommand {
+  ServoCommandType type;
+  int16_t angle;    // SWEEP: градуси; PRESET: 1/100°
+  int16_t speed;    // SWEEP: мс на градус
+  int32_t count;    // CYCLE: 0 - нескінченно (шаблон - у cyclePattern); PRESET: слот
+  uint32_t waypointSeq;  // скільки точок траєкторії було в черзі до цієї команди (ставить queueCommand)
+  uint32_t receivedUs;   // PRESET: micros() при отриманні запиту
+};
+
+// Знімок стану, який задача керування публікує кожен тік
+struct ServoState {
+  float position;
+  float velocity;
+  int16_t angle;     // 1/100°, записаний на servo
+  int16_t estimated; // 1/100°, оцінка положення валу (servoModel)
+  int16_t target;
+  uint16_t pulseUs;  // поточна ширина імпульсу
+  bool moving;
+  bool cycleRunning;
+  int32_t cycleCount;
+  int32_t cycleTarget;
+  uint16_t cycleRate;
+  bool trajectoryActive;
+  uint16_t trajectoryReached;  // точок пройдено з початку траєкторії
+  uint16_t trajectoryQueued;   // точок ще попереду (черга + lookahead)
+  int8_t presetSlot;           // останній викликаний, -1 - жодного
+  bool presetMoving;
+  uint32_t presetRecalls;
+  uint32_t presetLatencyUs;    // запит → рух заплановано
+  uint32_t presetTransitionMs; // рух заплановано → прибуття
+  uint32_t angleApplied;       // прямих цілей кута записано на servo
+  uint32_t angleLagUs;         // отримання → запис на servo для останньої
+  uint32_t angleMaxLagUs;
+  TickTiming timing;
+};
+
+SpscQueue<ServoCommand, 16> commandQueue;
+
+// Прямий кут (POST /api/servo, WS "servo") іде не через чергу: слайдер чи скрипт шле цілі
+// швидше, ніж servo встигає, а важить лише остання. Слот "остання перемагає" задача керування
+// забирає раз на тік; ціль, що прийшла до того, як забрали попередню, заміщує її (superseded).
+struct AngleTarget {
+  int16_t angle;         // градуси
+  uint32_t waypointSeq;  // як у ServoCommand
+  uint32_t receivedUs;   // micros() при отриманні
+};
+LatestSlot<AngleTarget> angleTarget;
+uint32_t angleApplied = 0;  // пише тільки задача керування
+uint32_t angleLagUs = 0;
+uint32_t angleMaxLagUs = 0;
+StateSnapshot<ServoState> servoState;
+TickStats controlStats(CONTROL_PERIOD_MS * 1000);
+#ifdef BENCH
+LoopProbe benchLoop(CONTROL_PERIOD_MS * 1000);
+// Слайдер: 20 цілей поспіль за один burst, від краю до краю
+const uint16_t BENCH_BURST_SIZE = 20;
+BurstProbe angleBurst("/api/servo", "{\"angle\":%.0f}", 0, 180, BENCH_BURST_SIZE,
+                      [] { return angleTarget.superseded(); });
+#endif
+
+// ===== МЕТРИКИ (GET /metrics) =====
+// Лічильник команд рахується при постановці в чергу і при записі прямого кута в слот (lib/Metrics)
+MetricCounter servoCommands;
+const uint32_t LOOP_PERIOD_BUCKETS_US[] = {4000, 4750, 4950, 5050, 5250, 6000, 7500, 10000, 20000};
+const uint32_t LOOP_JITTER_BUCKETS_US[] = {10, 25, 50, 100, 250, 500, 1000, 2500, 5000};
+MetricHistogram loopPeriod(LOOP_PERIOD_BUCKETS_US, sizeof(LOOP_PERIOD_BUCKETS_US) / sizeof(uint32_t));
+MetricHistogram loopJitter(LOOP_JITTER_BUCKETS_US, sizeof(LOOP_JITTER_BUCKETS_US) / sizeof(uint32_t));
+
+// ===== ЗБЕРЕЖЕНИЙ СТАН (NVS) =====
+// Кут утримання, LED і цикл переживають перезавантаження. Мережа порівнює знімок зі
+// збереженим і пише у flash лише коли зміна вляглася (lib/StateStore): 2 с без змін,
+// не частіше ніж раз на 10 с, і не пізніше ніж через 60 с для стану, що весь час змінюється.
+struct SavedState {
+  int16_t angle;        // 1/100°, кут у спокої (під час руху і циклу не оновлюється)
+  uint8_t cycleRunning;  // цикл, перерваний вимкненням, починається з початку
+  uint8_t led;
+  int32_t cycleTarget;
+  ScanPattern cycle;
+};
+const PersistPolicy STATE_POLICY = {2000, 10000, 60000};
+PersistentState<SavedState> savedState("servo", STATE_POLICY);
+uint32_t bootMs = 0;  // від увімкнення до старту задачі керування
+
+// ===== ТРАЄКТОРІЯ =====
+// Точки з POST /api/servo/trajectory йдуть в окрему обмежену чергу, задача керування
+// програє їх як один плавний рух (lib/Motion/Trajectory).
+// Будь-яка інша команда скасовує траєкторію - але лише ті точки, що прийшли до неї.
+#define TRAJECTORY_QUEUE_SIZE 32
+SpscQueue<Waypoint, TRAJECTORY_QUEUE_SIZE> waypointQueue;
+Trajectory trajectory;
+uint32_t waypointsPushed = 0;  // пише тільки мережа
+uint32_t waypointsTaken = 0;   // пише тільки задача керування
+
+// Поставити команду в чергу з міткою траєкторії
+bool queueCommand(ServoCommand cmd) {
+  cmd.waypointSeq = waypointsPushed;
+  if (!commandQueue.push(cmd)) return false;
+  servoCommands.inc();
+  return true;
+}
+
+// Прямий кут у слот (лише мережа); замінює ще не забрану ціль
+void postAngleTarget(int angle) {
+  angleTarget.post({(int16_t)angle, waypointsPushed, (uint32_t)micros()});
+  servoCommands.inc();
+}
+
+// Поставити команду в чергу; якщо черга повна - відповідаємо 503
+bool sendCommand(HttpResponse& res, const ServoCommand& cmd) {
+  if (queueCommand(cmd)) return true;
+  res.send(503, "application/json", "{\"error\":\"Command queue full\"}");
+  return false;
+}
+
+// Записати кут (1/100°) на servo - імпульс змінюється лише коли змінилась його ширина
+void writeServo(int32_t angle) {
+  TRACE_SCOPE("servo_write");
+  currentAngle = constrain(angle, 0, 180 * ANGLE_SCALE);
+  myServo.write(currentAngle);
+}
+
+// Миттєво встановити кут (скасовує поточний плавний рух)
+void setServoAngle(int angle) {
+  writeServo(angle * ANGLE_SCALE);
+  servoMotion.reset(angle);
+}
 
 // ===== API ENDPOINT: GET /api/status =====
-void handleApiStatus() {
-  JsonDocument doc;
+void handleApiStatus(HttpRequest&, HttpResponse& res) {
+  ServoState state = servoState.read();
+  JsonExchange json;
+  JsonDocument& doc = json.response;
   
   doc["status"] = "ok";
   doc["led"] = ledState ? "on" : "off";
-  doc["servo_angle"] = currentAngle;
-  doc["cycle_running"] = cycleRunning;
-  doc["cycle_count"] = cycleCount;
+  doc["servo_angle"] = angleToDegrees(state.angle);
+  doc["servo_estimated"] = angleToDegrees(state.estimated);
+  doc["servo_pulse_us"] = state.pulseUs;
+  doc["servo_target"] = state.target;
+  doc["moving"] = state.moving;
+  doc["cycle_running"] = state.cycleRunning;
+  doc["cycle_count"] = state.cycleCount;
+  doc["cycle_pattern"] = scanShapeName(cyclePattern.read().shape);
+  doc["cycle_rate"] = state.cycleRate;
+  doc["boot_ms"] = bootMs;
   doc["uptime"] = (millis() - startTime) / 1000;
   doc["freeHeap"] = ESP.getFreeHeap();
-  doc["commands"] = commandCount;
+  doc["commands"] = servoCommands.value();
   doc["rssi"] = WiFi.RSSI();
   
-  String response;
-  serializeJson(doc, response);
+  JsonObject control = doc["control"].to<JsonObject>();
+  control["ticks"] = state.timing.ticks;
+  control["deadline_misses"] = state.timing.deadlineMisses;
+  control["jitter_us"] = state.timing.lastJitterUs;
+  control["max_jitter_us"] = state.timing.maxJitterUs;
+  control["max_busy_us"] = state.timing.maxBusyUs;
+  control["queue_drops"] = commandQueue.dropped();
   
-  server.send(200, "application/json", response);
-  Serial.println("API: Status запит");
-}
-
-// ===== API ENDPOINT: POST /api/led =====
-void handleApiLed() {
-  if (server.method() != HTTP_POST) {
-    server.send(405, "application/json", "{\"error\":\"Method not allowed\"}");
-    return;
-  }
+  JsonObject direct = doc["angle_targets"].to<JsonObject>();
+  direct["accepted"] = angleTarget.posted();
+  direct["superseded"] = angleTarget.superseded();
+  direct["applied"] = state.angleApplied;
+  direct["lag_us"] = state.angleLagUs;
+  direct["max_lag_us"] = state.angleMaxLagUs;
   
-  String body = server.arg("plain");
-  JsonDocument doc;
-  DeserializationError error = deserializeJson(doc, body);
+  JsonObject path = doc["trajectory"].to<JsonObject>();
+  path["active"] = state.trajectoryActive;
+  path["reached"] = state.trajectoryReached;
+  path["queued"] = state.trajectoryQueued;
+  path["capacity"] = TRAJECTORY_QUEUE_SIZE;
   
-  if (error) {
-    server.send(400, "application/json", "{\"error\":\"Invalid JSON\"}");
-    return;
+  JsonObject log = doc["log"].to<JsonObject>();
+  log["written"] = logBuffer.written();
+  log["dropped"] = logBuffer.dropped();
+  
+  JsonObject recall = doc["presets"].to<JsonObject>();
+  recall["count"] = presets.count();
+  if (state.presetSlot >= 0) recall["slot"] = state.presetSlot;
+  recall["moving"] = state.presetMoving;
+  recall["recalls"] = state.presetRecalls;
+  recall["latency_us"] = state.presetLatencyUs;
+  recall["transition_ms"] = state.presetTransitionMs;
+  
+  if (allocCounterEnabled()) {
+    const HttpServerStats& http = server.stats();
+    JsonObject heap = doc["http"].to<JsonObject>();
+    heap["requests"] = http.requests;
+    heap["handler_allocs"] = http.handlerAllocs;
+    heap["alloc_requests"] = http.allocRequests;
   }
   
-  const char* state = doc["state"];
+  json.send(res, 200);
+  LOG_DEBUG("API: Status запит");
+}
+
+// ===== API ENDPOINT: POST /api/led =====
+void handleApiLed(JsonExchange& json, HttpRequest&, HttpResponse& res) {
+  JsonDocument& doc = json.request;
+  
+  const char* state = doc["state"] | "";
   
   if (strcmp(state, "on") == 0) {
     digitalWrite(LED_PIN, HIGH);
     ledState = true;
-    commandCount++;
-    server.send(200, "application/json", "{\"status\":\"ok\",\"led\":\"on\"}");
-    Serial.println("API: LED увімкнено");
+    res.send(200, "application/json", "{\"status\":\"ok\",\"led\":\"on\"}");
+    LOG_INFO("API: LED увімкнено");
   } else if (strcmp(state, "off") == 0) {
     digitalWrite(LED_PIN, LOW);
     ledState = false;
-    commandCount++;
-    server.send(200, "application/json", "{\"status\":\"ok\",\"led\":\"off\"}");
-    Serial.println("API: LED вимкнено");
+    res.send(200, "application/json", "{\"status\":\"ok\",\"led\":\"off\"}");
+    LOG_INFO("API: LED вимкнено");
   } else {
-    server.send(400, "application/json", "{\"error\":\"Invalid state\"}");
+    res.send(400, "application/json", "{\"error\":\"Invalid state\"}");
   }
 }
 
 // ===== API ENDPOINT: POST /api/servo =====
 // Встановити кут servo: {"angle": 90}
-void handleApiServo() {
-  if (server.method() != HTTP_POST) {
-    server.send(405, "application/json", "{\"error\":\"Method not allowed\"}");
-    return;
-  }
-  
-  String body = server.arg("plain");
-  JsonDocument doc;
-  DeserializationError error = deserializeJson(doc, body);
-  
-  if (error) {
-    server.send(400, "application/json", "{\"error\":\"Invalid JSON\"}");
-    return;
-  }
+void handleApiServo(JsonExchange& json, HttpRequest&, HttpResponse& res) {
+  JsonDocument& doc = json.request;
   
   int angle = doc["angle"] | -1;
   
   // Перевірка діапазону
   if (angle < 0 || angle > 180) {
-    server.send(400, "application/json", "{\"error\":\"Angle must be 0-180\"}");
+    res.send(400, "application/json", "{\"error\":\"Angle must be 0-180\"}");
     return;
   }
   
-  // Встановлюємо кут
-  myServo.write(angle);
-  currentAngle = angle;
-  commandCount++;
+  // Встановлюємо кут (задача керування забере найновіший на наступному тіку)
+  postAngleTarget(angle);
   
-  JsonDocument responseDoc;
+  JsonDocument& responseDoc = json.response;
   responseDoc["status"] = "ok";
   responseDoc["angle"] = angle;
   
-  String response;
-  serializeJson(responseDoc, response);
-  server.send(200, "application/json", response);
+  json.send(res, 200);
   
-  Serial.printf("API: Servo встановлено на %d°\n", angle);
+  LOG_DEBUG("API: Servo встановлено на %d°", angle);
 }
 
-// ===== API ENDPOINT: POST /api/servo/cycle =====
-// Цикл 0-180: {"count": 5, "delay": 300} або {"count": 0} для нескінченного
-void handleApiServoCycle() {
-  if (server.method() != HTTP_POST) {
-    server.send(405, "application/json", "{\"error\":\"Method not allowed\"}");
-    return;
+// Шаблон циклу із запиту (спільний для REST і WebSocket); false і `error`, якщо його не
+// побудувати. Без "pattern" - синус min-max з періодом 2 × delay.
+bool parseCyclePattern(JsonDocument& doc, ScanPattern& pattern, const char** error) {
+  pattern = DEFAULT_CYCLE;
+  if (!scanShapeFromName(doc["pattern"] | "sine", &pattern.shape)) {
+    *error = "pattern must be sine, raster or tour";
+    return false;
   }
   
-  String body = server.arg("plain");
-  JsonDocument doc;
-  DeserializationError error = deserializeJson(doc, body);
+  int delayMs = constrain(doc["delay"] | 300, 100, 2000);
+  float period = doc["period"] | delayMs * 2 / 1000.0f;  // с
+  pattern.periodMs = (uint16_t)constrain(lroundf(period * 1000), 0L, 60000L);
+  pattern.min[0] = angleFromDegrees(constrain(doc["min"] | 0.0f, 0.0f, 180.0f));
+  pattern.max[0] = angleFromDegrees(constrain(doc["max"] | 180.0f, 0.0f, 180.0f));
+  pattern.speed = constrain(doc["speed"] | pattern.speed, 1.0f, 600.0f);
+  pattern.dwellMs = constrain(doc["dwell"] | 0, 0, 10000);
   
-  if (error) {
-    server.send(400, "application/json", "{\"error\":\"Invalid JSON\"}");
-    return;
+  JsonArrayConst stops = doc["stops"];
+  if (pattern.shape == SCAN_TOUR && (stops.size() < 1 || stops.size() > SCAN_MAX_STOPS)) {
+    *error = "stops needs 1-8 entries";
+    return false;
+  }
+  pattern.stopCount = stops.size();
+  for (int i = 0; i < pattern.stopCount; i++) {
+    pattern.stops[i].angles[0] = angleFromDegrees(constrain(stops[i]["angle"] | 90.0f, 0.0f, 180.0f));
+    pattern.stops[i].dwellMs = constrain(stops[i]["dwell"] | 1000, 0, 60000);
   }
   
-  int count = doc["count"] | 1;
-  int delayMs = doc["delay"] | 300;
+  if (scanPeriodMs(pattern, 1) == 0) {
+    *error = "Invalid cycle pattern";
+    return false;
+  }
+  return true;
+}
+
+// ===== API ENDPOINT: POST /api/servo/cycle =====
+// Цикл: {"count": 5, "delay": 300} (синус 0-180 за 600 мс) або {"count": 0} для нескінченного.
+// Шаблон явно (один цикл - один період):
+// {"pattern": "sine", "period": 4, "min": 0, "max": 180}
+// {"pattern": "raster", "min": 20, "max": 160, "speed": 60, "dwell": 500} - рівномірно, з паузами на краях
+// {"pattern": "tour", "speed": 90, "stops": [{"angle": 30, "dwell": 1000}, ...]}
+void handleApiServoCycle(JsonExchange& json, HttpRequest&, HttpResponse& res) {
+  JsonDocument& doc = json.request;
   
+  int count = doc["count"] | 1;
   if (count < 0) {
-    server.send(400, "application/json", "{\"error\":\"Count must be >= 0\"}");
+    res.send(400, "application/json", "{\"error\":\"Count must be >= 0\"}");
     return;
   }
   
-  if (delayMs < 100) delayMs = 100;
-  if (delayMs > 2000) delayMs = 2000;
+  ScanPattern pattern;
+  const char* error = nullptr;
+  if (!parseCyclePattern(doc, pattern, &error)) {
+    JsonDocument& responseDoc = json.response;
+    responseDoc["error"] = error;
+    json.send(res, 400);
+    return;
+  }
   
-  cycleTarget = count;
-  cycleCount = 0;
-  cycleDelay = delayMs;
-  cycleRunning = true;
-  commandCount++;
+  cyclePattern.publish(pattern);
+  ServoCommand cmd = {CMD_CYCLE, 0, 0, count, 0, 0};
+  if (!sendCommand(res, cmd)) return;
   
-  Serial.printf("API: Servo cycle started - target: %d, count: %d, delay: %dms\n", cycleTarget, count, delayMs);
+  uint32_t periodMs = scanPeriodMs(pattern, 1);
+  LOG_INFO("API: Servo cycle started - count: %d, %s %lums", count, scanShapeName(pattern.shape),
+           (unsigned long)periodMs);
   
-  JsonDocument responseDoc;
+  JsonDocument& responseDoc = json.response;
   responseDoc["status"] = "ok";
-  responseDoc["cycles"] = count == 0 ? "infinite" : String(count);
-  responseDoc["delay"] = delayMs;
+  char cycles[12];
+  snprintf(cycles, sizeof(cycles), "%d", count);
+  responseDoc["cycles"] = count == 0 ? "infinite" : cycles;
+  responseDoc["pattern"] = scanShapeName(pattern.shape);
+  responseDoc["period_ms"] = periodMs;
   
-  String response;
-  serializeJson(responseDoc, response);
-  server.send(200, "application/json", response);
+  json.send(res, 200);
 }
 
 // ===== API ENDPOINT: POST /api/servo/stop =====
-// Зупинити цикл
-void handleApiServoStop() {
-  if (server.method() != HTTP_POST) {
-    server.send(405, "application/json", "{\"error\":\"Method not allowed\"}");
-    return;
-  }
+// Зупинити цикл і плавно загальмувати sweep
+void handleApiServoStop(HttpRequest&, HttpResponse& res) {
+  ServoCommand cmd = {CMD_STOP, 0, 0, 0, 0, 0};
+  if (!sendCommand(res, cmd)) return;
   
-  cycleRunning = false;
-  commandCount++;
+  int stoppedAt = servoState.read().cycleCount;
   
-  JsonDocument responseDoc;
+  JsonExchange json;
+  JsonDocument& responseDoc = json.response;
   responseDoc["status"] = "ok";
-  responseDoc["stopped_at"] = cycleCount;
+  responseDoc["stopped_at"] = stoppedAt;
   
-  String response;
-  serializeJson(responseDoc, response);
-  server.send(200, "application/json", response);
+  json.send(res, 200);
   
-  Serial.printf("API: Servo cycle stopped at %d\n", cycleCount);
+  LOG_INFO("API: Servo cycle stopped at %d", stoppedAt);
 }
 
 // ===== API ENDPOINT: POST /api/servo/sweep =====
 // Плавний рух від поточного кута до заданого: {"target": 180, "speed": 15}
-void handleApiServoSweep() {
-  if (server.method() != HTTP_POST) {
-    server.send(405, "application/json", "{\"error\":\"Method not allowed\"}");
-    return;
-  }
-  
-  String body = server.arg("plain");
-  JsonDocument doc;
-  DeserializationError error = deserializeJson(doc, body);
-  
-  if (error) {
-    server.send(400, "application/json", "{\"error\":\"Invalid JSON\"}");
-    return;
-  }
+void handleApiServoSweep(JsonExchange& json, HttpRequest&, HttpResponse& res) {
+  JsonDocument& doc = json.request;
   
   int target = doc["target"] | -1;
   int speed = doc["speed"] | 15;  // За замовчуванням 15ms затримка між кроками
   
   // Перевірка діапазону
   if (target < 0 || target > 180) {
-    server.send(400, "application/json", "{\"error\":\"Target must be 0-180\"}");
+    res.send(400, "application/json", "{\"error\":\"Target must be 0-180\"}");
     return;
   }
   
   if (speed < 5) speed = 5;
   if (speed > 100) speed = 100;
   
-  commandCount++;
+  ServoCommand cmd = {CMD_SWEEP, (int16_t)target, (int16_t)speed, 0, 0, 0};
+  if (!sendCommand(res, cmd)) return;
   
-  // Відправляємо відповідь одразу
-  JsonDocument responseDoc;
+  // Оцінка тривалості з поточного знімка (сам рух планує задача керування)
+  // speed - мс на градус, тобто максимальна швидкість 1000/speed °/с
+  ServoState state = servoState.read();
+  MotionLimits limits = {1000.0f / speed, SERVO_MAX_ACCEL};
+  TrapezoidProfile estimate;
+  estimate.plan(state.position, target, state.velocity, limits);
+  
+  JsonDocument& responseDoc = json.response;
   responseDoc["status"] = "ok";
-  responseDoc["from"] = currentAngle;
+  responseDoc["from"] = angleToDegrees(state.angle);
   responseDoc["to"] = target;
   responseDoc["speed"] = speed;
+  responseDoc["duration_ms"] = (uint32_t)(estimate.duration() * 1000.0f);
   
-  String response;
-  serializeJson(responseDoc, response);
-  server.send(200, "application/json", response);
+  json.send(res, 200);
   
-  // Виконуємо плавний рух
-  if (target > currentAngle) {
-    // Рух вперед
-    for (int pos = currentAngle; pos <= target; pos++) {
-      myServo.write(pos);
-      delay(speed);
+  LOG_INFO("API: Servo sweep %.1f° → %d° (speed: %dms)", angleToDegrees(state.angle), target, speed);
+}
+
+// ===== API ENDPOINT: POST /api/servo/trajectory =====
+// Маршрут з кількох точок одним запитом, рух без зупинок на проміжних точках:
+// {"points": [{"angle": 30, "time": 800}, {"angle": 150, "speed": 60}, ...]}
+// time - мс від попередньої точки, або speed - середня швидкість °/с.
+// Точки додаються в кінець поточної траєкторії.
+void handleApiServoTrajectory(JsonExchange& json, HttpRequest&, HttpResponse& res) {
+  JsonArrayConst points = json.request["points"];
+  
+  if (points.isNull() || points.size() == 0) {
+    res.send(400, "application/json", "{\"error\":\"points must be a non-empty array\"}");
+    return;
+  }
+  
+  // Спершу перевіряємо всі точки: траєкторія приймається або ціла, або ніяк
+  size_t count = points.size();
+  if (count > waypointQueue.capacity() - waypointQueue.size()) {
+    res.send(503, "application/json", "{\"error\":\"Trajectory queue full\"}");
+    return;
+  }
+  
+  for (JsonObjectConst point : points) {
+    int angle = point["angle"] | -1;
+    int time = point["time"] | 0;
+    int speed = point["speed"] | 0;
+    if (angle < 0 || angle > 180) {
+      res.send(400, "application/json", "{\"error\":\"Angle must be 0-180\"}");
+      return;
     }
-  } else {
-    // Рух назад
-    for (int pos = currentAngle; pos >= target; pos--) {
-      myServo.write(pos);
-      delay(speed);
+    if ((time < 20 || time > 60000) && (speed < 1 || speed > 1000)) {
+      res.send(400, "application/json", "{\"error\":\"Each point needs time 20-60000 ms or speed 1-1000 deg/s\"}");
+      return;
+    }
+  }
+  
+  for (JsonObjectConst point : points) {
+    int time = point["time"] | 0;
+    Waypoint waypoint;
+    waypoint.angle = point["angle"] | 0;
+    waypoint.durationMs = time >= 20 && time <= 60000 ? time : 0;
+    waypoint.velocity = point["speed"] | 0;
+    waypointQueue.push(waypoint);
+    waypointsPushed++;
+  }
+  servoCommands.inc();
+  
+  JsonDocument& responseDoc = json.response;
+  responseDoc["status"] = "ok";
+  responseDoc["accepted"] = count;
+  responseDoc["queued"] = waypointQueue.size();
+  json.send(res, 200);
+  
+  LOG_DEBUG("API: Trajectory +%u точок", (unsigned)count);
+}
+
+// ===== API ENDPOINT: GET/POST /api/servo/calibration =====
+// Таблиця імпульсів servo (NVS). POST одне з:
+// {"pulses_us": [7 значень для 0, 30, ..., 180°]} | {"min_us": 500, "max_us": 2500} | {"reset": true}
+void handleApiServoCalibration(JsonExchange& json, HttpRequest& req, HttpResponse& res) {
+  if (req.method() == HttpMethod::Post) {
+    JsonDocument& doc = json.request;
+    
+    ServoCalibration cal = linearCalibration(SERVO_MIN_US, SERVO_MAX_US);
+    JsonArrayConst pulses = doc["pulses_us"];
+    bool reset = doc["reset"] | false;
+    if (!reset && !pulses.isNull()) {
+      if (pulses.size() != SERVO_CAL_POINTS) {
+        res.send(400, "application/json", "{\"error\":\"pulses_us needs 7 values (0-180 every 30 deg)\"}");
+        return;
+      }
+      for (int i = 0; i < SERVO_CAL_POINTS; i++) cal.pulseUs[i] = constrain(pulses[i] | 0, 0, 0xFFFF);
+    } else if (!reset) {
+      int minUs = doc["min_us"] | 0;
+      int maxUs = doc["max_us"] | 0;
+      cal = linearCalibration(constrain(minUs, 0, 0xFFFF), constrain(maxUs, 0, 0xFFFF));
+    }
+    if (!calibrationValid(cal)) {
+      res.send(400, "application/json", "{\"error\":\"Invalid calibration\"}");
+      return;
+    }
+    
+    ServoCalibration previous = servoCalibration.read();
+    servoCalibration.publish(cal);
+    ServoCommand cmd = {CMD_CALIBRATE, 0, 0, 0, 0, 0};
+    if (!sendCommand(res, cmd)) {
+      servoCalibration.publish(previous);  // черга повна: не змінилось ні servo, ні NVS
+      return;
+    }
+    // У NVS лише те, що вже стоїть у черзі команд (задача застосує його на наступному тіку)
+    bool stored = reset ? eraseCalibration(SERVO_CAL_KEY) : saveCalibration(SERVO_CAL_KEY, cal);
+    if (!stored) {
+      res.send(500, "application/json", "{\"error\":\"Applied, but NVS write failed\"}");
+      return;
+    }
+    LOG_INFO("%s", reset ? "API: Калібрування servo скинуто" : "API: Калібрування servo збережено");
+  }
+  
+  ServoCalibration cal = servoCalibration.read();
+  JsonDocument& responseDoc = json.response;
+  responseDoc["step_deg"] = SERVO_CAL_STEP / ANGLE_SCALE;
+  JsonArray pulses = responseDoc["pulses_us"].to<JsonArray>();
+  for (int i = 0; i < SERVO_CAL_POINTS; i++) pulses.add(cal.pulseUs[i]);
+  
+  json.send(res, 200);
+}
+
+// ===== API ENDPOINT: GET/POST /api/servo/model =====
+// Швидкість servo для оцінки положення валу (NVS). POST одне з:
+// {"slew_deg_s": 450, "dead_ms": 20} | {"s_per_60deg": 0.13} (з даташиту або секундоміром) | {"reset": true}
+void handleApiServoModel(JsonExchange& json, HttpRequest& req, HttpResponse& res) {
+  if (req.method() == HttpMethod::Post) {
+    JsonDocument& doc = json.request;
+    
+    ServoDynamics dynamics = servoDynamics.read();
+    bool reset = doc["reset"] | false;
+    if (reset) {
+      dynamics = SG90_DYNAMICS;
+    } else {
+      float perSixty = doc["s_per_60deg"] | 0.0f;
+      dynamics.slewRate = perSixty > 0 ? 60.0f / perSixty : (doc["slew_deg_s"] | dynamics.slewRate);
+      dynamics.deadMs = constrain(doc["dead_ms"] | (int)dynamics.deadMs, 0, 0xFFFF);
+    }
+    if (!dynamicsValid(dynamics)) {
+      res.send(400, "application/json", "{\"error\":\"slew_deg_s must be 10-2000, dead_ms 0-80\"}");
+      return;
+    }
+    
+    ServoDynamics previous = servoDynamics.read();
+    servoDynamics.publish(dynamics);
+    ServoCommand cmd = {CMD_CALIBRATE, 0, 0, 0, 0, 0};
+    if (!sendCommand(res, cmd)) {
+      servoDynamics.publish(previous);  // черга повна: не змінилось ні servo, ні NVS
+      return;
+    }
+    // У NVS лише те, що вже стоїть у черзі команд (задача застосує його на наступному тіку)
+    bool stored = reset ? eraseDynamics(SERVO_CAL_KEY) : saveDynamics(SERVO_CAL_KEY, dynamics);
+    if (!stored) {
+      res.send(500, "application/json", "{\"error\":\"Applied, but NVS write failed\"}");
+      return;
+    }
+    LOG_INFO("API: Модель servo %.0f°/с, мертвий час %u мс", dynamics.slewRate, (unsigned)dynamics.deadMs);
+  }
+  
+  ServoDynamics dynamics = servoDynamics.read();
+  JsonDocument& responseDoc = json.response;
+  responseDoc["slew_deg_s"] = dynamics.slewRate;
+  responseDoc["s_per_60deg"] = 60.0f / dynamics.slewRate;
+  responseDoc["dead_ms"] = dynamics.deadMs;
+  
+  json.send(res, 200);
+}
+
+// ===== API ENDPOINT: GET/POST/DELETE /api/presets =====
+void presetList(JsonDocument& doc) {
+  doc["slots"] = PRESET_SLOTS;
+  JsonArray list = doc["presets"].to<JsonArray>();
+  for (int slot = 0; slot < PRESET_SLOTS; slot++) {
+    const Preset* preset = presets.get(slot);
+    if (!preset) continue;
+    JsonObject entry = list.add<JsonObject>();
+    entry["slot"] = slot;
+    entry["name"] = preset->name;
+    entry["angle"] = angleToDegrees(preset->angles[0]);
+  }
+}
+
+// {"slot": 2} або {"name": "door"} → слот, -1 якщо такого немає (індекс або один хеш)
+int findPreset(JsonDocument& doc) {
+  JsonVariant slot = doc["slot"];
+  if (slot.is<int>()) return presets.get(slot.as<int>()) ? slot.as<int>() : -1;
+  return presets.find(doc["name"] | "");
+}
+
+// GET - усі позиції. POST {"name": "door", "angle": 120} - зберегти (без angle - поточний
+// кут) під іменем, замінивши позицію з тим самим іменем або заданий "slot".
+// DELETE {"name": "door"} або {"slot": 2}.
+void handleApiPresets(JsonExchange& json, HttpRequest& req, HttpResponse& res) {
+  JsonDocument& doc = json.request;
+  
+  if (req.method() == HttpMethod::Post || req.method() == HttpMethod::Delete) {
+    if (req.method() == HttpMethod::Post) {
+      const char* name = doc["name"] | "";
+      if (!PresetTable::validName(name)) {
+        res.send(400, "application/json", "{\"error\":\"name must be 1-15 printable characters\"}");
+        return;
+      }
+      int slot = doc["slot"] | presets.find(name);
+      if (slot < 0) slot = presets.freeSlot();
+      if (slot < 0 || slot >= PRESET_SLOTS) {
+        res.send(409, "application/json", "{\"error\":\"No free preset slot\"}");
+        return;
+      }
+      JsonVariant angle = doc["angle"];
+      int16_t value = angle.is<float>() ? constrain(angleFromDegrees(angle.as<float>()), 0, 180 * ANGLE_SCALE)
+                                        : servoState.read().angle;
+      if (!presets.set(slot, name, &value, 1)) {
+        res.send(409, "application/json", "{\"error\":\"Name used by another slot\"}");
+        return;
+      }
+      LOG_INFO("API: Позиція %d \"%s\" = %.1f°", slot, name, angleToDegrees(value));
+    } else if (!presets.remove(findPreset(doc))) {
+      res.send(404, "application/json", "{\"error\":\"Unknown preset\"}");
+      return;
+    }
+    if (!saveStateBlob("presets", presets.slots(), PresetTable::slotsSize())) {
+      res.send(500, "application/json", "{\"error\":\"NVS write failed\"}");
+      return;
+    }
+  }
+  
+  presetList(json.response);
+  json.send(res, 200);
+}
+
+// Команда виклику позиції; false, якщо її немає
+bool parseRecall(JsonDocument& doc, ServoCommand& cmd) {
+  int slot = findPreset(doc);
+  const Preset* preset = presets.get(slot);
+  if (!preset) return false;
+  cmd = {CMD_PRESET, preset->angles[0], 0, slot, 0, 0};
+  cmd.receivedUs = micros();
+  return true;
+}
+
+// ===== API ENDPOINT: POST /api/presets/recall =====
+// Плавно перейти до позиції: {"name": "door"} або {"slot": 2}
+void handleApiPresetRecall(JsonExchange& json, HttpRequest&, HttpResponse& res) {
+  ServoCommand cmd;
+  if (!parseRecall(json.request, cmd)) {
+    res.send(404, "application/json", "{\"error\":\"Unknown preset\"}");
+    return;
+  }
+  if (!sendCommand(res, cmd)) return;
+  
+  JsonDocument& responseDoc = json.response;
+  responseDoc["status"] = "ok";
+  responseDoc["slot"] = cmd.count;
+  responseDoc["name"] = presets.get(cmd.count)->name;
+  responseDoc["angle"] = angleToDegrees(cmd.angle);
+  
+  json.send(res, 200);
+}
+
+// ===== WEBSOCKET: /ws =====
+// Push телеметрії + ті самі команди, що й REST:
+// {"cmd":"servo","angle":90}, {"cmd":"sweep","target":180,"speed":15},
+// {"cmd":"cycle","count":5,"delay":300} (+ поля шаблону, як у /api/servo/cycle), {"cmd":"stop"},
+// {"cmd":"preset","name":"door"}, {"cmd":"led","state":"on"}
+void wsError(uint8_t client, const char* message) {
+  char buf[96];
+  int n = snprintf(buf, sizeof(buf), "{\"error\":\"%s\"}", message);
+  server.wsSend(client, buf, n);
+}
+
+void handleWebSocket(uint8_t client, WebSocketEvent event, const char* data, size_t length) {
+  if (event == WebSocketEvent::Connect) {
+    telemetry.clientConnected(client);
+    return;
+  }
+  if (event == WebSocketEvent::Disconnect) {
+    telemetry.clientDisconnected(client);
+    return;
+  }
+  
+  JsonExchange json;
+  if (!json.parse(data, length)) {
+    wsError(client, "Invalid JSON");
+    return;
+  }
+  JsonDocument& doc = json.request;
+  
+  const char* name = doc["cmd"] | "";
+  ServoCommand cmd = {};
+  
+  if (strcmp(name, "servo") == 0) {
+    int angle = doc["angle"] | -1;
+    if (angle < 0 || angle > 180) {
+      wsError(client, "Angle must be 0-180");
+      return;
+    }
+    postAngleTarget(angle);
+    return;
+  } else if (strcmp(name, "sweep") == 0) {
+    int target = doc["target"] | -1;
+    int speed = doc["speed"] | 15;
+    speed = constrain(speed, 5, 100);
+    if (target < 0 || target > 180) {
+      wsError(client, "Target must be 0-180");
+      return;
+    }
+    cmd = {CMD_SWEEP, (int16_t)target, (int16_t)speed, 0, 0, 0};
+  } else if (strcmp(name, "cycle") == 0) {
+    int count = doc["count"] | 1;
+    if (count < 0) {
+      wsError(client, "Count must be >= 0");
+      return;
+    }
+    ScanPattern pattern;
+    const char* error = nullptr;
+    if (!parseCyclePattern(doc, pattern, &error)) {
+      wsError(client, error);
+      return;
     }
+    cyclePattern.publish(pattern);
+    cmd = {CMD_CYCLE, 0, 0, count, 0, 0};
+  } else if (strcmp(name, "stop") == 0) {
+    cmd = {CMD_STOP, 0, 0, 0, 0, 0};
+  } else if (strcmp(name, "preset") == 0) {
+    if (!parseRecall(doc, cmd)) {
+      wsError(client, "Unknown preset");
+      return;
+    }
+  } else if (strcmp(name, "led") == 0) {
+    ledState = strcmp(doc["state"] | "", "on") == 0;
+    digitalWrite(LED_PIN, ledState ? HIGH : LOW);
+    return;
+  } else {
+    wsError(client, "Unknown command");
+    return;
   }
   
-  currentAngle = target;
-  Serial.printf("API: Servo sweep %d° → %d° (speed: %dms)\n", responseDoc["from"].as<int>(), target, speed);
+  if (!queueCommand(cmd)) {
+    wsError(client, "Command queue full");
+    return;
+  }
+}
+
+// Зібрати телеметрію зі знімка; WebSocketTelemetry сам відкине незмінене
+void publishTelemetry() {
+  ServoState state = servoState.read();
+  char message[160];
+  int n = snprintf(message, sizeof(message),
+                   "{\"led\":\"%s\",\"servo_angle\":%.1f,\"servo_estimated\":%.1f,\"servo_target\":%d,"
+                   "\"moving\":%s,\"cycle_running\":%s,\"cycle_count\":%ld}",
+                   ledState ? "on" : "off", angleToDegrees(state.angle), angleToDegrees(state.estimated), state.target,
+                   state.moving ? "true" : "false", state.cycleRunning ? "true" : "false", (long)state.cycleCount);
+  telemetry.update(message, n);
 }
 
 // ===== WEB INTERFACE =====
-void handleRoot() {
-  String html = "<!DOCTYPE html><html><head>";
-  html += "<meta charset='UTF-8'>";
-  html += "<title>ESP32 Servo Control</title>";
-  html += "<style>";
-  html += "body{font-family:monospace;background:#1e1e1e;color:#d4d4d4;padding:20px}";
-  html += "button{background:#0e639c;color:white;padding:10px;border:none;margin:5px;cursor:pointer}";
-  html += "input{background:#3c3c3c;color:#d4d4d4;border:1px solid #555;padding:8px;margin:5px}";
-  html += ".servo-control{margin:20px 0;padding:15px;background:#252526}";
-  html += "</style></head><body>";
-  html += "<h1>🤖 ESP32 Servo Control</h1>";
-  
-  html += "<div><p>LED: <span id='ledStatus'>...</span></p>";
-  html += "<p>Servo Angle: <span id='servoAngle'>...</span>°</p>";
-  html += "<p>Cycle Status: <span id='cycleStatus'>stopped</span></p>";
-  html += "<p>Cycle Count: <span id='cycleCount'>0</span></p>";
-  html += "<p>Uptime: <span id='uptime'>...</span>s</p>";
-  html += "<p>Commands: <span id='commands'>...</span></p></div>";
-  
-  html += "<div><h2>LED Control</h2>";
-  html += "<button onclick='ledOn()'>LED ON</button>";
-  html += "<button onclick='ledOff()'>LED OFF</button></div>";
-  
-  html += "<div class='servo-control'><h2>Servo Control</h2>";
-  html += "<p>Quick positions:</p>";
-  html += "<button onclick='servoAngle(0)'>0°</button>";
-  html += "<button onclick='servoAngle(45)'>45°</button>";
-  html += "<button onclick='servoAngle(90)'>90°</button>";
-  html += "<button onclick='servoAngle(135)'>135°</button>";
-  html += "<button onclick='servoAngle(180)'>180°</button>";
-  html += "<p>Custom angle:</p>";
-  html += "<input type='number' id='customAngle' min='0' max='180' value='90'>";
-  html += "<button onclick='servoCustom()'>Set Angle</button>";
-  html += "<p>Smooth sweep:</p>";
-  html += "<input type='number' id='targetAngle' min='0' max='180' value='180'>";
-  html += "<input type='number' id='sweepSpeed' min='5' max='100' value='15' placeholder='Speed (ms)'>";
-  html += "<button onclick='servoSweep()'>Sweep</button>";
-  html += "</div>";
-  
-  html += "<div class='servo-control'><h2>Servo Cycle (0-180)</h2>";
-  html += "<p>Cycle count (0 = infinite):</p>";
-  html += "<input type='number' id='cycleTarget' min='0' max='1000' value='5'>";
-  html += "<p>Delay (ms, 100-2000):</p>";
-  html += "<input type='number' id='cycleDelay' min='100' max='2000' step='50' value='300'>";
-  html += "<button onclick='servoCycle()'>Start Cycle</button>";
-  html += "<button onclick='servoStop()' style='background:#c00'>Stop Cycle</button>";
-  html += "</div>";
-  
-  html += "<script>";
-  html += "function updateStatus(){";
-  html += "fetch('/api/status').then(r=>r.json()).then(d=>{";
-  html += "document.getElementById('ledStatus').textContent=d.led;";
-  html += "document.getElementById('servoAngle').textContent=d.servo_angle;";
-  html += "document.getElementById('cycleStatus').textContent=d.cycle_running?'running':'stopped';";
-  html += "document.getElementById('cycleCount').textContent=d.cycle_count;";
-  html += "document.getElementById('uptime').textContent=d.uptime;";
-  html += "document.getElementById('commands').textContent=d.commands;";
-  html += "});}";
-  html += "function ledOn(){fetch('/api/led',{method:'POST',headers:{'Content-Type':'application/json'},body:JSON.stringify({state:'on'})}).then(()=>updateStatus());}";
-  html += "function ledOff(){fetch('/api/led',{method:'POST',headers:{'Content-Type':'application/json'},body:JSON.stringify({state:'off'})}).then(()=>updateStatus());}";
-  html += "function servoAngle(a){fetch('/api/servo',{method:'POST',headers:{'Content-Type':'application/json'},body:JSON.stringify({angle:a})}).then(()=>updateStatus());}";
-  html += "function servoCustom(){let a=parseInt(document.getElementById('customAngle').value);servoAngle(a);}";
-  html += "function servoSweep(){let t=parseInt(document.getElementById('targetAngle').value);let s=parseInt(document.getElementById('sweepSpeed').value);fetch('/api/servo/sweep',{method:'POST',headers:{'Content-Type':'application/json'},body:JSON.stringify({target:t,speed:s})}).then(()=>setTimeout(updateStatus,2000));}";
-  html += "function servoCycle(){let c=parseInt(document.getElementById('cycleTarget').value);let d=parseInt(document.getElementById('cycleDelay').value);fetch('/api/servo/cycle',{method:'POST',headers:{'Content-Type':'application/json'},body:JSON.stringify({count:c,delay:d})}).then(()=>updateStatus());}";
-  html += "function servoStop(){fetch('/api/servo/stop',{method:'POST'}).then(()=>updateStatus());}";
-  html += "updateStatus();setInterval(updateStatus,1000);";
-  html += "</script>";
-  
-  html += "</body></html>";
-  
-  server.send(200, "text/html", html);
+void handleRoot(HttpRequest& req, HttpResponse& res) {
+  // Сторінка web/servo_control.html стиснута під час збірки (scripts/embed_web.py)
+  // і віддається з flash без копіювання
+  res.sendGzipAsset(req, "text/html; charset=utf-8", WEB_INDEX_GZ, WEB_INDEX_GZ_LENGTH, WEB_INDEX_ETAG);
 }
 
-// ===== SETUP =====
-void setup() {
-  Serial.begin(115200);
-  delay(100);
-  Serial.println("\n\n=== ESP32 Servo Control ===");
+// ===== МАРШРУТИ API =====
+// Таблиця будується і перевіряється під час компіляції (lib/RouteTable): пошук маршруту -
+// один хеш шляху. Метод перевіряє сервер (405), тіло JSON розбирає jsonRoute (400/413).
+constexpr HttpRoute ROUTES[] = {
+  {"/", HttpMethod::Get, handleRoot},
+  {"/api/status", HttpMethod::Get, handleApiStatus},
+  {"/api/led", HttpMethod::Post, jsonRoute<handleApiLed>},
+  {"/api/servo", HttpMethod::Post, jsonRoute<handleApiServo>},
+  {"/api/servo/sweep", HttpMethod::Post, jsonRoute<handleApiServoSweep>},
+  {"/api/servo/cycle", HttpMethod::Post, jsonRoute<handleApiServoCycle>},
+  {"/api/servo/stop", HttpMethod::Post, handleApiServoStop},
+  {"/api/servo/trajectory", HttpMethod::Post, jsonRoute<handleApiServoTrajectory>},
+  {"/api/servo/calibration", HttpMethod::Any, jsonRoute<handleApiServoCalibration>},
+  {"/api/servo/model", HttpMethod::Any, jsonRoute<handleApiServoModel>},
+  {"/api/presets", HttpMethod::Any, jsonRoute<handleApiPresets>},
+  {"/api/presets/recall", HttpMethod::Post, jsonRoute<handleApiPresetRecall>},
+#ifdef TRACE
+  {"/api/trace", HttpMethod::Get, handleTraceRequest},  // дамп трасування для Perfetto
+#endif
+  {"/metrics", HttpMethod::Get, handleMetricsRequest},  // Prometheus
+};
+ROUTE_TABLE(routeTable, ROUTES);
+
+// ===== MOTION =====
+// Побудувати таблицю з опублікованого шаблону і плавно поїхати до початку періоду
+void startCycle(int32_t target, unsigned long now) {
+  {
+    TRACE_SCOPE("cycle_build");
+    cycleTable.build(cyclePattern.read(), 1);  // шаблон перевірила мережа
+  }
+  cycleTable.restart();
+  cycleTarget = target;
+  cycleCount = 0;
+  cycleRate = 100;
+  cycleRunning = true;
+  cycleStarting = true;
   
-  // LED
-  pinMode(LED_PIN, OUTPUT);
-  digitalWrite(LED_PIN, LOW);
-  ledState = false;
+  int16_t start;
+  cycleTable.start(&start);
+  servoMotion.moveTo(angleToDegrees(start), CYCLE_START_LIMITS, now);
+}
+
+// Крок циклу: викликається кожен тік задачі керування, нічого не блокує.
+// Позиція - з таблиці за реальним часом; servoMotion лише стежить за нею, тож stop/sweep
+// посеред циклу гальмують плавно.
+// Таблиця йде не швидше, ніж servo встигає повертати (servoModel): де шаблон швидший, цикл
+// сповільнюється, тож вал доходить до країв, а не зрізає їх; де встигає - без очікувань.
+void updateCycle(unsigned long now) {
+  if (!cycleRunning) return;
+  if (cycleStarting) {
+    // під'їзд до початку веде updateMotion; період стартує, коли вал (за оцінкою) на місці
+    if (servoMotion.isMoving() || !servoModel.arrived()) return;
+    cycleStarting = false;
+    lastCycleStep = now;
+    LOG_INFO("Starting cycle 1 (target: %d)", cycleTarget);
+  }
+  TRACE_SCOPE("cycle_step");
   
-  // Servo
-  myServo.attach(SERVO_PIN);
-  myServo.write(90);  // Початкова позиція - центр
-  currentAngle = 90;
-  Serial.println("Servo ініціалізовано на 90°");
-  
-  // WiFi
-  Serial.print("Підключення до WiFi: ");
-  Serial.println(WIFI_SSID);
-  WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
-  
-  int attempts = 0;
-  while (WiFi.status() != WL_CONNECTED && attempts < 40) {
-    delay(500);
-    Serial.print(".");
-    attempts++;
-  }
-  
-  if (WiFi.status() == WL_CONNECTED) {
-    Serial.println("\n✅ WiFi підключено!");
-    Serial.print("IP адреса: ");
-    Serial.println(WiFi.localIP());
+  float slewRate = servoModel.dynamics().slewRate;
+  cycleRate = cycleTable.limitRate(now - lastCycleStep, 100, &slewRate);
+  uint32_t completed = cycleTable.advance(now - lastCycleStep, cycleRate);
+  lastCycleStep = now;
+  if (completed) {
+    cycleCount += completed;
+    LOG_DEBUG("Cycle %d completed (target: %d)", cycleCount, cycleTarget);
     
-    startTime = millis();
-    
-    // Блимання для підтвердження
-    for (int i = 0; i < 3; i++) {
-      digitalWrite(LED_PIN, HIGH);
-      delay(200);
-      digitalWrite(LED_PIN, LOW);
-      delay(200);
+    // Перевірка чи досягли ліміту: зупинка точно в кінці періоду
+    if (cycleTarget > 0 && cycleCount >= cycleTarget) {
+      cycleRunning = false;
+      int16_t end;
+      cycleTable.start(&end);
+      writeServo(end);
+      servoMotion.reset(angleToDegrees(end));
+      LOG_INFO("All cycles completed: %d", cycleCount);
+      return;
     }
-    
-    // Тестовий рух servo
-    Serial.println("Тестовий рух servo...");
-    myServo.write(0);
-    delay(500);
-    myServo.write(180);
-    delay(500);
-    myServo.write(90);
-    currentAngle = 90;
-    Serial.println("Servo готове!");
-    
-  } else {
-    Serial.println("\n❌ Не вдалося підключитися до WiFi!");
-    while (true) {
-      digitalWrite(LED_PIN, HIGH);
-      delay(1000);
-      digitalWrite(LED_PIN, LOW);
-      delay(1000);
+  }
+  
+  int16_t angle;
+  cycleTable.sample(&angle);
+  writeServo(angle);
+  servoMotion.follow(angleToDegrees(angle), cycleTable.velocity(0));
+}
+
+// Просунути плавний рух до поточного часу
+void updateMotion(unsigned long now) {
+  if (!servoMotion.isMoving()) return;
+  
+  writeServo(angleFromDegrees(servoMotion.update(now)));
+}
+
+// Оцінити, де вал після запису цього тіку; перехід до позиції закінчується, коли доїхав
+// вал, а не команда
+void updateModel(unsigned long now) {
+  servoModel.update(currentAngle, now);
+  if (presetMoving && !servoMotion.isMoving() && servoModel.arrived()) {
+    presetMoving = false;
+    presetTransitionMs = now - presetMoveStart;
+  }
+}
+
+// Скасувати траєкторію і викинути точки, що стали в чергу раніше за команду
+void cancelTrajectory(uint32_t waypointSeq) {
+  Waypoint waypoint;
+  while ((int32_t)(waypointSeq - waypointsTaken) > 0 && waypointQueue.pop(waypoint)) {
+    waypointsTaken++;
+  }
+  trajectory.cancel();  // servoMotion вже має позицію і швидкість - stop/sweep гальмують плавно
+}
+
+// Підкачати точки в lookahead і просунути траєкторію
+void updateTrajectory(unsigned long now) {
+  Waypoint waypoint;
+  while (!trajectory.lookaheadFull() && waypointQueue.pop(waypoint)) {
+    waypointsTaken++;
+    if (!trajectory.active()) {
+      // Перший сегмент стартує з поточного стану (в т.ч. з незавершеного sweep)
+      cycleRunning = false;
+      presetMoving = false;
+      trajectory.start(servoMotion.position(), servoMotion.velocity(), now);
     }
+    trajectory.push(waypoint);
   }
+  if (!trajectory.active()) return;
   
-  // Реєстрація API endpoints
-  server.on("/", handleRoot);
-  server.on("/api/status", HTTP_GET, handleApiStatus);
-  server.on("/api/led", HTTP_POST, handleApiLed);
-  server.on("/api/servo", HTTP_POST, handleApiServo);
-  server.on("/api/servo/sweep", HTTP_POST, handleApiServoSweep);
-  server.on("/api/servo/cycle", HTTP_POST, handleApiServoCycle);
-  server.on("/api/servo/stop", HTTP_POST, handleApiServoStop);
+  float position = trajectory.update(now);
+  servoMotion.follow(position, trajectory.velocity());  // sweep/stop стартують звідси
   
-  server.begin();
-  Serial.println("API сервер запущено!");
-  Serial.println("========================\n");
+  writeServo(angleFromDegrees(position));
 }
 
-// ===== LOOP =====
-void loop() {
-  server.handleClient();
+// Найновіший прямий кут: скільки б їх не прийшло за тік - один запис на servo
+void takeAngleTarget() {
+  AngleTarget target;
+  if (!angleTarget.take(target)) return;
+  cancelTrajectory(target.waypointSeq);
+  presetMoving = false;
+  cycleRunning = false;
+  setServoAngle(target.angle);
+  angleApplied++;
+  angleLagUs = micros() - target.receivedUs;
+  if (angleLagUs > angleMaxLagUs) angleMaxLagUs = angleLagUs;
+#ifdef BENCH
+  angleBurst.applied(angleLagUs);
+#endif
+}
+
+// Виконати команду з черги
+void applyCommand(const ServoCommand& cmd, unsigned long now) {
+  // Нова таблиця чи модель не чіпає руху: траєкторія, цикл і перехід до позиції йдуть далі
+  if (cmd.type == CMD_CALIBRATE) {
+    myServo.setCalibration(servoCalibration.read());
+    servoModel.setDynamics(servoDynamics.read());
+    return;
+  }
   
-  // Виконання циклу серво
-  while (cycleRunning) {
-    Serial.printf("Starting cycle %d (target: %d)\n", cycleCount + 1, cycleTarget);
-    
-    // Рух до 0
-    myServo.write(0);
-    currentAngle = 0;
-    delay(cycleDelay);
-    
-    if (!cycleRunning) break;
-    server.handleClient();
-    
-    // Рух до 180
-    myServo.write(180);
-    currentAngle = 180;
-    delay(cycleDelay);
+  cancelTrajectory(cmd.waypointSeq);
+  presetMoving = false;  // будь-яка команда замінює перехід до позиції
+  
+  switch (cmd.type) {
+    case CMD_SWEEP: {
+      cycleRunning = false;  // sweep стартує з поточної швидкості циклу
+      MotionLimits limits = {1000.0f / cmd.speed, SERVO_MAX_ACCEL};
+      servoMotion.moveTo(cmd.angle, limits, now);
+      break;
+    }
+      
+    case CMD_CYCLE:
+      startCycle(cmd.count, now);
+      break;
+      
+    case CMD_STOP:
+      cycleRunning = false;
+      servoMotion.stop(STOP_LIMITS, now);
+      break;
+      
+    case CMD_PRESET:
+      cycleRunning = false;
+      servoMotion.moveTo(angleToDegrees(cmd.angle), PRESET_LIMITS, now);
+      presetSlot = cmd.count;
+      presetMoving = servoMotion.isMoving() || !servoModel.arrived();
+      presetMoveStart = now;
+      presetRecalls++;
+      presetLatencyUs = micros() - cmd.receivedUs;
+      if (!presetMoving) presetTransitionMs = 0;  // вже на місці
+      break;
+      
+    case CMD_CALIBRATE:  // застосовано вище
+      break;
+  }
+}
+
+void publishState() {
+  TRACE_SCOPE("publish");
+  ServoState state;
+  if (trajectory.active()) {
+    state.position = trajectory.position();
+    state.velocity = trajectory.velocity();
+    state.target = (int16_t)lroundf(trajectory.target());
+  } else {
+    state.position = servoMotion.position();
+    state.velocity = servoMotion.velocity();
+    state.target = (int16_t)lroundf(servoMotion.target());
+  }
+  state.angle = currentAngle;
+  state.estimated = servoModel.estimated();
+  state.pulseUs = myServo.pulseUs();
+  state.moving = servoMotion.isMoving() || trajectory.active() || !servoModel.arrived();
+  state.cycleRunning = cycleRunning;
+  state.cycleCount = cycleCount;
+  state.cycleTarget = cycleTarget;
+  state.cycleRate = cycleRate;
+  state.trajectoryActive = trajectory.active();
+  state.trajectoryReached = (uint16_t)trajectory.reached();
+  state.trajectoryQueued = (uint16_t)(waypointQueue.size() + trajectory.pending() + (trajectory.active() ? 1 : 0));
+  state.presetSlot = (int8_t)presetSlot;
+  state.presetMoving = presetMoving;
+  state.presetRecalls = presetRecalls;
+  state.presetLatencyUs = presetLatencyUs;
+  state.presetTransitionMs = presetTransitionMs;
+  state.angleApplied = angleApplied;
+  state.angleLagUs = angleLagUs;
+  state.angleMaxLagUs = angleMaxLagUs;
+  state.timing = controlStats.timing();
+  servoState.publish(state);
+}
+
+// ===== ЗАДАЧА КЕРУВАННЯ (ядро 1) =====
+// Фіксований тік: прямий кут, команди → цикл → рух → оцінка валу → публікація стану
+void controlTask(void*) {
+  TickType_t lastWake = xTaskGetTickCount();
+  
+  for (;;) {
+    vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(CONTROL_PERIOD_MS));
+    controlStats.begin(micros());
+    TRACE_SCOPE("control_tick");
     
-    if (!cycleRunning) break;
-    server.handleClient();
+    unsigned long now = millis();
+    takeAngleTarget();  // до черги: sweep чи цикл, поставлені після нього, перемагають
+    ServoCommand cmd;
+    while (commandQueue.pop(cmd)) {
+      TRACE_SCOPE("command");
+      applyCommand(cmd, now);
+    }
     
-    cycleCount++;
-    Serial.printf("Cycle %d completed (target: %d, running: %d)\n", cycleCount, cycleTarget, cycleRunning);
+    updateCycle(now);
+    {
+      TRACE_SCOPE("motion");
+      updateMotion(now);
+      updateTrajectory(now);
+    }
+    updateModel(now);
+    publishState();
     
-    // Перевірка чи досягли ліміту
-    if (cycleTarget > 0 && cycleCount >= cycleTarget) {
-      cycleRunning = false;
-      Serial.printf("All cycles completed: %d\n", cycleCount);
-      break;
+    controlStats.end(micros());
+    const TickTiming& timing = controlStats.timing();
+    if (timing.lastPeriodUs) {
+      loopPeriod.observe(timing.lastPeriodUs);
+      loopJitter.observe(timing.lastJitterUs);
+    }
+#ifdef BENCH
+    benchLoop.record(controlStats.timing().lastBusyUs, controlStats.timing().lastJitterUs);
+#endif
+  }
+}
+
+// Зняти стан для NVS; запис - коли зміна вляглася (savedState)
+void persistState(unsigned long now) {
+  ServoState state = servoState.read();
+  SavedState saved = savedState.value();
+  if (!state.moving && !state.cycleRunning) saved.angle = state.angle;
+  saved.cycleRunning = state.cycleRunning;
+  saved.cycleTarget = state.cycleTarget;
+  saved.cycle = cyclePattern.read();
+  saved.led = ledState;
+  savedState.update(saved, now);
+  savedState.flush(now);
+}
+
+// ===== ЗАДАЧА МЕРЕЖІ (ядро 0) =====
+void networkTask(void*) {
+  for (;;) {
+    server.poll(5);
+    unsigned long now = millis();
+    if (wifiLink.poll(now)) {
+      IPAddress ip = WiFi.localIP();
+      LOG_INFO("✅ WiFi підключено, IP адреса: %u.%u.%u.%u", ip[0], ip[1], ip[2], ip[3]);
     }
+    pollWifiMetrics();
+    persistState(now);
+    TRACE_SCOPE("telemetry");
+    publishTelemetry();
+    telemetry.pump(millis());
+  }
+}
+
+// ===== ЗАДАЧА ЛОГУ (ядро 0) =====
+// Друкує те, що наклали виклики LOG_* (lib/Log). Найнижчий пріоритет: повільний UART
+// затримує лише сам лог, а повідомлення понад кільце відкидаються і рахуються.
+const uint32_t LOG_PERIOD_MS = 20;
+
+void logEmit(const char* line) {
+  Serial.println(line);
+}
+
+void logTask(void*) {
+  for (;;) {
+    logBuffer.drain(logEmit);
+    vTaskDelay(pdMS_TO_TICKS(LOG_PERIOD_MS));
   }
 }
+
+// ===== МЕТРИКИ =====
+// Після useRoutes(): маршрути отримують власні гістограми затримки
+void setupMetrics() {
+  attachHttpMetrics(server, metrics);
+  addSystemMetrics(metrics);
+  metrics.counter("servo_commands_total", "Commands accepted (queued or posted as the latest angle)", servoCommands);
+  metrics.counter("command_queue_drops_total", "Commands refused because the queue was full",
+                  [] { return (double)commandQueue.dropped(); });
+  metrics.gauge("command_queue_depth", "Commands waiting for the control task", [] { return (double)commandQueue.size(); });
+  metrics.counter("angle_targets_total", "Direct angle targets accepted (HTTP and WebSocket)",
+                  [] { return (double)angleTarget.posted(); });
+  metrics.counter("angle_targets_superseded_total", "Angle targets replaced by a newer one before the control tick",
+                  [] { return (double)angleTarget.superseded(); });
+  metrics.gauge("trajectory_queue_depth", "Trajectory waypoints waiting", [] { return (double)waypointQueue.size(); });
+  metrics.histogram("control_loop_period_seconds", "Start-to-start time of control ticks (nominal 5 ms)", loopPeriod);
+  metrics.histogram("control_loop_jitter_seconds", "Deviation of the tick period from nominal", loopJitter);
+  metrics.counter("control_loop_deadline_misses_total", "Ticks started a period late or overran",
+                  [] { return (double)servoState.read().timing.deadlineMisses; });
+  metrics.counter("log_messages_total", "Log messages queued for the serial port", [] { return (double)logBuffer.written(); });
+  metrics.counter("log_dropped_total", "Log messages dropped because the ring was full",
+                  [] { return (double)logBuffer.dropped(); });
+  metrics.counter("state_updates_total", "Changes of the persisted state", [] { return (double)savedState.updates(); });
+  metrics.counter("state_writes_total", "NVS writes the state changes were coalesced into",
+                  [] { return (double)savedState.writes(); });
+}
+
+// ===== BENCHMARK (збірка з -DBENCH) =====
+// Повторювані сценарії через власний API скетча; результати - рядки BENCH у Serial
+// (lib/Bench, tools/bench_report.py)
+#ifdef BENCH
+const uint32_t BENCH_SCENARIO_MS = 5000;
+
+void benchIdle(HttpBenchClient& api) {
+  api.request("POST", "/api/servo/stop", nullptr);
+}
+
+void benchCycle(HttpBenchClient& api) {
+  api.request("POST", "/api/servo/cycle", "{\"count\":0,\"delay\":300}");
+}
+
+// Sweep туди-назад: кожна нова ціль приходить, поки попередній рух ще триває
+void benchSweepStep(HttpBenchClient& api, uint32_t elapsedMs) {
+  static uint32_t lastPhase = UINT32_MAX;
+  uint32_t phase = elapsedMs / 1000;
+  if (phase == lastPhase) return;
+  lastPhase = phase;
+  api.request("POST", "/api/servo/sweep", phase % 2 ? "{\"target\":20,\"speed\":3}" : "{\"target\":160,\"speed\":3}");
+}
+
+void benchAngleBurst(HttpBenchClient& api, uint32_t elapsedMs) {
+  angleBurst.fire(api);
+}
+
+const BenchScenario BENCH_SCENARIOS[] = {
+  {"idle", BENCH_SCENARIO_MS, benchIdle, nullptr, false},
+  {"cycle", BENCH_SCENARIO_MS, benchCycle, nullptr, false},
+  {"sweep", BENCH_SCENARIO_MS, benchIdle, benchSweepStep, false},
+  {"angle_burst", BENCH_SCENARIO_MS, benchIdle, benchAngleBurst, false, &angleBurst},
+  {"http_idle", BENCH_SCENARIO_MS, benchIdle, nullptr, true},
+  {"http_cycle", BENCH_SCENARIO_MS, benchCycle, nullptr, true},
+};
+
+void benchEmit(const char* line) {
+  Serial.println(line);
+}
+
+void benchTask(void* param) {
+  delay(1000);
+  uint16_t port = server.port() + HTTP_PORT_OFFSET;
+  BenchTarget target = {
+    "servo_control", port,
+    "/api/status", "/api/servo", "{\"angle\":90}", 5,
+    &benchLoop, allocCounterEnabled() ? allocCount : nullptr, benchEmit,
+  };
+  benchLogCost(target.name, benchEmit);
+  runBenchmarks(target, BENCH_SCENARIOS, sizeof(BENCH_SCENARIOS) / sizeof(BENCH_SCENARIOS[0]));
+  
+  HttpBenchClient api;
+  if (api.connect(port, 2000)) benchIdle(api);
+  vTaskDelete(NULL);
+}
+#endif
+
+// ===== SETUP =====
+// Нічого не чекає: servo тримає збережений кут одразу після увімкнення, WiFi
+// підключається у фоні, а HTTP починає відповідати, щойно є з'єднання.
+void setup() {
+  Serial.begin(115200);
+  // Спершу лог: усе, що логується далі, чекає в кільці, ніхто не блокується на UART
+  xTaskCreatePinnedToCore(logTask, "log", 3072, nullptr, 0, nullptr, NETWORK_CORE);
+  LOG_INFO("=== ESP32 Servo Control ===");
+  startTime = millis();
+  
+  // Збережений стан: кут, LED, цикл (за замовчуванням - центр)
+  SavedState saved = {};
+  saved.angle = 90 * ANGLE_SCALE;
+  saved.cycle = DEFAULT_CYCLE;
+  if (savedState.load(saved)) {
+    LOG_INFO("Стан відновлено з NVS: %.1f°%s", angleToDegrees(saved.angle), saved.cycleRunning ? ", цикл" : "");
+  }
+  
+  // LED
+  pinMode(LED_PIN, OUTPUT);
+  ledState = saved.led;
+  digitalWrite(LED_PIN, ledState ? HIGH : LOW);
+  
+  // Servo: таблиця калібрування з NVS, якщо є
+  ServoCalibration cal = linearCalibration(SERVO_MIN_US, SERVO_MAX_US);
+  if (loadCalibration(SERVO_CAL_KEY, cal)) {
+    LOG_INFO("Калібрування servo завантажено з NVS");
+  }
+  servoCalibration.publish(cal);
+  ServoDynamics dynamics = SG90_DYNAMICS;
+  if (loadDynamics(SERVO_CAL_KEY, dynamics)) {
+    LOG_INFO("Модель servo завантажено з NVS: %.0f°/с", dynamics.slewRate);
+  }
+  servoDynamics.publish(dynamics);
+  servoModel.setDynamics(dynamics);
+  if (loadStateBlob("presets", presets.slots(), PresetTable::slotsSize())) {
+    presets.restore();
+    LOG_INFO("Позицій відновлено з NVS: %u", presets.count());
+  }
+  myServo.attach(SERVO_PIN);
+  myServo.setCalibration(cal);
+  writeServo(constrain((int32_t)saved.angle, 0, 180 * ANGLE_SCALE));
+  servoMotion.reset(angleToDegrees(currentAngle));
+  servoModel.reset(currentAngle, millis());  // де вал насправді, невідомо: вважаємо, що на збереженому куті
+  
+  cyclePattern.publish(scanPeriodMs(saved.cycle, 1) ? saved.cycle : DEFAULT_CYCLE);
+  if (saved.cycleRunning) startCycle(saved.cycleTarget, millis());
+  
+  // WiFi: лише старт підключення
+  LOG_INFO("Підключення до WiFi у фоні: %s", WIFI_SSID);
+  wifiLink.begin(millis());
+  
+  // API: таблиця ROUTES
+  useRoutes(server, routeTable);
+  server.onWebSocket("/ws", handleWebSocket);
+  if (allocCounterEnabled()) server.setAllocProbe(allocCount);  // алокації в обробниках (збірки з ALLOC_COUNTER)
+  setupMetrics();
+  
+  server.begin();  // слухає на всіх інтерфейсах, IP з'явиться після підключення
+  LOG_INFO("API сервер запущено!");
+  
+  // Запуск задач: керування на ядрі 1, мережа на ядрі 0
+  publishState();
+  bootMs = millis();
+  xTaskCreatePinnedToCore(controlTask, "servo_ctl", 4096, nullptr, 10, nullptr, CONTROL_CORE);
+  // Стек мережі з запасом під JsonExchange (арена JSON_ARENA_SIZE на стеку обробника)
+  xTaskCreatePinnedToCore(networkTask, "network", 12288, nullptr, 1, nullptr, NETWORK_CORE);
+#ifdef BENCH
+  xTaskCreatePinnedToCore(benchTask, "bench", 6144, nullptr, 1, nullptr, NETWORK_CORE);
+#endif
+  LOG_INFO("========================");
+}
+
+// ===== LOOP =====
+// Вся робота виконується в задачах controlTask / networkTask
+void loop() {
+  vTaskDelete(NULL);
+}
@@ -4,22 +4,150 @@
 
 #include <Arduino.h>
 #include <WiFi.h>
-#include <WebServer.h>
+#include <LittleFS.h>
 #include <ArduinoJson.h>
-#include <ESP32Servo.h>
+#include "HttpServer.h"
+#include "JsonExchange.h"
+#include "RouteTable.h"
+#include "AllocCounter.h"
+#include "WebSocketTelemetry.h"
+#include "UdpControl.h"
+#include "web_index.h"
+#include "SpscQueue.h"
+#include "LatestSlot.h"
+#include "StateSnapshot.h"
+#include "TickStats.h"
+#include "AxisFilter.h"
+#include "RatePan.h"
+#include "AxisMotion.h"
+#include "CoordinatedMove.h"
+#include "MotionTrack.h"
+#include "ScanPattern.h"
+#include "PresetTable.h"
+#include "CalibratedServo.h"
+#include "CalibrationStore.h"
+#include "ServoModel.h"
+#include "ButtonGesture.h"
+#include "Trace.h"
+#include "Log.h"
+#include "Metrics.h"
+#include "MetricsExport.h"
+#include "SystemMetrics.h"
+#include "WifiLink.h"
+#include "StateStore.h"
 #include "wifi_credentials.h"
+#ifdef BENCH
+#include "BenchRunner.h"
+#include "LogCostBench.h"
+#endif
+#ifdef TRACE
+#include "TraceExport.h"
+#endif
 
 // Web server
-WebServer server(80);
+HttpServer server(80);
 
-// Servo
-Servo platformServo;
-#define SERVO_PIN 25
-int currentAngle = 90;
+// WiFi connects and reconnects in the background (network task); local control never waits
+WifiLink wifiLink(WIFI_SSID, WIFI_PASSWORD);
+
+// WebSocket /ws pushes state on change, at most every 50 ms per client
+const uint32_t WS_MIN_INTERVAL_MS = 50;
+WebSocketTelemetry telemetry(server, WS_MIN_INTERVAL_MS);
+
+// Binary UDP joystick stream (lib/UdpControl, protocol in UdpProtocol.h).
+// The pan stops if packets stop arriving for UDP_WATCHDOG_MS.
+#define UDP_CONTROL_PORT 4210
+const uint32_t UDP_WATCHDOG_MS = 250;
+UdpControl udpControl(UDP_CONTROL_PORT, UDP_WATCHDOG_MS);
+
+// Servo axes, one servo (and its own LEDC channel) each.
+// Angles are fixed-point 1/100 degree and go out as pulse widths through a per-servo
+// calibration table (lib/ServoOutput). minUs/maxUs give the straight-line default table used
+// until one is stored in NVS (POST /api/calibration).
+#define AXIS_COUNT 2
+enum AxisId : uint8_t { PAN, TILT };
+const int16_t AXIS_KEEP = INT16_MIN;  // "leave this axis where it is" in a vector target
+
+struct ServoAxis {
+  const char* name;
+  uint8_t pin;
+  int16_t minAngle;
+  int16_t maxAngle;
+  int16_t home;
+  uint16_t minUs;
+  uint16_t maxUs;
+  MotionLimits limits;  // coordinated moves (deg/s, deg/s^2)
+  
+  CalibratedServo servo;
+  ServoModel model;     // where the horn probably is (no feedback from the servo)
+  RatePan rate;         // manual / remote velocity control
+  AxisMotion motion;    // coordinated moves
+  int32_t angle;        // last written, 1/100 degree
+  
+  ServoAxis(const char* name, uint8_t pin, int16_t minAngle, int16_t maxAngle, int16_t home,
+            uint16_t minUs, uint16_t maxUs, MotionLimits limits)
+      : name(name), pin(pin), minAngle(minAngle), maxAngle(maxAngle), home(home),
+        minUs(minUs), maxUs(maxUs), limits(limits), servo(linearCalibration(minUs, maxUs)),
+        model(SG90_DYNAMICS), rate(minAngle, maxAngle), angle(home * ANGLE_SCALE) {}
+};
+
+ServoAxis axes[AXIS_COUNT] = {
+  {"pan",  25, 0,  180, 90, 544, 2400, {120.0f, 480.0f}},
+  {"tilt", 26, 20, 160, 90, 544, 2400, {90.0f, 360.0f}},
+};
+
+// Calibration tables: written by the network task (POST /api/calibration), picked up by the
+// control task on CMD_CALIBRATE
+StateSnapshot<ServoCalibration> calibrations[AXIS_COUNT];
+
+// Servo dynamics for the position models: the SG90 datasheet until a measured slew rate is
+// stored (POST /api/model); picked up on CMD_CALIBRATE like the tables
+StateSnapshot<ServoDynamics> dynamics[AXIS_COUNT];
+
+// Coordinated move in progress: all axes started together and finish together
+bool moveActive = false;
+
+// Motion recording (lib/Motion/MotionTrack): the commanded angles of every control tick while
+// recording, played back tick for tick in Replay. The control task owns the track while it
+// records or replays; trackBusy is set by the network task when it queues either and cleared
+// by the control task when it ends. Only an idle track is saved (restored at boot).
+const size_t TRACK_BUFFER_SIZE = 8192;  // ~3 min of continuous panning, far more with pauses
+StaticMotionTrack<TRACK_BUFFER_SIZE> motionTrack(AXIS_COUNT);
+std::atomic<bool> trackBusy(false);
+bool recording = false;
+bool replaying = false;
+bool replayLoop = false;
+
+// Position presets (lib/Presets): the network task owns the table (/api/presets, written to
+// NVS on every change) and publishes a copy for the control task, which steps through the
+// presets on a long press in Standby. A recall is a coordinated move to the saved pose;
+// its latency (request -> move planned) and transition time (-> arrival) are reported.
+PresetTable presets;
+StateSnapshot<PresetTable> presetSnapshot;
+int presetSlot = -1;         // control task: last recalled
+bool presetMoving = false;   // its transition is still running
+unsigned long presetMoveStart = 0;
+uint32_t presetRecalls = 0;
+uint32_t presetLatencyUs = 0;
+uint32_t presetTransitionMs = 0;
+
+// The saved recording is a LittleFS file (the "spiffs" data partition of the default table):
+// this header, then the blocks. At up to 8 KB it would crowd the 20 KB NVS partition that
+// holds the calibration, presets and state. It is written to a temporary file and renamed
+// over the old one, so a failed or interrupted save keeps the previous recording.
+struct SavedTrack {
+  uint8_t format;
+  uint8_t channels;
+  uint16_t blocks;  // of MOTION_TRACK_BLOCK_SIZE bytes
+};
+const uint8_t TRACK_FORMAT = 1;
+const char* TRACK_FILE = "/track.bin";
+const char* TRACK_TEMP = "/track.tmp";
+bool trackFsReady = false;  // LittleFS mounted
 
 // Joystick
-#define VRX_PIN 35    // X-axis (speed control in auto mode)
-#define VRY_PIN 32    // Y-axis (manual positioning)
+#define VRX_PIN 35    // X-axis (tilt in manual mode, scan rate in auto mode)
+#define VRY_PIN 32    // Y-axis (pan in manual mode)
 #define SW_PIN  33    // Mode switch button
 
 // LED indicator
@@ -29,210 +157,1224 @@ int currentAngle = 90;
 enum Mode {
   STANDBY,      // LED off, joystick inactive
   AUTO_SCAN,    // LED blinking, automatic scanning
-  MANUAL_PAN    // LED on, manual positioning via VRy
+  MANUAL_PAN,   // LED on, manual positioning via VRy (pan) and VRx (tilt)
+  REMOTE,       // LED on, pan velocity streamed over UDP
+  REPLAY        // LED on, recorded motion played back
 };
 
 Mode currentMode = STANDBY;
 
-// Auto scan parameters
-int scanSpeed = 300;      // Delay between movements (100-500ms)
-const int MIN_SPEED = 100;
-const int MAX_SPEED = 500;
-const int SPEED_STEP = 50;
-
-// Manual pan parameters
-int targetAngle = 90;
-const int ANGLE_DEADZONE = 50;
+// Auto scan parameters: one period of a scan pattern (lib/Motion/ScanPattern) is precomputed
+// into a table when the scan starts and played at scanRate percent of its own timing.
+// Default: both ends of the pan range and back in 8 s as a sine, tilt held level.
+const ScanPattern DEFAULT_SCAN = {
+  SCAN_SINE, 3, 0, 0, 8000, 500, 30.0f, {0, 90 * ANGLE_SCALE}, {180 * ANGLE_SCALE, 90 * ANGLE_SCALE}, {},
+};
+int scanRate = 100;       // percent
+int scanRateEffective = 100;  // scanRate, or less where the pattern outruns the servos
+const int MIN_RATE = 25;
+const int MAX_RATE = 400;
+const int RATE_STEP = 2;  // per control tick while VRx is deflected: full range in ~2 s
+const int16_t RATE_DEFLECTION = 100;  // VRx beyond 10% of full scale changes the rate
 
-// Button handling
-bool lastSwState = HIGH;
-unsigned long lastClickTime = 0;
-int clickCount = 0;
-const unsigned long DOUBLE_CLICK_TIMEOUT = 500;
+// Button handling: the SW_PIN interrupt timestamps edges into buttonEdges, the control task
+// debounces them and turns them into gestures (lib/Button)
+const uint16_t BUTTON_DEBOUNCE_MS = 20;
+const uint16_t DOUBLE_CLICK_TIMEOUT = 500;
+const uint16_t LONG_PRESS_MS = 1000;
+SpscQueue<ButtonEdge, 32> buttonEdges;
+ButtonGesture button(BUTTON_DEBOUNCE_MS, DOUBLE_CLICK_TIMEOUT, LONG_PRESS_MS);
 
-// Auto scan state
+// Auto scan state. The pattern is written by the network task (POST /api/scan) and built
+// into scanTable by the control task on CMD_SCAN; the scan starts with a glide to its start.
+StateSnapshot<ScanPattern> scanPattern;
+ScanTable scanTable;
 bool isScanning = false;
-unsigned long lastScanMove = 0;
-bool scanDirection = true;  // true = forward, false = backward
+bool scanStarting = false;  // gliding to the start: the table waits until the servos are there
+unsigned long lastScanStep = 0;
 
 // LED blinking
 unsigned long lastLedToggle = 0;
 bool ledState = false;
 
+// Manual and remote pan: a velocity (stick deflection or UDP rate) integrated over real
+// elapsed time, acceleration-limited, braking into the axis limits (lib/Motion/RatePan)
+const PanResponse DEFAULT_PAN_RESPONSE = {120.0f, 0.5f, 360.0f};  // full traverse ~1.5 s
+unsigned long lastPanStep = 0;
+float remoteRate = 0;  // deg/s from UDP
+
+// UDP command waiting for its servo write to be reported (acked by the network task)
+bool udpPending = false;
+uint32_t udpPendingSeq = 0;
+uint32_t udpPendingReceivedUs = 0;
+uint32_t udpApplied = 0;
+uint32_t udpAppliedSeq = 0;
+uint32_t udpLatencyUs = 0;
+
+// Direct angle targets taken from angleTargets (control task)
+uint32_t angleApplied = 0;
+uint32_t angleLagUs = 0;     // receipt -> servo write of the last one
+uint32_t angleMaxLagUs = 0;
+
 // Statistics
 unsigned long startTime = 0;
-int commandCount = 0;
+uint32_t bootMs = 0;  // power-on -> control task running
+
+// Hold position, mode and the scan (pattern and rate) survive a restart. The network task compares the state
+// snapshot with what is stored and writes only once a change has settled (lib/StateStore):
+// 2 s unchanged, at most every 10 s, at the latest 60 s into a state that keeps changing.
+struct SavedState {
+  int16_t angles[AXIS_COUNT];  // 1/100 degree, updated only while holding still
+  int16_t scanRate;
+  uint8_t mode;                // REMOTE and REPLAY come back as STANDBY
+  uint8_t reserved;
+  ScanPattern scan;
+};
+const PersistPolicy STATE_POLICY = {2000, 10000, 60000};
+PersistentState<SavedState> savedState("platform", STATE_POLICY);
+
+// ===== TASKS =====
+// The control task (core 1) owns the servo, joystick and mode logic.
+// HTTP runs on core 0 and only talks to it through the command queue and state snapshot.
+#define CONTROL_CORE 1
+#define NETWORK_CORE 0
+const uint32_t CONTROL_PERIOD_MS = 10;
+
+enum CommandType : uint8_t {
+  CMD_SET_ANGLE,
+  CMD_SCAN,
+  CMD_STOP,
+  CMD_PAN_RATE,
+  CMD_PAN_HALT,  // UDP watchdog: zero the stream's rate, leave any other mode alone
+  CMD_MOVE,
+  CMD_CALIBRATE,
+  CMD_RECORD,
+  CMD_REPLAY,
+  CMD_PRESET
+};
+
+struct PlatformCommand {
+  CommandType type;
+  int16_t value;        // 1/100 deg for SET_ANGLE, rate % for SCAN, 1/10 deg/s for PAN_RATE,
+                        // deg/s cap for MOVE and PRESET (0 = axis limits), axis for CALIBRATE,
+                        // start (1) / stop (0) for RECORD, loop for REPLAY
+  bool udp;             // came from UdpControl: report when it reached the servo
+  uint32_t udpSeq;
+  uint32_t receivedUs;  // UDP and PRESET: micros() at receipt
+  int16_t targets[AXIS_COUNT];  // MOVE, PRESET: 1/100 deg per axis or AXIS_KEEP
+  uint8_t preset;       // PRESET: slot
+};
+
+struct PlatformState {
+  Mode mode;
+  int16_t angles[AXIS_COUNT];   // 1/100 degree
+  int16_t targets[AXIS_COUNT];  // 1/100 degree
+  int16_t estimated[AXIS_COUNT];  // 1/100 degree, servo models
+  uint16_t pulses[AXIS_COUNT];  // microseconds
+  bool moving;                  // a move in progress or a horn not yet at its command
+  int16_t scanRate;
+  int16_t scanRateEffective;
+  uint32_t udpApplied;    // UDP commands that reached the servo
+  uint32_t udpSeq;        // sequence number of the last one
+  uint32_t udpLatencyUs;  // its receipt -> servo write time
+  bool recording;
+  bool replaying;
+  MotionTrackStats track;
+  int8_t presetSlot;             // last recalled, -1 = none
+  bool presetMoving;
+  uint32_t presetRecalls;
+  uint32_t presetLatencyUs;      // request -> move planned
+  uint32_t presetTransitionMs;   // move planned -> arrived
+  uint32_t angleApplied;         // direct angle targets written to a servo
+  uint32_t angleLagUs;
+  uint32_t angleMaxLagUs;
+  TickTiming timing;
+};
+
+SpscQueue<PlatformCommand, 16> commandQueue;
+
+// Direct angle targets (POST /api/angle, WS "angle") bypass the queue: a dragged slider or a
+// script sends them far faster than the servo follows, and only the newest one matters. Each
+// axis has a latest-wins slot the control task takes once per tick; a target that arrives
+// before the previous one was taken replaces it and is counted as superseded.
+struct AngleTarget {
+  int16_t angle;        // 1/100 degree
+  uint32_t receivedUs;  // micros() at receipt
+};
+LatestSlot<AngleTarget> angleTargets[AXIS_COUNT];
+StateSnapshot<PlatformState> platformState;
+TickStats controlStats(CONTROL_PERIOD_MS * 1000);
+#ifdef BENCH
+LoopProbe benchLoop(CONTROL_PERIOD_MS * 1000);
+#endif
+
+// ===== METRICS (GET /metrics, lib/Metrics) =====
+// Commands are counted once, where they enter the queue or an angle slot (HTTP, WebSocket and
+// UDP alike)
+MetricCounter platformCommands;
+const uint32_t LOOP_PERIOD_BUCKETS_US[] = {8000, 9500, 9900, 10100, 10500, 12000, 15000, 20000, 40000};
+const uint32_t LOOP_JITTER_BUCKETS_US[] = {10, 25, 50, 100, 250, 500, 1000, 2500, 10000};
+MetricHistogram loopPeriod(LOOP_PERIOD_BUCKETS_US, sizeof(LOOP_PERIOD_BUCKETS_US) / sizeof(uint32_t));
+MetricHistogram loopJitter(LOOP_JITTER_BUCKETS_US, sizeof(LOOP_JITTER_BUCKETS_US) / sizeof(uint32_t));
+
+// Network task only (the queue has a single producer)
+bool queueCommand(const PlatformCommand& cmd) {
+  if (!commandQueue.push(cmd)) return false;
+  platformCommands.inc();
+  return true;
+}
+
+// ===== JOYSTICK SAMPLING =====
+// Background stage on core 1 (below the control task): every 5 ms both axes are oversampled,
+// filtered (lib/Joystick) and published as a lock-free snapshot. The center is measured at
+// boot, so the stick must be left alone for the first half second.
+const uint32_t JOYSTICK_PERIOD_MS = 5;       // 200 Hz filtered output
+#define JOYSTICK_OVERSAMPLE 8                // raw reads per axis per output
+const uint16_t JOYSTICK_CAL_SAMPLES = 100;   // 0.5 s of filtered output
+const uint16_t JOYSTICK_MIN_DEADZONE = 60;   // ADC units
+const uint16_t JOYSTICK_MAX_NOISE = 200;     // wider band at boot = stick was touched
+
+struct JoystickState {
+  int16_t x;               // -1000..1000, 0 inside the deadzone
+  int16_t y;
+  uint16_t filteredX;      // ADC units
+  uint16_t filteredY;
+  AxisCalibration calX;
+  AxisCalibration calY;
+  bool calibrated;
+  uint32_t samples;
+};
+
+StateSnapshot<JoystickState> joystickState;
+
+// Pan response curve: written by the network task (POST /api/pan), read every control tick
+StateSnapshot<PanResponse> panResponse;
+
+#ifdef BENCH
+// Benchmark scenarios replace the stick with a sweep and press the button themselves
+std::atomic<bool> benchStick(false);
+std::atomic<bool> benchButton(false);
+
+// Slider drag: 20 pan targets back to back per burst, end to end
+const uint16_t BENCH_BURST_SIZE = 20;
+BurstProbe angleBurst("/api/angle", "{\"angle\":%.1f}", 0, 180, BENCH_BURST_SIZE,
+                      [] { return angleTargets[PAN].superseded(); });
+#endif
+
+void buttonIsr();
+uint16_t readStick(uint8_t pin);
+bool buttonDown();
+void beginPan(unsigned long now);
+void enterAutoScan(unsigned long now);
+void recallNextPreset(unsigned long now);
+void startMove(const PlatformCommand& cmd, unsigned long now);
+void joystickTask(void* param);
+void controlTask(void* param);
+void networkTask(void* param);
+void logTask(void* param);
+void publishState();
+void setupMetrics();
+#ifdef BENCH
+void benchTask(void* param);
+#endif
+
+const char* modeName(Mode mode) {
+  switch (mode) {
+    case AUTO_SCAN: return "auto";
+    case MANUAL_PAN: return "manual";
+    case REMOTE: return "remote";
+    case REPLAY: return "replay";
+    default: return "standby";
+  }
+}
+
+// Control task only: clamp to the axis limits (angle in 1/100 degree); the servo is only
+// written when the pulse width changes
+void writeAxis(ServoAxis& axis, int32_t angle) {
+  TRACE_SCOPE("servo_write");
+  angle = constrain(angle, (int32_t)axis.minAngle * ANGLE_SCALE, (int32_t)axis.maxAngle * ANGLE_SCALE);
+  axis.servo.write(angle);
+  axis.angle = angle;
+}
+
+// Every horn at its last command, by the servo models
+bool servosArrived() {
+  for (const ServoAxis& axis : axes) {
+    if (!axis.model.arrived()) return false;
+  }
+  return true;
+}
+
+void cancelMove() {
+  presetMoving = false;
+  if (!moveActive) return;
+  moveActive = false;
+  for (ServoAxis& axis : axes) axis.motion.reset(angleToDegrees(axis.angle));
+}
+
+int axisIndex(const char* name) {
+  for (int i = 0; i < AXIS_COUNT; i++) {
+    if (strcmp(axes[i].name, name) == 0) return i;
+  }
+  return -1;
+}
+
+bool sendCommand(HttpResponse& res, const PlatformCommand& cmd) {
+  if (queueCommand(cmd)) return true;
+  res.send(503, "application/json", "{\"error\":\"Command queue full\"}");
+  return false;
+}
 
 // ===== API ENDPOINTS =====
 
-void handleApiStatus() {
-  JsonDocument doc;
+void handleApiStatus(HttpRequest&, HttpResponse& res) {
+  PlatformState state = platformState.read();
+  JsonExchange json;
+  JsonDocument& doc = json.response;
   
   doc["status"] = "ok";
-  doc["mode"] = currentMode == STANDBY ? "standby" : (currentMode == AUTO_SCAN ? "auto" : "manual");
-  doc["angle"] = currentAngle;
-  doc["scan_speed"] = scanSpeed;
+  doc["mode"] = modeName(state.mode);
+  doc["angle"] = angleToDegrees(state.angles[PAN]);
+  doc["tilt"] = angleToDegrees(state.angles[TILT]);
+  doc["moving"] = state.moving;
+  doc["scan_pattern"] = scanShapeName(scanPattern.read().shape);
+  doc["scan_rate"] = state.scanRate;
+  doc["scan_rate_effective"] = state.scanRateEffective;
+  doc["boot_ms"] = bootMs;
   doc["uptime"] = (millis() - startTime) / 1000;
+  doc["commands"] = platformCommands.value();
   doc["rssi"] = WiFi.RSSI();
   
-  String response;
-  serializeJson(doc, response);
-  server.send(200, "application/json", response);
+  JsonObject axesDoc = doc["axes"].to<JsonObject>();
+  for (int i = 0; i < AXIS_COUNT; i++) {
+    JsonObject axis = axesDoc[axes[i].name].to<JsonObject>();
+    axis["angle"] = angleToDegrees(state.angles[i]);
+    axis["estimated"] = angleToDegrees(state.estimated[i]);
+    axis["target"] = angleToDegrees(state.targets[i]);
+    axis["pulse_us"] = state.pulses[i];
+    axis["min"] = axes[i].minAngle;
+    axis["max"] = axes[i].maxAngle;
+  }
+  
+  JsonObject control = doc["control"].to<JsonObject>();
+  control["ticks"] = state.timing.ticks;
+  control["deadline_misses"] = state.timing.deadlineMisses;
+  control["jitter_us"] = state.timing.lastJitterUs;
+  control["max_jitter_us"] = state.timing.maxJitterUs;
+  control["max_busy_us"] = state.timing.maxBusyUs;
+  control["queue_drops"] = commandQueue.dropped();
+  
+  JsonObject direct = doc["angle_targets"].to<JsonObject>();
+  uint32_t posted = 0, superseded = 0;
+  for (const LatestSlot<AngleTarget>& slot : angleTargets) {
+    posted += slot.posted();
+    superseded += slot.superseded();
+  }
+  direct["accepted"] = posted;
+  direct["superseded"] = superseded;
+  direct["applied"] = state.angleApplied;
+  direct["lag_us"] = state.angleLagUs;
+  direct["max_lag_us"] = state.angleMaxLagUs;
+  
+  JoystickState stick = joystickState.read();
+  JsonObject joystick = doc["joystick"].to<JsonObject>();
+  joystick["calibrated"] = stick.calibrated;
+  joystick["x"] = stick.x;
+  joystick["y"] = stick.y;
+  joystick["center_x"] = stick.calX.center;
+  joystick["center_y"] = stick.calY.center;
+  joystick["deadzone_x"] = stick.calX.deadzone;
+  joystick["deadzone_y"] = stick.calY.deadzone;
+  
+  const UdpControlStats& udpStats = udpControl.stats();
+  JsonObject udp = doc["udp"].to<JsonObject>();
+  udp["port"] = UDP_CONTROL_PORT;
+  udp["received"] = udpStats.received;
+  udp["accepted"] = udpStats.accepted;
+  udp["stale"] = udpStats.stale;
+  udp["superseded"] = udpStats.superseded;
+  udp["malformed"] = udpStats.malformed;
+  udp["acks"] = udpStats.acks;
+  udp["watchdog_trips"] = udpStats.watchdogTrips;
+  udp["latency_us"] = state.udpLatencyUs;
+  
+  JsonObject log = doc["log"].to<JsonObject>();
+  log["written"] = logBuffer.written();
+  log["dropped"] = logBuffer.dropped();
+  
+  JsonObject recall = doc["presets"].to<JsonObject>();
+  recall["count"] = presets.count();
+  if (state.presetSlot >= 0) recall["slot"] = state.presetSlot;
+  recall["moving"] = state.presetMoving;
+  recall["recalls"] = state.presetRecalls;
+  recall["latency_us"] = state.presetLatencyUs;
+  recall["transition_ms"] = state.presetTransitionMs;
+  
+  if (allocCounterEnabled()) {
+    const HttpServerStats& http = server.stats();
+    JsonObject heap = doc["http"].to<JsonObject>();
+    heap["requests"] = http.requests;
+    heap["handler_allocs"] = http.handlerAllocs;
+    heap["alloc_requests"] = http.allocRequests;
+  }
+  
+  json.send(res, 200);
 }
 
-void handleApiSetAngle() {
-  if (server.method() != HTTP_POST) {
-    server.send(405, "text/plain", "Method Not Allowed");
-    return;
+// "angle" (pan; 90 when neither axis is named) and "tilt" into the axes' latest-wins slots.
+// `values` gets what was posted, AXIS_KEEP for an axis left alone.
+void postAngleTargets(JsonDocument& doc, int16_t* values) {
+  uint32_t nowUs = micros();
+  JsonVariant tilt = doc["tilt"];
+  values[PAN] = AXIS_KEEP;
+  values[TILT] = AXIS_KEEP;
+  if (doc["angle"].is<float>() || !tilt.is<float>()) {
+    float angle = doc["angle"] | 90.0f;
+    values[PAN] = constrain(angleFromDegrees(angle), 0, 180 * ANGLE_SCALE);
+    angleTargets[PAN].post({values[PAN], nowUs});
   }
+  if (tilt.is<float>()) {
+    values[TILT] = constrain(angleFromDegrees(tilt.as<float>()), (int32_t)axes[TILT].minAngle * ANGLE_SCALE,
+                             (int32_t)axes[TILT].maxAngle * ANGLE_SCALE);
+    angleTargets[TILT].post({values[TILT], nowUs});
+  }
+  platformCommands.inc();  // one command, however many axes it names
+}
+
+void handleApiSetAngle(JsonExchange& json, HttpRequest&, HttpResponse& res) {
+  int16_t values[AXIS_COUNT];
+  postAngleTargets(json.request, values);
+  
+  JsonDocument& response = json.response;
+  response["status"] = "ok";
+  if (values[PAN] != AXIS_KEEP) response["angle"] = angleToDegrees(values[PAN]);
+  if (values[TILT] != AXIS_KEEP) response["tilt"] = angleToDegrees(values[TILT]);
   
-  JsonDocument doc;
-  DeserializationError error = deserializeJson(doc, server.arg("plain"));
+  json.send(res, 200);
+}
+
+// Vector target -> MOVE command; false when the document names no axis
+bool parseMove(JsonDocument& doc, PlatformCommand& cmd) {
+  cmd = {CMD_MOVE, (int16_t)constrain((int)(doc["speed"] | 0), 0, 360), false, 0, 0, {}, 0};
+  bool any = false;
+  for (int i = 0; i < AXIS_COUNT; i++) {
+    JsonVariant target = doc[axes[i].name];
+    if (target.is<float>()) {
+      cmd.targets[i] = constrain(angleFromDegrees(target.as<float>()), (int32_t)axes[i].minAngle * ANGLE_SCALE,
+                                 (int32_t)axes[i].maxAngle * ANGLE_SCALE);
+      any = true;
+    } else {
+      cmd.targets[i] = AXIS_KEEP;
+    }
+  }
+  return any;
+}
+
+void handleApiMove(JsonExchange& json, HttpRequest&, HttpResponse& res) {
   
-  if (error) {
-    server.send(400, "application/json", "{\"error\":\"Invalid JSON\"}");
+  PlatformCommand cmd;
+  if (!parseMove(json.request, cmd)) {
+    res.send(400, "application/json", "{\"error\":\"No axis target\"}");
     return;
   }
+  if (!sendCommand(res, cmd)) return;
   
-  int angle = doc["angle"] | 90;
-  angle = constrain(angle, 0, 180);
+  JsonDocument& response = json.response;
+  response["status"] = "ok";
+  for (int i = 0; i < AXIS_COUNT; i++) {
+    if (cmd.targets[i] != AXIS_KEEP) response[axes[i].name] = angleToDegrees(cmd.targets[i]);
+  }
   
-  platformServo.write(angle);
-  currentAngle = angle;
+  json.send(res, 200);
+}
+
+// GET: every axis' table. POST one axis:
+// {"axis":"pan","pulses_us":[...]} | {"axis":"pan","min_us":500,"max_us":2500} | {"axis":"pan","reset":true}
+void handleApiCalibration(JsonExchange& json, HttpRequest& req, HttpResponse& res) {
+  if (req.method() == HttpMethod::Post) {
+    JsonDocument& doc = json.request;
+    
+    int index = axisIndex(doc["axis"] | "");
+    if (index < 0) {
+      res.send(400, "application/json", "{\"error\":\"Unknown axis\"}");
+      return;
+    }
+    ServoAxis& axis = axes[index];
+    
+    ServoCalibration cal = linearCalibration(axis.minUs, axis.maxUs);
+    JsonArrayConst pulses = doc["pulses_us"];
+    bool reset = doc["reset"] | false;
+    if (!reset && !pulses.isNull()) {
+      if (pulses.size() != SERVO_CAL_POINTS) {
+        res.send(400, "application/json", "{\"error\":\"pulses_us needs 7 values (0-180 every 30 deg)\"}");
+        return;
+      }
+      for (int i = 0; i < SERVO_CAL_POINTS; i++) cal.pulseUs[i] = constrain(pulses[i] | 0, 0, 0xFFFF);
+    } else if (!reset) {
+      int minUs = doc["min_us"] | 0;
+      int maxUs = doc["max_us"] | 0;
+      cal = linearCalibration(constrain(minUs, 0, 0xFFFF), constrain(maxUs, 0, 0xFFFF));
+    }
+    if (!calibrationValid(cal)) {
+      res.send(400, "application/json", "{\"error\":\"Invalid calibration\"}");
+      return;
+    }
+    
+    ServoCalibration previous = calibrations[index].read();
+    calibrations[index].publish(cal);
+    if (!sendCommand(res, {CMD_CALIBRATE, (int16_t)index, false, 0, 0, {}, 0})) {
+      calibrations[index].publish(previous);  // queue full: neither the servo nor NVS changed
+      return;
+    }
+    // Only what is already queued goes to NVS (the control task applies it next tick)
+    bool stored = reset ? eraseCalibration(axis.name) : saveCalibration(axis.name, cal);
+    if (!stored) {
+      res.send(500, "application/json", "{\"error\":\"Applied, but NVS write failed\"}");
+      return;
+    }
+  }
   
-  commandCount++;
+  JsonDocument& response = json.response;
+  response["step_deg"] = SERVO_CAL_STEP / ANGLE_SCALE;
+  for (int i = 0; i < AXIS_COUNT; i++) {
+    ServoCalibration cal = calibrations[i].read();
+    JsonArray pulses = response[axes[i].name]["pulses_us"].to<JsonArray>();
+    for (int j = 0; j < SERVO_CAL_POINTS; j++) pulses.add(cal.pulseUs[j]);
+  }
   
-  JsonDocument response;
-  response["status"] = "ok";
-  response["angle"] = currentAngle;
+  json.send(res, 200);
+}
+
+// GET: every axis' dynamics. POST one axis:
+// {"axis":"pan","slew_deg_s":450,"dead_ms":20} | {"axis":"pan","s_per_60deg":0.13} | {"axis":"pan","reset":true}
+// s_per_60deg is how datasheets quote it; time a long sweep to measure it.
+void handleApiModel(JsonExchange& json, HttpRequest& req, HttpResponse& res) {
+  if (req.method() == HttpMethod::Post) {
+    JsonDocument& doc = json.request;
+    
+    int index = axisIndex(doc["axis"] | "");
+    if (index < 0) {
+      res.send(400, "application/json", "{\"error\":\"Unknown axis\"}");
+      return;
+    }
+    ServoAxis& axis = axes[index];
+    
+    ServoDynamics servo = dynamics[index].read();
+    bool reset = doc["reset"] | false;
+    if (reset) {
+      servo = SG90_DYNAMICS;
+    } else {
+      float perSixty = doc["s_per_60deg"] | 0.0f;
+      servo.slewRate = perSixty > 0 ? 60.0f / perSixty : (doc["slew_deg_s"] | servo.slewRate);
+      servo.deadMs = constrain(doc["dead_ms"] | (int)servo.deadMs, 0, 0xFFFF);
+    }
+    if (!dynamicsValid(servo)) {
+      res.send(400, "application/json", "{\"error\":\"slew_deg_s must be 10-2000, dead_ms 0-80\"}");
+      return;
+    }
+    
+    ServoDynamics previous = dynamics[index].read();
+    dynamics[index].publish(servo);
+    if (!sendCommand(res, {CMD_CALIBRATE, (int16_t)index, false, 0, 0, {}, 0})) {
+      dynamics[index].publish(previous);  // queue full: neither the servo nor NVS changed
+      return;
+    }
+    // Only what is already queued goes to NVS (the control task applies it next tick)
+    bool stored = reset ? eraseDynamics(axis.name) : saveDynamics(axis.name, servo);
+    if (!stored) {
+      res.send(500, "application/json", "{\"error\":\"Applied, but NVS write failed\"}");
+      return;
+    }
+  }
+  
+  JsonDocument& response = json.response;
+  for (int i = 0; i < AXIS_COUNT; i++) {
+    ServoDynamics servo = dynamics[i].read();
+    JsonObject axis = response[axes[i].name].to<JsonObject>();
+    axis["slew_deg_s"] = servo.slewRate;
+    axis["s_per_60deg"] = 60.0f / servo.slewRate;
+    axis["dead_ms"] = servo.deadMs;
+  }
   
-  String responseStr;
-  serializeJson(response, responseStr);
-  server.send(200, "application/json", responseStr);
+  json.send(res, 200);
 }
 
-void handleApiScan() {
-  if (server.method() != HTTP_POST) {
-    server.send(405, "text/plain", "Method Not Allowed");
-    return;
+// [min, max] in degrees for one axis of a sine or raster pattern
+void parseScanRange(JsonVariantConst range, int axis, ScanPattern& pattern) {
+  if (!range.is<JsonArrayConst>() || range.size() != 2) return;
+  int32_t low = (int32_t)axes[axis].minAngle * ANGLE_SCALE;
+  int32_t high = (int32_t)axes[axis].maxAngle * ANGLE_SCALE;
+  pattern.min[axis] = constrain(angleFromDegrees(range[0] | 0.0f), low, high);
+  pattern.max[axis] = constrain(angleFromDegrees(range[1] | 0.0f), low, high);
+}
+
+// Scan fields of a request on top of the current pattern; false (and `error`) if the result
+// cannot be built
+bool parseScanPattern(JsonDocument& doc, ScanPattern& pattern, const char** error) {
+  pattern = scanPattern.read();
+  
+  const char* name = doc["pattern"] | scanShapeName(pattern.shape);
+  if (!scanShapeFromName(name, &pattern.shape)) {
+    *error = "pattern must be sine, raster or tour";
+    return false;
+  }
+  pattern.periodMs = constrain(lroundf((doc["period"] | pattern.periodMs / 1000.0f) * 1000), 0L, 60000L);
+  pattern.rows = constrain(doc["rows"] | (int)pattern.rows, 1, SCAN_MAX_ROWS);
+  pattern.dwellMs = constrain(doc["dwell"] | (int)pattern.dwellMs, 0, 10000);
+  pattern.speed = constrain(doc["speed"] | pattern.speed, 1.0f, 360.0f);
+  for (int i = 0; i < AXIS_COUNT; i++) parseScanRange(doc[axes[i].name], i, pattern);
+  
+  JsonArrayConst stops = doc["stops"];
+  if (!stops.isNull()) {
+    if (stops.size() < 1 || stops.size() > SCAN_MAX_STOPS) {
+      *error = "stops needs 1-8 entries";
+      return false;
+    }
+    pattern.stopCount = stops.size();
+    for (int s = 0; s < pattern.stopCount; s++) {
+      ScanStop& stop = pattern.stops[s];
+      for (int i = 0; i < AXIS_COUNT; i++) {
+        float angle = stops[s][axes[i].name] | (float)axes[i].home;
+        stop.angles[i] = constrain(angleFromDegrees(angle), (int32_t)axes[i].minAngle * ANGLE_SCALE,
+                                   (int32_t)axes[i].maxAngle * ANGLE_SCALE);
+      }
+      stop.dwellMs = constrain(stops[s]["dwell"] | 1000, 0, 60000);
+    }
+  }
+  
+  if (scanPeriodMs(pattern, AXIS_COUNT) == 0) {
+    *error = "Invalid scan pattern";
+    return false;
   }
+  return true;
+}
+
+void scanStatus(JsonDocument& doc, const ScanPattern& pattern, int rate) {
+  doc["pattern"] = scanShapeName(pattern.shape);
+  doc["rate"] = rate;
+  doc["period"] = scanPeriodMs(pattern, AXIS_COUNT) / 1000.0f;
+  if (pattern.shape == SCAN_TOUR) {
+    JsonArray stops = doc["stops"].to<JsonArray>();
+    for (int s = 0; s < pattern.stopCount; s++) {
+      JsonObject stop = stops.add<JsonObject>();
+      for (int i = 0; i < AXIS_COUNT; i++) stop[axes[i].name] = angleToDegrees(pattern.stops[s].angles[i]);
+      stop["dwell"] = pattern.stops[s].dwellMs;
+    }
+  } else {
+    for (int i = 0; i < AXIS_COUNT; i++) {
+      JsonArray range = doc[axes[i].name].to<JsonArray>();
+      range.add(angleToDegrees(pattern.min[i]));
+      range.add(angleToDegrees(pattern.max[i]));
+    }
+  }
+  if (pattern.shape == SCAN_RASTER) {
+    doc["rows"] = pattern.rows;
+    doc["dwell"] = pattern.dwellMs;
+  }
+  if (pattern.shape != SCAN_SINE) doc["speed"] = pattern.speed;
+}
+
+// GET: the scan pattern. POST: start auto scan, optionally with a new pattern
+// {"pattern":"sine","period":8,"pan":[0,180],"tilt":[90,90],"rate":100}
+// {"pattern":"raster","pan":[30,150],"tilt":[60,120],"rows":3,"speed":30,"dwell":500}
+// {"pattern":"tour","speed":60,"stops":[{"pan":45,"tilt":80,"dwell":2000},...]}
+void handleApiScan(JsonExchange& json, HttpRequest& req, HttpResponse& res) {
+  ScanPattern pattern = scanPattern.read();
+  int rate = platformState.read().scanRate;
   
-  JsonDocument doc;
-  DeserializationError error = deserializeJson(doc, server.arg("plain"));
+  if (req.method() == HttpMethod::Post) {
+    const char* error = nullptr;
+    if (!parseScanPattern(json.request, pattern, &error)) {
+      JsonDocument& response = json.response;
+      response["error"] = error;
+      json.send(res, 400);
+      return;
+    }
+    rate = constrain(json.request["rate"] | rate, MIN_RATE, MAX_RATE);
+    scanPattern.publish(pattern);
+    if (!sendCommand(res, {CMD_SCAN, (int16_t)rate, false, 0, 0, {}, 0})) return;
+    json.response["status"] = "scanning";
+  }
   
-  if (error) {
-    server.send(400, "application/json", "{\"error\":\"Invalid JSON\"}");
+  scanStatus(json.response, pattern, rate);
+  json.send(res, 200);
+}
+
+// GET returns the manual pan response curve, POST changes any of its fields
+void handleApiPan(JsonExchange& json, HttpRequest& req, HttpResponse& res) {
+  PanResponse response = panResponse.read();
+  
+  if (req.method() == HttpMethod::Post) {
+    JsonDocument& doc = json.request;
+    
+    response.maxRate = constrain(doc["max_rate"] | response.maxRate, 10.0f, 360.0f);
+    response.expo = constrain(doc["expo"] | response.expo, 0.0f, 1.0f);
+    response.maxAccel = constrain(doc["accel"] | response.maxAccel, 50.0f, 2000.0f);
+    panResponse.publish(response);
+  }
+  
+  JsonDocument& doc = json.response;
+  doc["max_rate"] = response.maxRate;
+  doc["expo"] = response.expo;
+  doc["accel"] = response.maxAccel;
+  
+  json.send(res, 200);
+}
+
+// Recording state shared by /api/record and /api/replay (durations in seconds)
+void trackStatus(JsonDocument& doc, const PlatformState& state) {
+  const MotionTrackStats& track = state.track;
+  doc["recording"] = state.recording;
+  doc["replaying"] = state.replaying;
+  doc["duration"] = track.ticks * CONTROL_PERIOD_MS / 1000.0f;
+  doc["position"] = track.played * CONTROL_PERIOD_MS / 1000.0f;
+  doc["dropped"] = track.dropped * CONTROL_PERIOD_MS / 1000.0f;
+  doc["bytes"] = track.bytes;
+  doc["capacity"] = motionTrack.capacity();
+  doc["ratio"] = track.bytes ? track.ticks * AXIS_COUNT * sizeof(int16_t) / (float)track.bytes : 0.0f;
+}
+
+// Network task, only while the control task leaves the track alone (!trackBusy)
+bool saveTrack() {
+  if (!trackFsReady) return false;
+  SavedTrack info = {TRACK_FORMAT, AXIS_COUNT, (uint16_t)(motionTrack.dataSize() / MOTION_TRACK_BLOCK_SIZE)};
+  File file = LittleFS.open(TRACK_TEMP, FILE_WRITE);
+  if (!file) return false;
+  bool ok = file.write((const uint8_t*)&info, sizeof(info)) == sizeof(info) &&
+            file.write(motionTrack.data(), motionTrack.dataSize()) == motionTrack.dataSize();
+  file.close();
+  ok = ok && LittleFS.rename(TRACK_TEMP, TRACK_FILE);
+  if (!ok) LittleFS.remove(TRACK_TEMP);
+  return ok;
+}
+
+// Boot: the saved recording, if its format and axes still match
+bool loadTrack() {
+  File file = LittleFS.open(TRACK_FILE, FILE_READ);
+  if (!file) return false;
+  SavedTrack info;
+  bool ok = file.read((uint8_t*)&info, sizeof(info)) == sizeof(info) && info.format == TRACK_FORMAT &&
+            info.channels == AXIS_COUNT && info.blocks > 0;
+  size_t size = ok ? (size_t)info.blocks * MOTION_TRACK_BLOCK_SIZE : 0;
+  ok = ok && size <= motionTrack.capacity() && file.size() == sizeof(info) + size &&
+       file.read(motionTrack.storage(), size) == size && motionTrack.restore(size);
+  file.close();
+  return ok;
+}
+
+// GET: recording state. POST {"action":"start"|"stop"|"save"}: record the commanded angles of
+// every tick (the oldest seconds give way when the buffer is full), stop, or store the
+// recording in flash
+void handleApiRecord(JsonExchange& json, HttpRequest& req, HttpResponse& res) {
+  const char* status = nullptr;
+  
+  if (req.method() == HttpMethod::Post) {
+    const char* action = json.request["action"] | "";
+    bool start = strcmp(action, "start") == 0;
+    bool save = strcmp(action, "save") == 0;
+    if (!start && !save && strcmp(action, "stop") != 0) {
+      res.send(400, "application/json", "{\"error\":\"action must be start, stop or save\"}");
+      return;
+    }
+    if ((start || save) && trackBusy) {
+      res.send(409, "application/json", "{\"error\":\"Recording or replay in progress\"}");
+      return;
+    }
+    
+    if (save) {
+      if (!saveTrack()) {
+        res.send(500, "application/json", "{\"error\":\"Flash write failed\"}");
+        return;
+      }
+      status = "saved";
+    } else {
+      trackBusy = trackBusy || start;
+      if (!sendCommand(res, {CMD_RECORD, (int16_t)start, false, 0, 0, {}, 0})) {
+        if (start) trackBusy = false;
+        return;
+      }
+      status = start ? "recording" : "stopped";
+    }
+  }
+  
+  JsonDocument& doc = json.response;
+  if (status) doc["status"] = status;
+  trackStatus(doc, platformState.read());
+  
+  json.send(res, 200);
+}
+
+// {"loop":false}: glide to where the recording starts and play it back; /api/stop ends it
+void handleApiReplay(JsonExchange& json, HttpRequest&, HttpResponse& res) {
+  PlatformState state = platformState.read();
+  if (trackBusy) {
+    res.send(409, "application/json", "{\"error\":\"Recording or replay in progress\"}");
+    return;
+  }
+  if (state.track.ticks == 0) {
+    res.send(409, "application/json", "{\"error\":\"Nothing recorded\"}");
     return;
   }
   
-  int speed = doc["speed"] | 300;
-  scanSpeed = constrain(speed, MIN_SPEED, MAX_SPEED);
+  bool loop = json.request["loop"] | false;
+  trackBusy = true;
+  if (!sendCommand(res, {CMD_REPLAY, (int16_t)loop, false, 0, 0, {}, 0})) {
+    trackBusy = false;
+    return;
+  }
   
-  currentMode = AUTO_SCAN;
-  isScanning = true;
+  JsonDocument& response = json.response;
+  response["status"] = "replaying";
+  response["loop"] = loop;
+  response["duration"] = state.track.ticks * CONTROL_PERIOD_MS / 1000.0f;
   
-  commandCount++;
+  json.send(res, 200);
+}
+
+void presetList(JsonDocument& doc) {
+  doc["slots"] = PRESET_SLOTS;
+  JsonArray list = doc["presets"].to<JsonArray>();
+  for (int slot = 0; slot < PRESET_SLOTS; slot++) {
+    const Preset* preset = presets.get(slot);
+    if (!preset) continue;
+    JsonObject entry = list.add<JsonObject>();
+    entry["slot"] = slot;
+    entry["name"] = preset->name;
+    for (int i = 0; i < AXIS_COUNT; i++) entry[axes[i].name] = angleToDegrees(preset->angles[i]);
+  }
+}
+
+// {"slot":2} or {"name":"door"}: the preset's slot, -1 if there is none. A slot is an index,
+// a name one hash lookup.
+int findPreset(JsonDocument& doc) {
+  JsonVariant slot = doc["slot"];
+  if (slot.is<int>()) return presets.get(slot.as<int>()) ? slot.as<int>() : -1;
+  return presets.find(doc["name"] | "");
+}
+
+// Network task only: the table changed, store it and hand the control task a copy
+bool storePresets() {
+  presetSnapshot.publish(presets);
+  return saveStateBlob("presets", presets.slots(), PresetTable::slotsSize());
+}
+
+// GET: every stored preset.
+// POST {"name":"door","pan":120,"tilt":60}: store a pose (default: the current angles) under a
+// name, replacing the preset of that name or the given "slot".
+// DELETE {"name":"door"} or {"slot":2}.
+void handleApiPresets(JsonExchange& json, HttpRequest& req, HttpResponse& res) {
+  JsonDocument& doc = json.request;
   
-  JsonDocument response;
-  response["status"] = "scanning";
-  response["speed"] = scanSpeed;
+  if (req.method() == HttpMethod::Post) {
+    const char* name = doc["name"] | "";
+    if (!PresetTable::validName(name)) {
+      res.send(400, "application/json", "{\"error\":\"name must be 1-15 printable characters\"}");
+      return;
+    }
+    int slot = doc["slot"] | presets.find(name);
+    if (slot < 0) slot = presets.freeSlot();
+    if (slot < 0 || slot >= PRESET_SLOTS) {
+      res.send(409, "application/json", "{\"error\":\"No free preset slot\"}");
+      return;
+    }
+    
+    PlatformState state = platformState.read();
+    int16_t angles[AXIS_COUNT];
+    for (int i = 0; i < AXIS_COUNT; i++) {
+      JsonVariant angle = doc[axes[i].name];
+      angles[i] = angle.is<float>() ? constrain(angleFromDegrees(angle.as<float>()),
+                                                (int32_t)axes[i].minAngle * ANGLE_SCALE,
+                                                (int32_t)axes[i].maxAngle * ANGLE_SCALE)
+                                    : state.angles[i];
+    }
+    if (!presets.set(slot, name, angles, AXIS_COUNT)) {
+      res.send(409, "application/json", "{\"error\":\"Name used by another slot\"}");
+      return;
+    }
+    if (!storePresets()) {
+      res.send(500, "application/json", "{\"error\":\"NVS write failed\"}");
+      return;
+    }
+  } else if (req.method() == HttpMethod::Delete) {
+    if (!presets.remove(findPreset(doc))) {
+      res.send(404, "application/json", "{\"error\":\"Unknown preset\"}");
+      return;
+    }
+    if (!storePresets()) {
+      res.send(500, "application/json", "{\"error\":\"NVS write failed\"}");
+      return;
+    }
+  }
   
-  String responseStr;
-  serializeJson(response, responseStr);
-  server.send(200, "application/json", responseStr);
+  presetList(json.response);
+  json.send(res, 200);
 }
 
-void handleApiStop() {
-  currentMode = STANDBY;
-  isScanning = false;
-  platformServo.write(90);
-  currentAngle = 90;
-  digitalWrite(LED_PIN, LOW);
+// Glide to a stored pose: {"name":"door"} or {"slot":2}, optionally "speed" (deg/s cap)
+bool parseRecall(JsonDocument& doc, PlatformCommand& cmd) {
+  int slot = findPreset(doc);
+  const Preset* preset = presets.get(slot);
+  if (!preset) return false;
+  cmd = {CMD_PRESET, (int16_t)constrain((int)(doc["speed"] | 0), 0, 360), false, 0, 0, {}, 0};
+  cmd.receivedUs = micros();
+  cmd.preset = slot;
+  memcpy(cmd.targets, preset->angles, sizeof(cmd.targets));
+  return true;
+}
+
+void handleApiPresetRecall(JsonExchange& json, HttpRequest&, HttpResponse& res) {
+  PlatformCommand cmd;
+  if (!parseRecall(json.request, cmd)) {
+    res.send(404, "application/json", "{\"error\":\"Unknown preset\"}");
+    return;
+  }
+  if (!sendCommand(res, cmd)) return;
+  
+  JsonDocument& response = json.response;
+  response["status"] = "ok";
+  response["slot"] = cmd.preset;
+  response["name"] = presets.get(cmd.preset)->name;
+  for (int i = 0; i < AXIS_COUNT; i++) response[axes[i].name] = angleToDegrees(cmd.targets[i]);
   
-  server.send(200, "application/json", "{\"status\":\"standby\"}");
+  json.send(res, 200);
 }
 
-void handleRoot() {
-  String html = "<!DOCTYPE html><html><head><meta charset='UTF-8'><meta name='viewport' content='width=device-width,initial-scale=1.0'><title>Webcam Platform</title><style>body{font-family:Arial;max-width:600px;margin:50px auto;padding:20px;background:#1a1a1a;color:#e0e0e0}button{padding:15px 30px;margin:10px;font-size:18px;cursor:pointer;border:none;border-radius:5px}.scan{background:#4CAF50;color:white}.stop{background:#f44336;color:white}.manual{background:#2196F3;color:white}.status{padding:20px;background:#2a2a2a;border-radius:5px;margin:20px 0;border:1px solid #444}.slider-container{display:flex;align-items:center;gap:10px;margin:20px 0}.btn-adjust{background:#555;color:white;border:none;padding:10px 15px;font-size:20px;cursor:pointer;border-radius:5px;width:50px}.btn-adjust:active{background:#777}input[type=range]{flex:1;height:40px}h1{color:#4CAF50}</style></head><body><h1>Webcam Platform Control</h1><div class='status'><p><strong>Mode:</strong> <span id='mode'>-</span></p><p><strong>Angle:</strong> <span id='angle'>-</span>&deg;</p><p><strong>Speed:</strong> <span id='speed'>-</span> ms</p></div><div><h3>Manual Positioning</h3><label>Pan Angle (0-180&deg;): <span id='angleValue'>90</span></label><div class='slider-container'><button class='btn-adjust' onclick='adjustAngle(-10)'>-</button><input type='range' id='angleSlider' min='0' max='180' step='10' value='90' oninput='onAngleChange()'><button class='btn-adjust' onclick='adjustAngle(10)'>+</button></div><button class='manual' onclick='setAngle()'>Set Position</button></div><div><h3>Auto Scan Mode</h3><label>Scan Speed (100-500 ms): <span id='speedValue'>300</span></label><div class='slider-container'><button class='btn-adjust' onclick='adjustSpeed(-50)'>-</button><input type='range' id='speedSlider' min='100' max='500' step='50' value='300' oninput='onSpeedChange()'><button class='btn-adjust' onclick='adjustSpeed(50)'>+</button></div><button class='scan' onclick='startScan()'>Start Scan</button><button class='stop' onclick='stop()'>Stop</button></div><script>const angleSlider=document.getElementById('angleSlider');const angleValue=document.getElementById('angleValue');const speedSlider=document.getElementById('speedSlider');const speedValue=document.getElementById('speedValue');function onAngleChange(){angleValue.textContent=angleSlider.value}function adjustAngle(delta){let newValue=parseInt(angleSlider.value)+delta;newValue=Math.max(0,Math.min(180,newValue));angleSlider.value=newValue;angleValue.textContent=newValue}function onSpeedChange(){speedValue.textContent=speedSlider.value}function adjustSpeed(delta){let newValue=parseInt(speedSlider.value)+delta;newValue=Math.max(100,Math.min(500,newValue));speedSlider.value=newValue;speedValue.textContent=newValue}function setAngle(){const angle=parseInt(angleSlider.value);fetch('/api/angle',{method:'POST',headers:{'Content-Type':'application/json'},body:JSON.stringify({angle:angle})}).then(()=>updateStatus())}function startScan(){const speed=parseInt(speedSlider.value);fetch('/api/scan',{method:'POST',headers:{'Content-Type':'application/json'},body:JSON.stringify({speed:speed})}).then(()=>updateStatus())}function stop(){fetch('/api/stop',{method:'POST'}).then(()=>updateStatus())}function updateStatus(){fetch('/api/status').then(r=>r.json()).then(data=>{document.getElementById('mode').textContent=data.mode;document.getElementById('angle').textContent=data.angle;document.getElementById('speed').textContent=data.scan_speed})}setInterval(updateStatus,1000);updateStatus()</script></body></html>";
+void handleApiStop(HttpRequest&, HttpResponse& res) {
+  if (!sendCommand(res, {CMD_STOP, 0, false, 0, 0, {}, 0})) return;
   
-  server.send(200, "text/html", html);
+  res.send(200, "application/json", "{\"status\":\"standby\"}");
+}
+
+// web/webcam_platform.html, gzipped at build time by scripts/embed_web.py and served from flash
+void handleRoot(HttpRequest& req, HttpResponse& res) {
+  res.sendGzipAsset(req, "text/html; charset=utf-8", WEB_INDEX_GZ, WEB_INDEX_GZ_LENGTH, WEB_INDEX_ETAG);
+}
+
+// ===== ROUTES =====
+// Built and checked at compile time (lib/RouteTable): a lookup is one hash of the path. The
+// server answers other methods with 405, jsonRoute parses the body (400/413) before the handler.
+constexpr HttpRoute ROUTES[] = {
+  {"/", HttpMethod::Get, handleRoot},
+  {"/api/status", HttpMethod::Get, handleApiStatus},
+  {"/api/angle", HttpMethod::Post, jsonRoute<handleApiSetAngle>},
+  {"/api/move", HttpMethod::Post, jsonRoute<handleApiMove>},
+  {"/api/calibration", HttpMethod::Any, jsonRoute<handleApiCalibration>},
+  {"/api/model", HttpMethod::Any, jsonRoute<handleApiModel>},
+  {"/api/scan", HttpMethod::Any, jsonRoute<handleApiScan>},
+  {"/api/stop", HttpMethod::Post, handleApiStop},
+  {"/api/pan", HttpMethod::Any, jsonRoute<handleApiPan>},
+  {"/api/record", HttpMethod::Any, jsonRoute<handleApiRecord>},
+  {"/api/replay", HttpMethod::Post, jsonRoute<handleApiReplay>},
+  {"/api/presets", HttpMethod::Any, jsonRoute<handleApiPresets>},
+  {"/api/presets/recall", HttpMethod::Post, jsonRoute<handleApiPresetRecall>},
+#ifdef TRACE
+  {"/api/trace", HttpMethod::Get, handleTraceRequest},
+#endif
+  {"/metrics", HttpMethod::Get, handleMetricsRequest},  // Prometheus
+};
+ROUTE_TABLE(routeTable, ROUTES);
+
+// ===== WEBSOCKET /ws =====
+// Pushes {"mode","angle","tilt","scan_rate","scan_pattern"} on change and accepts the REST
+// commands: {"cmd":"angle","angle":90,"tilt":60}, {"cmd":"move","pan":90,"tilt":60},
+// {"cmd":"scan","rate":100} (plus the /api/scan pattern fields), {"cmd":"preset","name":"door"},
+// {"cmd":"stop"}
+void wsError(uint8_t client, const char* message) {
+  char buf[96];
+  int n = snprintf(buf, sizeof(buf), "{\"error\":\"%s\"}", message);
+  server.wsSend(client, buf, n);
 }
 
+void handleWebSocket(uint8_t client, WebSocketEvent event, const char* data, size_t length) {
+  if (event == WebSocketEvent::Connect) {
+    telemetry.clientConnected(client);
+    return;
+  }
+  if (event == WebSocketEvent::Disconnect) {
+    telemetry.clientDisconnected(client);
+    return;
+  }
+  
+  JsonExchange json;
+  if (!json.parse(data, length)) {
+    wsError(client, "Invalid JSON");
+    return;
+  }
+  JsonDocument& doc = json.request;
+  
+  const char* name = doc["cmd"] | "";
+  PlatformCommand cmd;
+  
+  if (strcmp(name, "angle") == 0) {
+    int16_t values[AXIS_COUNT];
+    postAngleTargets(doc, values);
+    return;
+  } else if (strcmp(name, "move") == 0) {
+    if (!parseMove(doc, cmd)) {
+      wsError(client, "No axis target");
+      return;
+    }
+  } else if (strcmp(name, "scan") == 0) {
+    ScanPattern pattern;
+    const char* error = nullptr;
+    if (!parseScanPattern(doc, pattern, &error)) {
+      wsError(client, error);
+      return;
+    }
+    scanPattern.publish(pattern);
+    int rate = doc["rate"] | (int)platformState.read().scanRate;
+    cmd = {CMD_SCAN, (int16_t)constrain(rate, MIN_RATE, MAX_RATE), false, 0, 0, {}, 0};
+  } else if (strcmp(name, "preset") == 0) {
+    if (!parseRecall(doc, cmd)) {
+      wsError(client, "Unknown preset");
+      return;
+    }
+  } else if (strcmp(name, "stop") == 0) {
+    cmd = {CMD_STOP, 0, false, 0, 0, {}, 0};
+  } else {
+    wsError(client, "Unknown command");
+    return;
+  }
+  
+  if (!queueCommand(cmd)) {
+    wsError(client, "Command queue full");
+    return;
+  }
+}
+
+void publishTelemetry() {
+  PlatformState state = platformState.read();
+  char message[192];
+  int n = snprintf(message, sizeof(message),
+                   "{\"mode\":\"%s\",\"angle\":%.1f,\"tilt\":%.1f,\"angle_estimated\":%.1f,\"tilt_estimated\":%.1f,"
+                   "\"scan_rate\":%d,\"scan_pattern\":\"%s\"}",
+                   modeName(state.mode), angleToDegrees(state.angles[PAN]), angleToDegrees(state.angles[TILT]),
+                   angleToDegrees(state.estimated[PAN]), angleToDegrees(state.estimated[TILT]), state.scanRate,
+                   scanShapeName(scanPattern.read().shape));
+  telemetry.update(message, n);
+}
+
+// Nothing here waits: the servos hold their saved angles and the joystick is live as soon as
+// the tasks start; WiFi comes up in the background and HTTP answers once it has
 void setup() {
   Serial.begin(115200);
+  // Log output first: everything logged from here on waits in the ring, nothing blocks on the UART
+  xTaskCreatePinnedToCore(logTask, "log", 3072, nullptr, 0, nullptr, NETWORK_CORE);
   startTime = millis();
+  LOG_INFO("=== Webcam Platform Control ===");
+  
+  // Saved hold position, mode and scan (default: home, Standby, DEFAULT_SCAN)
+  SavedState saved = {};
+  for (int i = 0; i < AXIS_COUNT; i++) saved.angles[i] = axes[i].home * ANGLE_SCALE;
+  saved.scanRate = scanRate;
+  saved.mode = STANDBY;
+  saved.scan = DEFAULT_SCAN;
+  if (savedState.load(saved)) {
+    LOG_INFO("State restored from NVS: %s, pan %.1f, tilt %.1f", modeName((Mode)saved.mode),
+             angleToDegrees(saved.angles[PAN]), angleToDegrees(saved.angles[TILT]));
+  }
+  
+  // Saved recording (the first boot formats the data partition)
+  trackFsReady = LittleFS.begin(true);
+  if (!trackFsReady) {
+    LOG_ERROR("LittleFS mount failed: recordings cannot be saved");
+  } else if (loadTrack()) {
+    LOG_INFO("Recording restored: %.1f s", motionTrack.stats().ticks * CONTROL_PERIOD_MS / 1000.0f);
+  }
+  // Recordings were kept in NVS before; free the space they took
+  if (eraseStateBlob("track")) eraseStateBlob("track_info");
   
-  // Setup servo
-  platformServo.attach(SERVO_PIN);
-  platformServo.write(90);
+  // Saved presets
+  if (loadStateBlob("presets", presets.slots(), PresetTable::slotsSize())) {
+    presets.restore();
+    LOG_INFO("Presets restored from NVS: %u", presets.count());
+  }
+  presetSnapshot.publish(presets);
+  
+  // Setup servos; each attach() takes the next free LEDC channel
+  for (int i = 0; i < AXIS_COUNT; i++) {
+    ServoAxis& axis = axes[i];
+    ServoCalibration cal = linearCalibration(axis.minUs, axis.maxUs);
+    if (loadCalibration(axis.name, cal)) {
+      LOG_INFO("Servo %s: calibration loaded from NVS", axis.name);
+    }
+    calibrations[i].publish(cal);
+    ServoDynamics servo = SG90_DYNAMICS;
+    if (loadDynamics(axis.name, servo)) {
+      LOG_INFO("Servo %s: %.0f deg/s loaded from NVS", axis.name, servo.slewRate);
+    }
+    dynamics[i].publish(servo);
+    axis.model.setDynamics(servo);
+    axis.servo.attach(axis.pin);
+    axis.servo.setCalibration(cal);
+    writeAxis(axis, saved.angles[i]);
+    axis.model.reset(axis.angle, millis());  // unknown really; assume the horn held the saved angle
+  }
   
   // Setup LED
   pinMode(LED_PIN, OUTPUT);
   digitalWrite(LED_PIN, LOW);
   
-  // Setup joystick
+  panResponse.publish(DEFAULT_PAN_RESPONSE);
+  
+  scanRate = constrain((int)saved.scanRate, MIN_RATE, MAX_RATE);
+  scanPattern.publish(scanPeriodMs(saved.scan, AXIS_COUNT) ? saved.scan : DEFAULT_SCAN);
+  if (saved.mode == AUTO_SCAN) {
+    enterAutoScan(millis());
+  } else if (saved.mode == MANUAL_PAN) {
+    currentMode = MANUAL_PAN;
+    beginPan(millis());
+  }
+  
+  // Setup joystick; sampling starts now so the center is calibrated right after power-on
   pinMode(SW_PIN, INPUT_PULLUP);
+  attachInterrupt(digitalPinToInterrupt(SW_PIN), buttonIsr, CHANGE);
+  xTaskCreatePinnedToCore(joystickTask, "joystick", 4096, nullptr, 5, nullptr, CONTROL_CORE);
   
-  // Connect to WiFi
-  Serial.println("\n=== Webcam Platform Control ===");
-  Serial.print("Connecting to WiFi: ");
-  Serial.println(WIFI_SSID);
-  
-  WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
-  
-  while (WiFi.status() != WL_CONNECTED) {
-    delay(500);
-    Serial.print(".");
-  }
-  
-  Serial.println("\n✓ WiFi connected!");
-  Serial.print("IP address: ");
-  Serial.println(WiFi.localIP());
-  
-  // Setup API endpoints
-  server.on("/", handleRoot);
-  server.on("/api/status", handleApiStatus);
-  server.on("/api/angle", handleApiSetAngle);
-  server.on("/api/scan", handleApiScan);
-  server.on("/api/stop", handleApiStop);
-  
-  server.begin();
-  Serial.println("✓ HTTP server started");
-  Serial.println("================================\n");
-}
-
-void handleButtonClick() {
-  bool sw = digitalRead(SW_PIN);
-  
-  // Detect button press (HIGH -> LOW transition)
-  if (sw == LOW && lastSwState == HIGH) {
-    // Simple mode cycling: Standby -> Manual Pan -> Auto Scan -> Standby
-    if (currentMode == STANDBY) {
-      currentMode = MANUAL_PAN;
-      Serial.println("Mode: MANUAL_PAN");
-    } else if (currentMode == MANUAL_PAN) {
-      currentMode = AUTO_SCAN;
-      isScanning = true;
-      Serial.println("Mode: AUTO_SCAN");
-    } else if (currentMode == AUTO_SCAN) {
-      currentMode = STANDBY;
-      isScanning = false;
-      platformServo.write(90);
-      currentAngle = 90;
-      digitalWrite(LED_PIN, LOW);
-      Serial.println("Mode: STANDBY (returned to center)");
+  // WiFi: only start the association
+  LOG_INFO("Connecting to WiFi in the background: %s", WIFI_SSID);
+  wifiLink.begin(millis());
+  
+  // API endpoints: ROUTES
+  useRoutes(server, routeTable);
+  server.onWebSocket("/ws", handleWebSocket);
+  if (allocCounterEnabled()) server.setAllocProbe(allocCount);  // per-handler heap allocations (ALLOC_COUNTER builds)
+  setupMetrics();
+  
+  server.begin();  // listens on every interface, reachable once WiFi has an address
+  LOG_INFO("✓ HTTP server started");
+  
+  if (udpControl.begin()) {
+    server.wakeOn(udpControl.fd());  // UDP packets end the HTTP poll wait immediately
+    LOG_INFO("✓ UDP control on port %d", UDP_CONTROL_PORT);
+  }
+  
+  // Control on core 1, networking on core 0
+  publishState();
+  bootMs = millis();
+  xTaskCreatePinnedToCore(controlTask, "platform_ctl", 4096, nullptr, 10, nullptr, CONTROL_CORE);
+  // Extra stack for the JsonExchange arena that handlers keep on the stack
+  xTaskCreatePinnedToCore(networkTask, "network", 12288, nullptr, 1, nullptr, NETWORK_CORE);
+#ifdef BENCH
+  xTaskCreatePinnedToCore(benchTask, "bench", 6144, nullptr, 1, nullptr, NETWORK_CORE);
+#endif
+  LOG_INFO("================================");
+}
+
+// Runs on every SW_PIN edge: only timestamps it, all logic is in the control task
+void IRAM_ATTR buttonIsr() {
+  buttonEdges.push({(uint32_t)millis(), digitalRead(SW_PIN) == LOW});
+}
+
+void enterStandby() {
+  cancelMove();
+  currentMode = STANDBY;
+  isScanning = false;
+  for (ServoAxis& axis : axes) writeAxis(axis, axis.home * ANGLE_SCALE);
+  digitalWrite(LED_PIN, LOW);
+  LOG_INFO("Mode: STANDBY (returned to center)");
+}
+
+// Plan the transition to a preset; Manual Pan continues from the pose, other modes stop
+void recallPreset(const PlatformCommand& cmd, unsigned long now) {
+  if (currentMode == AUTO_SCAN || currentMode == REMOTE || currentMode == REPLAY) {
+    currentMode = STANDBY;
+    isScanning = false;
+  }
+  startMove(cmd, now);
+  presetSlot = cmd.preset;
+  presetMoving = true;
+  presetMoveStart = now;
+  presetRecalls++;
+  presetLatencyUs = micros() - cmd.receivedUs;
+  LOG_INFO("Preset %d", cmd.preset);
+}
+
+void recallNextPreset(unsigned long now) {
+  PresetTable table = presetSnapshot.read();
+  int slot = table.next(presetSlot);
+  if (slot < 0) {
+    LOG_INFO("No presets stored");
+    return;
+  }
+  PlatformCommand cmd = {CMD_PRESET, 0, false, 0, 0, {}, 0};
+  cmd.receivedUs = micros();
+  cmd.preset = slot;
+  memcpy(cmd.targets, table.get(slot)->angles, sizeof(cmd.targets));
+  recallPreset(cmd, now);
+}
+
+void enterManualPan(unsigned long now) {
+  cancelMove();
+  currentMode = MANUAL_PAN;
+  isScanning = false;
+  beginPan(now);
+  LOG_INFO("Mode: MANUAL_PAN");
+}
+
+// Build the published pattern and glide to where it starts; handleAutoScan takes over on arrival
+void enterAutoScan(unsigned long now) {
+  cancelMove();
+  currentMode = AUTO_SCAN;
+  isScanning = true;
+  {
+    TRACE_SCOPE("scan_build");
+    scanTable.build(scanPattern.read(), AXIS_COUNT);  // validated by the network task
+  }
+  scanTable.restart();
+  scanStarting = true;
+  scanRateEffective = scanRate;
+  
+  PlatformCommand move = {CMD_MOVE, 0, false, 0, 0, {}, 0};
+  scanTable.start(move.targets);
+  startMove(move, now);
+  LOG_INFO("Mode: AUTO_SCAN (%s, %.1f s at %d%%)", scanShapeName(scanPattern.read().shape),
+           scanTable.periodMs() / 1000.0f, scanRate);
+}
+
+void handleButtonEvent(ButtonEvent event, unsigned long now) {
+  // Long press from any mode: stop and return to center; in Standby: next preset
+  if (event == BUTTON_LONG_PRESS) {
+    if (currentMode != STANDBY) {
+      enterStandby();
+    } else {
+      recallNextPreset(now);
     }
-    
-    delay(300);  // Debounce
+    return;
   }
   
-  lastSwState = sw;
+  switch (currentMode) {
+    case STANDBY:
+      if (event == BUTTON_DOUBLE_CLICK) enterAutoScan(now);
+      else enterManualPan(now);
+      break;
+    case AUTO_SCAN:
+      enterManualPan(now);
+      break;
+    case MANUAL_PAN:
+      if (event == BUTTON_DOUBLE_CLICK) enterAutoScan(now);
+      else enterStandby();
+      break;
+    case REMOTE:
+    case REPLAY:
+      enterStandby();
+      break;
+  }
 }
 
-void handleAutoScan() {
-  if (!isScanning) return;
+void handleButton(unsigned long now) {
+  ButtonEdge edge;
+  while (buttonEdges.pop(edge)) button.edge(edge);
+  
+  // An edge lost to a full queue would leave the debouncer on the wrong level
+  button.edge({(uint32_t)now, buttonDown()});
   
-  unsigned long now = millis();
+  ButtonEvent event;
+  while ((event = button.poll(now)) != BUTTON_NONE) handleButtonEvent(event, now);
+}
+
+void handleAutoScan(unsigned long now) {
+  if (!isScanning) return;
   
   // LED blinking
   if (now - lastLedToggle >= 500) {
@@ -241,82 +1383,638 @@ void handleAutoScan() {
     lastLedToggle = now;
   }
   
-  // Read VRx for speed adjustment
-  int vrx = analogRead(VRX_PIN);
-  if (vrx < 1800) {
-    scanSpeed = max(MIN_SPEED, scanSpeed - SPEED_STEP);
-  } else if (vrx > 1900) {
-    scanSpeed = min(MAX_SPEED, scanSpeed + SPEED_STEP);
+  // VRx adjusts the rate (filtered, calibrated deflection); the table stays as it is
+  JoystickState stick = joystickState.read();
+  if (stick.x < -RATE_DEFLECTION) {
+    scanRate = max(MIN_RATE, scanRate - RATE_STEP);
+  } else if (stick.x > RATE_DEFLECTION) {
+    scanRate = min(MAX_RATE, scanRate + RATE_STEP);
   }
   
-  // Servo movement: 0 -> 180 -> 0 -> 180 (like Phase 7)
-  if (now - lastScanMove >= scanSpeed) {
-    if (scanDirection) {
-      platformServo.write(180);
-      currentAngle = 180;
-      scanDirection = false;
-    } else {
-      platformServo.write(0);
-      currentAngle = 0;
-      scanDirection = true;
-    }
-    lastScanMove = now;
+  // Advance through the table by the real elapsed time and interpolate, but no faster than the
+  // servos turn (their models): where the pattern outruns them the scan slows down instead of
+  // cutting the ends short, and it runs at full rate wherever they keep up
+  if (scanStarting) {
+    if (!servosArrived()) return;  // the glide's commands are there, the horns not yet
+    scanStarting = false;
+    lastScanStep = now;
   }
+  float slewRates[AXIS_COUNT];
+  for (int i = 0; i < AXIS_COUNT; i++) slewRates[i] = axes[i].model.dynamics().slewRate;
+  scanRateEffective = scanTable.limitRate(now - lastScanStep, scanRate, slewRates);
+  scanTable.advance(now - lastScanStep, scanRateEffective);
+  lastScanStep = now;
+  
+  int16_t angles[AXIS_COUNT];
+  scanTable.sample(angles);
+  for (int i = 0; i < AXIS_COUNT; i++) writeAxis(axes[i], angles[i]);
+}
+
+// Start integrating from where the servos are now
+void beginPan(unsigned long now) {
+  for (ServoAxis& axis : axes) axis.rate.reset(angleToDegrees(axis.angle));
+  lastPanStep = now;
 }
 
-void handleManualPan() {
+// Advance every axis towards its rate (deg/s) over the real time since the last step
+void stepPan(const float* rates, unsigned long now) {
+  PanResponse response = panResponse.read();
+  float dt = (now - lastPanStep) / 1000.0f;
+  lastPanStep = now;
+  
+  for (int i = 0; i < AXIS_COUNT; i++) {
+    writeAxis(axes[i], angleFromDegrees(axes[i].rate.update(rates[i], response.maxAccel, dt)));
+  }
+}
+
+void handleManualPan(unsigned long now) {
   // LED on solid
   digitalWrite(LED_PIN, HIGH);
   
-  // Read VRy for manual positioning
-  int vry = analogRead(VRY_PIN);
-  
-  // Map VRy to direction (with deadzone in center)
-  int centerValue = 2048;
-  int offset = vry - centerValue;
-  const int DEADZONE = 300;  // Deadzone for center position
-  
-  if (abs(offset) > DEADZONE) {
-    // Joystick moved from center - determine direction
-    if (offset < 0) {
-      // Joystick left - move to 0
-      if (currentAngle > 0) {
-        currentAngle--;
-        platformServo.write(currentAngle);
-        delay(15);  // Smooth movement
+  // Deflection -> velocity (VRy pans, VRx tilts); a released stick decelerates to a hold
+  JoystickState stick = joystickState.read();
+  PanResponse response = panResponse.read();
+  float rates[AXIS_COUNT] = {
+    stickToRate(stick.y / (float)JOYSTICK_FULL_SCALE, response),
+    stickToRate(stick.x / (float)JOYSTICK_FULL_SCALE, response),
+  };
+  stepPan(rates, now);
+}
+
+uint16_t readStick(uint8_t pin) {
+#ifdef BENCH
+  if (benchStick.load(std::memory_order_relaxed)) {
+    // Pan sweeps full scale every 4 s, tilt half scale every 3 s
+    float t = millis() / 1000.0f;
+    float deflection = pin == VRY_PIN ? sinf(t * 2 * PI / 4) : 0.5f * sinf(t * 2 * PI / 3);
+    return (uint16_t)(2048 + 2047 * deflection);
+  }
+#endif
+  return analogRead(pin);
+}
+
+bool buttonDown() {
+#ifdef BENCH
+  if (benchButton.load(std::memory_order_relaxed)) return true;
+#endif
+  return digitalRead(SW_PIN) == LOW;
+}
+
+// Oversample -> filter -> (boot) calibrate -> publish; never blocks the control task
+void joystickTask(void*) {
+  AxisFilter filterX, filterY;
+  CenterCalibrator calibratorX(JOYSTICK_CAL_SAMPLES, JOYSTICK_MIN_DEADZONE, JOYSTICK_MAX_NOISE);
+  CenterCalibrator calibratorY(JOYSTICK_CAL_SAMPLES, JOYSTICK_MIN_DEADZONE, JOYSTICK_MAX_NOISE);
+  JoystickState state = {};
+  uint16_t rawX[JOYSTICK_OVERSAMPLE];
+  uint16_t rawY[JOYSTICK_OVERSAMPLE];
+  TickType_t lastWake = xTaskGetTickCount();
+  
+  for (;;) {
+    vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(JOYSTICK_PERIOD_MS));
+    TRACE_SCOPE("joystick_sample");
+    
+    for (int i = 0; i < JOYSTICK_OVERSAMPLE; i++) {
+      rawX[i] = readStick(VRX_PIN);
+      rawY[i] = readStick(VRY_PIN);
+    }
+    state.filteredX = filterX.update(rawX, JOYSTICK_OVERSAMPLE);
+    state.filteredY = filterY.update(rawY, JOYSTICK_OVERSAMPLE);
+    state.samples++;
+    
+    if (!state.calibrated) {
+      calibratorX.add(state.filteredX);
+      calibratorY.add(state.filteredY);
+      if (calibratorX.done() && calibratorY.done()) {
+        bool okX, okY;
+        state.calX = calibratorX.result(&okX);
+        state.calY = calibratorY.result(&okY);
+        state.calibrated = true;
+        LOG_INFO("Joystick center: X=%u (±%u) Y=%u (±%u)%s", state.calX.center, state.calX.deadzone,
+                 state.calY.center, state.calY.deadzone, okX && okY ? "" : " - stick moved, nominal center used");
       }
     } else {
-      // Joystick right - move to 180
-      if (currentAngle < 180) {
-        currentAngle++;
-        platformServo.write(currentAngle);
-        delay(15);  // Smooth movement
-      }
+      state.x = normalizeAxis(state.filteredX, state.calX);
+      state.y = normalizeAxis(state.filteredY, state.calY);
     }
+    joystickState.publish(state);
   }
-  // If joystick in deadzone - stop (hold current position, no movement)
 }
 
-void loop() {
-  server.handleClient();
+// Integrate the UDP pan velocity; the watchdog zeroes it when the stream stops
+void handleRemotePan(unsigned long now) {
+  digitalWrite(LED_PIN, HIGH);
+  float rates[AXIS_COUNT] = {remoteRate, 0};
+  stepPan(rates, now);
+}
+
+// Plan every axis from where it is (and how fast it moves) so all of them arrive together
+void startMove(const PlatformCommand& cmd, unsigned long now) {
+  float from[AXIS_COUNT];
+  float to[AXIS_COUNT];
+  float velocity[AXIS_COUNT];
+  MotionLimits limits[AXIS_COUNT];
   
-  // Handle button clicks
-  handleButtonClick();
+  for (int i = 0; i < AXIS_COUNT; i++) {
+    ServoAxis& axis = axes[i];
+    if (moveActive) {
+      axis.motion.update(now);
+    } else {
+      axis.motion.reset(angleToDegrees(axis.angle));
+    }
+    from[i] = axis.motion.position();
+    velocity[i] = axis.motion.velocity();
+    to[i] = cmd.targets[i] != AXIS_KEEP ? angleToDegrees(cmd.targets[i]) : axis.motion.target();
+    limits[i] = axis.limits;
+    if (cmd.value > 0 && cmd.value < limits[i].maxVelocity) limits[i].maxVelocity = cmd.value;
+  }
   
-  // Handle current mode
-  switch (currentMode) {
-    case STANDBY:
-      digitalWrite(LED_PIN, LOW);
+  synchronizeLimits(from, to, velocity, limits, AXIS_COUNT);
+  for (int i = 0; i < AXIS_COUNT; i++) axes[i].motion.moveTo(to[i], limits[i], now);
+  moveActive = true;
+  presetMoving = false;  // a new move replaces a preset transition (recallPreset sets it again)
+}
+
+void updateMove(unsigned long now) {
+  bool moving = false;
+  for (ServoAxis& axis : axes) {
+    writeAxis(axis, angleFromDegrees(axis.motion.update(now)));
+    moving = moving || axis.motion.isMoving();
+  }
+  if (!moving) {
+    moveActive = false;
+    beginPan(now);  // Manual Pan continues from the end of the move
+  }
+}
+
+// Where the horns probably are after this tick's writes. A preset transition ends when they
+// arrive, not when the commands do.
+void updateModels(unsigned long now) {
+  for (ServoAxis& axis : axes) axis.model.update(axis.angle, now);
+  if (presetMoving && !moveActive && servosArrived()) {
+    presetMoving = false;
+    presetTransitionMs = now - presetMoveStart;
+  }
+}
+
+void stopRecording() {
+  recording = false;
+  motionTrack.finish();
+  trackBusy = false;
+  MotionTrackStats track = motionTrack.stats();
+  LOG_INFO("Recording stopped: %.1f s in %u bytes", track.ticks * CONTROL_PERIOD_MS / 1000.0f,
+           (unsigned)track.bytes);
+}
+
+// Glide to the first recorded sample; handleReplay continues from the second one
+bool startReplay(unsigned long now) {
+  int16_t first[AXIS_COUNT];
+  motionTrack.rewind();
+  if (!motionTrack.next(first)) return false;
+  
+  PlatformCommand move = {CMD_MOVE, 0, false, 0, 0, {}, 0};
+  memcpy(move.targets, first, sizeof(first));
+  startMove(move, now);
+  return true;
+}
+
+// One recorded sample per tick, the timing of the recording; at the end the platform holds
+// there in Standby, or glides back to the start when looping
+void handleReplay(unsigned long now) {
+  digitalWrite(LED_PIN, HIGH);
+  
+  int16_t angles[AXIS_COUNT];
+  if (motionTrack.next(angles)) {
+    for (int i = 0; i < AXIS_COUNT; i++) writeAxis(axes[i], angles[i]);
+    return;
+  }
+  if (replayLoop && startReplay(now)) return;
+  
+  currentMode = STANDBY;
+  LOG_INFO("Replay finished");
+}
+
+// Jump one axis to an angle (1/100 degree); a coordinated move in flight is dropped
+void setAxisAngle(int axis, int16_t angle) {
+  cancelMove();
+  writeAxis(axes[axis], angle);
+  axes[axis].rate.reset(angleToDegrees(axes[axis].angle));
+}
+
+// Newest direct target per axis: however many arrived since the last tick, one servo write
+void takeAngleTargets() {
+  for (int i = 0; i < AXIS_COUNT; i++) {
+    AngleTarget target;
+    if (!angleTargets[i].take(target)) continue;
+    setAxisAngle(i, target.angle);
+    angleApplied++;
+    angleLagUs = micros() - target.receivedUs;
+    if (angleLagUs > angleMaxLagUs) angleMaxLagUs = angleLagUs;
+#ifdef BENCH
+    angleBurst.applied(angleLagUs);
+#endif
+  }
+}
+
+void applyCommand(const PlatformCommand& cmd, unsigned long now) {
+  if (cmd.udp) {
+    udpPending = true;
+    udpPendingSeq = cmd.udpSeq;
+    udpPendingReceivedUs = cmd.receivedUs;
+  }
+  
+  switch (cmd.type) {
+    case CMD_SET_ANGLE:
+      setAxisAngle(PAN, cmd.value);
       break;
       
-    case AUTO_SCAN:
-      handleAutoScan();
+    case CMD_CALIBRATE:
+      axes[cmd.value].servo.setCalibration(calibrations[cmd.value].read());
+      axes[cmd.value].model.setDynamics(dynamics[cmd.value].read());
       break;
       
-    case MANUAL_PAN:
-      handleManualPan();
+    case CMD_MOVE:
+      // Auto scan, the UDP stream and a replay would fight the move; Manual Pan resumes after it
+      if (currentMode == AUTO_SCAN || currentMode == REMOTE || currentMode == REPLAY) {
+        currentMode = STANDBY;
+        isScanning = false;
+      }
+      startMove(cmd, now);
+      break;
+      
+    case CMD_SCAN:
+      scanRate = cmd.value;
+      enterAutoScan(now);
+      break;
+      
+    case CMD_STOP:
+      enterStandby();
+      break;
+      
+    case CMD_PAN_RATE:
+      if (currentMode != REMOTE) {
+        cancelMove();
+        currentMode = REMOTE;
+        isScanning = false;
+        beginPan(now);
+      }
+      remoteRate = cmd.value / 10.0f;
+      break;
+      
+    case CMD_PAN_HALT:
+      if (currentMode == REMOTE) remoteRate = 0;
+      break;
+      
+    case CMD_RECORD:
+      if (cmd.value) {
+        motionTrack.clear();
+        recording = true;
+        LOG_INFO("Recording started");
+      } else if (recording) {
+        stopRecording();
+      }
+      break;
+      
+    case CMD_PRESET:
+      recallPreset(cmd, now);
+      break;
+      
+    case CMD_REPLAY:
+      isScanning = false;
+      replayLoop = cmd.value != 0;
+      if (startReplay(now)) {
+        currentMode = REPLAY;
+        replaying = true;
+        LOG_INFO("Mode: REPLAY");
+      } else {
+        trackBusy = false;
+      }
       break;
   }
+}
+
+void publishState() {
+  TRACE_SCOPE("publish");
+  PlatformState state;
+  state.mode = currentMode;
+  for (int i = 0; i < AXIS_COUNT; i++) {
+    state.angles[i] = axes[i].angle;
+    state.targets[i] = moveActive ? angleFromDegrees(axes[i].motion.target()) : axes[i].angle;
+    state.estimated[i] = axes[i].model.estimated();
+    state.pulses[i] = axes[i].servo.pulseUs();
+  }
+  state.moving = moveActive || !servosArrived();
+  state.scanRate = scanRate;
+  state.scanRateEffective = isScanning ? scanRateEffective : scanRate;
+  state.udpApplied = udpApplied;
+  state.udpSeq = udpAppliedSeq;
+  state.udpLatencyUs = udpLatencyUs;
+  state.recording = recording;
+  state.replaying = replaying;
+  state.track = motionTrack.stats();
+  state.presetSlot = (int8_t)presetSlot;
+  state.presetMoving = presetMoving;
+  state.presetRecalls = presetRecalls;
+  state.presetLatencyUs = presetLatencyUs;
+  state.presetTransitionMs = presetTransitionMs;
+  state.angleApplied = angleApplied;
+  state.angleLagUs = angleLagUs;
+  state.angleMaxLagUs = angleMaxLagUs;
+  state.timing = controlStats.timing();
+  platformState.publish(state);
+}
+
+// Fixed-rate control tick: angle targets, commands -> button -> mode logic -> servo models -> snapshot
+void controlTask(void*) {
+  TickType_t lastWake = xTaskGetTickCount();
   
-  delay(10);
+  for (;;) {
+    vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(CONTROL_PERIOD_MS));
+    controlStats.begin(micros());
+    TRACE_SCOPE("control_tick");
+    
+    unsigned long now = millis();
+    takeAngleTargets();  // before the queue: a move or scan queued after them wins
+    PlatformCommand cmd;
+    while (commandQueue.pop(cmd)) {
+      TRACE_SCOPE("command");
+      applyCommand(cmd, now);
+    }
+    
+    // Handle button clicks
+    handleButton(now);
+    
+    // A coordinated move owns the servos until all axes arrive
+    TRACE_SCOPE("mode_update");  // until the end of the tick, publish included
+    if (moveActive) {
+      updateMove(now);
+    } else {
+      // Handle current mode
+      switch (currentMode) {
+        case STANDBY:
+          digitalWrite(LED_PIN, LOW);
+          break;
+          
+        case AUTO_SCAN:
+          handleAutoScan(now);
+          break;
+          
+        case MANUAL_PAN:
+          handleManualPan(now);
+          break;
+          
+        case REMOTE:
+          handleRemotePan(now);
+          break;
+          
+        case REPLAY:
+          handleReplay(now);
+          break;
+      }
+    }
+    
+    updateModels(now);
+    
+    // Replay finished or another mode took over: the track is free again
+    if (replaying && currentMode != REPLAY) {
+      replaying = false;
+      trackBusy = false;
+    }
+    
+    // Record what the servos were commanded this tick, whatever the mode
+    if (recording) {
+      int16_t angles[AXIS_COUNT];
+      for (int i = 0; i < AXIS_COUNT; i++) angles[i] = axes[i].angle;
+      motionTrack.add(angles);
+    }
+    
+    // The servo has its new position now: time the UDP command that caused it
+    if (udpPending) {
+      udpPending = false;
+      udpApplied++;
+      udpAppliedSeq = udpPendingSeq;
+      udpLatencyUs = micros() - udpPendingReceivedUs;
+    }
+    
+    publishState();
+    controlStats.end(micros());
+    const TickTiming& timing = controlStats.timing();
+    if (timing.lastPeriodUs) {
+      loopPeriod.observe(timing.lastPeriodUs);
+      loopJitter.observe(timing.lastJitterUs);
+    }
+#ifdef BENCH
+    benchLoop.record(controlStats.timing().lastBusyUs, controlStats.timing().lastJitterUs);
+#endif
+  }
+}
+
+// Latest UDP command into the queue, watchdog, and acks for commands the servo has applied
+void pollUdpControl() {
+  static uint32_t ackedCount = 0;
+  static bool haltPending = false;  // the watchdog fires once: retry while the queue is full
+  uint32_t nowUs = micros();
+  
+  UdpCommand udp;
+  if (udpControl.poll(nowUs, udp)) {
+    PlatformCommand cmd = {};
+    if (udp.type == UDP_ANGLE) {
+      cmd.type = CMD_SET_ANGLE;
+      cmd.value = constrain(udp.value, 0, 180 * ANGLE_SCALE);
+    } else if (udp.type == UDP_RATE) {
+      cmd.type = CMD_PAN_RATE;
+      cmd.value = udp.value;
+    } else {
+      cmd.type = CMD_STOP;
+    }
+    cmd.udp = true;
+    cmd.udpSeq = udp.seq;
+    cmd.receivedUs = nowUs;
+    if (queueCommand(cmd)) haltPending = false;  // the stream is back, its rate wins
+  }
+  
+  if (udpControl.watchdogExpired(nowUs)) {
+    haltPending = true;
+    LOG_WARN("UDP: stream lost, pan stopped");
+  }
+  if (haltPending) {
+    PlatformCommand halt = {};
+    halt.type = CMD_PAN_HALT;
+    if (queueCommand(halt)) haltPending = false;
+  }
+  
+  PlatformState state = platformState.read();
+  if (state.udpApplied != ackedCount) {
+    ackedCount = state.udpApplied;
+    udpControl.applied(state.udpSeq, state.angles[PAN], state.udpLatencyUs);
+  }
+}
+
+// Snapshot -> saved state; savedState decides when it is worth a flash write
+void persistState(unsigned long now) {
+  PlatformState state = platformState.read();
+  SavedState saved = savedState.value();
+  if (!state.moving && state.mode != AUTO_SCAN && state.mode != REPLAY) {
+    for (int i = 0; i < AXIS_COUNT; i++) saved.angles[i] = state.angles[i];
+  }
+  saved.scanRate = state.scanRate;
+  saved.scan = scanPattern.read();
+  saved.mode = state.mode == REMOTE || state.mode == REPLAY ? STANDBY : state.mode;
+  savedState.update(saved, now);
+  savedState.flush(now);
+}
+
+void networkTask(void*) {
+  for (;;) {
+    server.poll(5);
+    unsigned long now = millis();
+    if (wifiLink.poll(now)) {
+      IPAddress ip = WiFi.localIP();
+      LOG_INFO("✓ WiFi connected, IP address: %u.%u.%u.%u", ip[0], ip[1], ip[2], ip[3]);
+    }
+    pollWifiMetrics();
+    persistState(now);
+    {
+      TRACE_SCOPE("udp_poll");
+      pollUdpControl();
+    }
+    TRACE_SCOPE("telemetry");
+    publishTelemetry();
+    telemetry.pump(millis());
+  }
+}
+
+// Prints what the LOG_* calls queued (lib/Log). Lowest priority on core 0: a UART that cannot
+// keep up only ever delays the log, and messages beyond the ring are dropped and counted.
+const uint32_t LOG_PERIOD_MS = 20;
+
+void logEmit(const char* line) {
+  Serial.println(line);
+}
+
+void logTask(void*) {
+  for (;;) {
+    logBuffer.drain(logEmit);
+    vTaskDelay(pdMS_TO_TICKS(LOG_PERIOD_MS));
+  }
+}
+
+// Called after useRoutes(): every route gets its own latency histogram
+void setupMetrics() {
+  attachHttpMetrics(server, metrics);
+  addSystemMetrics(metrics);
+  metrics.counter("servo_commands_total", "Commands accepted (queued or posted as the latest angle)", platformCommands);
+  metrics.counter("command_queue_drops_total", "Commands refused because the queue was full",
+                  [] { return (double)commandQueue.dropped(); });
+  metrics.gauge("command_queue_depth", "Commands waiting for the control task", [] { return (double)commandQueue.size(); });
+  metrics.counter("angle_targets_total", "Direct angle targets accepted (HTTP and WebSocket)", [] {
+    return (double)(angleTargets[PAN].posted() + angleTargets[TILT].posted());
+  });
+  metrics.counter("angle_targets_superseded_total", "Angle targets replaced by a newer one before the control tick", [] {
+    return (double)(angleTargets[PAN].superseded() + angleTargets[TILT].superseded());
+  });
+  metrics.histogram("control_loop_period_seconds", "Start-to-start time of control ticks (nominal 10 ms)", loopPeriod);
+  metrics.histogram("control_loop_jitter_seconds", "Deviation of the tick period from nominal", loopJitter);
+  metrics.counter("control_loop_deadline_misses_total", "Ticks started a period late or overran",
+                  [] { return (double)platformState.read().timing.deadlineMisses; });
+  metrics.counter("udp_packets_total", "UDP control datagrams received",
+                  [] { return (double)udpControl.stats().received; });
+  metrics.counter("log_messages_total", "Log messages queued for the serial port", [] { return (double)logBuffer.written(); });
+  metrics.counter("log_dropped_total", "Log messages dropped because the ring was full",
+                  [] { return (double)logBuffer.dropped(); });
+  metrics.counter("state_updates_total", "Changes of the persisted state", [] { return (double)savedState.updates(); });
+  metrics.counter("state_writes_total", "NVS writes the state changes were coalesced into",
+                  [] { return (double)savedState.writes(); });
+}
+
+// ===== BENCHMARK (-DBENCH) =====
+// Repeatable scenarios through the real API and inputs; results go to Serial as BENCH lines
+// (lib/Bench, tools/bench_report.py)
+#ifdef BENCH
+const uint32_t BENCH_SCENARIO_MS = 5000;
+
+void benchStandby(HttpBenchClient& api) {
+  benchStick = false;
+  api.request("POST", "/api/stop", nullptr);
+}
+
+void benchAutoScan(HttpBenchClient& api) {
+  benchStick = false;
+  api.request("POST", "/api/scan", "{\"rate\":400}");
+}
+
+// Click from Standby: the click is reported once the double-click window has passed
+void benchManualPan(HttpBenchClient& api) {
+  benchStandby(api);
+  delay(CONTROL_PERIOD_MS * 2);
+  benchStick = true;
+  benchButton = true;
+  delay(BUTTON_DEBOUNCE_MS * 4);
+  benchButton = false;
+  delay(DOUBLE_CLICK_TIMEOUT + CONTROL_PERIOD_MS * 5);
+}
+
+// Manual pan with the recorder running, then the replay of that recording
+void benchRecord(HttpBenchClient& api) {
+  benchManualPan(api);
+  api.request("POST", "/api/record", "{\"action\":\"start\"}");
+}
+
+void benchReplay(HttpBenchClient& api) {
+  api.request("POST", "/api/record", "{\"action\":\"stop\"}");
+  benchStick = false;
+  delay(CONTROL_PERIOD_MS * 2);
+  api.request("POST", "/api/replay", "{\"loop\":true}");
+}
+
+// Alternate between two corners; every move is planned while the previous one is in flight
+void benchMoveStep(HttpBenchClient& api, uint32_t elapsedMs) {
+  static uint32_t lastPhase = UINT32_MAX;
+  uint32_t phase = elapsedMs / 1200;
+  if (phase == lastPhase) return;
+  lastPhase = phase;
+  api.request("POST", "/api/move", phase % 2 ? "{\"pan\":20,\"tilt\":40}" : "{\"pan\":160,\"tilt\":140}");
+}
+
+void benchAngleBurst(HttpBenchClient& api, uint32_t elapsedMs) {
+  angleBurst.fire(api);
+}
+
+const BenchScenario BENCH_SCENARIOS[] = {
+  {"standby", BENCH_SCENARIO_MS, benchStandby, nullptr, false},
+  {"auto_scan", BENCH_SCENARIO_MS, benchAutoScan, nullptr, false},
+  {"manual_pan", BENCH_SCENARIO_MS, benchManualPan, nullptr, false},
+  {"record", BENCH_SCENARIO_MS, benchRecord, nullptr, false},
+  {"replay", BENCH_SCENARIO_MS, benchReplay, nullptr, false},
+  {"coordinated_move", BENCH_SCENARIO_MS, benchStandby, benchMoveStep, false},
+  {"angle_burst", BENCH_SCENARIO_MS, benchStandby, benchAngleBurst, false, &angleBurst},
+  {"http_standby", BENCH_SCENARIO_MS, benchStandby, nullptr, true},
+  {"http_auto_scan", BENCH_SCENARIO_MS, benchAutoScan, nullptr, true},
+  {"http_manual_pan", BENCH_SCENARIO_MS, benchManualPan, nullptr, true},
+};
+
+void benchEmit(const char* line) {
+  Serial.println(line);
+}
+
+void benchTask(void* param) {
+  delay(2000);  // joystick center calibrated, boot output done
+  uint16_t port = server.port() + HTTP_PORT_OFFSET;
+  BenchTarget target = {
+    "webcam_platform", port,
+    "/api/status", "/api/angle", "{\"angle\":90}", 5,
+    &benchLoop, allocCounterEnabled() ? allocCount : nullptr, benchEmit,
+  };
+  benchLogCost(target.name, benchEmit);
+  runBenchmarks(target, BENCH_SCENARIOS, sizeof(BENCH_SCENARIOS) / sizeof(BENCH_SCENARIOS[0]));
+  
+  HttpBenchClient api;
+  if (api.connect(port, 2000)) benchStandby(api);
+  vTaskDelete(NULL);
+}
+#endif
+
+// All work runs in controlTask / networkTask
+void loop() {
+  vTaskDelete(NULL);
 }
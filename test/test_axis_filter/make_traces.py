@@ -0,0 +1,76 @@
+#!/usr/bin/env python3
+"""Regenerate noise_traces.h, the raw ADC fixtures of test_axis_filter.
+
+The traces are synthetic but shaped after what a KY-023 stick on an ESP32 ADC1 pin reads at
+11 dB attenuation: a center well off mid-scale, Gaussian noise of about 10 counts, a slow
+wander, 50 Hz pickup, and isolated spikes of several hundred counts in roughly 1 % of the
+readings. Each block is one 5 ms joystick step of 8 raw reads, as in webcam_platform.cpp.
+
+    python3 test/test_axis_filter/make_traces.py > test/test_axis_filter/noise_traces.h
+"""
+
+import math
+import random
+
+OVERSAMPLE = 8
+BLOCK_MS = 5
+CENTER = 1873
+
+
+def reading(rng, level, t_ms, hum, spikes):
+    value = level + rng.gauss(0, 10) + 6 * math.sin(2 * math.pi * t_ms / 1700)
+    value += hum * math.sin(2 * math.pi * 50 * t_ms / 1000 + 0.3)
+    if rng.random() < spikes:
+        value += rng.choice((-1, 1)) * rng.uniform(250, 700)
+    return max(0, min(4095, int(round(value))))
+
+
+def trace(seed, levels, hum=0.0, spikes=0.01):
+    """`levels`: (blocks, start level, end level) ramps of the stick position"""
+    rng = random.Random(seed)
+    samples = []
+    block = 0
+    for count, start, end in levels:
+        for i in range(count):
+            level = start + (end - start) * i / max(1, count - 1)
+            for k in range(OVERSAMPLE):
+                t_ms = block * BLOCK_MS + k * BLOCK_MS / OVERSAMPLE
+                samples.append(reading(rng, level, t_ms, hum, spikes))
+            block += 1
+    return samples
+
+
+TRACES = [
+    ("REST", "stick left alone",
+     trace(1, [(400, CENTER, CENTER)])),
+    ("REST_HUM", "left alone, 50 Hz pickup from a nearby servo supply",
+     trace(2, [(400, CENTER, CENTER)], hum=18)),
+    ("FLICK", "rest, pushed to the stop (ADC saturated) in 30 ms, held, released",
+     trace(3, [(100, CENTER, CENTER), (6, CENTER, 4095), (100, 4095, 4095), (100, CENTER, CENTER)])),
+    ("TOUCHED", "nudged while the boot calibration runs",
+     trace(4, [(50, CENTER, CENTER), (40, CENTER, 2300), (60, 2300, 2300)])),
+]
+
+
+def main():
+    print("// Raw ADC fixtures for test_axis_filter - generated by make_traces.py, do not edit")
+    print("// %d reads per 5 ms block; synthetic ESP32 ADC1 noise around a center of %d" % (OVERSAMPLE, CENTER))
+    print()
+    print("#pragma once")
+    print()
+    print("#include <stdint.h>")
+    print()
+    print("#define TRACE_OVERSAMPLE %d" % OVERSAMPLE)
+    print("#define TRACE_CENTER %d" % CENTER)
+    for name, what, samples in TRACES:
+        print()
+        print("// %s" % what)
+        print("const uint16_t TRACE_%s[] = {" % name)
+        for i in range(0, len(samples), 16):
+            print("    " + ", ".join(str(v) for v in samples[i:i + 16]) + ",")
+        print("};")
+        print("const uint16_t TRACE_%s_BLOCKS = %d;" % (name, len(samples) // OVERSAMPLE))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,657 @@
+// Raw ADC fixtures for test_axis_filter - generated by make_traces.py, do not edit
+// 8 reads per 5 ms block; synthetic ESP32 ADC1 noise around a center of 1873
+
+#pragma once
+
+#include <stdint.h>
+
+#define TRACE_OVERSAMPLE 8
+#define TRACE_CENTER 1873
+
+// stick left alone
+const uint16_t TRACE_REST[] = {
+    1886, 1888, 1862, 1873, 1875, 1874, 1873, 1872, 1876, 1897, 1885, 1875, 1875, 1883, 1862, 1878,
+    1875, 1884, 1880, 1862, 1893, 1872, 1870, 1858, 1881, 1860, 1888, 1860, 1881, 1875, 1879, 1885,
+    1866, 1881, 1864, 1872, 1889, 1878, 1869, 1877, 1875, 1861, 1849, 1871, 1872, 1403, 1864, 1870,
+    1868, 1871, 1868, 1881, 1865, 1867, 1880, 1886, 1879, 1856, 1872, 1870, 1874, 1866, 1872, 1877,
+    1878, 1881, 1869, 1884, 1868, 1877, 1867, 1874, 1876, 1874, 1882, 1887, 1879, 1901, 1876, 1888,
+    1868, 1887, 1894, 1870, 1865, 1896, 1874, 1876, 1885, 1851, 1892, 1854, 1868, 1881, 1868, 1877,
+    1871, 1886, 1876, 1873, 1892, 1873, 1866, 1857, 1886, 1864, 1876, 1890, 1880, 1871, 1880, 1866,
+    1884, 1864, 1883, 1884, 1893, 1884, 1867, 1886, 1868, 1872, 1885, 1867, 1872, 1892, 1873, 1871,
+    1882, 1877, 1879, 1879, 1892, 1888, 1882, 1870, 1887, 1883, 1883, 1874, 1874, 1878, 1880, 1874,
+    1887, 1873, 1874, 1887, 1882, 1879, 1867, 1863, 1872, 1883, 1882, 1870, 1863, 1869, 1875, 1879,
+    1888, 1882, 1855, 1876, 1876, 1871, 1880, 1847, 1885, 1883, 1880, 1872, 1867, 1895, 1884, 1861,
+    1870, 1878, 1875, 1879, 1864, 1872, 1868, 1881, 1869, 1867, 1872, 1880, 1880, 1867, 1876, 1877,
+    1869, 1867, 1876, 1887, 1865, 1882, 1873, 1890, 1855, 1874, 1882, 1870, 1865, 1887, 1889, 1859,
+    1879, 1883, 1876, 1873, 1869, 1886, 1903, 1883, 1873, 1898, 1879, 1857, 1855, 1884, 1879, 1866,
+    1891, 1892, 1868, 1870, 1388, 1893, 1902, 1881, 1879, 1881, 1877, 1857, 1880, 1871, 1881, 1881,
+    1884, 1856, 1885, 1877, 1874, 1873, 1862, 1882, 1888, 1887, 1868, 1890, 1885, 1871, 1866, 1864,
+    1883, 1898, 1891, 1870, 1862, 1881, 1871, 1865, 1857, 1858, 1903, 1889, 1876, 1878, 1878, 1867,
+    1892, 1884, 1880, 1867, 1869, 1878, 1876, 1881, 1886, 1881, 1879, 1880, 1873, 1888, 1891, 1883,
+    1864, 1879, 1874, 1843, 1876, 1867, 1876, 1890, 1871, 1872, 1884, 1869, 1877, 1885, 1886, 1867,
+    1891, 1896, 1881, 1856, 1873, 1880, 1883, 1880, 1880, 1876, 1877, 1862, 1874, 1856, 1875, 1891,
+    1878, 1888, 1878, 1885, 1870, 1879, 1878, 2275, 1867, 1886, 1889, 1866, 1883, 1878, 1873, 1881,
+    1879, 1876, 1885, 1879, 1891, 1880, 1886, 1865, 1891, 1875, 1890, 1872, 1866, 1873, 1872, 1881,
+    1869, 1864, 1877, 1870, 1895, 1868, 1893, 1887, 1880, 1877, 1884, 1885, 1890, 1879, 1880, 1879,
+    1875, 1882, 1883, 1871, 1869, 1874, 1890, 1874, 1849, 1887, 1874, 1866, 1876, 1883, 1885, 1883,
+    1883, 1864, 1872, 1885, 1872, 1877, 1876, 1881, 1897, 1866, 1898, 1868, 1865, 1876, 1873, 1862,
+    1871, 1870, 1872, 1877, 1858, 1869, 1877, 1875, 1877, 1883, 1874, 1877, 1874, 1873, 1865, 1892,
+    1888, 1869, 1865, 1885, 1883, 1863, 1878, 1885, 1866, 1877, 1882, 1865, 1872, 1880, 1883, 1878,
+    1878, 1851, 1866, 1874, 1888, 1875, 1874, 1889, 1884, 1877, 1877, 1865, 1898, 1870, 1895, 1869,
+    1881, 1869, 1872, 1888, 1877, 1879, 1887, 1868, 1878, 1890, 1862, 1885, 1852, 1880, 1896, 1897,
+    1878, 1890, 1875, 1860, 1891, 1878, 1903, 1870, 1865, 1886, 1876, 1890, 1882, 1864, 1874, 1871,
+    1893, 1891, 1884, 1875, 1902, 1858, 1888, 1871, 2539, 1888, 1877, 1891, 1882, 1872, 1874, 1881,
+    1858, 1864, 1885, 1887, 1878, 1885, 1871, 1890, 1874, 1867, 1873, 1865, 1874, 1889, 1883, 1884,
+    1875, 1866, 1883, 1891, 1881, 1879, 1885, 1882, 1871, 1890, 1876, 1883, 1877, 1876, 1886, 1884,
+    1884, 1880, 1874, 1873, 1870, 1878, 1883, 1865, 1886, 1871, 1866, 1876, 1890, 1870, 1873, 1878,
+    1871, 1877, 1869, 1880, 1872, 1868, 1876, 1864, 1876, 1873, 1884, 1874, 1868, 1897, 1871, 1886,
+    1877, 1893, 1903, 1880, 1869, 1888, 1881, 1866, 1867, 1886, 1270, 1882, 1862, 1876, 1855, 1868,
+    1871, 1857, 1898, 1873, 1876, 1869, 1864, 1864, 1871, 1884, 1881, 1872, 1876, 1883, 1864, 1864,
+    1869, 1873, 1889, 1876, 1888, 1877, 1878, 1869, 1889, 1875, 1871, 1879, 1864, 1888, 1870, 1881,
+    1884, 1876, 1879, 1890, 1881, 1872, 1872, 1877, 1885, 1892, 1873, 1877, 1880, 1886, 1883, 1890,
+    1888, 1884, 1883, 1880, 1891, 1882, 1886, 1870, 1888, 1889, 1859, 1855, 1874, 1864, 1875, 1902,
+    1886, 1893, 1886, 1876, 1877, 1878, 1880, 1883, 1864, 1875, 1864, 1883, 1887, 1891, 1874, 1882,
+    1857, 1872, 1884, 1894, 1883, 1887, 1876, 1891, 1897, 1881, 1871, 1887, 1880, 1873, 1881, 1875,
+    1879, 1867, 1886, 1878, 1861, 1877, 1875, 1861, 1872, 1868, 1886, 1892, 1872, 1883, 1864, 1880,
+    1896, 1881, 1877, 1861, 1894, 1887, 1881, 1885, 1872, 1885, 1865, 1870, 1882, 1880, 1893, 1860,
+    1897, 1887, 1869, 1886, 1878, 1888, 1898, 1872, 1879, 1861, 1883, 1879, 1873, 1887, 1877, 1878,
+    1868, 1899, 1876, 1882, 1870, 1877, 1898, 1869, 1867, 1873, 1871, 1883, 1868, 1891, 1883, 1863,
+    1880, 1875, 1889, 1876, 1874, 1873, 1890, 1882, 1883, 1891, 1875, 1890, 1880, 1876, 1885, 1890,
+    1871, 1870, 1880, 1892, 1877, 1868, 1857, 1885, 1892, 1872, 1890, 1897, 1888, 1871, 1882, 1889,
+    1868, 1900, 1884, 1892, 1872, 1873, 1872, 1868, 1885, 1867, 1883, 1890, 1867, 1870, 1866, 1869,
+    1874, 1875, 1873, 1895, 1879, 1881, 1870, 1881, 1870, 1880, 1881, 1876, 1885, 1875, 1872, 1885,
+    1880, 1876, 1870, 1862, 1876, 1889, 1869, 1867, 1879, 1864, 1903, 1867, 1888, 1875, 1879, 1886,
+    1867, 1868, 1869, 1891, 1881, 1884, 1869, 1894, 1890, 1888, 1861, 1887, 1884, 1883, 1901, 1875,
+    1891, 1883, 1878, 1882, 1874, 1869, 1881, 1880, 1869, 1870, 1868, 1873, 1876, 1881, 1887, 1881,
+    1874, 1878, 1872, 1896, 1878, 1875, 1878, 1853, 1881, 1885, 1894, 1884, 1877, 1855, 1890, 1867,
+    1874, 1887, 1885, 1871, 1896, 1871, 1885, 1891, 1871, 1882, 1869, 1895, 1868, 1901, 1876, 1886,
+    1877, 1872, 1888, 1894, 1875, 1886, 1884, 1886, 1883, 1886, 1881, 1879, 1877, 1869, 1885, 1869,
+    1875, 1873, 1890, 1868, 1883, 1871, 1879, 1871, 1887, 1904, 1878, 1884, 1857, 1877, 1883, 1859,
+    1886, 1896, 1877, 1885, 1890, 1880, 1885, 1882, 1864, 1883, 1871, 1860, 1882, 1899, 1885, 1869,
+    1863, 1877, 1875, 1886, 1868, 1895, 1873, 1871, 1879, 1886, 1888, 1875, 1877, 1883, 1875, 1895,
+    1876, 1885, 1886, 1883, 1888, 1904, 1877, 1875, 1889, 1883, 1872, 1889, 1870, 1884, 1865, 1882,
+    1871, 1885, 1859, 1872, 1880, 1883, 1872, 1885, 1865, 1879, 1872, 1880, 1869, 1880, 1890, 1891,
+    1879, 1893, 1873, 1889, 1881, 1872, 1881, 1869, 1871, 1877, 1868, 1876, 1887, 1885, 1866, 1879,
+    1890, 1873, 1868, 1891, 1879, 1876, 1890, 1875, 1869, 1892, 1876, 1888, 1861, 1889, 1885, 1868,
+    1882, 1882, 1888, 1868, 1868, 1882, 1887, 1873, 1872, 1892, 1882, 1871, 1880, 1881, 1889, 1877,
+    1870, 1888, 1870, 1891, 1883, 1888, 1885, 1880, 1875, 1878, 1892, 1863, 1899, 1876, 2386, 1888,
+    1881, 1871, 1865, 1887, 1879, 1873, 1861, 1874, 1884, 1885, 1869, 1851, 1891, 1899, 1887, 1886,
+    1868, 1892, 1883, 1884, 1865, 1877, 1864, 1874, 1891, 1893, 1865, 1879, 2152, 1898, 1883, 1893,
+    1884, 1883, 1889, 1876, 1883, 1884, 1869, 1882, 1883, 1880, 1863, 1880, 2518, 1860, 1881, 1882,
+    1869, 1881, 1892, 1893, 1891, 1890, 1894, 1871, 1891, 1879, 1890, 1875, 1871, 1876, 1866, 1885,
+    1886, 1876, 1881, 1881, 1884, 1882, 2531, 1864, 1871, 1889, 1874, 1878, 1868, 1869, 1865, 1900,
+    1875, 1882, 1871, 1873, 1877, 1861, 1867, 1870, 1881, 1878, 1880, 1869, 1868, 1874, 1896, 1876,
+    1887, 1869, 1859, 1872, 1874, 1876, 1871, 1864, 1865, 1867, 1863, 1880, 1873, 1870, 1888, 1879,
+    1879, 1881, 1867, 1888, 1884, 1886, 1874, 1899, 1873, 1887, 1882, 1891, 1880, 1866, 1862, 1893,
+    1879, 1899, 1872, 1882, 1888, 1874, 2258, 1865, 1868, 1902, 1866, 1864, 1873, 1875, 1882, 1880,
+    1872, 1882, 1860, 1876, 1868, 1868, 1885, 1877, 1884, 1879, 1866, 1869, 1876, 1866, 1868, 1873,
+    1860, 1869, 1875, 1880, 1872, 1866, 1877, 1862, 1877, 1863, 1869, 1871, 1874, 1878, 1881, 1863,
+    1866, 1877, 1882, 1869, 1876, 1882, 1883, 1873, 1862, 1867, 1878, 1901, 1870, 1878, 1880, 1856,
+    1873, 1869, 1891, 1889, 1868, 1902, 1892, 1882, 1880, 1865, 1870, 1877, 1866, 1874, 1874, 1878,
+    1881, 1866, 1872, 1870, 1888, 1877, 1895, 1856, 1857, 1868, 1881, 1871, 1869, 1886, 1864, 1882,
+    1867, 1881, 1889, 1883, 1865, 1866, 1880, 1881, 1880, 1864, 1875, 1872, 1861, 1870, 1868, 1880,
+    1873, 1886, 1875, 1881, 1867, 1879, 1889, 1869, 1881, 1871, 1890, 1886, 1882, 1882, 1856, 1882,
+    1873, 1884, 1877, 1895, 1883, 1863, 1882, 1866, 1885, 1883, 1871, 1877, 1880, 1864, 1864, 1869,
+    1874, 1890, 1879, 1879, 1867, 1873, 1864, 1876, 1884, 1862, 1883, 1880, 1881, 1876, 1858, 1876,
+    1863, 1890, 1876, 1872, 1877, 1879, 1869, 1883, 1884, 1876, 1848, 1870, 1879, 1865, 1861, 1878,
+    1872, 1863, 1856, 1869, 1872, 1883, 1883, 1869, 1874, 1886, 1865, 1872, 1871, 1863, 1863, 1867,
+    1874, 1878, 1857, 1876, 1871, 1885, 1866, 1881, 1862, 1883, 1871, 1860, 1887, 1864, 1878, 1866,
+    1861, 1860, 1880, 1888, 1862, 1870, 1859, 1870, 1881, 1887, 1862, 1887, 1873, 1880, 1871, 1886,
+    1865, 1884, 1882, 1859, 1878, 1875, 1870, 1861, 1867, 1861, 1869, 1873, 1861, 1864, 1864, 1884,
+    1866, 1866, 1886, 1864, 1871, 1859, 1871, 1868, 1853, 1864, 1863, 1869, 1872, 1867, 1869, 1862,
+    1864, 1874, 1872, 1869, 1854, 1860, 1852, 1861, 1887, 1887, 1866, 1867, 1866, 1866, 1868, 1875,
+    1883, 1852, 1876, 1878, 1890, 1886, 1878, 1877, 1889, 1877, 1867, 1867, 1896, 1869, 1880, 1856,
+    1868, 1871, 1889, 1867, 1886, 1872, 1860, 1864, 1858, 1884, 1869, 1867, 1892, 1875, 1874, 1866,
+    1875, 1863, 1873, 1871, 1865, 1863, 1864, 1874, 1860, 1896, 2463, 1877, 1872, 1867, 1873, 1882,
+    1878, 1858, 1869, 1890, 1866, 1869, 1882, 1863, 1888, 1864, 1874, 1869, 1859, 1884, 1879, 1867,
+    1864, 1882, 1871, 1863, 1877, 1853, 1866, 1878, 1877, 1869, 1852, 1867, 1876, 1873, 1848, 1875,
+    1876, 1849, 1873, 1879, 1865, 1888, 1869, 1876, 1869, 1879, 1863, 1871, 1868, 1876, 1888, 1864,
+    1873, 1869, 1866, 1882, 1881, 1879, 1878, 1871, 1868, 1859, 1865, 1873, 1875, 1857, 1869, 1876,
+    1885, 1866, 1850, 1879, 1861, 1864, 1885, 1880, 1872, 1863, 1866, 1871, 1874, 1887, 1882, 1877,
+    1867, 1878, 1870, 1877, 2285, 1871, 1865, 1866, 1862, 1866, 1883, 1863, 1872, 1852, 1869, 1853,
+    1872, 1884, 1866, 1863, 1859, 1880, 1866, 1855, 1868, 1884, 1867, 1866, 1873, 1884, 1869, 1877,
+    1875, 1871, 1879, 1867, 1877, 1891, 1857, 1858, 1873, 1871, 1867, 1877, 1865, 1859, 1854, 1877,
+    1871, 1853, 1890, 1884, 1863, 1878, 1862, 1877, 1877, 1861, 1858, 1859, 1870, 1864, 1872, 1869,
+    1875, 1875, 1856, 1883, 1866, 1865, 1855, 1878, 1875, 1867, 1858, 1866, 1870, 1873, 1857, 1859,
+    1885, 1876, 1879, 1869, 1852, 1873, 1870, 1874, 1859, 1873, 1878, 1866, 1869, 1866, 1878, 1883,
+    1857, 1872, 1874, 1874, 1858, 1853, 1864, 1884, 1885, 1874, 1880, 1869, 1871, 1872, 1875, 1859,
+    1870, 1867, 1863, 1874, 1887, 1874, 1858, 1894, 1866, 1858, 1866, 1872, 1860, 1877, 1871, 1880,
+    1854, 1866, 1850, 1871, 1852, 1868, 1881, 1866, 1862, 1885, 1883, 1876, 1889, 1860, 1868, 1858,
+    1851, 1873, 1866, 1882, 1879, 1869, 1866, 1861, 1868, 1847, 1884, 1865, 1867, 1861, 1868, 1872,
+    1872, 1865, 1875, 1850, 1863, 1853, 1867, 1868, 1852, 1871, 1889, 1866, 1875, 1865, 1878, 1868,
+    1866, 1873, 1881, 1880, 1855, 2559, 1859, 1872, 1869, 1851, 1871, 1876, 2123, 1869, 1869, 1884,
+    1875, 1866, 1871, 1875, 1864, 1876, 1862, 1866, 1872, 1853, 1873, 1864, 1859, 1847, 1865, 1870,
+    1861, 1874, 1865, 1866, 1867, 1859, 1869, 1876, 1874, 1883, 1865, 1866, 1848, 1855, 1861, 1865,
+    1842, 1869, 1879, 1861, 1857, 1867, 1875, 1858, 1871, 1876, 1860, 1858, 1870, 1880, 1871, 1864,
+    1869, 1877, 1875, 1861, 1882, 1873, 1865, 1876, 1864, 1877, 1882, 1864, 1871, 1881, 1892, 1859,
+    1875, 1859, 1870, 1879, 1883, 1865, 1861, 1889, 1877, 1863, 1872, 1890, 1844, 1869, 1865, 1853,
+    1860, 1874, 1883, 1865, 1870, 1871, 1862, 1864, 1845, 1872, 1865, 1857, 1859, 1871, 1871, 1878,
+    1881, 1866, 1889, 1877, 1877, 1860, 1846, 1866, 1863, 1849, 1861, 1871, 1860, 1862, 1861, 1863,
+    1867, 1859, 1854, 1863, 1869, 1855, 1881, 1873, 1864, 1878, 1873, 1892, 1876, 1867, 1893, 1873,
+    1869, 1862, 1882, 1869, 1876, 1851, 1874, 1860, 1877, 1868, 1851, 1858, 1868, 1869, 1864, 1864,
+    1868, 1864, 1883, 1858, 1876, 1872, 1856, 1850, 1873, 1861, 1864, 1880, 1871, 1857, 1856, 1865,
+    1867, 1867, 1879, 1883, 1862, 1869, 1857, 1876, 1858, 1855, 1878, 1878, 1865, 1884, 1856, 1876,
+    1868, 1873, 1877, 1860, 1857, 1855, 1855, 1327, 1876, 1848, 1872, 1886, 1873, 1863, 1871, 1870,
+    1903, 1848, 1849, 1879, 1882, 1851, 1882, 1869, 1865, 1872, 1867, 1865, 1867, 1874, 1874, 1858,
+    1867, 1869, 1864, 1860, 1885, 1867, 1876, 1883, 1871, 1860, 1860, 1889, 1850, 1865, 1867, 1865,
+    1854, 1851, 1872, 1877, 1872, 1883, 1848, 1876, 1868, 1874, 1865, 1861, 1857, 1871, 1861, 1858,
+    1865, 1862, 1880, 1878, 1868, 1868, 1882, 1861, 1876, 1866, 1867, 1869, 1866, 1873, 1883, 1869,
+    1858, 1874, 1872, 1872, 1872, 1876, 1854, 1884, 1848, 1872, 1855, 1880, 1888, 1858, 1865, 1882,
+    1875, 1870, 1856, 1861, 1874, 1869, 1859, 1860, 1872, 1873, 1875, 1859, 1861, 1867, 1867, 1847,
+    1855, 1877, 1877, 1875, 1876, 1857, 1862, 1867, 1874, 1872, 1884, 1888, 1876, 1871, 1854, 1870,
+    1855, 1863, 1874, 1866, 1861, 1868, 1878, 1880, 1864, 1859, 1876, 1863, 1881, 1865, 1865, 1860,
+    1878, 1864, 1855, 1868, 1859, 1844, 1865, 1870, 1855, 1880, 1867, 1868, 1873, 1857, 1857, 1872,
+    1867, 1862, 1876, 1878, 1844, 1863, 1871, 1876, 1864, 1877, 1859, 1884, 1861, 1876, 1864, 1882,
+    1880, 1866, 1892, 1870, 1855, 1870, 1884, 1880, 1890, 1864, 1864, 1873, 1859, 1879, 1864, 1865,
+    1862, 1857, 1874, 1866, 1861, 1856, 1871, 1872, 1858, 1868, 1865, 1879, 1869, 1862, 1883, 1858,
+    1174, 1859, 1864, 1863, 1859, 1872, 1874, 1858, 1854, 1872, 1848, 1870, 1885, 1889, 2277, 1880,
+    1839, 1878, 1878, 1878, 1879, 1865, 1877, 1877, 1851, 1862, 1881, 1849, 1857, 1863, 1840, 1862,
+    1871, 1860, 1859, 1866, 1876, 1851, 1876, 1860, 1867, 1872, 1888, 1858, 1853, 1884, 1849, 1863,
+    1868, 1863, 1866, 1863, 1873, 1867, 1864, 1858, 1855, 1872, 1868, 1876, 1865, 1875, 1877, 1858,
+    1876, 1887, 1874, 1851, 1871, 1855, 1873, 1873, 1857, 1883, 1875, 1899, 1878, 1870, 1857, 1855,
+    1887, 1861, 1871, 1867, 1866, 1873, 1865, 1865, 1869, 1876, 1871, 1861, 1889, 1862, 1869, 1870,
+    1864, 1883, 1865, 1871, 1876, 1873, 1861, 1874, 1868, 1875, 1879, 1874, 1852, 1862, 1886, 1856,
+    1884, 1862, 1858, 1877, 1852, 1867, 1883, 1882, 1885, 1855, 1862, 1861, 1882, 1872, 1863, 1863,
+    1865, 1867, 1861, 1867, 1862, 1862, 1861, 1883, 1870, 1856, 1873, 1869, 1863, 1871, 1865, 1861,
+    1857, 1879, 1885, 1869, 1868, 1866, 1876, 1879, 1846, 1871, 1862, 1865, 1860, 1851, 1856, 1848,
+    1873, 1873, 1867, 1861, 1870, 1873, 1879, 1872, 1859, 1879, 1877, 1864, 1878, 1878, 1871, 1858,
+    1863, 1869, 1892, 1870, 1878, 1856, 1868, 1863, 1866, 1862, 1873, 1878, 1866, 1862, 1873, 1857,
+    1868, 1872, 1862, 1885, 1874, 1863, 1860, 1868, 1887, 1866, 1870, 1873, 1850, 1860, 1869, 1879,
+    1879, 1880, 1872, 1873, 1876, 1869, 1880, 1876, 1864, 1874, 1886, 1846, 1864, 1877, 1870, 1860,
+    1859, 1870, 1869, 1868, 1881, 1879, 1879, 1870, 1869, 1879, 1876, 1859, 1865, 1865, 1871, 1857,
+    1875, 1877, 1845, 1875, 1855, 1879, 1881, 1871, 1881, 1866, 1872, 1849, 1871, 1875, 1867, 1876,
+    1875, 1862, 1860, 1861, 1872, 1876, 1864, 1873, 1865, 1863, 1869, 1869, 1866, 1881, 1857, 1861,
+    1872, 1864, 1852, 1875, 1857, 1874, 1858, 1853, 1870, 1886, 1880, 1858, 1881, 1852, 1855, 1873,
+    1870, 1875, 1860, 1875, 1870, 1866, 1852, 1877, 1858, 1869, 1853, 1886, 1878, 1867, 1863, 1859,
+    1871, 1877, 1857, 1854, 1879, 1865, 1883, 1889, 1869, 1848, 1878, 1864, 1869, 1881, 1864, 1866,
+    1864, 1864, 1881, 1857, 1867, 1875, 1873, 1883, 1863, 1871, 1878, 1865, 1880, 1852, 1872, 2537,
+    1880, 1866, 1874, 1865, 1869, 1876, 1848, 1866, 1864, 1884, 1865, 1891, 1866, 1881, 1877, 1862,
+    1883, 1874, 1868, 1872, 1882, 1888, 1861, 1872, 1876, 1867, 1871, 1867, 1859, 1868, 1882, 1868,
+    1864, 1873, 1881, 1860, 1871, 1882, 1888, 1880, 1872, 1873, 1859, 1861, 1881, 1866, 1861, 1875,
+    1871, 1875, 1884, 1861, 1867, 1866, 1846, 1855, 1855, 1874, 1894, 1871, 1870, 1876, 1864, 1877,
+    1889, 1877, 1857, 1872, 1887, 1869, 1884, 1871, 1871, 1868, 1866, 1868, 1865, 1888, 1878, 1867,
+    1869, 1873, 1880, 1869, 1871, 1867, 1872, 1863, 1884, 1857, 1877, 1867, 1868, 1883, 1881, 1884,
+    1861, 1859, 1858, 1849, 1875, 1872, 2143, 1889, 1864, 1877, 1878, 1878, 1870, 1871, 1888, 1881,
+    1864, 1871, 1875, 1872, 1874, 1876, 2275, 1880, 1886, 1879, 1877, 1873, 1876, 1873, 1873, 1877,
+    1866, 1884, 1870, 1858, 1865, 1861, 1862, 1864, 1868, 1856, 1859, 1874, 1878, 1877, 1873, 1878,
+    1883, 1863, 1864, 1863, 1887, 1893, 1858, 1877, 1861, 1859, 1878, 1884, 1888, 1882, 1867, 1886,
+    1870, 1877, 1880, 1297, 1865, 1881, 1870, 1868, 1868, 1865, 2217, 1887, 1883, 1868, 1882, 1866,
+    1866, 1871, 1866, 1893, 1859, 1869, 1873, 1861, 1865, 1868, 1886, 1846, 1870, 1861, 1870, 1857,
+    1863, 1867, 1886, 1879, 1873, 1863, 1890, 1892, 1884, 1879, 1862, 1881, 1873, 1867, 1887, 1874,
+    1862, 1888, 1864, 1848, 1874, 1879, 1871, 1865, 1874, 1859, 1861, 1867, 1861, 1877, 1866, 1887,
+    1882, 1879, 1880, 1872, 1886, 1875, 1862, 1878, 1872, 1889, 1878, 1875, 1871, 1892, 1861, 1882,
+    1864, 1862, 1869, 1864, 1869, 1872, 1876, 1851, 1865, 1879, 1875, 1862, 1876, 1879, 1896, 1863,
+    1891, 1896, 1871, 1872, 1850, 1875, 1873, 1863, 1880, 1857, 1880, 1867, 1891, 1867, 1868, 1886,
+    1864, 1882, 1852, 1867, 1875, 1873, 1865, 1870, 1883, 1863, 1879, 1885, 1883, 1867, 1888, 1860,
+    1891, 1882, 1868, 1869, 1875, 1871, 1867, 1868, 1890, 1872, 1879, 1860, 1872, 1879, 1871, 1855,
+    1875, 1901, 1864, 1887, 1866, 1861, 1885, 1868, 1875, 1874, 1866, 1883, 1865, 1867, 1880, 1887,
+    1895, 1885, 1870, 1893, 1873, 1873, 1883, 1869, 1880, 1882, 1879, 1861, 1873, 1868, 1877, 1871,
+    1879, 1880, 1867, 1884, 1879, 1875, 1879, 1863, 1883, 1890, 1867, 1873, 1877, 1862, 1866, 1872,
+    1864, 1881, 1877, 1862, 1876, 1879, 1885, 1870, 1860, 1880, 1866, 1863, 1893, 1876, 1879, 1864,
+    1876, 1862, 1872, 1877, 1873, 1864, 1881, 1874, 1868, 1897, 1873, 1869, 1867, 1856, 1871, 1865,
+    1876, 1881, 1870, 1876, 1875, 1869, 1884, 1872, 1880, 1863, 1869, 1870, 1877, 1868, 1883, 1875,
+    1874, 1874, 1863, 1869, 1872, 1870, 1872, 1862, 1884, 1899, 1856, 2287, 1873, 1878, 1874, 1886,
+    1859, 1879, 1875, 1884, 1877, 1869, 1884, 1865, 1890, 1886, 1861, 1872, 1885, 1867, 1875, 1865,
+    1902, 1874, 1876, 1892, 1872, 1870, 1867, 1868, 1874, 1876, 1895, 1883, 1866, 1860, 1884, 1865,
+    1866, 1878, 1870, 1867, 1876, 1879, 1866, 1884, 1857, 1874, 1876, 1862, 1867, 1872, 1881, 1876,
+    1870, 1880, 1880, 1877, 1874, 1878, 1863, 1882, 1879, 1864, 1876, 1876, 1875, 1877, 1874, 1852,
+    1869, 1869, 1882, 1871, 1866, 1872, 1873, 1875, 1862, 1869, 1884, 1879, 1887, 1886, 1886, 1873,
+    1873, 1865, 1859, 1862, 1869, 1878, 1893, 1894, 1902, 1875, 1871, 1875, 1882, 1880, 1878, 1858,
+    1880, 1870, 1877, 1875, 1881, 1884, 1890, 1879, 1877, 1875, 1864, 1883, 1879, 1891, 1888, 1869,
+    1891, 1879, 1885, 1882, 1879, 1876, 1884, 1875, 1875, 1893, 1884, 1889, 1879, 1863, 1885, 1896,
+    1868, 1879, 1881, 1862, 1885, 1875, 1877, 1888, 1873, 1862, 1875, 1871, 1891, 1515, 1896, 1895,
+    1874, 1852, 1868, 1890, 1884, 1876, 1894, 1881, 1867, 1887, 1874, 1890, 1873, 1883, 1872, 1883,
+    1875, 1880, 1891, 1865, 1871, 1896, 1883, 1888, 1869, 1864, 1889, 1877, 1872, 1869, 1867, 1880,
+    1873, 1873, 1863, 1882, 1878, 1873, 1883, 1871, 1884, 1877, 1867, 1885, 1870, 1869, 1877, 1871,
+    1891, 1892, 1889, 1862, 1873, 1867, 1872, 1879, 1923, 1896, 1875, 1866, 1882, 1879, 1881, 1875,
+    1869, 1894, 1882, 1866, 1874, 1876, 1884, 1893, 1867, 1871, 1872, 1878, 1884, 1870, 1896, 1865,
+    1894, 1886, 1895, 1882, 1870, 1873, 1870, 1871, 1861, 1885, 1890, 1869, 1886, 1882, 1881, 1883,
+    1881, 1872, 1882, 1884, 1894, 1875, 1887, 1884, 1895, 1870, 1878, 1883, 1884, 1891, 1873, 1869,
+    1888, 1884, 1876, 1872, 1881, 1885, 1870, 1871, 1874, 1858, 1867, 1865, 1875, 1872, 1873, 1876,
+    1879, 1874, 1881, 1878, 1883, 1878, 1886, 1858, 1867, 1883, 1892, 1874, 1875, 1852, 1879, 1881,
+    1874, 1869, 1886, 1887, 1861, 1876, 1890, 1872, 1862, 1868, 1879, 1870, 1881, 1874, 1881, 1871,
+};
+const uint16_t TRACE_REST_BLOCKS = 400;
+
+// left alone, 50 Hz pickup from a nearby servo supply
+const uint16_t TRACE_REST_HUM[] = {
+    1902, 1875, 1893, 1873, 1878, 1882, 1882, 1895, 1902, 1885, 1889, 1885, 1866, 1893, 1875, 1874,
+    1832, 1862, 1876, 1848, 1859, 1838, 1861, 1854, 1844, 1860, 1841, 1862, 1874, 1862, 1870, 1864,
+    1877, 1876, 1892, 1883, 1877, 1890, 1889, 1898, 1888, 1887, 1893, 1881, 1877, 1872, 1885, 1879,
+    1873, 1885, 1871, 1862, 1879, 1869, 1863, 1857, 1863, 1872, 1866, 1862, 1853, 1858, 1883, 1878,
+    1893, 1873, 1878, 1889, 1899, 1898, 1883, 1887, 1899, 1888, 1901, 1887, 1888, 1880, 1847, 1871,
+    1870, 1876, 1850, 1848, 1424, 1863, 1852, 1856, 1857, 1854, 1849, 1866, 1866, 1862, 1886, 1878,
+    1860, 1872, 1911, 1891, 1882, 1870, 1888, 1895, 1900, 1874, 1868, 1473, 1887, 1878, 1867, 1868,
+    1865, 1869, 1871, 1849, 1873, 1860, 1847, 1857, 1856, 1871, 1869, 1841, 1868, 1881, 1863, 1856,
+    1888, 1889, 1883, 1891, 1905, 1891, 1894, 1908, 1887, 1890, 1889, 1882, 1882, 1901, 1850, 1892,
+    1876, 1875, 1868, 1857, 1846, 1867, 1832, 1862, 1849, 1845, 1854, 1857, 1866, 1869, 1884, 1867,
+    1896, 1878, 1890, 1886, 1896, 1908, 1895, 1888, 1892, 1904, 2383, 1886, 1896, 1886, 1857, 1879,
+    1863, 1861, 1872, 1861, 1859, 1855, 1855, 1852, 1861, 1860, 1866, 1879, 1861, 1856, 1870, 1886,
+    1873, 1875, 1890, 1903, 1887, 1893, 1882, 1889, 1885, 1876, 1884, 1894, 1892, 1873, 1884, 1873,
+    1879, 1860, 1866, 1867, 1851, 1856, 1855, 1874, 1858, 1851, 1858, 1851, 1854, 1868, 1867, 1879,
+    1901, 1896, 1892, 1889, 1904, 2239, 1899, 1885, 1898, 1899, 1894, 1893, 1884, 1890, 1871, 1868,
+    1876, 1870, 1866, 1857, 1851, 1874, 1868, 1858, 1851, 1878, 1834, 1858, 1858, 1874, 1900, 1899,
+    1872, 1865, 1888, 1889, 1895, 1899, 1909, 1892, 1894, 1904, 1887, 1888, 1890, 1871, 1886, 1884,
+    1877, 1872, 1855, 1872, 1858, 1848, 1873, 1870, 1853, 1867, 1848, 1876, 1860, 1873, 1877, 1894,
+    1894, 1888, 1876, 1884, 1889, 1883, 1903, 1878, 1896, 1897, 1900, 1911, 1877, 1884, 1876, 1867,
+    1863, 1874, 1863, 1859, 1867, 1856, 1849, 1867, 1862, 1846, 1854, 1868, 1873, 1882, 1868, 1875,
+    1887, 1880, 1900, 1881, 1897, 1887, 1898, 1903, 1893, 1884, 1892, 1887, 1894, 1893, 1860, 1864,
+    1879, 1848, 1888, 1858, 1871, 1850, 1860, 1866, 1869, 1872, 1873, 1864, 1870, 1879, 1896, 1892,
+    1880, 1876, 1877, 1891, 1889, 1879, 1890, 1896, 1881, 1890, 1902, 1896, 1881, 1885, 1855, 1880,
+    1884, 1863, 1850, 1882, 1871, 1853, 1211, 1876, 1847, 1858, 1865, 1860, 1888, 1869, 1878, 1878,
+    1891, 1880, 1886, 1890, 1904, 1895, 1894, 1893, 1877, 1906, 1882, 1892, 1875, 1882, 1884, 1862,
+    1879, 1876, 1880, 1862, 1851, 1865, 1863, 1876, 1859, 1860, 1876, 1864, 1870, 1889, 1862, 1883,
+    1859, 1893, 1868, 1891, 1899, 1894, 1871, 1903, 1882, 1882, 1895, 1881, 1880, 1875, 1883, 1867,
+    1861, 1878, 1859, 1851, 1857, 1862, 1847, 1850, 1859, 1866, 1874, 1862, 1881, 1875, 1871, 1890,
+    1894, 1877, 1885, 1888, 1879, 1889, 1883, 1896, 1902, 1893, 1891, 1883, 1895, 1873, 1871, 1883,
+    1878, 1884, 1854, 1853, 1862, 1861, 1862, 1866, 1882, 1864, 1859, 1868, 1877, 1854, 1882, 1882,
+    1888, 1876, 1911, 1896, 1904, 1905, 1905, 1899, 1897, 1908, 1880, 1874, 1892, 1884, 1858, 1876,
+    1866, 1864, 1871, 1876, 1852, 1849, 1871, 1873, 1853, 1864, 1869, 1866, 1859, 1889, 1858, 1872,
+    1896, 1882, 1888, 1896, 1882, 1904, 1909, 1890, 1910, 1890, 1885, 1897, 1886, 1896, 1888, 1863,
+    1862, 1859, 1860, 1865, 1868, 1866, 1845, 1854, 1858, 1869, 1882, 1860, 1877, 2129, 1879, 1882,
+    1896, 1873, 1901, 1878, 1903, 1893, 1903, 1889, 1890, 1886, 1879, 1897, 1887, 1894, 1896, 1865,
+    1869, 1896, 1868, 1872, 1866, 1871, 1857, 1871, 1857, 1868, 1863, 1868, 1871, 1880, 1882, 1876,
+    1894, 1880, 1875, 1873, 1906, 1900, 1894, 1875, 1890, 1897, 1892, 1902, 1902, 1885, 1870, 1878,
+    1890, 1867, 1879, 1870, 1866, 1876, 1847, 1867, 1853, 1880, 1840, 1863, 1875, 1881, 1886, 1882,
+    1896, 1231, 1903, 1884, 1894, 1903, 1889, 1884, 1921, 1895, 1890, 1905, 1899, 1897, 1874, 1877,
+    1890, 1880, 1863, 1882, 1871, 1864, 1854, 1850, 1838, 1839, 1875, 1875, 1867, 1870, 1872, 1882,
+    1878, 1879, 1889, 1898, 1895, 1897, 1903, 1902, 1897, 1888, 1897, 1893, 1870, 1867, 1891, 1897,
+    1888, 1878, 1866, 1882, 1858, 1877, 1862, 1861, 1873, 1862, 1879, 1845, 1890, 1883, 1881, 1876,
+    1895, 1871, 1876, 1879, 1898, 1916, 1892, 1890, 1882, 1902, 1906, 1877, 1890, 1882, 1877, 1880,
+    1896, 1851, 1870, 1860, 1863, 1854, 1846, 1868, 1860, 1860, 1872, 1864, 1861, 1874, 1859, 1875,
+    1891, 1888, 1897, 1890, 1870, 1898, 1887, 1904, 1898, 1891, 1896, 1896, 1882, 1883, 1883, 1864,
+    1852, 1887, 1874, 1868, 1862, 1859, 1856, 1857, 1848, 1864, 1857, 1872, 1869, 1892, 1872, 1871,
+    1904, 1888, 1899, 1888, 1901, 1890, 1897, 1899, 1901, 1919, 1879, 1908, 1884, 1877, 1880, 1889,
+    1872, 1883, 1857, 1861, 1875, 1861, 1863, 1846, 1843, 1869, 1866, 1866, 1856, 1858, 1896, 1882,
+    1894, 1863, 1884, 1897, 1894, 1906, 1898, 1896, 1899, 1882, 1903, 1882, 1883, 1887, 1906, 1874,
+    1870, 1872, 1849, 1861, 1872, 1841, 1870, 1853, 1880, 1841, 1865, 1876, 1868, 1871, 1886, 1879,
+    1892, 1910, 1881, 1891, 1896, 1904, 1885, 1884, 1894, 1895, 1901, 1909, 1886, 1889, 1874, 1863,
+    1868, 1856, 1880, 1862, 1868, 1847, 1855, 1856, 1846, 1859, 1869, 1863, 1865, 1882, 1883, 1874,
+    1879, 1875, 1908, 1895, 1889, 1886, 1904, 1899, 1899, 1904, 1898, 1877, 1878, 1880, 1877, 1868,
+    1874, 1858, 1879, 1867, 1866, 1855, 2566, 1867, 1849, 1885, 1850, 1864, 1860, 1880, 1877, 1876,
+    1887, 1873, 1875, 1904, 1880, 1886, 1899, 1886, 1890, 1893, 1893, 1893, 1889, 1878, 1890, 1878,
+    1871, 1875, 1865, 1860, 1878, 1865, 1859, 1863, 1833, 1853, 1853, 1872, 1867, 1873, 1870, 1889,
+    1891, 1894, 1891, 1910, 1889, 1894, 1892, 1906, 1889, 1888, 1891, 1893, 1882, 1886, 1886, 1898,
+    1865, 1882, 1869, 1867, 1883, 1862, 1869, 1862, 1855, 1864, 1865, 1859, 1871, 1867, 1896, 1891,
+    1884, 1890, 1883, 1879, 1888, 1895, 1890, 1894, 1894, 1892, 1895, 1886, 1865, 1897, 1877, 1884,
+    1862, 1854, 1854, 1844, 1843, 1858, 1860, 1857, 1850, 1866, 1848, 1862, 1869, 1858, 1878, 1871,
+    1861, 1882, 1873, 1893, 1894, 1908, 1886, 1894, 1901, 1887, 1891, 1892, 1875, 1882, 1875, 1864,
+    1856, 1875, 1864, 1869, 1859, 1868, 1857, 1850, 1870, 1878, 1853, 1873, 1884, 1872, 1863, 1876,
+    1882, 1891, 1899, 1883, 1891, 1881, 1906, 1894, 1882, 1897, 2260, 1887, 1893, 1903, 1867, 1865,
+    1878, 1868, 1880, 1850, 1851, 1869, 1844, 1854, 1869, 1864, 1856, 1847, 1869, 1865, 1868, 1870,
+    1885, 1880, 1905, 1898, 1886, 1898, 1882, 1901, 1896, 1882, 1879, 1879, 1878, 1892, 1895, 1876,
+    1875, 1867, 1859, 1856, 1859, 1870, 1870, 1855, 1843, 1858, 1855, 1860, 1873, 1871, 1873, 1896,
+    1877, 1896, 1895, 1914, 1902, 1880, 1877, 1891, 1902, 1896, 1917, 1886, 1888, 1863, 1884, 1874,
+    1878, 1859, 1858, 1853, 1860, 1862, 1855, 1856, 1858, 1861, 1847, 1868, 1867, 1864, 1873, 1871,
+    1883, 1879, 1880, 1891, 1887, 1898, 1890, 1897, 1879, 1893, 2591, 1895, 1883, 1888, 1858, 1871,
+    1866, 1870, 1867, 1859, 1874, 1859, 1866, 1868, 1860, 1854, 1856, 1876, 1865, 1888, 1887, 1906,
+    1902, 1884, 1885, 2253, 1892, 1896, 1896, 1881, 1877, 1865, 1901, 1895, 1872, 1880, 1886, 1884,
+    1876, 1866, 1875, 1855, 1862, 1848, 1863, 1861, 1853, 1869, 1844, 1865, 1859, 1883, 1892, 1872,
+    1876, 1896, 1883, 1891, 1890, 1887, 1894, 1882, 1886, 1877, 1895, 1868, 1863, 1902, 1884, 1888,
+    1862, 1871, 1876, 1855, 1849, 1862, 1847, 1849, 2235, 1850, 1864, 1858, 1864, 1870, 1853, 1882,
+    1888, 1885, 1888, 1895, 1889, 1881, 2423, 1898, 1894, 1911, 1903, 1892, 1888, 1868, 1881, 1882,
+    1884, 1858, 1866, 1878, 1852, 1865, 1873, 1873, 1858, 1860, 1878, 1874, 1869, 1885, 1874, 1889,
+    1868, 1887, 1903, 1877, 1893, 1892, 1896, 1888, 1895, 1899, 1895, 1902, 1868, 1882, 1890, 1887,
+    1848, 1855, 1857, 1870, 1851, 1855, 1864, 1836, 1865, 1855, 1870, 1870, 1876, 1867, 1880, 1882,
+    1879, 1875, 1876, 1883, 1881, 1891, 1900, 1897, 1886, 1885, 1901, 1897, 1873, 1884, 1884, 1862,
+    1868, 1871, 1873, 1856, 1855, 1859, 1861, 1872, 1839, 1854, 1853, 2263, 1846, 1879, 1892, 1878,
+    1873, 1878, 1865, 1892, 1888, 1884, 1883, 1881, 1890, 1896, 1890, 1890, 1883, 1879, 1879, 1873,
+    1875, 1864, 1864, 1857, 1865, 1852, 1854, 1858, 1850, 1844, 1859, 1851, 1871, 1864, 1855, 1876,
+    1873, 1877, 1882, 1881, 1876, 1880, 1879, 1889, 1899, 1880, 1886, 1884, 1872, 1872, 1875, 1877,
+    1884, 1869, 1868, 1854, 1860, 1860, 1177, 1867, 1858, 1865, 1854, 1880, 1884, 1881, 1862, 1882,
+    1876, 1885, 1875, 1879, 1876, 1879, 1877, 1878, 1892, 1888, 1880, 1884, 1881, 1879, 1879, 1871,
+    1884, 1864, 1877, 1847, 1848, 1851, 1847, 1852, 1859, 1853, 1857, 1861, 1870, 1884, 1853, 1876,
+    1860, 1880, 1879, 1889, 1875, 1883, 1901, 1895, 1886, 1890, 1883, 1908, 1885, 1879, 1853, 1878,
+    1861, 1863, 1857, 1860, 1852, 1860, 1880, 1848, 1834, 1859, 1852, 1865, 1856, 1866, 1867, 1874,
+    1882, 1890, 1867, 1884, 1881, 1891, 1898, 1901, 1880, 1889, 2575, 1894, 1895, 1879, 1879, 1864,
+    1869, 1855, 1877, 1870, 1865, 1858, 1849, 1866, 1876, 1853, 1862, 1845, 1849, 1870, 1868, 1879,
+    1870, 1879, 1896, 1870, 1880, 1901, 1907, 1886, 1889, 1892, 1889, 1891, 1882, 1873, 1873, 1870,
+    1863, 1850, 1855, 1858, 1845, 1861, 1850, 1855, 1857, 1862, 1852, 1858, 1854, 1851, 1862, 1895,
+    1875, 1885, 1867, 1888, 1876, 1878, 1888, 1881, 1883, 1888, 1894, 1908, 1875, 1869, 1874, 1866,
+    1868, 1859, 1855, 1847, 1855, 1851, 1845, 1847, 1849, 1870, 1860, 1860, 1869, 1850, 1868, 1871,
+    1870, 1873, 1885, 1890, 1878, 1892, 1891, 1884, 1892, 1884, 1883, 1900, 1872, 1870, 1871, 1879,
+    1880, 1876, 1848, 1843, 1851, 1859, 1869, 1852, 1859, 1856, 1842, 1853, 1862, 1861, 1858, 1868,
+    1879, 1866, 1883, 1869, 1871, 1869, 1902, 1892, 1890, 1900, 1882, 1875, 1871, 1881, 1862, 1878,
+    1877, 1854, 1852, 1864, 1864, 1858, 1871, 1858, 1848, 1844, 1859, 1855, 1856, 1863, 1871, 1887,
+    1881, 1882, 1886, 2150, 1892, 1876, 1900, 1893, 1888, 1884, 1904, 1896, 1862, 1883, 1886, 1869,
+    1862, 1849, 1865, 1861, 1859, 1857, 1851, 1844, 1850, 1838, 1875, 1863, 1858, 1870, 1875, 1865,
+    1871, 1896, 1871, 1892, 1897, 1876, 1893, 1892, 1878, 1908, 1871, 1868, 1883, 1882, 1850, 1862,
+    1876, 1861, 1830, 1850, 1853, 1855, 1865, 1843, 1849, 1863, 1856, 1880, 1866, 1863, 1842, 1858,
+    1865, 1862, 1878, 1868, 1889, 1886, 1894, 1870, 1886, 1858, 1885, 1879, 1900, 1876, 1861, 1867,
+    1888, 1864, 1858, 1861, 1849, 1860, 1855, 1856, 1847, 1845, 1884, 1869, 1870, 1875, 1881, 1876,
+    1871, 1872, 1881, 1905, 1864, 1890, 1870, 1899, 1878, 1886, 1873, 1896, 1876, 1860, 1877, 1869,
+    1837, 1867, 1866, 1856, 1845, 1851, 1864, 1851, 1837, 1854, 1855, 1857, 1863, 1865, 1843, 1867,
+    1863, 1889, 1880, 1883, 1890, 1877, 1885, 1897, 1885, 1882, 1910, 1890, 1876, 1874, 1871, 1870,
+    1858, 1872, 1852, 1852, 1861, 1845, 1834, 1857, 1848, 1848, 1848, 1858, 1867, 1859, 1865, 1872,
+    1861, 1886, 1858, 1862, 1897, 1894, 1871, 1884, 1871, 1881, 1893, 1868, 1873, 1852, 1859, 1845,
+    1852, 1860, 1847, 1850, 1860, 1846, 1824, 1836, 1866, 1849, 1842, 1858, 2196, 1845, 1876, 1866,
+    1877, 1869, 1874, 1874, 1885, 1885, 1886, 1881, 1905, 1905, 1882, 1880, 1867, 1880, 1885, 1879,
+    1859, 1882, 1868, 1847, 1875, 1840, 1855, 1845, 1850, 1848, 1833, 1855, 1865, 1870, 1878, 1883,
+    1875, 1865, 1895, 1880, 1880, 1902, 1886, 1890, 1883, 1900, 1887, 1869, 1876, 1887, 1869, 1859,
+    1879, 1864, 1884, 1846, 1852, 1845, 1859, 1857, 1833, 1846, 1862, 1836, 1848, 1860, 1883, 1869,
+    1881, 1883, 1896, 1881, 1885, 1915, 1892, 1893, 1886, 1905, 1872, 1871, 1873, 1857, 2296, 1856,
+    1861, 1869, 1859, 1863, 1842, 1841, 1870, 1849, 1849, 1854, 1845, 1863, 1855, 1861, 1871, 1874,
+    1870, 1886, 1889, 1878, 1874, 1867, 1884, 1901, 1892, 1880, 1875, 1891, 1861, 1859, 1876, 1847,
+    1851, 1847, 1850, 1848, 1850, 1847, 1847, 1854, 1845, 1847, 1832, 1365, 1843, 1869, 1884, 1870,
+    1867, 1881, 1896, 1881, 1882, 1880, 1885, 1880, 1879, 1885, 1874, 1889, 1875, 1864, 1877, 1868,
+    1852, 1850, 1855, 1854, 1857, 1831, 1848, 1842, 1842, 1874, 1856, 1851, 1838, 1837, 1855, 1869,
+    1877, 1884, 1854, 1873, 1879, 1875, 1887, 1884, 1891, 1886, 1903, 1850, 1887, 1862, 1859, 1877,
+    1863, 1867, 1854, 1866, 1836, 1851, 1855, 1847, 1845, 1837, 1851, 1838, 1836, 1838, 1851, 1866,
+    1857, 1879, 1862, 1882, 1882, 1888, 1893, 1873, 1878, 1895, 1885, 1867, 1887, 1880, 1854, 1857,
+    1842, 1855, 1861, 1860, 1848, 1860, 1839, 1845, 1854, 1843, 1860, 1846, 1860, 1857, 1866, 1885,
+    1861, 1879, 1878, 1897, 1890, 1884, 1886, 1896, 1893, 1885, 1897, 1864, 1864, 1889, 1868, 1871,
+    1856, 1871, 1853, 1844, 1849, 1851, 1858, 1866, 1862, 1844, 1852, 1867, 1860, 1860, 1875, 1876,
+    1884, 1884, 1879, 1879, 1873, 1881, 1876, 1897, 1870, 1878, 1885, 1876, 1873, 1880, 1883, 1862,
+    1871, 1857, 1853, 1862, 1855, 1841, 1853, 1834, 1850, 1847, 1869, 1863, 1867, 1854, 1863, 1867,
+    1876, 1868, 1885, 1890, 1870, 1902, 1895, 1875, 1889, 1889, 2522, 1886, 1885, 1866, 1885, 1863,
+    1855, 1865, 1856, 1840, 1841, 1854, 1863, 1839, 1855, 1845, 1848, 1856, 1849, 1852, 1889, 1864,
+    1872, 1871, 1876, 1879, 1898, 1875, 1888, 1902, 1880, 1875, 1903, 1872, 1876, 1875, 1874, 1855,
+    1850, 1861, 1851, 1849, 1852, 1862, 2286, 1847, 1863, 1867, 1859, 1850, 1831, 1857, 1872, 1850,
+    1869, 1885, 1885, 1874, 1896, 1888, 1904, 1905, 1882, 1887, 1874, 1879, 1882, 1889, 1873, 1879,
+    1862, 1852, 1855, 1856, 1853, 2109, 1843, 1861, 1853, 1880, 1854, 1851, 1854, 1881, 1849, 1845,
+    1868, 1867, 1903, 1896, 1887, 1899, 1878, 1894, 1899, 1888, 2432, 1881, 1890, 1884, 1877, 1864,
+    1872, 1861, 1849, 1851, 1859, 1837, 1854, 1842, 1863, 1839, 1854, 1866, 1854, 1854, 1868, 1873,
+    1878, 1876, 1882, 1869, 1880, 1892, 1904, 1887, 1885, 1887, 1894, 1867, 1867, 1870, 1858, 1874,
+    1872, 1860, 1871, 1851, 2328, 1859, 1862, 1813, 1848, 1843, 1855, 1857, 1851, 1872, 1858, 1870,
+    1869, 1887, 1878, 1867, 1894, 1888, 1887, 1890, 1872, 1878, 1874, 1883, 1885, 1883, 1895, 1867,
+    1873, 1853, 1859, 1855, 1869, 1846, 1836, 1844, 1848, 1863, 1837, 1852, 1871, 1877, 1867, 1870,
+    1871, 1884, 1883, 1883, 1880, 1876, 1880, 1893, 1891, 1895, 1878, 1878, 1870, 1883, 1866, 1859,
+    1866, 1852, 1836, 1847, 1859, 1840, 1847, 1823, 1849, 1842, 1847, 1851, 1872, 1863, 1858, 1873,
+    1868, 1902, 1886, 1894, 1874, 1894, 1880, 1889, 1895, 1869, 1884, 1877, 1879, 1883, 1865, 1865,
+    1864, 1848, 1859, 1839, 1855, 1859, 1843, 1836, 1859, 1848, 1860, 1859, 1862, 1864, 1857, 1873,
+    1894, 1881, 1866, 1887, 1889, 1896, 1871, 1887, 1873, 1888, 1907, 1895, 1878, 1865, 1878, 1877,
+    1855, 1848, 1829, 1835, 1844, 1856, 1830, 1852, 1852, 1838, 1850, 1848, 1846, 1844, 1875, 1870,
+    1878, 1885, 1894, 1881, 1884, 1897, 1889, 1891, 1886, 1889, 1897, 1876, 1875, 1879, 1876, 1889,
+    1873, 1856, 1860, 1846, 1837, 1844, 1853, 1843, 1845, 1852, 1848, 1856, 1871, 1862, 1863, 1875,
+    1862, 1876, 1878, 1873, 1877, 1876, 1870, 1900, 1896, 1883, 1885, 1886, 1877, 1877, 1882, 1859,
+    1843, 1869, 1854, 1868, 1846, 1850, 1863, 1861, 1866, 1844, 1855, 1859, 1866, 1855, 1880, 1868,
+    2452, 1883, 1866, 1894, 1886, 1883, 1905, 1875, 1894, 1876, 1894, 1892, 1872, 1868, 1866, 1870,
+    1875, 1881, 1855, 1852, 1856, 1847, 1859, 1854, 1855, 1846, 1872, 1868, 1871, 1847, 1877, 1868,
+    1870, 1896, 1868, 1884, 1884, 1882, 2569, 1888, 1882, 1899, 1877, 1876, 1866, 1851, 1877, 1870,
+    1854, 1861, 1873, 1843, 1871, 1845, 1868, 1840, 1844, 1864, 1868, 1860, 1877, 1869, 1856, 1856,
+    1892, 1896, 1880, 1884, 1887, 1885, 1890, 1879, 1880, 1877, 1874, 1868, 1877, 1865, 1883, 1847,
+    1862, 1858, 1852, 1872, 1852, 1859, 1851, 1868, 1861, 1835, 1861, 1857, 1845, 1886, 1852, 1857,
+    1874, 1887, 1876, 1889, 1890, 1892, 1886, 1897, 1908, 1873, 1882, 1877, 1888, 1879, 1865, 1865,
+    1872, 1859, 1860, 1868, 1845, 1836, 1857, 1861, 1841, 1826, 1876, 1858, 1864, 1867, 1861, 1865,
+    1855, 1886, 1869, 1876, 1872, 1895, 1894, 1875, 1888, 1886, 1891, 1879, 1878, 1879, 1882, 1855,
+    1872, 1849, 1863, 1844, 1870, 1861, 1853, 1834, 1849, 1851, 1854, 1858, 1866, 1852, 1871, 1860,
+    1884, 1875, 1881, 1898, 1886, 1886, 1907, 1872, 1885, 1875, 1890, 1877, 1874, 1870, 1867, 1877,
+    1885, 1869, 1850, 1839, 1863, 1855, 1857, 1860, 1835, 1876, 1861, 1853, 1855, 1865, 1883, 1881,
+    1875, 1869, 1884, 1880, 1890, 1897, 1916, 1879, 1890, 1882, 1894, 1878, 1898, 1882, 1859, 1874,
+    1861, 1844, 1845, 1845, 1857, 1874, 1867, 1858, 1841, 1861, 1843, 1865, 1853, 1876, 1885, 1865,
+    1884, 1880, 1888, 1876, 1897, 1887, 1888, 1900, 1889, 1905, 1868, 1893, 1887, 1870, 1873, 1882,
+    1870, 1858, 1868, 1861, 1858, 1845, 1843, 1860, 1848, 1866, 1870, 1864, 1850, 1867, 1885, 1866,
+    1871, 1876, 1890, 1899, 1887, 1905, 1896, 1889, 1881, 1900, 1893, 1896, 1871, 1873, 1880, 1873,
+    1867, 1850, 1834, 1853, 1856, 1858, 1859, 1878, 1845, 1857, 1864, 1862, 1854, 1874, 1848, 1872,
+    1873, 1889, 1880, 1903, 1887, 1897, 1892, 1909, 1907, 1874, 1873, 1884, 1887, 1882, 1413, 1871,
+    1872, 1861, 1881, 1842, 1846, 1856, 1843, 1837, 1849, 1866, 1864, 1862, 1847, 1851, 1864, 1880,
+    1876, 1882, 1880, 1900, 1892, 1917, 1909, 1887, 1896, 1903, 1894, 1886, 1898, 1902, 1860, 1850,
+    1869, 1849, 1862, 1840, 1860, 1849, 1854, 1853, 1838, 1867, 1873, 1861, 1852, 1884, 1872, 1894,
+    1864, 1896, 1883, 1881, 1873, 1890, 1879, 1880, 1900, 1889, 1887, 1886, 1871, 1879, 1866, 1890,
+    1859, 1876, 1858, 1864, 1861, 1852, 1853, 1843, 1867, 1870, 1866, 1870, 1861, 1861, 1848, 1870,
+    1878, 2159, 1890, 1887, 1893, 1889, 1889, 1901, 1896, 1867, 1905, 1903, 1889, 1880, 1868, 1869,
+    1881, 1853, 1855, 1840, 1860, 1852, 1864, 1868, 1854, 1864, 1854, 1871, 1862, 1877, 1868, 1877,
+    1889, 1894, 1882, 1896, 1895, 1884, 1901, 1869, 1906, 1881, 1887, 1887, 1886, 1858, 1900, 1868,
+    1860, 1868, 1867, 1864, 1871, 1863, 1869, 1849, 1854, 1848, 1861, 1860, 1877, 1863, 1875, 1877,
+    1889, 1875, 1895, 1894, 1913, 1896, 1887, 1900, 1872, 1881, 1872, 1880, 1878, 1875, 1878, 1889,
+    1876, 1877, 1858, 1846, 1844, 1861, 1862, 1850, 1857, 1871, 1867, 1853, 1878, 1862, 1870, 1875,
+    1862, 1877, 1877, 1893, 1897, 1896, 1904, 1896, 1879, 1882, 1887, 1883, 1892, 1870, 1863, 1883,
+    1866, 1850, 1847, 1873, 1851, 1861, 1864, 1841, 1856, 1845, 1849, 1870, 1853, 1883, 1882, 1871,
+    1887, 1884, 1891, 1891, 1884, 1893, 1879, 1889, 1879, 1890, 1892, 1888, 1863, 1876, 1867, 1868,
+    1881, 1856, 1850, 1858, 1872, 1862, 1870, 1856, 1855, 1869, 1851, 1869, 1877, 1862, 1870, 1881,
+    1880, 1892, 1878, 1895, 1898, 1882, 1873, 1907, 1885, 1880, 1890, 1875, 1886, 1895, 1885, 1862,
+    1870, 1878, 1855, 1865, 1856, 1876, 1862, 1843, 1859, 1866, 1850, 1870, 1868, 1872, 1857, 1896,
+    1879, 1897, 1885, 1898, 1879, 1887, 1891, 1893, 1897, 1895, 1885, 1870, 1895, 1872, 1861, 1882,
+    1884, 1873, 1858, 1863, 2363, 1856, 1845, 1860, 1866, 1860, 1857, 1863, 1874, 1877, 1862, 1893,
+    1903, 1890, 1896, 1893, 1900, 1892, 1888, 1894, 1894, 1887, 1904, 1899, 1892, 1884, 1878, 1877,
+    2344, 1867, 1882, 1826, 1871, 1867, 1861, 1846, 1867, 1848, 1874, 1868, 1849, 1863, 1880, 1893,
+    1905, 1883, 1913, 1900, 1890, 1887, 1888, 1906, 1886, 1897, 1882, 1896, 1880, 1880, 1902, 1872,
+    1873, 1867, 1860, 1877, 1854, 1859, 1859, 1862, 1858, 1867, 1868, 1861, 1874, 1890, 1876, 1862,
+    1892, 1880, 1874, 1890, 1912, 1902, 1892, 1886, 1887, 1885, 1895, 1896, 1904, 1899, 1873, 1874,
+    1864, 1873, 1868, 1854, 1880, 1864, 1870, 1872, 1846, 1863, 1842, 1869, 1882, 1871, 1881, 1885,
+    1887, 1888, 1897, 1896, 1897, 1893, 1897, 1899, 1900, 1893, 1900, 1873, 1881, 1892, 1873, 1874,
+    1875, 1868, 1877, 1867, 1869, 1849, 1841, 1847, 1858, 1848, 1860, 1862, 1872, 1873, 1869, 1887,
+    1878, 1890, 1888, 1897, 1888, 1902, 1881, 1904, 1897, 1895, 1906, 1895, 1886, 1898, 1885, 1880,
+    1875, 1878, 1854, 1850, 1589, 1877, 1845, 1860, 1845, 1857, 1873, 1869, 1874, 1880, 1896, 1882,
+    1878, 1896, 1896, 1904, 1909, 1888, 1906, 1909, 1898, 1887, 1869, 1902, 1869, 1882, 1881, 1869,
+    1877, 1876, 1880, 1864, 1865, 1866, 1867, 1855, 1859, 1872, 1863, 1871, 1878, 1880, 1880, 1880,
+};
+const uint16_t TRACE_REST_HUM_BLOCKS = 400;
+
+// rest, pushed to the stop (ADC saturated) in 30 ms, held, released
+const uint16_t TRACE_FLICK[] = {
+    1874, 1886, 1870, 1870, 1873, 1880, 1879, 1863, 1860, 1858, 1871, 1870, 1872, 1876, 1869, 1853,
+    1859, 1884, 1877, 1870, 1884, 1871, 1863, 1873, 1855, 1862, 1892, 1849, 1890, 1854, 1872, 1867,
+    1873, 1877, 1889, 1883, 1869, 1890, 1871, 1872, 1894, 1854, 1872, 1877, 1877, 1883, 1893, 1879,
+    1881, 1868, 1865, 1863, 1885, 1869, 1874, 1882, 1872, 1873, 1888, 1876, 1866, 1866, 1869, 1858,
+    1862, 1851, 1867, 1869, 1865, 1884, 1874, 1872, 1871, 1881, 1878, 1884, 1870, 1882, 1878, 1869,
+    1882, 1867, 1868, 1873, 1877, 1882, 1877, 1866, 1876, 1867, 1865, 1879, 1898, 1875, 1852, 1884,
+    1874, 1855, 1872, 1883, 1867, 1870, 1887, 1866, 1885, 1867, 1878, 1882, 1854, 1887, 1874, 1894,
+    1871, 1880, 1883, 1890, 1875, 1874, 1882, 1877, 1865, 1281, 1878, 1876, 1872, 1863, 1884, 1879,
+    1872, 1904, 1891, 1875, 1886, 1878, 1873, 1873, 1863, 1863, 1873, 1876, 1860, 1865, 1884, 1877,
+    1878, 1871, 1873, 1856, 1882, 1881, 1873, 1864, 1862, 1873, 1879, 1867, 1884, 1883, 1874, 1879,
+    1868, 1874, 1863, 1871, 1907, 1892, 1868, 1853, 1887, 1870, 1877, 1898, 1864, 1882, 1873, 1870,
+    1882, 1885, 1888, 1871, 1875, 1870, 1883, 1865, 1884, 1865, 1882, 1870, 1879, 1888, 1882, 1868,
+    1879, 1888, 1907, 1881, 1880, 1855, 1887, 1867, 1877, 1883, 1885, 1886, 1881, 1873, 1891, 1885,
+    1878, 1874, 1875, 1878, 1889, 1883, 1882, 1882, 1866, 1880, 1861, 1873, 1862, 1880, 1878, 1872,
+    1865, 1871, 1884, 1879, 1866, 1863, 1886, 1871, 1889, 1869, 1874, 1882, 1875, 1872, 1867, 1872,
+    1881, 1878, 1872, 1865, 1859, 1882, 1882, 1876, 1856, 1868, 1863, 1870, 1886, 1886, 1870, 1875,
+    1871, 1882, 1861, 1886, 1872, 1887, 1888, 1867, 1873, 1873, 1883, 1889, 1881, 1894, 1883, 1882,
+    1872, 1877, 1868, 1869, 1872, 1884, 1893, 1886, 1905, 1892, 1883, 1879, 1870, 1893, 1874, 1867,
+    1881, 1871, 1862, 1881, 1884, 1879, 1870, 1885, 1876, 1886, 1878, 1879, 1873, 1873, 1885, 1894,
+    1892, 1880, 1855, 1878, 1872, 1881, 1888, 1870, 1901, 1874, 1864, 1878, 1886, 1877, 1889, 1884,
+    1889, 1878, 1868, 1877, 1871, 1887, 1865, 1888, 1883, 1875, 1865, 1874, 1888, 1860, 1873, 1882,
+    1863, 1883, 1861, 1876, 1880, 1876, 1879, 1873, 1872, 1890, 1875, 1875, 1427, 1850, 1888, 1885,
+    1873, 1871, 1869, 1867, 1884, 1876, 1880, 1864, 1880, 1883, 1879, 1879, 1881, 1875, 1884, 1865,
+    1884, 1871, 1892, 1890, 1881, 1890, 1886, 1882, 1862, 1872, 1872, 1873, 1872, 1887, 1889, 1898,
+    1891, 1877, 1856, 1890, 1861, 1879, 1885, 1874, 1891, 1887, 1876, 1876, 1869, 1882, 1877, 1882,
+    1883, 1880, 1905, 1874, 1882, 1885, 1869, 1875, 1858, 1883, 1879, 1896, 1866, 1876, 1883, 1894,
+    1884, 1851, 1889, 1879, 1874, 1877, 1881, 1868, 1865, 1884, 1881, 1871, 1881, 1866, 1877, 1884,
+    1895, 1865, 1895, 1870, 1872, 1877, 1891, 1877, 1861, 1883, 1883, 1885, 1889, 1863, 1891, 1881,
+    1875, 1894, 1873, 1870, 1892, 1875, 1882, 1887, 1875, 1902, 1872, 1883, 1882, 1878, 1889, 1884,
+    2554, 1865, 1852, 1890, 1873, 1876, 1888, 1891, 1877, 1879, 1872, 1872, 1886, 1888, 1880, 1868,
+    1882, 1881, 1891, 2572, 1886, 1877, 1863, 1880, 1869, 1892, 1866, 1881, 1882, 1873, 1882, 1873,
+    1882, 1885, 1889, 1877, 1899, 1880, 1874, 1867, 1868, 1876, 1873, 1889, 1870, 1889, 1891, 1864,
+    1878, 1884, 1871, 1891, 1868, 1882, 1891, 1878, 1888, 1883, 1897, 1886, 1874, 1884, 1860, 1887,
+    1875, 1890, 1867, 1862, 1880, 1888, 1886, 1883, 1857, 1873, 1888, 1862, 1877, 1874, 1858, 1882,
+    1885, 1867, 1878, 1880, 1877, 1889, 1869, 1868, 1894, 1877, 1879, 2508, 1876, 1875, 1884, 1874,
+    1882, 1878, 1871, 1878, 1887, 1862, 1873, 1888, 1871, 1875, 1871, 1888, 1865, 1871, 1875, 1859,
+    1883, 1874, 1889, 1874, 1879, 1870, 1872, 1864, 1880, 1887, 1895, 1875, 1882, 1884, 1882, 1870,
+    1866, 1876, 1876, 1888, 1877, 1879, 1869, 1885, 1869, 1880, 1887, 1886, 1875, 1887, 1875, 1875,
+    1888, 1881, 1871, 1853, 1875, 1872, 1892, 1872, 1863, 1873, 1882, 1887, 1877, 1870, 1867, 1880,
+    1870, 1876, 1877, 1873, 1874, 1877, 1876, 1886, 1880, 1887, 1875, 1883, 1877, 1896, 1879, 1887,
+    1895, 1892, 1888, 1878, 1881, 1881, 1893, 1895, 1867, 1874, 1877, 1887, 1412, 1881, 1888, 1866,
+    1863, 1873, 1894, 1903, 1879, 1873, 1874, 1875, 1350, 1875, 1876, 1867, 1887, 1896, 1878, 1880,
+    1884, 1871, 1891, 1880, 1871, 1518, 1875, 1881, 1866, 1875, 1888, 1881, 1877, 1896, 1878, 1867,
+    1895, 1886, 1891, 1873, 1906, 1907, 1884, 1879, 1879, 1902, 1878, 1879, 1882, 1877, 1871, 1880,
+    1876, 1876, 1885, 1878, 1862, 1876, 1892, 1886, 1883, 1879, 1865, 1886, 1866, 1882, 1878, 1871,
+    1870, 1890, 1872, 1880, 1880, 1892, 1881, 1883, 1878, 1900, 1876, 1880, 1868, 1891, 1880, 1886,
+    1878, 1874, 1870, 1887, 1868, 1888, 1886, 1899, 1884, 1878, 1889, 1888, 1892, 1862, 1883, 1897,
+    1857, 1887, 1887, 1876, 1878, 1883, 1883, 1902, 1875, 1886, 1870, 1875, 1891, 1859, 1886, 1882,
+    1900, 1875, 1887, 1886, 1878, 1887, 1886, 1875, 1887, 1873, 1873, 1875, 1899, 1882, 1877, 1883,
+    1871, 1884, 1881, 1868, 1883, 1883, 1870, 1887, 1873, 1886, 1867, 1880, 1877, 1873, 1883, 1874,
+    1890, 1885, 1899, 1859, 1892, 1889, 1889, 1843, 2319, 2322, 2339, 2333, 2330, 2324, 2300, 2322,
+    2767, 2754, 2774, 2768, 2770, 2780, 2756, 2772, 3209, 3194, 3212, 3218, 3203, 3220, 3203, 3226,
+    3677, 3666, 3635, 3670, 3664, 3662, 3670, 3651, 4089, 4092, 4082, 4095, 4095, 4095, 4086, 4095,
+    4095, 3439, 4095, 4095, 4095, 4095, 4095, 4095, 4089, 4087, 4093, 4095, 4095, 4095, 4095, 4095,
+    4095, 4095, 4089, 4095, 4086, 4095, 4092, 4095, 4093, 4095, 4091, 4095, 4095, 4095, 4095, 4095,
+    4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4093, 4095, 4093, 4095, 4095,
+    4082, 4095, 4095, 4090, 4095, 4095, 4095, 4090, 4095, 4095, 4090, 4087, 4095, 4095, 4095, 4085,
+    4085, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4080, 4095, 4095, 4095, 4095, 4095, 4085,
+    4094, 4088, 4095, 4095, 4095, 4091, 4092, 4095, 4083, 4090, 4095, 4090, 4095, 4095, 4095, 4094,
+    4095, 4095, 4095, 4095, 4092, 4095, 4095, 4095, 4084, 4095, 4095, 4095, 4095, 4095, 4095, 4095,
+    4095, 4095, 4095, 4095, 4095, 4090, 4083, 4095, 4095, 4095, 4095, 4095, 4089, 4095, 4095, 4088,
+    4089, 4082, 4080, 4095, 4095, 4095, 4095, 4095, 4095, 4094, 4095, 4095, 4095, 4095, 4095, 4095,
+    4095, 4095, 4095, 4092, 4095, 4095, 4095, 4091, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4084,
+    4090, 4094, 4095, 4082, 3605, 4082, 4095, 4089, 4091, 4095, 4095, 4095, 4095, 4095, 4085, 4095,
+    4087, 4095, 4095, 4089, 4095, 4095, 4095, 4092, 4095, 4095, 4095, 4080, 4095, 4089, 4095, 4095,
+    4095, 4095, 4095, 4091, 4095, 4095, 4095, 4095, 4095, 3469, 4095, 3711, 4095, 4089, 4095, 4095,
+    4095, 4095, 4087, 4095, 4093, 4095, 4095, 4095, 4095, 4090, 4095, 4091, 4095, 4095, 4090, 4090,
+    4095, 4095, 4095, 4095, 4085, 4085, 4095, 4095, 4095, 4082, 4095, 4095, 4095, 4095, 4093, 4095,
+    4095, 4083, 4093, 4086, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4089, 4095,
+    4095, 4095, 4081, 4095, 4095, 4095, 4080, 4095, 4095, 4094, 4095, 4095, 4095, 4089, 4095, 4095,
+    4090, 4095, 4095, 4093, 4095, 4095, 4074, 4095, 4095, 4095, 4094, 4095, 4089, 4091, 4095, 4095,
+    4084, 4095, 4095, 4095, 4095, 4095, 4090, 4095, 4095, 4095, 4095, 4085, 4095, 4095, 4095, 4095,
+    4095, 4089, 4084, 4095, 4091, 4095, 4094, 4095, 4090, 4095, 4084, 4095, 4088, 4095, 4095, 4089,
+    4095, 4088, 4083, 4092, 4095, 4091, 4090, 4092, 4093, 4086, 4095, 4093, 4095, 4095, 4095, 4093,
+    4082, 4095, 4094, 4095, 4095, 4093, 4089, 4095, 3701, 4095, 4092, 4095, 4089, 4095, 4095, 4073,
+    4095, 4086, 4095, 4094, 4095, 4086, 4088, 4084, 4095, 4095, 4095, 4087, 4095, 4091, 4093, 4081,
+    4095, 4095, 4090, 4093, 4089, 4095, 4095, 4095, 4087, 4095, 4090, 4089, 4095, 4095, 4095, 4095,
+    4081, 4086, 4090, 4095, 4095, 4095, 4095, 4085, 4060, 4071, 4095, 4085, 4094, 4074, 4095, 4078,
+    4095, 4095, 4095, 4095, 4095, 4095, 4095, 4088, 4091, 4095, 4085, 4093, 4095, 4095, 4095, 4095,
+    4095, 4095, 4095, 4084, 4095, 4079, 3751, 4092, 4087, 4095, 4093, 4095, 4095, 4095, 4095, 4084,
+    4095, 4095, 4095, 4095, 4094, 4094, 4095, 4094, 4095, 4095, 4095, 4091, 4095, 4095, 4095, 4095,
+    4095, 4095, 4086, 4079, 4094, 4078, 4088, 4095, 4095, 4095, 4095, 4090, 4095, 4094, 4084, 4088,
+    4095, 4095, 4095, 4095, 4094, 4095, 4095, 4095, 4083, 4095, 4095, 4095, 4095, 4087, 4095, 4095,
+    4095, 4095, 4073, 4095, 4091, 4072, 4085, 4095, 4095, 4095, 4081, 4095, 4095, 4095, 4095, 4095,
+    4095, 4093, 4080, 4095, 4095, 4095, 4079, 4095, 4095, 4095, 4093, 4083, 4095, 4095, 4095, 4085,
+    4095, 4095, 4095, 4095, 4083, 4094, 4087, 4092, 4089, 4087, 4095, 4095, 4074, 4095, 4095, 4095,
+    4092, 4081, 4095, 4095, 4095, 4079, 4094, 4070, 4095, 4095, 4087, 4095, 4089, 4085, 4080, 4095,
+    4095, 4079, 4095, 4095, 4061, 4084, 4095, 4094, 4092, 4095, 4082, 4081, 4095, 4095, 4095, 4087,
+    4095, 4082, 4095, 4076, 4095, 4095, 4094, 4089, 4095, 4092, 4095, 4090, 4095, 4095, 4095, 4095,
+    4089, 4093, 4095, 4095, 4091, 4090, 4095, 4095, 4095, 4074, 4078, 4095, 4089, 4088, 4095, 4095,
+    4092, 4095, 4095, 4087, 4088, 4090, 4095, 4084, 4095, 4095, 4095, 4081, 4095, 4095, 4094, 4095,
+    4090, 4090, 4095, 4072, 4094, 4095, 4088, 4080, 4095, 4095, 4095, 4093, 4088, 4082, 4095, 4095,
+    4075, 4076, 4089, 4085, 4095, 4086, 4085, 4095, 4095, 4095, 4088, 4092, 4095, 4075, 4095, 4081,
+    4095, 4095, 4088, 4090, 4095, 4092, 4092, 4089, 4085, 4093, 4071, 4095, 4095, 4095, 4095, 4095,
+    4095, 4095, 4095, 4094, 4095, 4095, 4095, 4095, 4086, 4095, 4076, 4095, 4095, 4095, 4085, 4095,
+    4071, 4095, 4073, 4088, 4089, 4095, 4095, 4095, 4091, 4094, 4095, 4095, 4073, 4087, 4094, 4095,
+    4095, 4095, 4082, 4095, 4079, 4086, 4091, 4095, 4095, 4080, 4095, 4083, 4095, 4095, 4090, 4085,
+    4095, 4095, 4084, 4095, 4089, 4095, 4092, 4091, 4095, 4085, 4095, 4093, 4088, 4095, 4095, 4095,
+    4090, 4095, 4095, 4090, 4070, 4095, 4095, 4086, 4083, 4090, 4082, 4095, 4075, 4095, 4092, 4095,
+    4094, 4092, 4093, 4095, 4080, 4082, 4095, 4084, 4095, 4088, 4095, 4095, 4071, 4095, 4095, 4095,
+    4095, 4091, 4095, 4095, 4094, 4087, 4095, 4088, 4095, 4087, 4093, 4083, 4092, 4095, 4089, 4085,
+    4090, 4086, 4090, 4084, 4085, 4085, 4085, 4095, 4091, 4095, 4091, 4093, 4095, 4095, 4095, 4075,
+    4095, 4081, 4089, 4089, 4074, 4083, 4088, 4093, 4095, 4084, 4075, 4086, 4087, 4090, 4083, 4095,
+    1872, 1861, 1855, 1868, 1851, 1857, 1871, 1877, 1876, 1874, 1866, 1865, 1872, 1476, 1877, 1872,
+    1873, 1872, 1868, 1861, 1874, 1875, 1876, 1887, 1861, 1885, 1875, 1875, 1875, 1861, 1866, 1877,
+    1882, 1883, 1891, 1872, 1867, 1879, 1866, 1888, 1873, 1856, 1873, 1874, 1855, 1867, 1866, 1847,
+    1865, 1859, 1859, 1872, 1859, 1877, 1873, 1857, 1874, 1859, 1854, 1868, 1892, 1866, 1872, 1873,
+    1868, 1874, 1883, 1859, 1864, 1896, 1850, 1871, 1860, 1876, 1872, 1880, 1878, 1857, 2515, 1888,
+    1859, 1883, 1887, 1878, 1850, 1877, 1870, 1867, 1861, 1871, 1871, 1884, 1869, 1885, 1854, 1861,
+    1868, 1861, 1877, 1857, 1869, 1876, 1875, 1866, 1858, 1863, 1883, 1864, 1881, 1870, 1864, 1386,
+    1870, 1869, 1878, 1873, 1862, 1864, 1881, 1856, 1860, 1865, 1859, 1873, 1872, 1864, 1859, 1875,
+    1863, 1872, 1857, 1857, 1886, 1878, 1864, 1877, 1858, 1873, 1886, 1856, 1876, 1860, 1882, 1876,
+    1319, 1876, 1864, 1872, 1861, 1856, 1871, 1868, 1851, 1862, 1854, 1869, 1875, 1868, 1875, 1871,
+    1880, 1861, 1878, 1881, 1876, 1856, 1866, 1873, 1874, 1874, 1859, 1873, 1879, 1866, 1851, 1848,
+    1879, 1868, 1888, 1860, 1868, 1885, 1871, 1866, 1864, 1874, 1877, 1865, 1854, 1861, 1855, 1844,
+    1881, 1874, 1860, 1862, 1861, 1883, 1858, 1865, 1861, 1864, 1866, 1861, 1883, 1868, 1864, 1857,
+    1868, 1870, 1869, 1859, 1867, 1880, 1852, 1868, 1870, 1859, 1872, 1885, 1868, 1873, 1866, 1874,
+    1864, 1850, 1849, 1851, 1864, 1870, 1870, 1869, 1257, 1877, 1862, 1866, 1866, 1864, 1875, 1876,
+    1872, 1843, 1858, 1846, 1873, 1864, 1872, 1877, 1865, 1876, 1874, 1860, 1875, 1858, 1875, 1850,
+    1852, 1879, 1869, 1859, 1864, 1867, 1879, 1869, 1861, 1887, 1858, 1877, 1864, 1881, 1867, 1866,
+    1866, 1868, 1871, 1844, 1866, 1863, 1864, 1874, 1866, 1862, 1858, 1878, 1882, 1865, 1864, 1865,
+    1872, 1874, 1857, 1879, 1859, 1871, 1885, 1860, 1873, 1877, 1869, 1875, 1863, 1867, 1857, 1864,
+    1864, 1862, 1865, 1873, 1850, 1872, 1873, 1870, 1856, 1856, 1890, 1860, 1854, 1847, 1861, 1875,
+    1864, 1868, 1858, 1863, 1881, 1864, 1880, 1850, 1873, 1876, 1869, 1882, 1879, 1867, 1865, 1881,
+    1877, 1863, 1857, 1860, 1866, 1882, 1864, 1870, 1875, 1859, 1869, 1866, 1888, 1861, 1878, 1854,
+    1866, 1869, 1871, 1871, 1858, 1868, 1853, 1864, 1865, 1875, 1880, 1883, 1880, 1852, 1878, 1862,
+    1851, 1865, 1871, 1850, 1869, 1874, 1887, 1876, 1870, 1857, 1866, 1886, 1864, 1845, 1858, 1855,
+    1882, 1859, 1872, 1871, 1868, 1869, 1853, 1860, 1854, 1859, 1862, 1874, 1878, 1863, 1853, 1863,
+    1869, 1871, 1868, 1861, 1880, 1868, 1887, 1860, 1854, 1875, 1890, 1870, 1895, 1857, 1844, 1867,
+    1869, 1863, 1881, 1879, 1864, 1858, 1861, 1850, 1875, 1863, 1862, 1864, 1875, 1887, 1861, 1856,
+    1871, 1857, 1867, 1867, 1883, 1854, 1869, 1869, 1871, 1862, 1876, 1876, 1868, 1850, 1871, 1871,
+    1859, 1872, 1860, 1862, 1874, 1885, 1870, 1862, 1865, 1882, 1844, 1850, 1855, 1863, 1887, 1881,
+    1863, 1853, 1875, 1874, 1862, 1863, 1867, 1858, 1864, 1863, 1877, 1859, 1879, 1870, 1860, 1842,
+    1865, 1876, 1855, 1883, 1865, 1858, 1863, 1887, 1874, 1863, 1855, 1869, 1870, 1857, 1850, 1884,
+    1891, 1858, 1866, 1862, 1863, 1869, 1876, 1875, 1863, 1878, 1868, 1877, 1869, 1841, 1862, 1876,
+    1862, 1886, 1868, 1883, 1874, 1878, 1868, 1859, 1861, 1880, 1870, 1867, 1887, 1860, 1871, 1857,
+    1861, 1858, 1875, 1859, 1888, 1870, 1880, 1886, 1869, 1869, 1862, 1856, 1860, 1868, 1865, 1864,
+    1846, 1872, 1877, 1856, 1867, 1864, 1872, 1871, 1879, 1862, 1874, 1869, 1869, 1851, 1866, 1853,
+    1863, 1871, 1875, 2252, 1864, 1860, 1872, 1855, 1864, 1870, 1863, 1869, 1879, 1870, 1880, 1859,
+    1862, 1869, 1863, 1873, 1877, 1875, 1856, 1876, 1861, 1846, 1884, 1856, 1864, 1887, 1872, 1861,
+    1856, 1853, 1874, 1860, 1861, 1867, 1875, 1854, 1888, 1877, 1859, 1863, 1855, 1872, 1857, 1869,
+    1878, 1859, 1884, 1870, 1870, 1879, 1856, 1873, 1874, 1882, 1873, 1871, 1842, 1866, 1867, 1867,
+    1850, 1886, 1873, 1890, 1880, 1873, 1877, 1882, 1855, 1860, 1874, 1176, 1855, 1878, 1852, 1881,
+    1855, 1864, 1863, 1883, 1870, 1871, 1859, 1875, 1859, 1846, 1880, 1865, 1869, 1863, 1885, 1868,
+    1867, 1861, 1888, 1865, 1882, 1848, 1865, 1878, 1862, 1879, 1880, 1872, 1876, 1859, 1863, 1872,
+    1867, 1875, 1856, 1881, 1872, 1874, 1867, 1858, 1878, 1858, 1871, 1860, 1882, 1863, 1870, 1855,
+    1859, 1849, 1861, 1864, 1861, 1865, 1875, 1864, 1869, 1849, 1878, 1873, 1860, 1881, 1869, 1849,
+    1847, 1878, 1864, 1872, 1888, 1860, 1861, 1860, 1868, 1873, 1864, 1870, 1885, 1851, 1870, 1863,
+    2182, 1876, 1865, 1877, 1388, 1872, 1864, 1845, 1877, 1870, 1857, 1871, 1888, 1858, 1858, 1874,
+    1869, 1878, 1847, 1882, 1837, 1860, 1861, 1869, 1866, 1537, 1867, 1880, 1871, 1870, 1876, 1862,
+    1857, 1866, 1868, 1861, 1876, 1875, 1869, 1895, 1883, 1876, 1859, 1845, 1859, 1871, 1858, 1858,
+    1861, 1882, 1866, 1870, 1883, 1879, 1853, 1880, 1856, 1872, 1862, 1874, 1872, 1875, 1879, 1863,
+    1866, 1870, 1883, 1869, 1874, 1873, 1884, 1885, 1875, 1876, 1866, 1885, 1856, 1872, 1864, 1861,
+};
+const uint16_t TRACE_FLICK_BLOCKS = 306;
+
+// nudged while the boot calibration runs
+const uint16_t TRACE_TOUCHED[] = {
+    1873, 1878, 1882, 1877, 1874, 1866, 1875, 1877, 1882, 1857, 1868, 1886, 1876, 1870, 1867, 1873,
+    1892, 1865, 1884, 1866, 1863, 1873, 1878, 1881, 1887, 1877, 1864, 1875, 1868, 1877, 1863, 1886,
+    1877, 1871, 1875, 1860, 1878, 1883, 1893, 1858, 1882, 1875, 1853, 1886, 1872, 1880, 1855, 1436,
+    1862, 1887, 1867, 1876, 1889, 1880, 1864, 1866, 1892, 1878, 1870, 1868, 1867, 1874, 1868, 1877,
+    1874, 1886, 1873, 1883, 1884, 1883, 1885, 1862, 1853, 1884, 1878, 1881, 1870, 1884, 1877, 1865,
+    1879, 1868, 1863, 1883, 1887, 1858, 1864, 1876, 1876, 1880, 1861, 1885, 1897, 1882, 1880, 1863,
+    1871, 1876, 1867, 1871, 1892, 1884, 1872, 1878, 1882, 1901, 1881, 1866, 1877, 1865, 1872, 1864,
+    1860, 1857, 1866, 1871, 1865, 1892, 1881, 1875, 1888, 1886, 1864, 1873, 1359, 1893, 1884, 1869,
+    1887, 1862, 1886, 1888, 1878, 1878, 1884, 1894, 1867, 1886, 1881, 1872, 1874, 1877, 1884, 1859,
+    1882, 1886, 1891, 1869, 1866, 1863, 1879, 1868, 1858, 1863, 1876, 1884, 1883, 1869, 1873, 1885,
+    1860, 1871, 1889, 1871, 1905, 1870, 1874, 1879, 1894, 1866, 1876, 1884, 1879, 1861, 1874, 1888,
+    1884, 1877, 1884, 1875, 1874, 1861, 1873, 1863, 1864, 1872, 1872, 1876, 1875, 1885, 1871, 1884,
+    1877, 1874, 1886, 1892, 1865, 1872, 1891, 1846, 1885, 1872, 1872, 1873, 1871, 1889, 1890, 1879,
+    1871, 1868, 1866, 1892, 1887, 1866, 1847, 1871, 1873, 1864, 1876, 1883, 1889, 1868, 1351, 1865,
+    1892, 1878, 1882, 1883, 1879, 1868, 1886, 1878, 1882, 1870, 1873, 1866, 1894, 1861, 1864, 1884,
+    1871, 1871, 1875, 1884, 1876, 1872, 1882, 1880, 1885, 1869, 1847, 1885, 1879, 1872, 1863, 1870,
+    1880, 1871, 1877, 1870, 1872, 1884, 1856, 1899, 1900, 1870, 1897, 1884, 1879, 1873, 1864, 1878,
+    1876, 1857, 1881, 1882, 1881, 1890, 1870, 1853, 1883, 1876, 1884, 1862, 1885, 1879, 1883, 1884,
+    1872, 1879, 1876, 1866, 1857, 1869, 1871, 1876, 1864, 1867, 1879, 1872, 1874, 1887, 1881, 1885,
+    1900, 1871, 1865, 1874, 1881, 1888, 1852, 1860, 1874, 1875, 1898, 1889, 1869, 1875, 1882, 1872,
+    1868, 1853, 1876, 1877, 1879, 1874, 1857, 1887, 1895, 1872, 1909, 2344, 1874, 1877, 1880, 1883,
+    1882, 1879, 1889, 1875, 1886, 1887, 1876, 1877, 1867, 1864, 1883, 1885, 1850, 1886, 1890, 1879,
+    1866, 1871, 1883, 1875, 1887, 1865, 1875, 1897, 1880, 1899, 1852, 1887, 1900, 1884, 1887, 1898,
+    1867, 1887, 1868, 1877, 1869, 1883, 1884, 1880, 1881, 1874, 1873, 1882, 1873, 1876, 1861, 1875,
+    1885, 1885, 1869, 1883, 1891, 1868, 1869, 1886, 1887, 1877, 1883, 1887, 1861, 1876, 1865, 1866,
+    1887, 1873, 1854, 1879, 1865, 1894, 1875, 1883, 1912, 1875, 1896, 1898, 1875, 1876, 1906, 1892,
+    1893, 1880, 1885, 1904, 1907, 1900, 1895, 1910, 1909, 1908, 1911, 1922, 1914, 1917, 1920, 1934,
+    1921, 1932, 1935, 1915, 1922, 1925, 1938, 1928, 1948, 1938, 1934, 1917, 1942, 1927, 1922, 1944,
+    1935, 1935, 1921, 1953, 1944, 1957, 1936, 1957, 1964, 1963, 1964, 1970, 1962, 1971, 1954, 1937,
+    2581, 1953, 1973, 1983, 1967, 1965, 1972, 1976, 1975, 1971, 1986, 1992, 1981, 1993, 1981, 1981,
+    1993, 1978, 1982, 1972, 1988, 1993, 2006, 1975, 2003, 1998, 1988, 1991, 2003, 2008, 1992, 1992,
+    2006, 2002, 2009, 2007, 2015, 2006, 2002, 2010, 2023, 2023, 2014, 2027, 2017, 2024, 2023, 2005,
+    2020, 2045, 2040, 2043, 2046, 2038, 2029, 2024, 2053, 2043, 2045, 2042, 2049, 2026, 2052, 2024,
+    2052, 2038, 2063, 2055, 2067, 2059, 2064, 2062, 2061, 2086, 2067, 2053, 2075, 2082, 2060, 2071,
+    2061, 2074, 2072, 2090, 2066, 2084, 2069, 2088, 2083, 2093, 2111, 2085, 2080, 2077, 2100, 2071,
+    2104, 2093, 2107, 2105, 2093, 2094, 2102, 2096, 2114, 2117, 2097, 2104, 2100, 2101, 2092, 2119,
+    2115, 2133, 2099, 2110, 2107, 2125, 2126, 2130, 2139, 2143, 2147, 2122, 2122, 2130, 2130, 2124,
+    2140, 2123, 2161, 2165, 2146, 2137, 2135, 2133, 2124, 2153, 2700, 2150, 2158, 2145, 2164, 2157,
+    2164, 2160, 2145, 2157, 2149, 2162, 2159, 2183, 2171, 2204, 2161, 2190, 2175, 2191, 2186, 2185,
+    2196, 2191, 2186, 2193, 2187, 2180, 2185, 2194, 2204, 2178, 2188, 2203, 2178, 2211, 2184, 2184,
+    2205, 2216, 2191, 2209, 2181, 2219, 2210, 2229, 2210, 2209, 2210, 2230, 2216, 2210, 2222, 2218,
+    2235, 2239, 2235, 2211, 2233, 2245, 2232, 2221, 2236, 2244, 2255, 2254, 2228, 2250, 2247, 2243,
+    2234, 2239, 2245, 2244, 2267, 2247, 2243, 2255, 2268, 2249, 2263, 2257, 2260, 2267, 2254, 2272,
+    2281, 2277, 2273, 2279, 2280, 2290, 2288, 2283, 2286, 2292, 2268, 2301, 2272, 2287, 2285, 2290,
+    2287, 2287, 2298, 2288, 2297, 2298, 2296, 2307, 2312, 2315, 2292, 2308, 2301, 2305, 2301, 2296,
+    2298, 2312, 2305, 2310, 2309, 2306, 2316, 2298, 2304, 2285, 2299, 2290, 2328, 2297, 2296, 2306,
+    2297, 2290, 2297, 2309, 2298, 2315, 2303, 2297, 2311, 2320, 2292, 2303, 2314, 2297, 2319, 2315,
+    2298, 2297, 2319, 2306, 2312, 2307, 2314, 2315, 2304, 2313, 2299, 2303, 2303, 2299, 2299, 2290,
+    2295, 2316, 2291, 2310, 2324, 2308, 2294, 2323, 2306, 2303, 2304, 2298, 2317, 2298, 2284, 2316,
+    2294, 2289, 2309, 2291, 2302, 2309, 2297, 2304, 2310, 2318, 2329, 2308, 2315, 2307, 2308, 2311,
+    2294, 2306, 2296, 2309, 2303, 2308, 2309, 2302, 2314, 2303, 2302, 2320, 2302, 2318, 2296, 2301,
+    2290, 2297, 2304, 2312, 2314, 2300, 2308, 2286, 2302, 2312, 2312, 2302, 2308, 2297, 2318, 2310,
+    2317, 2313, 2306, 2319, 2311, 2310, 2313, 2322, 2318, 2303, 2304, 2325, 2315, 2317, 2300, 2306,
+    2318, 2300, 2293, 2305, 2320, 2300, 2311, 2304, 2304, 2304, 2286, 2327, 2294, 2298, 2314, 2305,
+    2311, 2308, 2311, 2318, 2313, 2305, 2311, 2314, 2306, 2309, 2305, 2305, 2306, 2308, 2305, 2302,
+    2302, 2311, 2297, 2302, 2305, 2322, 2303, 2314, 2302, 2304, 2308, 2316, 2298, 2313, 2311, 2295,
+    2312, 2310, 2312, 2297, 2307, 2297, 2309, 2306, 2307, 2318, 2304, 2297, 2299, 2303, 2323, 2313,
+    2300, 2304, 2291, 2295, 2290, 2297, 2306, 2318, 2308, 2301, 2290, 2290, 2290, 2296, 2289, 2311,
+    2288, 2319, 2311, 2315, 2301, 2305, 2310, 2318, 2303, 2304, 2303, 2328, 2304, 2302, 2292, 2284,
+    2300, 2304, 2303, 2302, 2319, 2309, 2309, 2304, 2288, 2310, 2292, 2290, 2321, 2327, 2290, 2287,
+    2303, 2293, 2308, 2323, 2299, 2297, 2319, 2306, 2321, 2296, 2312, 2318, 2304, 2317, 2284, 2310,
+    2304, 2287, 2310, 2311, 2301, 2303, 2320, 2319, 2321, 2313, 2320, 2312, 2296, 2300, 2284, 2303,
+    2295, 2279, 2314, 2296, 2301, 2292, 2300, 2316, 2305, 2318, 2289, 2308, 2312, 2304, 2318, 2308,
+    2309, 2297, 2312, 2302, 2306, 2308, 2302, 2300, 2289, 2304, 2312, 2292, 2305, 2298, 2308, 2290,
+    2299, 2300, 2312, 2682, 2308, 2301, 2321, 2292, 2299, 2296, 2313, 2286, 2299, 2282, 2300, 2304,
+    2302, 2302, 2319, 2329, 2308, 2311, 2295, 1988, 2329, 2304, 2298, 2311, 2294, 2320, 2295, 2309,
+    2295, 2314, 2331, 2318, 2302, 2307, 2308, 2305, 2312, 2307, 2322, 2295, 2306, 2318, 2306, 2317,
+    2302, 2292, 2305, 2299, 2312, 2309, 2291, 2313, 2284, 2302, 2299, 2304, 2312, 2620, 2308, 2287,
+    2300, 2304, 2316, 2303, 2305, 2314, 2297, 2295, 2301, 1963, 2310, 2284, 2313, 2299, 2293, 2300,
+    2290, 2283, 2286, 2305, 2295, 2324, 2309, 2301, 2301, 2290, 2583, 2302, 2296, 2314, 2301, 2287,
+    2315, 2319, 2300, 2320, 2306, 2283, 2303, 2310, 2302, 2320, 2314, 2295, 2299, 2309, 2313, 2300,
+    2312, 2303, 2305, 2300, 2299, 2311, 2295, 2290, 2289, 2316, 2291, 2312, 2307, 2319, 2304, 2296,
+    2310, 2288, 2281, 2306, 2302, 2299, 2303, 2300, 2318, 2307, 2297, 2300, 2292, 2308, 2293, 2302,
+    2310, 2299, 2302, 2315, 2301, 2303, 2300, 2316, 2314, 2300, 2309, 2311, 2300, 2316, 2311, 2300,
+    2302, 2303, 2295, 2301, 2296, 2297, 2302, 2288, 2291, 2304, 2314, 2308, 2275, 2315, 2289, 2302,
+};
+const uint16_t TRACE_TOUCHED_BLOCKS = 150;
@@ -0,0 +1,130 @@
+// AxisFilter, CenterCalibrator and normalizeAxis replaying recorded-style ADC noise
+// (noise_traces.h, regenerated by make_traces.py). Settings as in webcam_platform.cpp.
+
+#include <unity.h>
+
+#include "AxisFilter.h"
+#include "noise_traces.h"
+
+const uint16_t CAL_SAMPLES = 100;  // 0.5 s of filtered output
+const uint16_t MIN_DEADZONE = 60;
+const uint16_t MAX_NOISE = 200;
+
+void setUp() {}
+void tearDown() {}
+
+struct Replay {
+  AxisFilter filter;
+  CenterCalibrator calibrator{CAL_SAMPLES, MIN_DEADZONE, MAX_NOISE};
+  AxisCalibration cal = {};
+  bool calOk = false;
+
+  // Boot calibration over the first blocks of `trace`, then returns the next block index
+  uint16_t calibrate(const uint16_t* trace) {
+    uint16_t block = 0;
+    while (!calibrator.done()) calibrator.add(filter.update(trace + TRACE_OVERSAMPLE * block++, TRACE_OVERSAMPLE));
+    cal = calibrator.result(&calOk);
+    return block;
+  }
+  uint16_t step(const uint16_t* trace, uint16_t block) {
+    return filter.update(trace + TRACE_OVERSAMPLE * block, TRACE_OVERSAMPLE);
+  }
+};
+
+// Peak-to-peak of the raw reads and of the filter output over blocks first..last-1
+static void spread(const uint16_t* trace, uint16_t first, uint16_t last, AxisFilter& filter, uint16_t* raw,
+                   uint16_t* filtered) {
+  uint16_t rawLo = 0xFFFF, rawHi = 0, outLo = 0xFFFF, outHi = 0;
+  for (uint16_t b = first; b < last; b++) {
+    for (int k = 0; k < TRACE_OVERSAMPLE; k++) {
+      uint16_t v = trace[TRACE_OVERSAMPLE * b + k];
+      if (v < rawLo) rawLo = v;
+      if (v > rawHi) rawHi = v;
+    }
+    uint16_t out = filter.update(trace + TRACE_OVERSAMPLE * b, TRACE_OVERSAMPLE);
+    if (out < outLo) outLo = out;
+    if (out > outHi) outHi = out;
+  }
+  *raw = rawHi - rawLo;
+  *filtered = outHi - outLo;
+}
+
+void test_calibration_finds_center_at_rest() {
+  Replay replay;
+  replay.calibrate(TRACE_REST);
+  TEST_ASSERT_TRUE(replay.calOk);
+  TEST_ASSERT_INT_WITHIN(8, TRACE_CENTER, replay.cal.center);
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT32(MIN_DEADZONE, replay.cal.deadzone);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(MAX_NOISE, replay.cal.deadzone);
+}
+
+void test_jitter_and_spikes_rejected() {
+  const uint16_t* traces[] = {TRACE_REST, TRACE_REST_HUM};
+  const uint16_t blocks[] = {TRACE_REST_BLOCKS, TRACE_REST_HUM_BLOCKS};
+  for (int t = 0; t < 2; t++) {
+    Replay replay;
+    uint16_t first = replay.calibrate(traces[t]);
+    uint16_t raw, filtered;
+    spread(traces[t], first, blocks[t], replay.filter, &raw, &filtered);
+    // The traces hold spikes of several hundred counts; the output moves a few counts at most
+    TEST_ASSERT_GREATER_THAN_UINT32(500, raw);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(40, filtered);
+  }
+}
+
+void test_deadzone_holds_released_stick_at_zero() {
+  const uint16_t* traces[] = {TRACE_REST, TRACE_REST_HUM};
+  const uint16_t blocks[] = {TRACE_REST_BLOCKS, TRACE_REST_HUM_BLOCKS};
+  for (int t = 0; t < 2; t++) {
+    Replay replay;
+    for (uint16_t b = replay.calibrate(traces[t]); b < blocks[t]; b++) {
+      TEST_ASSERT_EQUAL_INT16(0, normalizeAxis(replay.step(traces[t], b), replay.cal));
+    }
+  }
+}
+
+void test_flick_reaches_full_scale_and_returns_to_zero() {
+  // Blocks 0..99 rest, 100..105 push, 106..205 held at the stop, 206.. released
+  Replay replay;
+  uint16_t b = replay.calibrate(TRACE_FLICK);
+  TEST_ASSERT_TRUE(replay.calOk);
+  for (; b < 100; b++) TEST_ASSERT_EQUAL_INT16(0, normalizeAxis(replay.step(TRACE_FLICK, b), replay.cal));
+
+  int fullAt = -1;
+  for (; b < 206; b++) {
+    int16_t x = normalizeAxis(replay.step(TRACE_FLICK, b), replay.cal);
+    TEST_ASSERT_GREATER_OR_EQUAL_INT(0, x);  // never kicks the wrong way
+    if (fullAt < 0 && x >= 950) fullAt = b;
+  }
+  // Full deflection within 50 ms of reaching the stop
+  TEST_ASSERT_GREATER_OR_EQUAL_INT(0, fullAt);
+  TEST_ASSERT_LESS_OR_EQUAL_INT(106 + 10, fullAt);
+
+  int zeroAt = -1;
+  for (; b < TRACE_FLICK_BLOCKS; b++) {
+    int16_t x = normalizeAxis(replay.step(TRACE_FLICK, b), replay.cal);
+    if (zeroAt < 0 && x == 0) zeroAt = b;
+    if (zeroAt >= 0) TEST_ASSERT_EQUAL_INT16(0, x);  // and stays there
+  }
+  // The IIR (alpha 1/4) has 2200 counts to lose before the deadzone: about 75 ms
+  TEST_ASSERT_GREATER_OR_EQUAL_INT(0, zeroAt);
+  TEST_ASSERT_LESS_OR_EQUAL_INT(206 + 15, zeroAt);
+}
+
+void test_touched_stick_falls_back_to_nominal_center() {
+  Replay replay;
+  replay.calibrate(TRACE_TOUCHED);
+  TEST_ASSERT_FALSE(replay.calOk);
+  TEST_ASSERT_EQUAL_UINT16((JOYSTICK_ADC_MAX + 1) / 2, replay.cal.center);
+  TEST_ASSERT_EQUAL_UINT16(MIN_DEADZONE, replay.cal.deadzone);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_calibration_finds_center_at_rest);
+  RUN_TEST(test_jitter_and_spikes_rejected);
+  RUN_TEST(test_deadzone_holds_released_stick_at_zero);
+  RUN_TEST(test_flick_reaches_full_scale_and_returns_to_zero);
+  RUN_TEST(test_touched_stick_falls_back_to_nominal_center);
+  return UNITY_END();
+}
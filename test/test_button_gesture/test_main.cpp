@@ -0,0 +1,166 @@
+// ButtonGesture from synthetic edge sequences: clicks, double clicks, long presses, contact
+// bounce and glitches. Timings as in webcam_platform.cpp.
+
+#include <unity.h>
+
+#include "ButtonGesture.h"
+
+const uint16_t DEBOUNCE_MS = 20;
+const uint16_t DOUBLE_CLICK_MS = 500;
+const uint16_t LONG_PRESS_MS = 1000;
+const uint32_t POLL_MS = 10;  // the sketch polls once per control tick
+
+struct Seen {
+  ButtonEvent event;
+  uint32_t atMs;
+};
+
+// Plays edges in time order, polling every POLL_MS in between (and until `endMs`) like the
+// sketch does, and collects the gestures with the poll time they came out at
+struct Player {
+  ButtonGesture button{DEBOUNCE_MS, DOUBLE_CLICK_MS, LONG_PRESS_MS};
+  ButtonEdge edges[64];
+  int edgeCount = 0;
+  Seen seen[16];
+  int seenCount = 0;
+
+  void at(uint32_t ms, bool pressed) { edges[edgeCount++] = {ms, pressed}; }
+
+  // A mechanical contact: 4 ms of chatter before it settles on `pressed`
+  void bouncy(uint32_t ms, bool pressed) {
+    for (int i = 0; i < 4; i++) at(ms + i, i % 2 == 0 ? pressed : !pressed);
+    at(ms + 4, pressed);
+  }
+  void click(uint32_t ms, uint32_t holdMs) {
+    bouncy(ms, true);
+    bouncy(ms + holdMs, false);
+  }
+
+  void play(uint32_t endMs) {
+    int next = 0;
+    for (uint32_t now = 0; now <= endMs; now += POLL_MS) {
+      while (next < edgeCount && edges[next].timeMs <= now) button.edge(edges[next++]);
+      for (ButtonEvent e = button.poll(now); e != BUTTON_NONE; e = button.poll(now)) seen[seenCount++] = {e, now};
+    }
+  }
+};
+
+void setUp() {}
+void tearDown() {}
+
+void test_single_click_after_double_click_window() {
+  Player p;
+  p.click(100, 120);
+  p.play(2000);
+  TEST_ASSERT_EQUAL_INT(1, p.seenCount);
+  TEST_ASSERT_EQUAL_UINT8(BUTTON_CLICK, p.seen[0].event);
+  // Reported on the first poll after the window, timed from the release edge (224 ms)
+  TEST_ASSERT_UINT32_WITHIN(POLL_MS, 224 + DOUBLE_CLICK_MS, p.seen[0].atMs);
+  TEST_ASSERT_EQUAL_UINT32(1, p.button.presses());
+}
+
+void test_double_click() {
+  Player p;
+  p.click(100, 100);
+  p.click(350, 100);
+  p.play(2000);
+  TEST_ASSERT_EQUAL_INT(1, p.seenCount);
+  TEST_ASSERT_EQUAL_UINT8(BUTTON_DOUBLE_CLICK, p.seen[0].event);
+  // At the second release, not after a timeout
+  TEST_ASSERT_UINT32_WITHIN(POLL_MS, 454 + DEBOUNCE_MS, p.seen[0].atMs);
+  TEST_ASSERT_EQUAL_UINT32(2, p.button.presses());
+}
+
+void test_two_slow_clicks_stay_single() {
+  Player p;
+  p.click(100, 100);
+  p.click(100 + 100 + DOUBLE_CLICK_MS + 100, 100);
+  p.play(3000);
+  TEST_ASSERT_EQUAL_INT(2, p.seenCount);
+  TEST_ASSERT_EQUAL_UINT8(BUTTON_CLICK, p.seen[0].event);
+  TEST_ASSERT_EQUAL_UINT8(BUTTON_CLICK, p.seen[1].event);
+}
+
+void test_long_press_fires_while_held() {
+  Player p;
+  p.bouncy(100, true);
+  p.bouncy(2500, false);
+  p.play(4000);
+  TEST_ASSERT_EQUAL_INT(1, p.seenCount);
+  TEST_ASSERT_EQUAL_UINT8(BUTTON_LONG_PRESS, p.seen[0].event);
+  // Without waiting for the release; timed from the press edge, not from the poll
+  TEST_ASSERT_UINT32_WITHIN(POLL_MS, 104 + LONG_PRESS_MS, p.seen[0].atMs);
+  TEST_ASSERT_FALSE(p.button.pressed());
+}
+
+void test_click_then_long_press() {
+  Player p;
+  p.click(100, 100);
+  p.bouncy(400, true);
+  p.bouncy(2000, false);
+  p.play(3000);
+  TEST_ASSERT_EQUAL_INT(2, p.seenCount);
+  TEST_ASSERT_EQUAL_UINT8(BUTTON_CLICK, p.seen[0].event);
+  TEST_ASSERT_EQUAL_UINT8(BUTTON_LONG_PRESS, p.seen[1].event);
+  TEST_ASSERT_UINT32_WITHIN(POLL_MS, 404 + LONG_PRESS_MS, p.seen[1].atMs);
+}
+
+void test_bounce_counts_once() {
+  // Chatter on both edges of every press: one stable press each
+  Player p;
+  for (int i = 0; i < 5; i++) p.click(100 + i * 2000, 200);
+  p.play(11000);
+  TEST_ASSERT_EQUAL_UINT32(5, p.button.presses());
+  TEST_ASSERT_EQUAL_INT(5, p.seenCount);
+  for (int i = 0; i < p.seenCount; i++) TEST_ASSERT_EQUAL_UINT8(BUTTON_CLICK, p.seen[i].event);
+}
+
+void test_glitches_shorter_than_debounce_ignored() {
+  // EMI spikes from the servo supply: a few ms low, never long enough to count
+  Player p;
+  for (uint32_t t = 100; t < 1500; t += 150) {
+    p.at(t, true);
+    p.at(t + DEBOUNCE_MS / 2, false);
+  }
+  p.play(3000);
+  TEST_ASSERT_EQUAL_UINT32(0, p.button.presses());
+  TEST_ASSERT_EQUAL_INT(0, p.seenCount);
+}
+
+void test_glitch_during_hold_does_not_split_press() {
+  // A held button dropping out for a few ms is still one long press
+  Player p;
+  p.bouncy(100, true);
+  p.at(600, false);
+  p.at(605, true);
+  p.bouncy(2000, false);
+  p.play(3000);
+  TEST_ASSERT_EQUAL_UINT32(1, p.button.presses());
+  TEST_ASSERT_EQUAL_INT(1, p.seenCount);
+  TEST_ASSERT_EQUAL_UINT8(BUTTON_LONG_PRESS, p.seen[0].event);
+}
+
+void test_timing_independent_of_poll_rate() {
+  // Edges queued by the ISR and handed over late: the gesture still uses the edge times
+  ButtonGesture button(DEBOUNCE_MS, DOUBLE_CLICK_MS, LONG_PRESS_MS);
+  button.edge({100, true});
+  button.edge({200, false});
+  button.edge({350, true});
+  button.edge({450, false});
+  TEST_ASSERT_EQUAL_UINT8(BUTTON_DOUBLE_CLICK, button.poll(5000));
+  TEST_ASSERT_EQUAL_UINT8(BUTTON_NONE, button.poll(5000));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_single_click_after_double_click_window);
+  RUN_TEST(test_double_click);
+  RUN_TEST(test_two_slow_clicks_stay_single);
+  RUN_TEST(test_long_press_fires_while_held);
+  RUN_TEST(test_click_then_long_press);
+  RUN_TEST(test_bounce_counts_once);
+  RUN_TEST(test_glitches_shorter_than_debounce_ignored);
+  RUN_TEST(test_glitch_during_hold_does_not_split_press);
+  RUN_TEST(test_timing_independent_of_poll_rate);
+  return UNITY_END();
+}
@@ -0,0 +1,148 @@
+// HttpServer WebSocket framing over a loopback socket: a frame whose length does not fit the
+// receive buffer closes the connection, whatever the length field says
+
+#include <unity.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "HttpServer.h"
+
+const uint16_t PORT = 18391;
+
+HttpServer* server = nullptr;
+int client = -1;
+char received[64];
+size_t receivedLength = 0;
+
+void onWebSocket(uint8_t, WebSocketEvent event, const char* data, size_t length) {
+  if (event != WebSocketEvent::Message || length >= sizeof(received)) return;
+  memcpy(received, data, length);
+  receivedLength = length;
+}
+
+// Lets the server take what the client sent (or answer it)
+void pollServer() {
+  for (int i = 0; i < 10; i++) server->poll(5);
+}
+
+// Connects and completes the WebSocket upgrade; the 101 response is read and dropped
+void connectWebSocket() {
+  client = socket(AF_INET, SOCK_STREAM, 0);
+  TEST_ASSERT_TRUE(client >= 0);
+  struct timeval timeout = {0, 200000};
+  setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons(PORT + HTTP_PORT_OFFSET);
+  TEST_ASSERT_EQUAL(0, connect(client, (struct sockaddr*)&addr, sizeof(addr)));
+
+  const char* upgrade =
+      "GET /ws HTTP/1.1\r\n"
+      "Host: localhost\r\n"
+      "Upgrade: websocket\r\n"
+      "Connection: Upgrade\r\n"
+      "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+      "Sec-WebSocket-Version: 13\r\n\r\n";
+  TEST_ASSERT_EQUAL((ssize_t)strlen(upgrade), send(client, upgrade, strlen(upgrade), 0));
+  pollServer();
+
+  char response[256];
+  ssize_t n = recv(client, response, sizeof(response) - 1, 0);
+  TEST_ASSERT_TRUE(n > 0);
+  response[n] = '\0';
+  TEST_ASSERT_NOT_NULL(strstr(response, "101"));
+}
+
+// Masked frame header with an all-zero mask, so the payload goes out as is
+size_t frameHeader(uint8_t* frame, uint8_t lengthCode, uint64_t length) {
+  size_t n = 0;
+  frame[n++] = 0x81;  // FIN, text
+  frame[n++] = 0x80 | lengthCode;
+  if (lengthCode == 126) {
+    frame[n++] = (uint8_t)(length >> 8);
+    frame[n++] = (uint8_t)length;
+  } else if (lengthCode == 127) {
+    for (int i = 7; i >= 0; i--) frame[n++] = (uint8_t)(length >> (8 * i));
+  }
+  for (int i = 0; i < 4; i++) frame[n++] = 0;
+  return n;
+}
+
+// True once the server has hung up on the client
+bool closedByServer() {
+  char buffer[64];
+  return recv(client, buffer, sizeof(buffer), 0) == 0;
+}
+
+void setUp() {
+  server = new HttpServer(PORT);
+  server->onWebSocket("/ws", onWebSocket);
+  TEST_ASSERT_TRUE(server->begin());
+  receivedLength = 0;
+  connectWebSocket();
+}
+
+void tearDown() {
+  if (client >= 0) close(client);
+  client = -1;
+  delete server;
+  server = nullptr;
+}
+
+void test_small_frame_reaches_handler() {
+  uint8_t frame[32];
+  size_t n = frameHeader(frame, 5, 5);
+  memcpy(frame + n, "hello", 5);
+  send(client, frame, n + 5, 0);
+  pollServer();
+
+  TEST_ASSERT_EQUAL(5, receivedLength);
+  TEST_ASSERT_EQUAL_MEMORY("hello", received, 5);
+  TEST_ASSERT_EQUAL(0, server->stats().errors);
+}
+
+void test_oversized_16_bit_length_closes() {
+  uint8_t frame[32];
+  size_t n = frameHeader(frame, 126, HTTP_RX_BUFFER_SIZE);
+  memset(frame + n, 'x', 8);
+  send(client, frame, n + 8, 0);
+  pollServer();
+
+  TEST_ASSERT_EQUAL(1, server->stats().errors);
+  TEST_ASSERT_TRUE(closedByServer());
+}
+
+// The top bits set make length + header wrap to a small number; the unmask loop must never
+// see it
+void test_wrapping_64_bit_length_closes() {
+  const uint64_t lengths[] = {0xFFFFFFFFFFFFFFFFull, 0xFFFFFFFFFFFFFFF2ull, 0x8000000000000000ull};
+  for (uint64_t length : lengths) {
+    uint8_t frame[32];
+    size_t n = frameHeader(frame, 127, length);
+    memset(frame + n, 'x', 8);
+    send(client, frame, n + 8, 0);
+    pollServer();
+
+    TEST_ASSERT_EQUAL(0, receivedLength);
+    TEST_ASSERT_TRUE(closedByServer());
+    close(client);
+    connectWebSocket();
+  }
+  TEST_ASSERT_EQUAL(3, server->stats().errors);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_small_frame_reaches_handler);
+  RUN_TEST(test_oversized_16_bit_length_closes);
+  RUN_TEST(test_wrapping_64_bit_length_closes);
+  return UNITY_END();
+}
@@ -0,0 +1,159 @@
+// MotionTrack: lossless round trip, compression on typical motion, ring overflow and restore
+
+#include <unity.h>
+
+#include <string.h>
+
+#include "MotionTrack.h"
+
+const int MINUTE = 6000;  // 10 ms control ticks
+const int MAX_TICKS = 2 * MINUTE;
+
+static int16_t input[MAX_TICKS][MOTION_TRACK_MAX_CHANNELS];
+static uint8_t storage[16384];
+static uint8_t copy[16384];
+
+void setUp() {}
+void tearDown() {}
+
+static uint32_t seed;
+static int32_t randomIn(int32_t lo, int32_t hi) {
+  seed = seed * 1103515245u + 12345u;
+  return lo + (int32_t)((seed >> 8) % (uint32_t)(hi - lo + 1));
+}
+
+// Hand on a stick: the acceleration changes every few ticks (a filtered stick does not jump
+// every 10 ms), the speed wanders, and every fourth second the stick rests
+static void stickMotion(int ticks, uint8_t channels) {
+  seed = 7;
+  int32_t pos[MOTION_TRACK_MAX_CHANNELS];
+  int32_t speed[MOTION_TRACK_MAX_CHANNELS] = {};
+  int32_t accel[MOTION_TRACK_MAX_CHANNELS] = {};
+  for (uint8_t c = 0; c < channels; c++) pos[c] = 9000;
+  for (int t = 0; t < ticks; t++) {
+    bool hold = (t / 100) % 4 == 3;
+    for (uint8_t c = 0; c < channels; c++) {
+      if (t % 4 == 0) accel[c] = randomIn(-3, 3);
+      speed[c] = hold ? 0 : speed[c] + accel[c];
+      if (speed[c] > 90) speed[c] = 90;
+      if (speed[c] < -90) speed[c] = -90;
+      pos[c] += speed[c];
+      if (pos[c] < 0 || pos[c] > 18000) {
+        speed[c] = -speed[c];
+        pos[c] = pos[c] < 0 ? 0 : 18000;
+      }
+      input[t][c] = (int16_t)pos[c];
+    }
+  }
+}
+
+static void record(MotionTrack& track, int ticks) {
+  track.clear();
+  for (int t = 0; t < ticks; t++) track.add(input[t]);
+  track.finish();
+}
+
+// Plays the track and compares with input[first..first+count)
+static void expectPlayback(MotionTrack& track, int first, int count) {
+  int16_t angles[MOTION_TRACK_MAX_CHANNELS];
+  track.rewind();
+  for (int t = 0; t < count; t++) {
+    TEST_ASSERT_TRUE(track.next(angles));
+    for (uint8_t c = 0; c < track.channels(); c++) TEST_ASSERT_EQUAL_INT16(input[first + t][c], angles[c]);
+  }
+  TEST_ASSERT_FALSE(track.next(angles));
+  TEST_ASSERT_EQUAL_UINT32(count, track.stats().played);
+}
+
+void test_round_trip_every_channel_count() {
+  for (uint8_t channels = 1; channels <= MOTION_TRACK_MAX_CHANNELS; channels++) {
+    MotionTrack track(storage, sizeof(storage), channels);
+    stickMotion(MINUTE, channels);
+    // Jumps (a preset recall, a direct angle) need the varint tokens
+    for (uint8_t c = 0; c < channels; c++) {
+      input[1000][c] = 0;
+      input[1001][c] = 18000;
+      input[1002][c] = -32768;
+      input[1003][c] = 32767;
+    }
+    record(track, MINUTE);
+    TEST_ASSERT_EQUAL_UINT32(MINUTE, track.stats().ticks);
+    TEST_ASSERT_EQUAL_UINT32(0, track.stats().dropped);
+    expectPlayback(track, 0, MINUTE);
+  }
+}
+
+void test_hold_and_constant_speed_compress_to_runs() {
+  MotionTrack track(storage, sizeof(storage), 2);
+  for (int t = 0; t < MINUTE; t++) {
+    input[t][0] = 4500;
+    input[t][1] = (int16_t)(t < MINUTE / 2 ? 3000 + t : 3000 + MINUTE / 2);  // 1 deg/s, then rest
+  }
+  record(track, MINUTE);
+  expectPlayback(track, 0, MINUTE);
+
+  // A minute is 24000 raw bytes; runs of 128 ticks make it about one byte per 1.28 s
+  const uint32_t raw = MINUTE * 2 * sizeof(int16_t);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(80, track.stats().bytes);
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT32(300, raw / track.stats().bytes);
+}
+
+void test_stick_motion_compression_ratio() {
+  // Two axes of continuous stick movement: the documented "about 3 KB per minute"
+  MotionTrack track(storage, sizeof(storage), 2);
+  stickMotion(MINUTE, 2);
+  record(track, MINUTE);
+  expectPlayback(track, 0, MINUTE);
+
+  const uint32_t raw = MINUTE * 2 * sizeof(int16_t);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(3072, track.stats().bytes);
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT32(8, raw / track.stats().bytes);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(track.dataSize(), track.stats().bytes);
+}
+
+void test_full_ring_drops_oldest_blocks() {
+  // 2 KB holds well under two minutes of stick movement: the end is kept, block aligned
+  MotionTrack track(storage, 2048, 2);
+  stickMotion(MAX_TICKS, 2);
+  record(track, MAX_TICKS);
+  MotionTrackStats stats = track.stats();
+  TEST_ASSERT_GREATER_THAN_UINT32(0, stats.dropped);
+  TEST_ASSERT_EQUAL_UINT32(MAX_TICKS, stats.ticks + stats.dropped);
+  TEST_ASSERT_EQUAL_size_t(2048, track.dataSize());
+  expectPlayback(track, (int)stats.dropped, (int)stats.ticks);
+}
+
+void test_restore_from_saved_bytes() {
+  MotionTrack track(storage, sizeof(storage), 2);
+  stickMotion(MINUTE, 2);
+  record(track, MINUTE);
+  size_t size = track.dataSize();
+  memcpy(copy, track.data(), size);
+
+  // What loading it back at boot does
+  uint8_t loaded[sizeof(storage)];
+  MotionTrack restored(loaded, sizeof(loaded), 2);
+  memcpy(restored.storage(), copy, size);
+  TEST_ASSERT_TRUE(restored.restore(size));
+  TEST_ASSERT_EQUAL_UINT32(track.stats().ticks, restored.stats().ticks);
+  TEST_ASSERT_EQUAL_UINT32(track.stats().bytes, restored.stats().bytes);
+  expectPlayback(restored, 0, MINUTE);
+
+  // A damaged block count or a partial block is refused, leaving an empty track
+  memcpy(restored.storage(), copy, size);
+  restored.storage()[MOTION_TRACK_BLOCK_SIZE + 2] ^= 0x01;  // second block's tick count
+  TEST_ASSERT_FALSE(restored.restore(size));
+  TEST_ASSERT_TRUE(restored.empty());
+  TEST_ASSERT_FALSE(restored.restore(size - 1));
+  TEST_ASSERT_FALSE(restored.restore(sizeof(loaded) + MOTION_TRACK_BLOCK_SIZE));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_round_trip_every_channel_count);
+  RUN_TEST(test_hold_and_constant_speed_compress_to_runs);
+  RUN_TEST(test_stick_motion_compression_ratio);
+  RUN_TEST(test_full_ring_drops_oldest_blocks);
+  RUN_TEST(test_restore_from_saved_bytes);
+  return UNITY_END();
+}
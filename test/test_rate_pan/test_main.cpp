@@ -0,0 +1,130 @@
+// RatePan: the expo stick curve, rate and acceleration limits, braking at the travel limits
+
+#include <unity.h>
+
+#include <math.h>
+
+#include "RatePan.h"
+
+const PanResponse RESPONSE = {90.0f, 0.6f, 360.0f};  // deg/s, expo, deg/s^2
+const float DT = 0.01f;                              // 100 Hz control tick
+
+void setUp() {}
+void tearDown() {}
+
+void test_expo_curve_shape() {
+  // Full deflection is maxRate whatever the expo; center is 0
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 90.0f, stickToRate(1.0f, RESPONSE));
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, -90.0f, stickToRate(-1.0f, RESPONSE));
+  TEST_ASSERT_EQUAL_FLOAT(0, stickToRate(0, RESPONSE));
+
+  // Half deflection: 90 * (0.4 * 0.5 + 0.6 * 0.125)
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 24.75f, stickToRate(0.5f, RESPONSE));
+
+  // Odd and monotonic, and softer than linear everywhere inside the stroke
+  float previous = stickToRate(-1.0f, RESPONSE);
+  for (int i = -99; i <= 100; i++) {
+    float x = i / 100.0f;
+    float rate = stickToRate(x, RESPONSE);
+    TEST_ASSERT_TRUE(rate > previous);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, -rate, stickToRate(-x, RESPONSE));
+    if (i > 0 && i < 100) TEST_ASSERT_TRUE(rate < RESPONSE.maxRate * x);
+    previous = rate;
+  }
+}
+
+void test_expo_extremes_and_clamping() {
+  PanResponse linear = {90.0f, 0.0f, 0};
+  PanResponse cubic = {90.0f, 1.0f, 0};
+  PanResponse beyond = {90.0f, 3.0f, 0};
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 45.0f, stickToRate(0.5f, linear));
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 11.25f, stickToRate(0.5f, cubic));
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 11.25f, stickToRate(0.5f, beyond));  // expo clamped to 1
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 90.0f, stickToRate(1.7f, RESPONSE));  // deflection clamped
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, -90.0f, stickToRate(-5.0f, RESPONSE));
+}
+
+void test_acceleration_limited_ramp() {
+  RatePan pan(0, 180);
+  pan.reset(20);
+  float previous = 0;
+  int ticks = 0;
+  while (pan.velocity() < RESPONSE.maxRate - 1e-3f) {
+    pan.update(RESPONSE.maxRate, RESPONSE.maxAccel, DT);
+    TEST_ASSERT_LESS_OR_EQUAL_FLOAT(RESPONSE.maxAccel * DT + 1e-3f, pan.velocity() - previous);
+    previous = pan.velocity();
+    ticks++;
+  }
+  // 90 deg/s at 360 deg/s^2: 0.25 s and 11.25 degrees
+  TEST_ASSERT_EQUAL_INT(25, ticks);
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 31.25f, pan.position());
+
+  // Then cruises at the commanded rate, never above it
+  for (int i = 0; i < 50; i++) pan.update(RESPONSE.maxRate, RESPONSE.maxAccel, DT);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3f, RESPONSE.maxRate, pan.velocity());
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 76.25f, pan.position());
+
+  // Stick released: decelerates at the same limit
+  pan.update(0, RESPONSE.maxAccel, DT);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3f, RESPONSE.maxRate - RESPONSE.maxAccel * DT, pan.velocity());
+  for (int i = 0; i < 30; i++) pan.update(0, RESPONSE.maxAccel, DT);
+  TEST_ASSERT_EQUAL_FLOAT(0, pan.velocity());
+  TEST_ASSERT_FLOAT_WITHIN(0.05f, 87.5f, pan.position());
+}
+
+void test_reversal_is_acceleration_limited() {
+  RatePan pan(0, 180);
+  pan.reset(90);
+  for (int i = 0; i < 100; i++) pan.update(60, RESPONSE.maxAccel, DT);
+  float previous = pan.velocity();
+  for (int i = 0; i < 100; i++) {
+    pan.update(-60, RESPONSE.maxAccel, DT);
+    TEST_ASSERT_LESS_OR_EQUAL_FLOAT(RESPONSE.maxAccel * DT + 1e-3f, fabsf(pan.velocity() - previous));
+    previous = pan.velocity();
+  }
+  TEST_ASSERT_FLOAT_WITHIN(1e-3f, -60.0f, pan.velocity());
+}
+
+void test_brakes_to_rest_at_travel_limit() {
+  // Full speed into the end stop: slows down in time and stops on it, never past it
+  RatePan pan(10, 170);
+  pan.reset(100);
+  float previous = 0;
+  for (int i = 0; i < 300; i++) {
+    pan.update(RESPONSE.maxRate, RESPONSE.maxAccel, DT);
+    TEST_ASSERT_LESS_OR_EQUAL_FLOAT(170.0f, pan.position());
+    // Braking is acceleration-limited too (the last tick may clip onto the limit)
+    if (pan.position() < 170.0f) {
+      TEST_ASSERT_LESS_OR_EQUAL_FLOAT(RESPONSE.maxAccel * DT + 0.5f, fabsf(pan.velocity() - previous));
+    }
+    previous = pan.velocity();
+  }
+  TEST_ASSERT_FLOAT_WITHIN(0.05f, 170.0f, pan.position());
+  TEST_ASSERT_EQUAL_FLOAT(0, pan.velocity());
+
+  // And away from it again
+  pan.update(-RESPONSE.maxRate, RESPONSE.maxAccel, DT);
+  TEST_ASSERT_TRUE(pan.position() < 170.0f);
+}
+
+void test_no_accel_limit_follows_rate_directly() {
+  RatePan pan(0, 180);
+  pan.reset(90);
+  pan.update(45, 0, 0.1f);
+  TEST_ASSERT_EQUAL_FLOAT(45, pan.velocity());
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 94.5f, pan.position());
+  for (int i = 0; i < 100; i++) pan.update(45, 0, 0.1f);
+  TEST_ASSERT_EQUAL_FLOAT(180, pan.position());  // clamped at the limit
+  TEST_ASSERT_EQUAL_FLOAT(0, pan.velocity());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_expo_curve_shape);
+  RUN_TEST(test_expo_extremes_and_clamping);
+  RUN_TEST(test_acceleration_limited_ramp);
+  RUN_TEST(test_reversal_is_acceleration_limited);
+  RUN_TEST(test_brakes_to_rest_at_travel_limit);
+  RUN_TEST(test_no_accel_limit_follows_rate_directly);
+  return UNITY_END();
+}
@@ -0,0 +1,209 @@
+// Libraries on the mock HAL (sim/NativeHal), in the sketch sim envs:
+//   pio test -e servo_control_native
+//   pio test -e webcam_platform_native
+// The clock is paused, so every test decides exactly how much time passes.
+
+#include <unity.h>
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <Preferences.h>
+
+#include "AllocCounter.h"
+#include "CalibratedServo.h"
+#include "SimHal.h"
+#include "StateStore.h"
+
+const uint8_t SERVO_PIN = 18;
+const uint8_t ADC_PIN = 34;
+const uint8_t BUTTON_PIN = 4;
+
+struct TestState {
+  int16_t angle;
+  int16_t rate;
+};
+
+const PersistPolicy POLICY = {500, 2000, 5000};  // settle, min interval, max delay (ms)
+
+void setUp() {
+  sim::pause();
+  sim::setAdcNoise(0);
+  Preferences prefs;
+  prefs.begin("state", false);
+  prefs.clear();
+  prefs.end();
+}
+
+void tearDown() {}
+
+void test_paused_clock_moves_only_on_step() {
+  uint32_t start = micros();
+  uint32_t startMs = millis();
+  TEST_ASSERT_EQUAL_UINT32(start, micros());
+
+  sim::step(2500);
+  TEST_ASSERT_EQUAL_UINT32(start + 2500, micros());
+  sim::step(1000000);
+  TEST_ASSERT_UINT32_WITHIN(1, startMs + 1002, millis());
+}
+
+void test_pins_and_interrupts() {
+  TEST_ASSERT_EQUAL_UINT16(2048, analogRead(ADC_PIN));  // a centered stick by default
+  sim::setAnalog(ADC_PIN, 3100);
+  TEST_ASSERT_EQUAL_UINT16(3100, analogRead(ADC_PIN));
+
+  static volatile int edges = 0;
+  edges = 0;
+  pinMode(BUTTON_PIN, INPUT_PULLUP);
+  TEST_ASSERT_EQUAL_INT(HIGH, digitalRead(BUTTON_PIN));
+  attachInterrupt(BUTTON_PIN, [] { edges = edges + 1; }, CHANGE);
+  sim::setDigital(BUTTON_PIN, false);
+  sim::setDigital(BUTTON_PIN, true);
+  detachInterrupt(BUTTON_PIN);
+  sim::setDigital(BUTTON_PIN, false);
+  TEST_ASSERT_EQUAL_INT(2, edges);
+  TEST_ASSERT_EQUAL_INT(LOW, digitalRead(BUTTON_PIN));
+  sim::setDigital(BUTTON_PIN, true);
+}
+
+void test_calibrated_servo_lands_in_timeline() {
+  CalibratedServo servo(linearCalibration(500, 2500));
+  servo.attach(SERVO_PIN);
+  size_t before = sim::servoTimeline().size();
+
+  TEST_ASSERT_TRUE(servo.write(90 * ANGLE_SCALE));
+  sim::step(20000);
+  TEST_ASSERT_TRUE(servo.write(45 * ANGLE_SCALE));
+  TEST_ASSERT_FALSE(servo.write(45 * ANGLE_SCALE));  // same pulse: no write
+
+  std::vector<sim::PwmSample> timeline = sim::servoTimeline();
+  TEST_ASSERT_EQUAL_size_t(before + 2, timeline.size());
+  const sim::PwmSample& center = timeline[before];
+  const sim::PwmSample& quarter = timeline[before + 1];
+  TEST_ASSERT_EQUAL_UINT8(SERVO_PIN, center.pin);
+  TEST_ASSERT_EQUAL_UINT16(1500, center.pulseUs);
+  TEST_ASSERT_EQUAL_UINT16(1000, quarter.pulseUs);
+  TEST_ASSERT_EQUAL(20000, quarter.timeUs - center.timeUs);
+  TEST_ASSERT_EQUAL_UINT16(1000, sim::servoPulse(SERVO_PIN));
+}
+
+void test_persistent_state_coalesces_on_sim_clock() {
+  PersistentState<TestState> state("test", POLICY);
+  TestState value = {};
+
+  // A pan: a new angle every 10 ms for 3 s, then it rests
+  for (int i = 0; i < 300; i++) {
+    value.angle = (int16_t)((i + 1) * 10);
+    state.update(value, millis());
+    state.flush(millis());
+    sim::step(10000);
+  }
+  // Kept changing: written once maxDelayMs in, not 300 times
+  TEST_ASSERT_EQUAL_UINT32(300, state.updates());
+  TEST_ASSERT_EQUAL_UINT32(0, state.writes());
+
+  sim::step(2000000);
+  TEST_ASSERT_TRUE(state.flush(millis()));
+  TEST_ASSERT_FALSE(state.flush(millis()));
+  TEST_ASSERT_EQUAL_UINT32(1, state.writes());
+  TEST_ASSERT_EQUAL_UINT32(0, state.failures());
+
+  // What a reboot finds in the mock NVS
+  PersistentState<TestState> restored("test", POLICY);
+  TestState loaded = {};
+  TEST_ASSERT_TRUE(restored.load(loaded));
+  TEST_ASSERT_EQUAL_INT16(3000, loaded.angle);
+
+  PersistentState<TestState> missing("other", POLICY);
+  TEST_ASSERT_FALSE(missing.load(loaded));
+}
+
+void test_persistent_state_max_delay_and_min_interval() {
+  PersistentState<TestState> state("test", POLICY);
+  TestState value = {};
+
+  // Never settles: forced out after maxDelayMs, then no sooner than minIntervalMs apart
+  uint32_t writes = 0;
+  for (int i = 0; i < 1200; i++) {  // 12 s
+    value.rate = (int16_t)i;
+    state.update(value, millis());
+    if (state.flush(millis())) writes++;
+    sim::step(10000);
+  }
+  TEST_ASSERT_EQUAL_UINT32(writes, state.writes());
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT32(2, writes);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(12000 / POLICY.maxDelayMs + 1, writes);
+}
+
+void test_state_updates_do_not_allocate() {
+  if (!allocCounterEnabled()) return;  // only the -DALLOC_COUNTER builds wrap malloc
+
+  // The control-loop side: update() every tick, flush() while nothing is due
+  PersistentState<TestState> state("test", POLICY);
+  TestState value = {};
+  uint32_t before = allocCount();
+  for (int i = 0; i < 100; i++) {
+    value.angle = (int16_t)(i / 10 + 1);  // a new value every 10th tick
+    state.update(value, millis());
+    TEST_ASSERT_FALSE(state.flush(millis()));
+    sim::step(10000);
+  }
+  TEST_ASSERT_EQUAL_UINT32(before, allocCount());
+  TEST_ASSERT_EQUAL_UINT32(10, state.updates());
+}
+
+void test_littlefs_replace_by_rename() {
+  // How the webcam sketch saves its recording: a temporary file renamed over the old one
+  TEST_ASSERT_TRUE(LittleFS.begin(true));
+  TEST_ASSERT_TRUE(LittleFS.format());
+  const uint8_t first[] = {1, 2, 3};
+  const uint8_t second[] = {4, 5, 6, 7};
+
+  File file = LittleFS.open("/blob.tmp", FILE_WRITE);
+  TEST_ASSERT_TRUE((bool)file);
+  TEST_ASSERT_EQUAL_size_t(sizeof(first), file.write(first, sizeof(first)));
+  TEST_ASSERT_FALSE(LittleFS.exists("/blob.tmp"));  // appears on close
+  file.close();
+  TEST_ASSERT_TRUE(LittleFS.rename("/blob.tmp", "/blob.bin"));
+
+  file = LittleFS.open("/blob.tmp", FILE_WRITE);
+  file.write(second, sizeof(second));
+  file.close();
+  TEST_ASSERT_TRUE(LittleFS.rename("/blob.tmp", "/blob.bin"));
+  TEST_ASSERT_FALSE(LittleFS.exists("/blob.tmp"));
+
+  uint8_t read[8] = {};
+  file = LittleFS.open("/blob.bin");
+  TEST_ASSERT_EQUAL_size_t(sizeof(second), file.size());
+  TEST_ASSERT_EQUAL_size_t(sizeof(second), file.read(read, sizeof(read)));
+  TEST_ASSERT_EQUAL_MEMORY(second, read, sizeof(second));
+  file.close();
+  TEST_ASSERT_FALSE((bool)LittleFS.open("/missing.bin"));
+}
+
+void test_littlefs_full_partition_writes_short() {
+  TEST_ASSERT_TRUE(LittleFS.begin(true));
+  TEST_ASSERT_TRUE(LittleFS.format());
+  static uint8_t chunk[65536];
+  File file = LittleFS.open("/big.bin", FILE_WRITE);
+  size_t written = 0;
+  while (file.write(chunk, sizeof(chunk)) == sizeof(chunk)) written += sizeof(chunk);
+  file.close();
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(LittleFS.totalBytes(), written);
+  TEST_ASSERT_EQUAL_size_t(LittleFS.totalBytes(), LittleFS.usedBytes());
+  TEST_ASSERT_TRUE(LittleFS.remove("/big.bin"));
+  TEST_ASSERT_EQUAL_size_t(0, LittleFS.usedBytes());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_paused_clock_moves_only_on_step);
+  RUN_TEST(test_pins_and_interrupts);
+  RUN_TEST(test_calibrated_servo_lands_in_timeline);
+  RUN_TEST(test_persistent_state_coalesces_on_sim_clock);
+  RUN_TEST(test_persistent_state_max_delay_and_min_interval);
+  RUN_TEST(test_state_updates_do_not_allocate);
+  RUN_TEST(test_littlefs_replace_by_rename);
+  RUN_TEST(test_littlefs_full_partition_writes_short);
+  return UNITY_END();
+}
@@ -0,0 +1,158 @@
+// Trajectory over a long waypoint stream: continuity across segment boundaries, no overshoot,
+// and a total duration that does not drift with the tick rate
+
+#include <unity.h>
+
+#include <math.h>
+#include <stdint.h>
+
+#include "Trajectory.h"
+
+const int WAYPOINTS = 400;
+
+static Waypoint path[WAYPOINTS];
+static uint32_t pathMs;  // sum of all segment durations
+
+// Deterministic pseudo-random path: 5..30 degree steps in runs of the same direction, with
+// explicit durations and speed-derived ones mixed
+static void buildPath() {
+  uint32_t seed = 12345;
+  auto next = [&seed] {
+    seed = seed * 1103515245u + 12345u;
+    return (seed >> 16) & 0x7FFF;
+  };
+  float angle = 90;
+  float dir = 1;
+  pathMs = 0;
+  for (int i = 0; i < WAYPOINTS; i++) {
+    if (next() % 4 == 0) dir = -dir;
+    float step = 5 + next() % 26;
+    if (angle + dir * step > 180 || angle + dir * step < 0) dir = -dir;
+    float from = angle;
+    angle += dir * step;
+    if (i % 3 == 0) {
+      path[i] = {angle, 0, 40.0f + next() % 80};
+    } else {
+      path[i] = {angle, 150u + next() % 350, 0};
+    }
+    pathMs += Trajectory::segmentMs(path[i], from);
+  }
+}
+
+// Feeds the lookahead the way the sketches do: before every tick
+struct Runner {
+  Trajectory trajectory;
+  int fed = 0;
+
+  void start(uint32_t nowMs) {
+    trajectory.start(90, 0, nowMs);
+    fed = 0;
+  }
+  float tick(uint32_t nowMs) {
+    while (fed < WAYPOINTS && !trajectory.lookaheadFull()) trajectory.push(path[fed++]);
+    return trajectory.update(nowMs);
+  }
+};
+
+void setUp() { buildPath(); }
+void tearDown() {}
+
+void test_total_duration_is_exact_at_1ms_ticks() {
+  static Runner runner;
+  const uint32_t t0 = 5000;
+  runner.start(t0);
+  uint32_t now = t0;
+  while (runner.trajectory.active()) runner.tick(++now);
+  TEST_ASSERT_EQUAL_UINT32(t0 + pathMs, now);
+  TEST_ASSERT_EQUAL_UINT32(WAYPOINTS, runner.trajectory.reached());
+  TEST_ASSERT_EQUAL_FLOAT(path[WAYPOINTS - 1].angle, runner.trajectory.position());
+  TEST_ASSERT_EQUAL_FLOAT(0, runner.trajectory.velocity());
+}
+
+void test_jittery_ticks_do_not_drift() {
+  // 5..15 ms ticks: the end is noticed on the first tick at or after the planned time
+  static Runner runner;
+  uint32_t seed = 99;
+  const uint32_t t0 = 0xFFFF0000u;  // crosses the millis() wrap on the way
+  runner.start(t0);
+  uint32_t now = t0;
+  uint32_t previous = now;
+  while (runner.trajectory.active()) {
+    previous = now;
+    seed = seed * 1103515245u + 12345u;
+    now += 5 + (seed >> 16) % 11;
+    runner.tick(now);
+  }
+  const uint32_t end = t0 + pathMs;
+  TEST_ASSERT_TRUE((int32_t)(now - end) >= 0);
+  TEST_ASSERT_TRUE((int32_t)(previous - end) < 0);
+  TEST_ASSERT_EQUAL_UINT32(WAYPOINTS, runner.trajectory.reached());
+}
+
+void test_segment_boundaries_are_continuous() {
+  static Runner runner;
+  runner.start(0);
+  uint32_t now = 0;
+  float prevPos = runner.tick(0);
+  float prevVel = runner.trajectory.velocity();
+  float prevPrevVel = prevVel;
+  float worstMiss = 0;
+  int boundaries = 0;
+
+  while (runner.trajectory.active()) {
+    uint32_t reachedBefore = runner.trajectory.reached();
+    float pos = runner.tick(++now);
+    float vel = runner.trajectory.velocity();
+
+    // Never a position step the velocity does not explain
+    TEST_ASSERT_FLOAT_WITHIN(0.01f + fmaxf(fabsf(vel), fabsf(prevVel)) * 0.001f, prevPos, pos);
+
+    if (runner.trajectory.reached() != reachedBefore && runner.trajectory.active()) {
+      // Exactly on the waypoint at the boundary tick, with the velocity the old segment was
+      // heading for (extrapolated from its last two ticks), not a restart
+      TEST_ASSERT_EQUAL_FLOAT(path[runner.trajectory.reached() - 1].angle, pos);
+      worstMiss = fmaxf(worstMiss, fabsf(vel - (2 * prevVel - prevPrevVel)));
+      boundaries++;
+    }
+    prevPos = pos;
+    prevPrevVel = prevVel;
+    prevVel = vel;
+  }
+  TEST_ASSERT_EQUAL_INT(WAYPOINTS - 1, boundaries);
+  TEST_ASSERT_LESS_THAN_FLOAT(0.5f, worstMiss);  // deg/s
+}
+
+void test_no_overshoot_and_stop_at_reversals() {
+  static Runner runner;
+  runner.start(0);
+  uint32_t now = 0;
+  float from = 90;
+  uint32_t segment = 0;
+  while (runner.trajectory.active()) {
+    float pos = runner.tick(++now);
+    if (runner.trajectory.reached() != segment) {
+      // At a waypoint where the path turns back the axis is at rest
+      uint32_t i = runner.trajectory.reached() - 1;
+      if (i + 1 < WAYPOINTS) {
+        float in = path[i].angle - from;
+        float out = path[i + 1].angle - path[i].angle;
+        if (in * out < 0) TEST_ASSERT_EQUAL_FLOAT(0, runner.trajectory.velocity());
+      }
+      from = path[i].angle;
+      segment = runner.trajectory.reached();
+      continue;
+    }
+    const float lo = fminf(from, path[segment].angle);
+    const float hi = fmaxf(from, path[segment].angle);
+    TEST_ASSERT_TRUE(pos >= lo - 1e-3f && pos <= hi + 1e-3f);
+  }
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_total_duration_is_exact_at_1ms_ticks);
+  RUN_TEST(test_jittery_ticks_do_not_drift);
+  RUN_TEST(test_segment_boundaries_are_continuous);
+  RUN_TEST(test_no_overshoot_and_stop_at_reversals);
+  return UNITY_END();
+}
@@ -0,0 +1,133 @@
+// TrapezoidProfile: phase timing, limits along the way and exact endpoints
+
+#include <unity.h>
+
+#include <math.h>
+
+#include "TrapezoidProfile.h"
+
+const MotionLimits LIMITS = {60.0f, 120.0f};  // deg/s, deg/s^2
+const float EPS = 1e-3f;
+
+void setUp() {}
+void tearDown() {}
+
+// Samples the whole profile: speed and acceleration stay within the limits, the position
+// follows the integrated velocity without jumps
+static void checkLimits(const TrapezoidProfile& p, const MotionLimits& limits) {
+  const float dt = 0.001f;
+  float prevPos = p.positionAt(0);
+  float prevVel = p.velocityAt(0);
+  for (float t = dt; t <= p.duration() + dt; t += dt) {
+    float pos = p.positionAt(t);
+    float vel = p.velocityAt(t);
+    TEST_ASSERT_LESS_OR_EQUAL_FLOAT(limits.maxVelocity + EPS, fabsf(vel));
+    TEST_ASSERT_LESS_OR_EQUAL_FLOAT(limits.maxVelocity * dt + EPS, fabsf(pos - prevPos));
+    if (t < p.duration()) {
+      TEST_ASSERT_LESS_OR_EQUAL_FLOAT(limits.maxAcceleration * dt + 0.01f, fabsf(vel - prevVel));
+    }
+    prevPos = pos;
+    prevVel = vel;
+  }
+}
+
+void test_cruise_profile_timing() {
+  // 0.5 s up to 60 deg/s (15 deg), 60 deg cruise (1 s), 0.5 s down (15 deg)
+  TrapezoidProfile p;
+  p.plan(0, 90, 0, LIMITS);
+  TEST_ASSERT_FLOAT_WITHIN(EPS, 2.0f, p.duration());
+  TEST_ASSERT_FLOAT_WITHIN(EPS, 15.0f, p.positionAt(0.5f));
+  TEST_ASSERT_FLOAT_WITHIN(EPS, 60.0f, p.velocityAt(0.5f));
+  TEST_ASSERT_FLOAT_WITHIN(EPS, 45.0f, p.positionAt(1.0f));
+  TEST_ASSERT_FLOAT_WITHIN(EPS, 75.0f, p.positionAt(1.5f));
+  TEST_ASSERT_FLOAT_WITHIN(EPS, 30.0f, p.velocityAt(1.75f));
+  checkLimits(p, LIMITS);
+}
+
+void test_triangular_profile_timing() {
+  // Too short to reach 60 deg/s: peak sqrt(a * d) at half time
+  TrapezoidProfile p;
+  p.plan(0, 10, 0, LIMITS);
+  const float half = sqrtf(10.0f / 120.0f);
+  TEST_ASSERT_FLOAT_WITHIN(EPS, 2 * half, p.duration());
+  TEST_ASSERT_FLOAT_WITHIN(EPS, 5.0f, p.positionAt(half));
+  TEST_ASSERT_FLOAT_WITHIN(EPS, 120.0f * half, p.velocityAt(half));
+  checkLimits(p, LIMITS);
+}
+
+void test_endpoints_are_exact() {
+  const float moves[][2] = {{0, 90}, {90, 0}, {12.34f, 12.35f}, {180, 0.01f}, {45.5f, 45.5f}};
+  for (const auto& move : moves) {
+    TrapezoidProfile p;
+    p.plan(move[0], move[1], 0, LIMITS);
+    TEST_ASSERT_EQUAL_FLOAT(move[0], p.positionAt(0));
+    TEST_ASSERT_EQUAL_FLOAT(move[1], p.positionAt(p.duration()));
+    TEST_ASSERT_EQUAL_FLOAT(move[1], p.positionAt(p.duration() + 10));
+    TEST_ASSERT_EQUAL_FLOAT(0, p.velocityAt(p.duration()));
+    // The last sample before the end is already within one tick of travel
+    TEST_ASSERT_FLOAT_WITHIN(LIMITS.maxVelocity * 0.01f, move[1], p.positionAt(p.duration() - 0.01f));
+  }
+}
+
+void test_reverse_direction() {
+  TrapezoidProfile p;
+  p.plan(90, 0, 0, LIMITS);
+  TEST_ASSERT_FLOAT_WITHIN(EPS, 2.0f, p.duration());
+  TEST_ASSERT_FLOAT_WITHIN(EPS, 75.0f, p.positionAt(0.5f));
+  TEST_ASSERT_FLOAT_WITHIN(EPS, -60.0f, p.velocityAt(1.0f));
+  checkLimits(p, LIMITS);
+}
+
+void test_retarget_with_start_velocity() {
+  // Moving at full speed towards 90 and retargeted to 30: keeps going, no velocity jump
+  TrapezoidProfile p;
+  p.plan(20, 30, 60, LIMITS);
+  TEST_ASSERT_FLOAT_WITHIN(EPS, 60.0f, p.velocityAt(0));
+  TEST_ASSERT_EQUAL_FLOAT(30, p.positionAt(p.duration()));
+  checkLimits(p, LIMITS);
+}
+
+void test_overshoot_when_too_fast_to_stop() {
+  // 15 deg needed to stop from 60 deg/s, only 1 deg left: overshoot and come back
+  TrapezoidProfile p;
+  p.plan(0, 1, 60, LIMITS);
+  float furthest = 0;
+  for (float t = 0; t < p.duration(); t += 0.001f) furthest = fmaxf(furthest, p.positionAt(t));
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 15.0f, furthest);
+  TEST_ASSERT_EQUAL_FLOAT(1, p.positionAt(p.duration()));
+  TEST_ASSERT_EQUAL_FLOAT(0, p.velocityAt(p.duration()));
+  checkLimits(p, LIMITS);
+}
+
+void test_entering_above_max_velocity() {
+  // Handed over at 90 deg/s (limits lowered mid-move): slows to 60 first
+  TrapezoidProfile p;
+  p.plan(0, 90, 90, LIMITS);
+  TEST_ASSERT_FLOAT_WITHIN(EPS, 90.0f, p.velocityAt(0));
+  TEST_ASSERT_FLOAT_WITHIN(EPS, 60.0f, p.velocityAt(0.25f));
+  TEST_ASSERT_EQUAL_FLOAT(90, p.positionAt(p.duration()));
+}
+
+void test_no_limits_or_no_distance_is_instant() {
+  TrapezoidProfile p;
+  p.plan(10, 80, 0, {0, 0});
+  TEST_ASSERT_EQUAL_FLOAT(0, p.duration());
+  TEST_ASSERT_EQUAL_FLOAT(80, p.positionAt(0));
+
+  p.plan(45, 45, 0, LIMITS);
+  TEST_ASSERT_EQUAL_FLOAT(0, p.duration());
+  TEST_ASSERT_EQUAL_FLOAT(45, p.positionAt(0.1f));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_cruise_profile_timing);
+  RUN_TEST(test_triangular_profile_timing);
+  RUN_TEST(test_endpoints_are_exact);
+  RUN_TEST(test_reverse_direction);
+  RUN_TEST(test_retarget_with_start_velocity);
+  RUN_TEST(test_overshoot_when_too_fast_to_stop);
+  RUN_TEST(test_entering_above_max_velocity);
+  RUN_TEST(test_no_limits_or_no_distance_is_instant);
+  return UNITY_END();
+}
@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+"""Collect benchmark results from a -DBENCH build and compare them with a baseline.
+
+The firmware prints one "BENCH {json}" line per scenario and {"done": true} at the end.
+Read them from the board's serial port or from the native build's stdout:
+
+    pio run -e webcam_platform_bench -t upload
+    python3 tools/bench_report.py --serial /dev/ttyUSB0 --out bench.json
+
+    pio run -e webcam_platform_bench_native
+    .pio/build/webcam_platform_bench_native/program --seconds 60 | python3 tools/bench_report.py --out bench.json
+
+With --baseline the run is compared with an earlier --out file; the exit code is 1 when a
+tracked metric got worse by more than --tolerance (default 20 %).
+"""
+
+import argparse
+import json
+import sys
+import time
+
+# (path in the scenario object, True when bigger is better)
+TRACKED = [
+    (("loop", "busy_us", "p99"), False),
+    (("loop", "jitter_us", "p99"), False),
+    (("loop", "deadline_misses"), False),
+    (("http", "rps"), True),
+    (("http", "latency_us", "p50"), False),
+    (("http", "latency_us", "p99"), False),
+    (("burst", "rps"), True),
+    (("burst", "lag_us", "p99"), False),
+    (("log", "ns"), False),
+    (("log", "drop_ns"), False),
+    (("heap", "free_min"), True),
+    (("heap", "largest_block_min"), True),
+    (("allocs",), False),
+]
+
+# Below these, differences are timer noise rather than regressions
+ABSOLUTE_SLACK = {"p50": 20, "p99": 50, "deadline_misses": 0, "allocs": 0, "ns": 200, "drop_ns": 200}
+
+
+def lookup(scenario, path):
+    value = scenario
+    for key in path:
+        if not isinstance(value, dict) or key not in value:
+            return None
+        value = value[key]
+    return value
+
+
+def serial_lines(port, baud, timeout):
+    import serial  # pyserial, only needed for a board
+
+    deadline = time.monotonic() + timeout
+    with serial.Serial(port, baud, timeout=1) as link:
+        while time.monotonic() < deadline:
+            yield link.readline().decode("utf-8", errors="replace")
+
+
+def collect(lines):
+    bench = None
+    scenarios = []
+    for line in lines:
+        start = line.find("BENCH {")
+        if start < 0:
+            continue
+        try:
+            record = json.loads(line[start + 6:])
+        except ValueError:
+            print("unparsable: %s" % line.strip(), file=sys.stderr)
+            continue
+        bench = record.get("bench", bench)
+        if record.get("done"):
+            return bench, scenarios, True
+        scenarios.append(record)
+        print_scenario(record)
+    return bench, scenarios, False
+
+
+def print_scenario(s):
+    if "log" in s:
+        log = s["log"]
+        print("%-18s log call %s ns  dropped %s ns (%s/%s)  Serial.printf %s ns" % (
+            s.get("scenario"), log.get("ns"), log.get("drop_ns"), log.get("dropped"), log.get("drop_calls"),
+            log.get("serial_ns")), file=sys.stderr)
+        return
+    loop = s.get("loop", {})
+    text = "%-18s loop p50/p99/max %5s/%5s/%5s us  misses %s" % (
+        s.get("scenario"), lookup(loop, ("busy_us", "p50")), lookup(loop, ("busy_us", "p99")),
+        lookup(loop, ("busy_us", "max")), loop.get("deadline_misses"))
+    if "http" in s:
+        http = s["http"]
+        text += "  http %s req/s p50/p99 %s/%s us errors %s" % (
+            http.get("rps"), lookup(http, ("latency_us", "p50")), lookup(http, ("latency_us", "p99")),
+            http.get("errors"))
+    if "burst" in s:
+        burst = s["burst"]
+        text += "  burst %s req/s superseded %s/%s lag p50/p99 %s/%s us" % (
+            burst.get("rps"), burst.get("superseded"), burst.get("requests"), lookup(burst, ("lag_us", "p50")),
+            lookup(burst, ("lag_us", "p99")))
+    text += "  largest block %s" % lookup(s, ("heap", "largest_block_min"))
+    print(text, file=sys.stderr)
+
+
+def compare(current, baseline, tolerance):
+    old = {s["scenario"]: s for s in baseline.get("scenarios", [])}
+    regressions = []
+    for s in current["scenarios"]:
+        base = old.get(s["scenario"])
+        if base is None:
+            continue
+        for path, higher_is_better in TRACKED:
+            now, then = lookup(s, path), lookup(base, path)
+            if now is None or then is None:
+                continue
+            slack = max(abs(then) * tolerance, ABSOLUTE_SLACK.get(path[-1], 0))
+            worse = then - now if higher_is_better else now - then
+            if worse > slack:
+                regressions.append("%s %s: %s -> %s" % (s["scenario"], ".".join(path), then, now))
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--serial", help="read from this serial port instead of stdin")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--timeout", type=float, default=300, help="seconds to wait for the run on a board")
+    parser.add_argument("--out", help="write the collected results here (JSON)")
+    parser.add_argument("--baseline", help="results of an earlier run to compare with")
+    parser.add_argument("--tolerance", type=float, default=0.2, help="allowed relative regression")
+    args = parser.parse_args()
+
+    lines = serial_lines(args.serial, args.baud, args.timeout) if args.serial else sys.stdin
+    bench, scenarios, done = collect(lines)
+    if not scenarios:
+        print("no BENCH lines received", file=sys.stderr)
+        return 2
+    if not done:
+        print("warning: run did not finish, results are partial", file=sys.stderr)
+
+    result = {"bench": bench, "time": int(time.time()), "complete": done, "scenarios": scenarios}
+    if args.out:
+        with open(args.out, "w") as f:
+            json.dump(result, f, indent=1)
+
+    if args.baseline:
+        with open(args.baseline) as f:
+            regressions = compare(result, json.load(f), args.tolerance)
+        for r in regressions:
+            print("REGRESSION %s" % r, file=sys.stderr)
+        if regressions:
+            return 1
+        print("no regressions against %s" % args.baseline, file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,89 @@
+#!/usr/bin/env python3
+"""HTTP load generator for the device API (or the http_native host build).
+
+Opens N keep-alive connections, each sending requests back-to-back, and reports
+throughput and latency percentiles. Mix of /api/status polls and /api/angle commands.
+
+    python3 tools/http_load.py --host 127.0.0.1 --port 8080 --connections 8 --requests 2000
+"""
+
+import argparse
+import http.client
+import json
+import threading
+import time
+
+
+def worker(args, index, latencies, errors):
+    conn = http.client.HTTPConnection(args.host, args.port, timeout=5)
+    body = json.dumps({"angle": 90})
+    headers = {"Content-Type": "application/json"}
+    for i in range(args.requests):
+        start = time.perf_counter()
+        try:
+            if args.post_every and i % args.post_every == 0:
+                conn.request("POST", "/api/angle", body, headers)
+            else:
+                conn.request("GET", "/api/status")
+            response = conn.getresponse()
+            response.read()
+            if response.status != 200:
+                errors.append(response.status)
+        except (OSError, http.client.HTTPException) as e:
+            errors.append(str(e))
+            conn.close()
+            conn = http.client.HTTPConnection(args.host, args.port, timeout=5)
+            continue
+        latencies[index].append(time.perf_counter() - start)
+    conn.close()
+
+
+def percentile(sorted_values, p):
+    if not sorted_values:
+        return 0.0
+    k = min(len(sorted_values) - 1, int(round(p / 100.0 * (len(sorted_values) - 1))))
+    return sorted_values[k]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=8080)
+    parser.add_argument("--connections", type=int, default=4)
+    parser.add_argument("--requests", type=int, default=500, help="requests per connection")
+    parser.add_argument("--post-every", type=int, default=5, help="every Nth request is POST /api/angle (0 = never)")
+    parser.add_argument("--json", action="store_true", help="print results as JSON")
+    args = parser.parse_args()
+
+    latencies = [[] for _ in range(args.connections)]
+    errors = []
+    threads = [threading.Thread(target=worker, args=(args, i, latencies, errors)) for i in range(args.connections)]
+
+    start = time.perf_counter()
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    elapsed = time.perf_counter() - start
+
+    samples = sorted(x for per_conn in latencies for x in per_conn)
+    result = {
+        "connections": args.connections,
+        "requests": len(samples),
+        "errors": len(errors),
+        "seconds": round(elapsed, 3),
+        "rps": round(len(samples) / elapsed, 1) if elapsed > 0 else 0,
+        "p50_ms": round(percentile(samples, 50) * 1000, 3),
+        "p99_ms": round(percentile(samples, 99) * 1000, 3),
+        "max_ms": round(samples[-1] * 1000, 3) if samples else 0,
+    }
+
+    if args.json:
+        print(json.dumps(result))
+    else:
+        for key, value in result.items():
+            print(f"{key:>12}: {value}")
+
+
+if __name__ == "__main__":
+    main()
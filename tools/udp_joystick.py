@@ -0,0 +1,153 @@
+#!/usr/bin/env python3
+"""Joystick stream sender and latency benchmark for the UDP control protocol.
+
+Streams RATE (or ANGLE) packets at a fixed rate to webcam_platform (or the http_native
+host build), asks for acks, and reports command-to-servo latency:
+
+  rtt     - packet sent -> ack received (network both ways + queueing + control tick)
+  device  - packet received -> servo written, as measured on the device
+
+    python3 tools/udp_joystick.py --host 192.168.1.50 --rate 100 --seconds 10
+    python3 tools/udp_joystick.py --port 4210 --mode angle --reorder 0.05 --json
+
+Packet layout: lib/UdpControl/UdpProtocol.h.
+"""
+
+import argparse
+import json
+import math
+import random
+import socket
+import struct
+import threading
+import time
+
+MAGIC = 0xC7
+UDP_ANGLE, UDP_RATE, UDP_STOP, UDP_HEARTBEAT, UDP_ACK = 1, 2, 3, 4, 0x80
+FLAG_ACK = 0x01
+
+COMMAND = struct.Struct("<BBBBIIhH")
+ACK = struct.Struct("<BBBBIIhHI")
+
+
+def now_us():
+    return (time.perf_counter_ns() // 1000) & 0xFFFFFFFF
+
+
+def percentile(values, p):
+    if not values:
+        return 0.0
+    values = sorted(values)
+    return values[min(len(values) - 1, int(len(values) * p / 100.0))]
+
+
+def receiver(sock, stop, rtts, device, acked):
+    sock.settimeout(0.1)
+    while not stop.is_set():
+        try:
+            data = sock.recv(64)
+        except socket.timeout:
+            continue
+        except OSError:
+            break
+        if len(data) != ACK.size:
+            continue
+        magic, kind, _, _, seq, stamp, angle, _, latency_us = ACK.unpack(data)
+        if magic != MAGIC or kind != UDP_ACK:
+            continue
+        rtts.append(((now_us() - stamp) & 0xFFFFFFFF) / 1000.0)
+        device.append(latency_us / 1000.0)
+        acked.add(seq)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=4210)
+    parser.add_argument("--rate", type=float, default=100.0, help="packets per second")
+    parser.add_argument("--seconds", type=float, default=5.0)
+    parser.add_argument("--mode", choices=["rate", "angle"], default="rate")
+    parser.add_argument("--amplitude", type=float, default=60.0, help="deg/s (rate) or deg around 90 (angle)")
+    parser.add_argument("--ack-every", type=int, default=1, help="request an ack every N packets, 0 = never")
+    parser.add_argument("--reorder", type=float, default=0.0, help="fraction of packets sent late (stale test)")
+    parser.add_argument("--no-stop", action="store_true", help="just go quiet at the end (watchdog test)")
+    parser.add_argument("--json", action="store_true", help="machine-readable summary")
+    args = parser.parse_args()
+
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.connect((args.host, args.port))
+
+    rtts, device, acked = [], [], set()
+    stop = threading.Event()
+    thread = threading.Thread(target=receiver, args=(sock, stop, rtts, device, acked), daemon=True)
+    thread.start()
+
+    period = 1.0 / args.rate
+    count = int(args.seconds * args.rate)
+    requested = []
+    held = None
+    start = time.perf_counter()
+
+    for seq in range(1, count + 1):
+        phase = 2 * math.pi * 0.25 * seq * period  # 0.25 Hz sweep of the virtual stick
+        if args.mode == "rate":
+            kind, value = UDP_RATE, int(args.amplitude * math.sin(phase) * 10)
+        else:
+            kind, value = UDP_ANGLE, int((90 + args.amplitude * math.sin(phase)) * 100)
+
+        flags = FLAG_ACK if args.ack_every and seq % args.ack_every == 0 else 0
+        packet = COMMAND.pack(MAGIC, kind, flags, 0, seq, now_us(), value, 0)
+
+        if args.reorder and held is None and random.random() < args.reorder:
+            held = packet  # goes out after the next one and must be dropped as stale
+        else:
+            if flags:
+                requested.append(seq)
+            sock.send(packet)
+            if held is not None:
+                sock.send(held)
+                held = None
+
+        next_at = start + seq * period
+        delay = next_at - time.perf_counter()
+        if delay > 0:
+            time.sleep(delay)
+
+    elapsed = time.perf_counter() - start
+    if not args.no_stop:
+        sock.send(COMMAND.pack(MAGIC, UDP_STOP, 0, 0, count + 1, now_us(), 0, 0))
+    time.sleep(0.3)
+    stop.set()
+    thread.join()
+    sock.close()
+
+    lost = len([s for s in requested if s not in acked])
+    summary = {
+        "packets": count,
+        "rate_hz": round(count / elapsed, 1),
+        "acks_requested": len(requested),
+        "acks_received": len(rtts),
+        "acks_lost": lost,
+        "rtt_ms": {
+            "p50": round(percentile(rtts, 50), 3),
+            "p99": round(percentile(rtts, 99), 3),
+            "max": round(max(rtts), 3) if rtts else 0.0,
+        },
+        "device_ms": {
+            "p50": round(percentile(device, 50), 3),
+            "p99": round(percentile(device, 99), 3),
+            "max": round(max(device), 3) if device else 0.0,
+        },
+    }
+
+    if args.json:
+        print(json.dumps(summary))
+        return
+
+    print(f"packets: {count} at {summary['rate_hz']} Hz, acks: {len(rtts)}/{len(requested)} (lost {lost})")
+    print("rtt      p50 {p50:.3f} ms  p99 {p99:.3f} ms  max {max:.3f} ms".format(**summary["rtt_ms"]))
+    print("device   p50 {p50:.3f} ms  p99 {p99:.3f} ms  max {max:.3f} ms".format(**summary["device_ms"]))
+
+
+if __name__ == "__main__":
+    main()